@@ -21,6 +21,7 @@ export interface NodeSensorAssignment {
   echoPinOverride?: number;
   baudRateOverride?: number;
   intervalSecondsOverride?: number;
+  aggregationWindowSeconds?: number;
   isActive: boolean;
   lastSeenAt?: string;
   assignedAt: string;
@@ -44,6 +45,7 @@ export interface CreateNodeSensorAssignmentDto {
   echoPinOverride?: number;
   baudRateOverride?: number;
   intervalSecondsOverride?: number;
+  aggregationWindowSeconds?: number;
 }
 
 /**
@@ -61,6 +63,7 @@ export interface UpdateNodeSensorAssignmentDto {
   echoPinOverride?: number;
   baudRateOverride?: number;
   intervalSecondsOverride?: number;
+  aggregationWindowSeconds?: number;
   isActive?: boolean;
 }
 
@@ -81,4 +84,5 @@ export interface EffectiveConfig {
   baudRate?: number;
   offsetCorrection: number;
   gainCorrection: number;
+  aggregationWindowSeconds: number;
 }
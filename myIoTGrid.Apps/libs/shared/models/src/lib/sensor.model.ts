@@ -42,6 +42,10 @@ export interface SensorCapability {
   matterClusterName?: string;
   sortOrder: number;
   isActive: boolean;
+  deadbandAbsolute?: number;
+  deadbandPercent?: number;
+  deadbandSlopePerMinute?: number;
+  maxSilenceSeconds?: number;
 }
 
 /**
@@ -142,6 +146,10 @@ export interface CreateSensorCapabilityDto {
   matterClusterId?: number;
   matterClusterName?: string;
   sortOrder?: number;
+  deadbandAbsolute?: number;
+  deadbandPercent?: number;
+  deadbandSlopePerMinute?: number;
+  maxSilenceSeconds?: number;
 }
 
 /**
@@ -207,6 +215,10 @@ export interface UpdateSensorCapabilityDto {
   matterClusterName?: string;
   sortOrder?: number;
   isActive?: boolean;
+  deadbandAbsolute?: number;
+  deadbandPercent?: number;
+  deadbandSlopePerMinute?: number;
+  maxSilenceSeconds?: number;
 }
 
 /**
@@ -92,6 +92,10 @@ public class NodeConfiguration : IEntityTypeConfiguration<Node>
         builder.Property(n => n.HardwareStatusJson)
             .HasColumnType("jsonb");
 
+        // Heartbeat Diagnostics
+        builder.Property(n => n.DiagnosticsJson)
+            .HasColumnType("jsonb");
+
         // Relationships
         builder.HasOne(n => n.Hub)
             .WithMany(h => h.Nodes)
@@ -0,0 +1,28 @@
+﻿using Microsoft.EntityFrameworkCore.Migrations;
+
+#nullable disable
+
+namespace myIoTGrid.Cloud.Infrastructure.Migrations
+{
+    /// <inheritdoc />
+    public partial class AddAssignmentAggregationWindow : Migration
+    {
+        /// <inheritdoc />
+        protected override void Up(MigrationBuilder migrationBuilder)
+        {
+            migrationBuilder.AddColumn<int>(
+                name: "AggregationWindowSeconds",
+                table: "NodeSensorAssignments",
+                type: "integer",
+                nullable: true);
+        }
+
+        /// <inheritdoc />
+        protected override void Down(MigrationBuilder migrationBuilder)
+        {
+            migrationBuilder.DropColumn(
+                name: "AggregationWindowSeconds",
+                table: "NodeSensorAssignments");
+        }
+    }
+}
@@ -0,0 +1,39 @@
+﻿using System;
+using Microsoft.EntityFrameworkCore.Migrations;
+
+#nullable disable
+
+namespace myIoTGrid.Cloud.Infrastructure.Migrations
+{
+    /// <inheritdoc />
+    public partial class AddNodeHeartbeatDiagnostics : Migration
+    {
+        /// <inheritdoc />
+        protected override void Up(MigrationBuilder migrationBuilder)
+        {
+            migrationBuilder.AddColumn<string>(
+                name: "DiagnosticsJson",
+                table: "Nodes",
+                type: "jsonb",
+                nullable: true);
+
+            migrationBuilder.AddColumn<DateTime>(
+                name: "DiagnosticsReportedAt",
+                table: "Nodes",
+                type: "timestamp with time zone",
+                nullable: true);
+        }
+
+        /// <inheritdoc />
+        protected override void Down(MigrationBuilder migrationBuilder)
+        {
+            migrationBuilder.DropColumn(
+                name: "DiagnosticsJson",
+                table: "Nodes");
+
+            migrationBuilder.DropColumn(
+                name: "DiagnosticsReportedAt",
+                table: "Nodes");
+        }
+    }
+}
@@ -0,0 +1,58 @@
+﻿using Microsoft.EntityFrameworkCore.Migrations;
+
+#nullable disable
+
+namespace myIoTGrid.Cloud.Infrastructure.Migrations
+{
+    /// <inheritdoc />
+    public partial class AddCapabilityDeadband : Migration
+    {
+        /// <inheritdoc />
+        protected override void Up(MigrationBuilder migrationBuilder)
+        {
+            migrationBuilder.AddColumn<double>(
+                name: "DeadbandAbsolute",
+                table: "SensorCapabilities",
+                type: "double precision",
+                nullable: true);
+
+            migrationBuilder.AddColumn<double>(
+                name: "DeadbandPercent",
+                table: "SensorCapabilities",
+                type: "double precision",
+                nullable: true);
+
+            migrationBuilder.AddColumn<double>(
+                name: "DeadbandSlopePerMinute",
+                table: "SensorCapabilities",
+                type: "double precision",
+                nullable: true);
+
+            migrationBuilder.AddColumn<int>(
+                name: "MaxSilenceSeconds",
+                table: "SensorCapabilities",
+                type: "integer",
+                nullable: true);
+        }
+
+        /// <inheritdoc />
+        protected override void Down(MigrationBuilder migrationBuilder)
+        {
+            migrationBuilder.DropColumn(
+                name: "DeadbandAbsolute",
+                table: "SensorCapabilities");
+
+            migrationBuilder.DropColumn(
+                name: "DeadbandPercent",
+                table: "SensorCapabilities");
+
+            migrationBuilder.DropColumn(
+                name: "DeadbandSlopePerMinute",
+                table: "SensorCapabilities");
+
+            migrationBuilder.DropColumn(
+                name: "MaxSilenceSeconds",
+                table: "SensorCapabilities");
+        }
+    }
+}
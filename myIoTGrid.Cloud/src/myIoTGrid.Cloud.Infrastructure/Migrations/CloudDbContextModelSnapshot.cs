@@ -220,6 +220,12 @@ namespace myIoTGrid.Cloud.Infrastructure.Migrations
                         .HasColumnType("integer")
                         .HasDefaultValue(1);
 
+                    b.Property<string>("DiagnosticsJson")
+                        .HasColumnType("jsonb");
+
+                    b.Property<DateTime?>("DiagnosticsReportedAt")
+                        .HasColumnType("timestamp with time zone");
+
                     b.Property<bool>("EnableRemoteLogging")
                         .ValueGeneratedOnAdd()
                         .HasColumnType("boolean")
@@ -363,6 +369,9 @@ namespace myIoTGrid.Cloud.Infrastructure.Migrations
                         .ValueGeneratedOnAdd()
                         .HasColumnType("uuid");
 
+                    b.Property<int?>("AggregationWindowSeconds")
+                        .HasColumnType("integer");
+
                     b.Property<string>("Alias")
                         .HasMaxLength(100)
                         .HasColumnType("character varying(100)");
@@ -650,6 +659,15 @@ namespace myIoTGrid.Cloud.Infrastructure.Migrations
                         .HasColumnType("double precision")
                         .HasDefaultValue(0.5);
 
+                    b.Property<double?>("DeadbandAbsolute")
+                        .HasColumnType("double precision");
+
+                    b.Property<double?>("DeadbandPercent")
+                        .HasColumnType("double precision");
+
+                    b.Property<double?>("DeadbandSlopePerMinute")
+                        .HasColumnType("double precision");
+
                     b.Property<string>("DisplayName")
                         .IsRequired()
                         .HasMaxLength(100)
@@ -667,6 +685,9 @@ namespace myIoTGrid.Cloud.Infrastructure.Migrations
                         .HasMaxLength(100)
                         .HasColumnType("character varying(100)");
 
+                    b.Property<int?>("MaxSilenceSeconds")
+                        .HasColumnType("integer");
+
                     b.Property<double?>("MaxValue")
                         .HasColumnType("double precision");
 
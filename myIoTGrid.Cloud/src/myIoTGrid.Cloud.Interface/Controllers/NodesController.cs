@@ -645,7 +645,11 @@ public class NodesController : ControllerBase
                 .Select(c => new SensorCapabilityConfigDto(
                     MeasurementType: c.MeasurementType,
                     DisplayName: c.DisplayName,
-                    Unit: c.Unit
+                    Unit: c.Unit,
+                    DeadbandAbsolute: c.DeadbandAbsolute,
+                    DeadbandPercent: c.DeadbandPercent,
+                    DeadbandSlopePerMinute: c.DeadbandSlopePerMinute,
+                    MaxSilenceSeconds: c.MaxSilenceSeconds
                 ))
                 .ToList() ?? new List<SensorCapabilityConfigDto>();
 
@@ -667,7 +671,8 @@ public class NodesController : ControllerBase
                 EchoPin: a.EffectiveConfig.EchoPin,
                 OffsetCorrection: a.EffectiveConfig.OffsetCorrection,
                 GainCorrection: a.EffectiveConfig.GainCorrection,
-                Capabilities: capabilities
+                Capabilities: capabilities,
+                AggregationWindowSeconds: a.EffectiveConfig.AggregationWindowSeconds
             ));
         }
 
@@ -25,7 +25,8 @@ public class EffectiveConfigService : IEffectiveConfigService
             EchoPin: assignment.EchoPinOverride ?? sensor.EchoPin,
             BaudRate: assignment.BaudRateOverride ?? sensor.BaudRate,
             OffsetCorrection: GetEffectiveOffset(sensor),
-            GainCorrection: GetEffectiveGain(sensor)
+            GainCorrection: GetEffectiveGain(sensor),
+            AggregationWindowSeconds: assignment.AggregationWindowSeconds ?? 0
         );
     }
 
@@ -4,13 +4,68 @@ namespace myIoTGrid.Gateway.LoRaWAN.Bridge.Decoders;
 /// myIoTGrid Custom Payload Decoder
 /// Format: [Type:1][Value:2 signed] pro Sensor (3 Bytes)
 /// Unterstützt Multi-Sensor Payloads
+///
+/// FPort 2: Aggregierter Multi-Sample Frame
+///   [SampleCount:1] SampleCount × [Age:2 (Sekunden vor TX)][Count:1][Count × Reading:3]
+///
+/// FPort 3: Fragment eines Batches, der nicht in einen Frame passt
+///   [BatchId:1][Index:4 Bit | Total:4 Bit][N × Reading:3]
+///   Fragmente werden je DevEUI + BatchId gepuffert und erst dekodiert,
+///   wenn alle Total Fragmente vorliegen.
+///
+/// FPort 4: Energie-Diagnose des letzten Wake-Zyklus (alle Werte uint16, MSB first)
+///   [Version:1][PhaseCount:1][PhaseCount × PhaseMs:2][DisplayMs:2][SleepSeconds:2][ChargeUah:2]
 /// </summary>
 public class MyIoTGridDecoder : IPayloadDecoder
 {
     private readonly ILogger<MyIoTGridDecoder> _logger;
+    private readonly TimeProvider _timeProvider;
 
     public string Name => "myIoTGrid";
 
+    /// <summary>
+    /// FPort für aggregierte Multi-Sample Frames (NodeLoraWan LORAWAN_AGGREGATED_PORT)
+    /// </summary>
+    public const int AggregatedPort = 2;
+
+    /// <summary>
+    /// FPort für Batch-Fragmente (NodeLoraWan LORAWAN_FRAGMENT_PORT)
+    /// </summary>
+    public const int FragmentPort = 3;
+
+    /// <summary>
+    /// FPort für Energie-Diagnose (NodeLoraWan LORAWAN_DIAG_PORT)
+    /// </summary>
+    public const int DiagnosticsPort = 4;
+
+    /// <summary>
+    /// Unvollständige Batches werden nach dieser Zeit verworfen
+    /// (Fragmente warten auf den Duty Cycle, die BatchId läuft nach 256 Batches über)
+    /// </summary>
+    public static readonly TimeSpan FragmentTimeout = TimeSpan.FromMinutes(30);
+
+    private const int ReadingSize = 3;
+    private const int SampleHeaderSize = 3;
+    private const int FragmentHeaderSize = 2;
+    private const byte DiagnosticsVersion = 1;
+
+    /// <summary>
+    /// Phasen des Energie-Profils in Frame-Reihenfolge (NodeLoraWan PowerPhase)
+    /// </summary>
+    private static readonly string[] EnergyPhases = ["boot", "sensor", "join", "tx", "rx", "idle"];
+
+    /// <summary>
+    /// Reassembly-Puffer: Key "DevEui/BatchId"
+    /// </summary>
+    private readonly Dictionary<string, PendingBatch> _pendingBatches = new();
+    private readonly object _pendingLock = new();
+
+    private sealed class PendingBatch
+    {
+        public required byte[]?[] Fragments { get; init; }
+        public required DateTime FirstReceived { get; init; }
+    }
+
     /// <summary>
     /// Sensor Type Mapping
     /// Key: Type Code (1 Byte)
@@ -66,18 +121,43 @@ public class MyIoTGridDecoder : IPayloadDecoder
         [0xFF] = ("status", "", 1),                 // Status-Code
     };
 
-    public MyIoTGridDecoder(ILogger<MyIoTGridDecoder> logger)
+    public MyIoTGridDecoder(ILogger<MyIoTGridDecoder> logger, TimeProvider? timeProvider = null)
     {
         _logger = logger;
+        _timeProvider = timeProvider ?? TimeProvider.System;
+    }
+
+    /// <summary>
+    /// Anzahl unvollständiger Batches im Reassembly-Puffer
+    /// </summary>
+    public int PendingBatchCount
+    {
+        get
+        {
+            lock (_pendingLock)
+            {
+                return _pendingBatches.Count;
+            }
+        }
     }
 
     public bool CanDecode(byte[] payload, int fPort)
     {
+        if (payload == null || payload.Length == 0 || fPort < 1 || fPort > 10)
+            return false;
+
+        if (fPort == AggregatedPort)
+            return TryGetSampleLayout(payload, out _);
+
+        if (fPort == FragmentPort)
+            return IsValidFragment(payload);
+
+        if (fPort == DiagnosticsPort)
+            return IsValidDiagnostics(payload);
+
         // myIoTGrid Format: Payload muss Vielfaches von 3 sein
         // FPort 1-10 sind für Sensordaten reserviert
-        return payload.Length > 0 &&
-               payload.Length % 3 == 0 &&
-               fPort >= 1 && fPort <= 10;
+        return payload.Length % ReadingSize == 0;
     }
 
     public IEnumerable<DecodedReading> Decode(byte[] payload, string devEui, int fPort)
@@ -85,21 +165,247 @@ public class MyIoTGridDecoder : IPayloadDecoder
         if (payload == null || payload.Length == 0)
         {
             _logger.LogWarning("Empty payload for device {DevEui}", devEui);
-            yield break;
+            return [];
         }
 
-        if (payload.Length % 3 != 0)
+        if (fPort == AggregatedPort)
+            return DecodeAggregated(payload, devEui, fPort);
+
+        if (fPort == FragmentPort)
+            return DecodeFragment(payload, devEui, fPort);
+
+        if (fPort == DiagnosticsPort)
+            return DecodeDiagnostics(payload, devEui, fPort);
+
+        if (payload.Length % ReadingSize != 0)
         {
             _logger.LogWarning(
                 "Invalid payload length: {Length} (must be multiple of 3) for device {DevEui}",
                 payload.Length, devEui);
-            yield break;
+            return [];
+        }
+
+        return DecodeReadings(
+            payload, 0, payload.Length / ReadingSize, devEui, fPort, _timeProvider.GetUtcNow().UtcDateTime);
+    }
+
+    /// <summary>
+    /// Dekodiert einen aggregierten Frame. Jedes Sample erhält seinen
+    /// Messzeitpunkt (Empfangszeit minus Age).
+    /// </summary>
+    private IEnumerable<DecodedReading> DecodeAggregated(byte[] payload, string devEui, int fPort)
+    {
+        if (!TryGetSampleLayout(payload, out var samples))
+        {
+            _logger.LogWarning(
+                "Invalid aggregated frame ({Length} bytes) for device {DevEui}",
+                payload.Length, devEui);
+            return [];
+        }
+
+        var receivedAt = _timeProvider.GetUtcNow().UtcDateTime;
+        var readings = new List<DecodedReading>();
+
+        foreach (var (offset, count, ageSeconds) in samples)
+        {
+            readings.AddRange(DecodeReadings(
+                payload, offset, count, devEui, fPort, receivedAt.AddSeconds(-ageSeconds)));
+        }
+
+        return readings;
+    }
+
+    /// <summary>
+    /// Puffert ein Fragment. Sobald alle Fragmente des Batches vorliegen,
+    /// werden die Readings in Index-Reihenfolge mit dem Empfangszeitpunkt
+    /// des ersten Fragments geliefert, sonst keine.
+    /// </summary>
+    private IEnumerable<DecodedReading> DecodeFragment(byte[] payload, string devEui, int fPort)
+    {
+        if (!IsValidFragment(payload))
+        {
+            _logger.LogWarning(
+                "Invalid fragment ({Length} bytes) for device {DevEui}",
+                payload.Length, devEui);
+            return [];
         }
 
-        var timestamp = DateTime.UtcNow;
+        var batchId = payload[0];
+        var index = payload[1] >> 4;
+        var total = payload[1] & 0x0F;
+        var key = $"{devEui}/{batchId}";
+        var now = _timeProvider.GetUtcNow().UtcDateTime;
+
+        PendingBatch batch;
+
+        lock (_pendingLock)
+        {
+            RemoveExpiredBatches(now);
+
+            if (!_pendingBatches.TryGetValue(key, out batch!) || batch.Fragments.Length != total)
+            {
+                // Neuer Batch (oder wiederverwendete BatchId mit anderer Fragmentzahl)
+                batch = new PendingBatch { Fragments = new byte[]?[total], FirstReceived = now };
+                _pendingBatches[key] = batch;
+            }
 
+            batch.Fragments[index] = payload;
+
+            if (batch.Fragments.Any(f => f == null))
+            {
+                _logger.LogDebug(
+                    "Fragment {Index}/{Total} of batch {BatchId} buffered for device {DevEui}",
+                    index + 1, total, batchId, devEui);
+                return [];
+            }
+
+            _pendingBatches.Remove(key);
+        }
+
+        var readings = new List<DecodedReading>();
+
+        foreach (var fragment in batch.Fragments)
+        {
+            var count = (fragment!.Length - FragmentHeaderSize) / ReadingSize;
+            readings.AddRange(DecodeReadings(
+                fragment, FragmentHeaderSize, count, devEui, fPort, batch.FirstReceived));
+        }
+
+        foreach (var reading in readings)
+        {
+            reading.Metadata!["batchId"] = batchId.ToString();
+        }
+
+        _logger.LogDebug(
+            "Batch {BatchId} reassembled from {Total} fragments for device {DevEui}",
+            batchId, total, devEui);
+
+        return readings;
+    }
+
+    /// <summary>
+    /// Verwirft Batches, deren erstes Fragment älter als FragmentTimeout ist
+    /// (Aufrufer hält _pendingLock)
+    /// </summary>
+    private void RemoveExpiredBatches(DateTime now)
+    {
+        foreach (var (key, batch) in _pendingBatches.Where(b => now - b.Value.FirstReceived > FragmentTimeout).ToList())
+        {
+            _logger.LogWarning(
+                "Dropping incomplete batch {Key} ({Received}/{Total} fragments)",
+                key, batch.Fragments.Count(f => f != null), batch.Fragments.Length);
+            _pendingBatches.Remove(key);
+        }
+    }
+
+    private static bool IsValidFragment(byte[] payload)
+    {
+        if (payload.Length < FragmentHeaderSize + ReadingSize ||
+            (payload.Length - FragmentHeaderSize) % ReadingSize != 0)
+            return false;
+
+        var index = payload[1] >> 4;
+        var total = payload[1] & 0x0F;
+        return total > 0 && index < total;
+    }
+
+    /// <summary>
+    /// Dekodiert den Energie-Diagnose-Frame zu Readings "energy_&lt;phase&gt;" (ms),
+    /// "energy_display" (ms), "energy_sleep" (s) und "energy_charge" (µAh)
+    /// </summary>
+    private IEnumerable<DecodedReading> DecodeDiagnostics(byte[] payload, string devEui, int fPort)
+    {
+        if (!IsValidDiagnostics(payload))
+        {
+            _logger.LogWarning(
+                "Invalid diagnostics frame (version {Version}, {Length} bytes) for device {DevEui}",
+                payload[0], payload.Length, devEui);
+            return [];
+        }
+
+        var timestamp = _timeProvider.GetUtcNow().UtcDateTime;
+        var values = new List<(string Type, string Unit, int Raw)>();
+        int phaseCount = payload[1];
+        int pos = 2;
+
+        for (int i = 0; i < phaseCount; i++, pos += 2)
+        {
+            var phase = i < EnergyPhases.Length ? EnergyPhases[i] : $"phase{i}";
+            values.Add(($"energy_{phase}", "ms", ReadUInt16(payload, pos)));
+        }
+
+        values.Add(("energy_display", "ms", ReadUInt16(payload, pos)));
+        values.Add(("energy_sleep", "s", ReadUInt16(payload, pos + 2)));
+        values.Add(("energy_charge", "µAh", ReadUInt16(payload, pos + 4)));
+
+        _logger.LogDebug(
+            "Decoded energy diagnostics ({Charge} µAh per cycle) from device {DevEui}",
+            values[^1].Raw, devEui);
+
+        return values.Select(v => new DecodedReading
+        {
+            DevEui = devEui,
+            Type = v.Type,
+            Value = v.Raw,
+            Unit = v.Unit,
+            Timestamp = timestamp,
+            Metadata = new Dictionary<string, string>
+            {
+                ["fPort"] = fPort.ToString(),
+                ["rawValue"] = v.Raw.ToString(),
+                ["decoder"] = Name,
+                ["diagVersion"] = payload[0].ToString()
+            }
+        }).ToList();
+    }
+
+    private static bool IsValidDiagnostics(byte[] payload)
+    {
+        return payload.Length >= 2 &&
+               payload[0] == DiagnosticsVersion &&
+               payload.Length == 2 + payload[1] * 2 + 6;
+    }
+
+    private static int ReadUInt16(byte[] payload, int offset)
+    {
+        return (payload[offset] << 8) | payload[offset + 1];
+    }
+
+    /// <summary>
+    /// Prüft die Struktur eines aggregierten Frames und liefert die Lage der Samples
+    /// </summary>
+    private static bool TryGetSampleLayout(
+        byte[] payload, out List<(int Offset, int Count, int AgeSeconds)> samples)
+    {
+        samples = [];
+
+        int sampleCount = payload[0];
+        int pos = 1;
+
+        for (int i = 0; i < sampleCount; i++)
+        {
+            if (pos + SampleHeaderSize > payload.Length)
+                return false;
+
+            int ageSeconds = (payload[pos] << 8) | payload[pos + 1];
+            int count = payload[pos + 2];
+            pos += SampleHeaderSize;
+
+            if (pos + count * ReadingSize > payload.Length)
+                return false;
+
+            samples.Add((pos, count, ageSeconds));
+            pos += count * ReadingSize;
+        }
+
+        return sampleCount > 0 && pos == payload.Length;
+    }
+
+    private IEnumerable<DecodedReading> DecodeReadings(
+        byte[] payload, int offset, int count, string devEui, int fPort, DateTime timestamp)
+    {
         // Decode all sensors in payload
-        for (int i = 0; i + 2 < payload.Length; i += 3)
+        for (int i = offset; i < offset + count * ReadingSize; i += ReadingSize)
         {
             var typeCode = payload[i];
 
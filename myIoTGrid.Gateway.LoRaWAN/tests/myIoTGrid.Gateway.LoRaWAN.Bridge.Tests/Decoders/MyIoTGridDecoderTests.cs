@@ -614,4 +614,265 @@ public class MyIoTGridDecoderTests
     }
 
     #endregion
+
+    #region Aggregated Frame Tests (FPort 2)
+
+    [Fact]
+    public void Decode_Aggregated_TwoSamples_UsesSampleAge()
+    {
+        // Arrange: 2 Samples, vor 600 s und vor 0 s
+        byte[] payload = [
+            0x02,                          // SampleCount
+            0x02, 0x58, 0x02,              // Age 600 s, 2 Readings
+            0x01, 0x07, 0xD0,              //   Temperature 20.00 °C
+            0x02, 0x19, 0x64,              //   Humidity 65.00 %
+            0x00, 0x00, 0x01,              // Age 0 s, 1 Reading
+            0x01, 0x08, 0x34               //   Temperature 21.00 °C
+        ];
+        var devEui = "0000000000000001";
+        var before = DateTime.UtcNow;
+
+        // Act
+        var readings = _decoder.Decode(payload, devEui, 2).ToList();
+
+        // Assert
+        Assert.Equal(3, readings.Count);
+        Assert.Equal("temperature", readings[0].Type);
+        Assert.Equal(20.00, readings[0].Value, 2);
+        Assert.Equal("humidity", readings[1].Type);
+        Assert.Equal(21.00, readings[2].Value, 2);
+        Assert.Equal(readings[0].Timestamp, readings[1].Timestamp);
+        Assert.Equal(600, (readings[2].Timestamp - readings[0].Timestamp).TotalSeconds, 3);
+        Assert.True(readings[2].Timestamp >= before);
+        Assert.Equal("2", readings[0].Metadata!["fPort"]);
+    }
+
+    [Fact]
+    public void Decode_Aggregated_Truncated_ReturnsEmpty()
+    {
+        // Arrange: Header kündigt 2 Readings an, nur eines vorhanden
+        byte[] payload = [0x01, 0x00, 0x0A, 0x02, 0x01, 0x07, 0xD0];
+
+        // Act
+        var readings = _decoder.Decode(payload, "0000000000000001", 2).ToList();
+
+        // Assert
+        Assert.Empty(readings);
+    }
+
+    [Fact]
+    public void CanDecode_Aggregated_ValidFrame_ReturnsTrue()
+    {
+        // 1 + 3 + 3 = 7 Bytes, kein Vielfaches von 3
+        byte[] payload = [0x01, 0x00, 0x0A, 0x01, 0x01, 0x07, 0xD0];
+        Assert.True(_decoder.CanDecode(payload, 2));
+        Assert.False(_decoder.CanDecode(payload, 1));
+    }
+
+    [Fact]
+    public void CanDecode_Aggregated_TrailingBytes_ReturnsFalse()
+    {
+        byte[] payload = [0x01, 0x00, 0x0A, 0x01, 0x01, 0x07, 0xD0, 0xFF];
+        Assert.False(_decoder.CanDecode(payload, 2));
+    }
+
+    [Fact]
+    public void CanDecode_Aggregated_NoSamples_ReturnsFalse()
+    {
+        byte[] payload = [0x00];
+        Assert.False(_decoder.CanDecode(payload, 2));
+    }
+
+    #endregion
+
+    #region Fragment Tests (FPort 3)
+
+    private sealed class ManualTimeProvider : TimeProvider
+    {
+        public DateTimeOffset Now { get; set; } = new(2025, 12, 12, 10, 0, 0, TimeSpan.Zero);
+
+        public override DateTimeOffset GetUtcNow() => Now;
+    }
+
+    [Fact]
+    public void Decode_Fragments_ReassembledWhenComplete()
+    {
+        // Arrange: Batch 7 in 2 Fragmenten, 2 + 3 Bytes Header/Reading (≡ 2 mod 3)
+        byte[] first = [0x07, 0x02, 0x01, 0x07, 0xD0, 0x02, 0x19, 0x64];
+        byte[] second = [0x07, 0x12, 0x03, 0x27, 0x46];
+        var devEui = "0000000000000001";
+
+        // Act
+        var afterFirst = _decoder.Decode(first, devEui, 3).ToList();
+        var afterSecond = _decoder.Decode(second, devEui, 3).ToList();
+
+        // Assert
+        Assert.Empty(afterFirst);
+        Assert.Equal(3, afterSecond.Count);
+        Assert.Equal("temperature", afterSecond[0].Type);
+        Assert.Equal("humidity", afterSecond[1].Type);
+        Assert.Equal("pressure", afterSecond[2].Type);
+        Assert.Equal(1005.4, afterSecond[2].Value, 1);
+        Assert.Equal("7", afterSecond[0].Metadata!["batchId"]);
+        Assert.Equal(0, _decoder.PendingBatchCount);
+    }
+
+    [Fact]
+    public void Decode_Fragments_OutOfOrder_KeepIndexOrder()
+    {
+        // Arrange
+        byte[] first = [0x01, 0x02, 0x01, 0x07, 0xD0];
+        byte[] second = [0x01, 0x12, 0x02, 0x19, 0x64];
+        var devEui = "0000000000000001";
+
+        // Act
+        _decoder.Decode(second, devEui, 3).ToList();
+        var readings = _decoder.Decode(first, devEui, 3).ToList();
+
+        // Assert
+        Assert.Equal(2, readings.Count);
+        Assert.Equal("temperature", readings[0].Type);
+        Assert.Equal("humidity", readings[1].Type);
+    }
+
+    [Fact]
+    public void Decode_Fragments_KeyedByDevice()
+    {
+        // Arrange: gleiche BatchId von zwei Geräten
+        byte[] first = [0x05, 0x02, 0x01, 0x07, 0xD0];
+        byte[] second = [0x05, 0x12, 0x02, 0x19, 0x64];
+
+        // Act
+        var deviceA = _decoder.Decode(first, "000000000000000A", 3).ToList();
+        var deviceB = _decoder.Decode(second, "000000000000000B", 3).ToList();
+
+        // Assert
+        Assert.Empty(deviceA);
+        Assert.Empty(deviceB);
+        Assert.Equal(2, _decoder.PendingBatchCount);
+    }
+
+    [Fact]
+    public void Decode_Fragments_ExpiredBatchDropped()
+    {
+        // Arrange
+        var time = new ManualTimeProvider();
+        var decoder = new MyIoTGridDecoder(_logger, time);
+        byte[] first = [0x09, 0x02, 0x01, 0x07, 0xD0];
+        byte[] second = [0x09, 0x12, 0x02, 0x19, 0x64];
+        var devEui = "0000000000000001";
+
+        // Act
+        decoder.Decode(first, devEui, 3).ToList();
+        time.Now += MyIoTGridDecoder.FragmentTimeout + TimeSpan.FromSeconds(1);
+        var readings = decoder.Decode(second, devEui, 3).ToList();
+
+        // Assert: erstes Fragment verworfen, zweites wartet auf neuen Batch
+        Assert.Empty(readings);
+        Assert.Equal(1, decoder.PendingBatchCount);
+    }
+
+    [Fact]
+    public void Decode_Fragments_TimestampOfFirstFragment()
+    {
+        // Arrange
+        var time = new ManualTimeProvider();
+        var decoder = new MyIoTGridDecoder(_logger, time);
+        var firstReceived = time.Now.UtcDateTime;
+        byte[] first = [0x02, 0x02, 0x01, 0x07, 0xD0];
+        byte[] second = [0x02, 0x12, 0x02, 0x19, 0x64];
+
+        // Act
+        decoder.Decode(first, "0000000000000001", 3).ToList();
+        time.Now += TimeSpan.FromSeconds(40);
+        var readings = decoder.Decode(second, "0000000000000001", 3).ToList();
+
+        // Assert
+        Assert.Equal(2, readings.Count);
+        Assert.All(readings, r => Assert.Equal(firstReceived, r.Timestamp));
+    }
+
+    [Fact]
+    public void CanDecode_Fragment_ValidHeader_ReturnsTrue()
+    {
+        byte[] payload = [0x07, 0x02, 0x01, 0x07, 0xD0];
+        Assert.True(_decoder.CanDecode(payload, 3));
+    }
+
+    [Fact]
+    public void CanDecode_Fragment_IndexNotBelowTotal_ReturnsFalse()
+    {
+        byte[] payload = [0x07, 0x22, 0x01, 0x07, 0xD0];
+        Assert.False(_decoder.CanDecode(payload, 3));
+    }
+
+    [Fact]
+    public void CanDecode_Fragment_HeaderOnly_ReturnsFalse()
+    {
+        byte[] payload = [0x07, 0x02];
+        Assert.False(_decoder.CanDecode(payload, 3));
+    }
+
+    #endregion
+
+    #region Diagnostics Tests (FPort 4)
+
+    private static readonly byte[] DiagnosticsFrame = [
+        0x01, 0x06,     // Version 1, 6 Phasen
+        0x01, 0xF4,     // boot    500 ms
+        0x00, 0xC8,     // sensor  200 ms
+        0x00, 0x00,     // join      0 ms
+        0x00, 0x3D,     // tx       61 ms
+        0x04, 0xB0,     // rx     1200 ms
+        0x00, 0x64,     // idle    100 ms
+        0x00, 0x00,     // display   0 ms
+        0x01, 0x2C,     // sleep   300 s
+        0x00, 0x2A      // charge   42 µAh
+    ];
+
+    [Fact]
+    public void Decode_Diagnostics_AllValues()
+    {
+        // Act
+        var readings = _decoder.Decode(DiagnosticsFrame, "0000000000000001", 4).ToList();
+
+        // Assert: 6 Phasen + Display + Sleep + Charge
+        Assert.Equal(9, readings.Count);
+        Assert.Equal("energy_boot", readings[0].Type);
+        Assert.Equal(500, readings[0].Value);
+        Assert.Equal("ms", readings[0].Unit);
+        Assert.Equal("energy_rx", readings[4].Type);
+        Assert.Equal(1200, readings[4].Value);
+        Assert.Equal("energy_sleep", readings[7].Type);
+        Assert.Equal(300, readings[7].Value);
+        Assert.Equal("s", readings[7].Unit);
+        Assert.Equal("energy_charge", readings[8].Type);
+        Assert.Equal(42, readings[8].Value);
+        Assert.Equal("µAh", readings[8].Unit);
+        Assert.Equal("1", readings[8].Metadata!["diagVersion"]);
+    }
+
+    [Fact]
+    public void CanDecode_Diagnostics_20Bytes_ReturnsTrue()
+    {
+        Assert.Equal(20, DiagnosticsFrame.Length);
+        Assert.True(_decoder.CanDecode(DiagnosticsFrame, 4));
+    }
+
+    [Fact]
+    public void CanDecode_Diagnostics_UnknownVersion_ReturnsFalse()
+    {
+        var payload = (byte[])DiagnosticsFrame.Clone();
+        payload[0] = 0x02;
+        Assert.False(_decoder.CanDecode(payload, 4));
+    }
+
+    [Fact]
+    public void Decode_Diagnostics_Truncated_ReturnsEmpty()
+    {
+        var readings = _decoder.Decode(DiagnosticsFrame[..18], "0000000000000001", 4).ToList();
+        Assert.Empty(readings);
+    }
+
+    #endregion
 }
@@ -7,6 +7,7 @@ using Microsoft.AspNetCore.Server.Kestrel.Core;
 using Microsoft.EntityFrameworkCore;
 using myIoTGrid.Shared.Common.Interfaces;
 using myIoTGrid.Hub.Interface.BackgroundServices;
+using myIoTGrid.Hub.Interface.Formatters;
 using MatterBridgeService = myIoTGrid.Hub.Interface.BackgroundServices.MatterBridgeService;
 using myIoTGrid.Hub.Infrastructure.Data;
 using myIoTGrid.Hub.Infrastructure.Matter;
@@ -170,7 +171,12 @@ try
     builder.Services.AddHostedService<MqttLoRaWanAdapter>();
 
     // Controllers (aus Interface-Projekt)
-    builder.Services.AddControllers()
+    builder.Services.AddControllers(options =>
+        {
+            // MessagePack-Bodies der Sensoren (wireFormat "msgpack"); JSON bleibt Standard
+            options.InputFormatters.Add(new MsgPackInputFormatter());
+            options.OutputFormatters.Add(new MsgPackOutputFormatter());
+        })
         .AddApplicationPart(typeof(myIoTGrid.Hub.Interface.Controllers.ReadingsController).Assembly)
         .AddJsonOptions(options =>
         {
@@ -181,6 +187,9 @@ try
             options.JsonSerializerOptions.Converters.Add(new UtcNullableDateTimeConverter());
         });
 
+    // Komprimierte Request-Bodies (gzip von Sensoren, spart Mobilfunk-Volumen)
+    builder.Services.AddRequestDecompression();
+
     // Swagger/OpenAPI
     builder.Services.AddEndpointsApiExplorer();
     builder.Services.AddSwaggerGen();
@@ -238,6 +247,9 @@ try
     // Exception Middleware
     app.UseExceptionMiddleware();
 
+    // Request-Dekomprimierung + Accept-Encoding-Ankündigung für Sensoren
+    app.UseSensorRequestDecompression();
+
     // Swagger (in Development und Production für lokale Tests)
     app.UseSwagger();
     app.UseSwaggerUI(options =>
@@ -219,6 +219,12 @@ namespace myIoTGrid.Hub.Infrastructure.Migrations
                         .HasColumnType("TEXT")
                         .HasDefaultValue("Normal");
 
+                    b.Property<string>("DiagnosticsJson")
+                        .HasColumnType("TEXT");
+
+                    b.Property<DateTime?>("DiagnosticsReportedAt")
+                        .HasColumnType("TEXT");
+
                     b.Property<bool>("EnableRemoteLogging")
                         .ValueGeneratedOnAdd()
                         .HasColumnType("INTEGER")
@@ -368,6 +374,9 @@ namespace myIoTGrid.Hub.Infrastructure.Migrations
                         .ValueGeneratedOnAdd()
                         .HasColumnType("TEXT");
 
+                    b.Property<int?>("AggregationWindowSeconds")
+                        .HasColumnType("INTEGER");
+
                     b.Property<string>("Alias")
                         .HasMaxLength(200)
                         .HasColumnType("TEXT");
@@ -663,6 +672,15 @@ namespace myIoTGrid.Hub.Infrastructure.Migrations
                         .HasColumnType("REAL")
                         .HasDefaultValue(0.5);
 
+                    b.Property<double?>("DeadbandAbsolute")
+                        .HasColumnType("REAL");
+
+                    b.Property<double?>("DeadbandPercent")
+                        .HasColumnType("REAL");
+
+                    b.Property<double?>("DeadbandSlopePerMinute")
+                        .HasColumnType("REAL");
+
                     b.Property<string>("DisplayName")
                         .IsRequired()
                         .HasMaxLength(100)
@@ -680,6 +698,9 @@ namespace myIoTGrid.Hub.Infrastructure.Migrations
                         .HasMaxLength(100)
                         .HasColumnType("TEXT");
 
+                    b.Property<int?>("MaxSilenceSeconds")
+                        .HasColumnType("INTEGER");
+
                     b.Property<double?>("MaxValue")
                         .HasColumnType("REAL");
 
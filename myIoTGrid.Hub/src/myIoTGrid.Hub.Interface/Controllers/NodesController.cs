@@ -613,7 +613,11 @@ public class NodesController : ControllerBase
                 .Select(c => new SensorCapabilityConfigDto(
                     MeasurementType: c.MeasurementType,
                     DisplayName: c.DisplayName,
-                    Unit: c.Unit
+                    Unit: c.Unit,
+                    DeadbandAbsolute: c.DeadbandAbsolute,
+                    DeadbandPercent: c.DeadbandPercent,
+                    DeadbandSlopePerMinute: c.DeadbandSlopePerMinute,
+                    MaxSilenceSeconds: c.MaxSilenceSeconds
                 ))
                 .ToList() ?? new List<SensorCapabilityConfigDto>();
 
@@ -635,7 +639,8 @@ public class NodesController : ControllerBase
                 EchoPin: a.EffectiveConfig.EchoPin,
                 OffsetCorrection: a.EffectiveConfig.OffsetCorrection,
                 GainCorrection: a.EffectiveConfig.GainCorrection,
-                Capabilities: capabilities
+                Capabilities: capabilities,
+                AggregationWindowSeconds: a.EffectiveConfig.AggregationWindowSeconds
             ));
         }
 
@@ -646,7 +651,8 @@ public class NodesController : ControllerBase
             IsSimulation: node.IsSimulation,
             DefaultIntervalSeconds: 60,
             Sensors: sensorConfigs,
-            ConfigurationTimestamp: DateTime.UtcNow
+            ConfigurationTimestamp: DateTime.UtcNow,
+            WireFormat: _configuration["NodeConfiguration:WireFormat"] ?? "json"
         );
 
         return Ok(configuration);
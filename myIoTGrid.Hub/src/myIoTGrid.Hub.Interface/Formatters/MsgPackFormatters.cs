@@ -0,0 +1,72 @@
+using System.Text.Json;
+using Microsoft.AspNetCore.Http;
+using Microsoft.AspNetCore.Mvc;
+using Microsoft.AspNetCore.Mvc.Formatters;
+using Microsoft.Extensions.DependencyInjection;
+using Microsoft.Extensions.Options;
+
+namespace myIoTGrid.Hub.Interface.Formatters;
+
+/// <summary>
+/// Liest application/msgpack-Bodies der Sensoren.
+/// Der Body wird nach JSON transkodiert und mit den JsonOptions der API
+/// deserialisiert, sodass DTOs und Konverter identisch zu JSON sind.
+/// </summary>
+public class MsgPackInputFormatter : InputFormatter
+{
+    public MsgPackInputFormatter()
+    {
+        SupportedMediaTypes.Add(MsgPackWireCodec.ContentType);
+    }
+
+    protected override bool CanReadType(Type type) => true;
+
+    public override async Task<InputFormatterResult> ReadRequestBodyAsync(InputFormatterContext context)
+    {
+        var httpContext = context.HttpContext;
+
+        using var body = new MemoryStream();
+        await httpContext.Request.Body.CopyToAsync(body, httpContext.RequestAborted);
+
+        try
+        {
+            var json = MsgPackWireCodec.ToJson(body.GetBuffer().AsSpan(0, (int)body.Length));
+            var model = JsonSerializer.Deserialize(json, context.ModelType, GetSerializerOptions(httpContext));
+            return await InputFormatterResult.SuccessAsync(model);
+        }
+        catch (Exception ex) when (ex is FormatException or JsonException)
+        {
+            context.ModelState.TryAddModelError(context.ModelName, $"Invalid MessagePack body: {ex.Message}");
+            return await InputFormatterResult.FailureAsync();
+        }
+    }
+
+    internal static JsonSerializerOptions GetSerializerOptions(HttpContext httpContext) =>
+        httpContext.RequestServices.GetService<IOptions<JsonOptions>>()?.Value.JsonSerializerOptions
+        ?? new JsonSerializerOptions(JsonSerializerDefaults.Web);
+}
+
+/// <summary>
+/// Antwortet in application/msgpack, wenn der Sensor es per Accept-Header anfordert.
+/// Browser und andere Clients erhalten weiterhin JSON.
+/// </summary>
+public class MsgPackOutputFormatter : OutputFormatter
+{
+    public MsgPackOutputFormatter()
+    {
+        SupportedMediaTypes.Add(MsgPackWireCodec.ContentType);
+    }
+
+    protected override bool CanWriteType(Type? type) => true;
+
+    public override async Task WriteResponseBodyAsync(OutputFormatterWriteContext context)
+    {
+        var httpContext = context.HttpContext;
+        var options = MsgPackInputFormatter.GetSerializerOptions(httpContext);
+
+        var element = JsonSerializer.SerializeToElement(context.Object, context.ObjectType ?? typeof(object), options);
+        var body = MsgPackWireCodec.FromJson(element);
+
+        await httpContext.Response.Body.WriteAsync(body, httpContext.RequestAborted);
+    }
+}
@@ -0,0 +1,372 @@
+using System.Buffers.Binary;
+using System.Text;
+using System.Text.Json;
+
+namespace myIoTGrid.Hub.Interface.Formatters;
+
+/// <summary>
+/// MessagePack-Wire-Format der Sensor-Firmware (application/msgpack).
+/// Feldnamen werden durch kleine Integer-Schlüssel aus einem gemeinsamen
+/// Schema ersetzt (Firmware: wire_codec.h / wire_codec.cpp). Das Schema ist
+/// append-only: Schlüssel werden nie umnummeriert oder wiederverwendet.
+/// Die Bodies werden nach/aus JSON transkodiert, damit Controller und DTOs
+/// für beide Formate identisch bleiben.
+/// </summary>
+public static class MsgPackWireCodec
+{
+    public const string ContentType = "application/msgpack";
+
+    private const int MaxDepth = 10;
+
+    /// <summary>
+    /// Index = Schema-Schlüssel (0 unbenutzt); identisch mit KEY_NAMES der Firmware
+    /// </summary>
+    private static readonly string?[] KeyNames =
+    [
+        null,
+        "deviceId", "type", "value", "unit", "timestamp", "endpointId",
+        "nodeId", "serialNumber", "firmwareVersion", "batteryLevel",
+        "readings", "sensorType", "aggregate", "count", "min", "max", "stddev", "last", "windowSeconds",
+        "success", "serverTime", "nextHeartbeatSeconds", "wifi", "pipeline", "time", "compression",
+        "name", "isSimulation", "defaultIntervalSeconds", "storageMode", "sensors",
+        "sensorCode", "sensorName", "icon", "color", "isActive", "intervalSeconds", "i2CAddress",
+        "sdaPin", "sclPin", "oneWirePin", "analogPin", "digitalPin", "triggerPin", "echoPin", "baudRate",
+        "offsetCorrection", "gainCorrection", "aggregationWindowSeconds",
+        "capabilities", "measurementType", "displayName",
+        "deadbandAbsolute", "deadbandPercent", "deadbandSlopePerMinute", "maxSilenceSeconds",
+        "configurationChanged", "wireFormat", "hardwareType",
+        "location", "isNewNode", "message", "connection", "endpoint",
+        "sync", "metrics", "loop"
+    ];
+
+    private static readonly Dictionary<string, int> KeyIndex = KeyNames
+        .Select((name, key) => (name, key))
+        .Where(entry => entry.name != null)
+        .ToDictionary(entry => entry.name!, entry => entry.key, StringComparer.Ordinal);
+
+    /// <summary>
+    /// JSON-Feldname eines Schema-Schlüssels (null = unbekannt)
+    /// </summary>
+    public static string? KeyName(long key) =>
+        key > 0 && key < KeyNames.Length ? KeyNames[key] : null;
+
+    /// <summary>
+    /// Schema-Schlüssel eines JSON-Feldnamens (0 = nicht im Schema)
+    /// </summary>
+    public static int KeyOf(string name) =>
+        KeyIndex.TryGetValue(name, out var key) ? key : 0;
+
+    #region Decode (MessagePack -> JSON)
+
+    /// <summary>
+    /// Transkodiert einen MessagePack-Body in JSON (UTF-8)
+    /// </summary>
+    /// <exception cref="FormatException">Ungültiges oder nicht unterstütztes MessagePack</exception>
+    public static byte[] ToJson(ReadOnlySpan<byte> msgpack)
+    {
+        using var buffer = new MemoryStream();
+        using (var writer = new Utf8JsonWriter(buffer))
+        {
+            var reader = new Reader(msgpack);
+            reader.ReadValue(writer, 0);
+            if (!reader.AtEnd)
+                throw new FormatException("Trailing bytes after MessagePack value");
+        }
+        return buffer.ToArray();
+    }
+
+    private ref struct Reader
+    {
+        private readonly ReadOnlySpan<byte> _data;
+        private int _pos;
+
+        public Reader(ReadOnlySpan<byte> data)
+        {
+            _data = data;
+            _pos = 0;
+        }
+
+        public readonly bool AtEnd => _pos == _data.Length;
+
+        public void ReadValue(Utf8JsonWriter writer, int depth)
+        {
+            if (depth > MaxDepth)
+                throw new FormatException("MessagePack nesting too deep");
+
+            var code = Take(1)[0];
+
+            if (code < 0x80) { writer.WriteNumberValue(code); return; }
+            if (code >= 0xE0) { writer.WriteNumberValue((sbyte)code); return; }
+            if ((code & 0xF0) == 0x80) { ReadMap(writer, code & 0x0F, depth); return; }
+            if ((code & 0xF0) == 0x90) { ReadArray(writer, code & 0x0F, depth); return; }
+            if ((code & 0xE0) == 0xA0) { writer.WriteStringValue(ReadString(code & 0x1F)); return; }
+
+            switch (code)
+            {
+                case 0xC0: writer.WriteNullValue(); return;
+                case 0xC2: writer.WriteBooleanValue(false); return;
+                case 0xC3: writer.WriteBooleanValue(true); return;
+                case 0xCA: writer.WriteNumberValue((double)BinaryPrimitives.ReadSingleBigEndian(Take(4))); return;
+                case 0xCB: writer.WriteNumberValue(BinaryPrimitives.ReadDoubleBigEndian(Take(8))); return;
+                case 0xCC: writer.WriteNumberValue(Take(1)[0]); return;
+                case 0xCD: writer.WriteNumberValue(BinaryPrimitives.ReadUInt16BigEndian(Take(2))); return;
+                case 0xCE: writer.WriteNumberValue(BinaryPrimitives.ReadUInt32BigEndian(Take(4))); return;
+                case 0xCF: writer.WriteNumberValue(BinaryPrimitives.ReadUInt64BigEndian(Take(8))); return;
+                case 0xD0: writer.WriteNumberValue((sbyte)Take(1)[0]); return;
+                case 0xD1: writer.WriteNumberValue(BinaryPrimitives.ReadInt16BigEndian(Take(2))); return;
+                case 0xD2: writer.WriteNumberValue(BinaryPrimitives.ReadInt32BigEndian(Take(4))); return;
+                case 0xD3: writer.WriteNumberValue(BinaryPrimitives.ReadInt64BigEndian(Take(8))); return;
+                case 0xD9: writer.WriteStringValue(ReadString(Take(1)[0])); return;
+                case 0xDA: writer.WriteStringValue(ReadString(BinaryPrimitives.ReadUInt16BigEndian(Take(2)))); return;
+                case 0xDB: writer.WriteStringValue(ReadString(ReadLength32())); return;
+                case 0xDC: ReadArray(writer, BinaryPrimitives.ReadUInt16BigEndian(Take(2)), depth); return;
+                case 0xDD: ReadArray(writer, ReadLength32(), depth); return;
+                case 0xDE: ReadMap(writer, BinaryPrimitives.ReadUInt16BigEndian(Take(2)), depth); return;
+                case 0xDF: ReadMap(writer, ReadLength32(), depth); return;
+                default:
+                    // bin / ext: not produced by the firmware
+                    throw new FormatException($"Unsupported MessagePack type 0x{code:X2}");
+            }
+        }
+
+        private void ReadMap(Utf8JsonWriter writer, int count, int depth)
+        {
+            writer.WriteStartObject();
+            for (var i = 0; i < count; i++)
+            {
+                writer.WritePropertyName(ReadKey());
+                ReadValue(writer, depth + 1);
+            }
+            writer.WriteEndObject();
+        }
+
+        private void ReadArray(Utf8JsonWriter writer, int count, int depth)
+        {
+            writer.WriteStartArray();
+            for (var i = 0; i < count; i++)
+                ReadValue(writer, depth + 1);
+            writer.WriteEndArray();
+        }
+
+        private string ReadKey()
+        {
+            var code = Take(1)[0];
+            long key;
+            if (code < 0x80) key = code;
+            else if (code == 0xCC) key = Take(1)[0];
+            else if (code == 0xCD) key = BinaryPrimitives.ReadUInt16BigEndian(Take(2));
+            else if ((code & 0xE0) == 0xA0) return ReadString(code & 0x1F);
+            else if (code == 0xD9) return ReadString(Take(1)[0]);
+            else if (code == 0xDA) return ReadString(BinaryPrimitives.ReadUInt16BigEndian(Take(2)));
+            else throw new FormatException($"Unsupported MessagePack map key type 0x{code:X2}");
+
+            // Unknown keys come from a newer firmware schema: keep them addressable
+            return KeyName(key) ?? key.ToString();
+        }
+
+        private string ReadString(int length) => Encoding.UTF8.GetString(Take(length));
+
+        private int ReadLength32()
+        {
+            var length = BinaryPrimitives.ReadUInt32BigEndian(Take(4));
+            if (length > int.MaxValue)
+                throw new FormatException("MessagePack length out of range");
+            return (int)length;
+        }
+
+        private ReadOnlySpan<byte> Take(int count)
+        {
+            if (count > _data.Length - _pos)
+                throw new FormatException("Incomplete MessagePack input");
+            var slice = _data.Slice(_pos, count);
+            _pos += count;
+            return slice;
+        }
+    }
+
+    #endregion
+
+    #region Encode (JSON -> MessagePack)
+
+    /// <summary>
+    /// Kodiert ein JSON-Element als MessagePack mit Schema-Schlüsseln.
+    /// Feldnamen außerhalb des Schemas werden als String gesendet.
+    /// </summary>
+    public static byte[] FromJson(JsonElement element)
+    {
+        using var buffer = new MemoryStream();
+        WriteValue(buffer, element, 0);
+        return buffer.ToArray();
+    }
+
+    private static void WriteValue(Stream output, JsonElement element, int depth)
+    {
+        if (depth > MaxDepth)
+        {
+            output.WriteByte(0xC0);
+            return;
+        }
+
+        switch (element.ValueKind)
+        {
+            case JsonValueKind.Object:
+                WriteContainerHeader(output, element.EnumerateObject().Count(), 0x80, 0xDE);
+                foreach (var property in element.EnumerateObject())
+                {
+                    var key = KeyOf(property.Name);
+                    if (key != 0)
+                        WriteUnsigned(output, (ulong)key);
+                    else
+                        WriteString(output, property.Name);
+                    WriteValue(output, property.Value, depth + 1);
+                }
+                break;
+
+            case JsonValueKind.Array:
+                WriteContainerHeader(output, element.GetArrayLength(), 0x90, 0xDC);
+                foreach (var item in element.EnumerateArray())
+                    WriteValue(output, item, depth + 1);
+                break;
+
+            case JsonValueKind.String:
+                WriteString(output, element.GetString()!);
+                break;
+
+            case JsonValueKind.Number:
+                if (element.TryGetInt64(out var signed))
+                    WriteSigned(output, signed);
+                else if (element.TryGetUInt64(out var unsigned))
+                    WriteUnsigned(output, unsigned);
+                else
+                    WriteFloat(output, element.GetDouble());
+                break;
+
+            case JsonValueKind.True:
+                output.WriteByte(0xC3);
+                break;
+
+            case JsonValueKind.False:
+                output.WriteByte(0xC2);
+                break;
+
+            default:
+                output.WriteByte(0xC0);
+                break;
+        }
+    }
+
+    private static void WriteBigEndian(Stream output, ulong value, int bytes)
+    {
+        for (var i = bytes - 1; i >= 0; i--)
+            output.WriteByte((byte)(value >> (8 * i)));
+    }
+
+    private static void WriteUnsigned(Stream output, ulong value)
+    {
+        if (value < 0x80)
+        {
+            output.WriteByte((byte)value);                  // positive fixint
+        }
+        else if (value <= 0xFF)
+        {
+            output.WriteByte(0xCC); WriteBigEndian(output, value, 1);
+        }
+        else if (value <= 0xFFFF)
+        {
+            output.WriteByte(0xCD); WriteBigEndian(output, value, 2);
+        }
+        else if (value <= 0xFFFFFFFF)
+        {
+            output.WriteByte(0xCE); WriteBigEndian(output, value, 4);
+        }
+        else
+        {
+            output.WriteByte(0xCF); WriteBigEndian(output, value, 8);
+        }
+    }
+
+    private static void WriteSigned(Stream output, long value)
+    {
+        if (value >= 0)
+        {
+            WriteUnsigned(output, (ulong)value);
+        }
+        else if (value >= -32)
+        {
+            output.WriteByte((byte)(sbyte)value);           // negative fixint
+        }
+        else if (value >= sbyte.MinValue)
+        {
+            output.WriteByte(0xD0); WriteBigEndian(output, (byte)(sbyte)value, 1);
+        }
+        else if (value >= short.MinValue)
+        {
+            output.WriteByte(0xD1); WriteBigEndian(output, (ushort)(short)value, 2);
+        }
+        else if (value >= int.MinValue)
+        {
+            output.WriteByte(0xD2); WriteBigEndian(output, (uint)(int)value, 4);
+        }
+        else
+        {
+            output.WriteByte(0xD3); WriteBigEndian(output, (ulong)value, 8);
+        }
+    }
+
+    private static void WriteFloat(Stream output, double value)
+    {
+        // float32 wenn verlustfrei (wie die Firmware)
+        var narrow = (float)value;
+        if ((double)narrow == value)
+        {
+            output.WriteByte(0xCA);
+            WriteBigEndian(output, BitConverter.SingleToUInt32Bits(narrow), 4);
+        }
+        else
+        {
+            output.WriteByte(0xCB);
+            WriteBigEndian(output, BitConverter.DoubleToUInt64Bits(value), 8);
+        }
+    }
+
+    private static void WriteString(Stream output, string value)
+    {
+        var bytes = Encoding.UTF8.GetBytes(value);
+        var length = (ulong)bytes.Length;
+        if (length < 32)
+        {
+            output.WriteByte((byte)(0xA0 | (int)length));
+        }
+        else if (length <= 0xFF)
+        {
+            output.WriteByte(0xD9); WriteBigEndian(output, length, 1);
+        }
+        else if (length <= 0xFFFF)
+        {
+            output.WriteByte(0xDA); WriteBigEndian(output, length, 2);
+        }
+        else
+        {
+            output.WriteByte(0xDB); WriteBigEndian(output, length, 4);
+        }
+        output.Write(bytes);
+    }
+
+    private static void WriteContainerHeader(Stream output, int count, byte fixBase, byte code16)
+    {
+        if (count < 16)
+        {
+            output.WriteByte((byte)(fixBase | count));
+        }
+        else if (count <= 0xFFFF)
+        {
+            output.WriteByte(code16); WriteBigEndian(output, (ulong)count, 2);
+        }
+        else
+        {
+            output.WriteByte((byte)(code16 + 1)); WriteBigEndian(output, (ulong)count, 4);
+        }
+    }
+
+    #endregion
+}
@@ -0,0 +1,59 @@
+using Microsoft.AspNetCore.Builder;
+using Microsoft.AspNetCore.Http;
+using Microsoft.Net.Http.Headers;
+
+namespace myIoTGrid.Hub.Interface.Middleware;
+
+/// <summary>
+/// Middleware für komprimierte Request-Bodies (Sensoren)
+/// Kündigt die unterstützten Content-Encodings im Accept-Encoding-Header jeder
+/// API-Antwort an (RFC 7694). Sensoren komprimieren ihre Uploads erst, nachdem
+/// sie diesen Header gesehen haben. Die Dekomprimierung selbst übernimmt
+/// die ASP.NET Core RequestDecompression-Middleware.
+/// </summary>
+public class SensorRequestDecompressionMiddleware
+{
+    private readonly RequestDelegate _next;
+
+    /// <summary>
+    /// Unterstützte Request-Encodings (RequestDecompression-Standardprovider)
+    /// </summary>
+    public const string SupportedEncodings = "gzip, deflate, br";
+
+    private static readonly PathString ApiPath = new("/api");
+
+    public SensorRequestDecompressionMiddleware(RequestDelegate next)
+    {
+        _next = next;
+    }
+
+    public async Task InvokeAsync(HttpContext context)
+    {
+        if (context.Request.Path.StartsWithSegments(ApiPath))
+        {
+            context.Response.OnStarting(() =>
+            {
+                context.Response.Headers[HeaderNames.AcceptEncoding] = SupportedEncodings;
+                return Task.CompletedTask;
+            });
+        }
+
+        await _next(context);
+    }
+}
+
+/// <summary>
+/// Extension Methods für SensorRequestDecompressionMiddleware Registration
+/// </summary>
+public static class SensorRequestDecompressionMiddlewareExtensions
+{
+    /// <summary>
+    /// Dekomprimiert Request-Bodies und kündigt die Encodings an
+    /// Erfordert builder.Services.AddRequestDecompression()
+    /// </summary>
+    public static IApplicationBuilder UseSensorRequestDecompression(this IApplicationBuilder builder)
+    {
+        builder.UseRequestDecompression();
+        return builder.UseMiddleware<SensorRequestDecompressionMiddleware>();
+    }
+}
@@ -41,7 +41,8 @@ public static class NodeSensorAssignmentMappingExtensions
             IsActive: assignment.IsActive,
             LastSeenAt: assignment.LastSeenAt,
             AssignedAt: assignment.AssignedAt,
-            EffectiveConfig: effectiveConfig
+            EffectiveConfig: effectiveConfig,
+            AggregationWindowSeconds: assignment.AggregationWindowSeconds
         );
     }
 
@@ -67,6 +68,7 @@ public static class NodeSensorAssignmentMappingExtensions
             EchoPinOverride = dto.EchoPinOverride,
             BaudRateOverride = dto.BaudRateOverride,
             IntervalSecondsOverride = dto.IntervalSecondsOverride,
+            AggregationWindowSeconds = dto.AggregationWindowSeconds,
             IsActive = true,
             AssignedAt = DateTime.UtcNow
         };
@@ -110,6 +112,9 @@ public static class NodeSensorAssignmentMappingExtensions
         if (dto.IntervalSecondsOverride.HasValue)
             assignment.IntervalSecondsOverride = dto.IntervalSecondsOverride;
 
+        if (dto.AggregationWindowSeconds.HasValue)
+            assignment.AggregationWindowSeconds = dto.AggregationWindowSeconds;
+
         if (dto.IsActive.HasValue)
             assignment.IsActive = dto.IsActive.Value;
     }
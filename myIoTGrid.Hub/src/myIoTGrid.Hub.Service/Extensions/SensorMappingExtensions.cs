@@ -89,7 +89,11 @@ public static class SensorMappingExtensions
             MatterClusterId: capability.MatterClusterId,
             MatterClusterName: capability.MatterClusterName,
             SortOrder: capability.SortOrder,
-            IsActive: capability.IsActive
+            IsActive: capability.IsActive,
+            DeadbandAbsolute: capability.DeadbandAbsolute,
+            DeadbandPercent: capability.DeadbandPercent,
+            DeadbandSlopePerMinute: capability.DeadbandSlopePerMinute,
+            MaxSilenceSeconds: capability.MaxSilenceSeconds
         );
     }
 
@@ -171,7 +175,11 @@ public static class SensorMappingExtensions
                     MatterClusterId = cap.MatterClusterId,
                     MatterClusterName = cap.MatterClusterName,
                     SortOrder = cap.SortOrder != 0 ? cap.SortOrder : sortOrder++,
-                    IsActive = true
+                    IsActive = true,
+                    DeadbandAbsolute = cap.DeadbandAbsolute,
+                    DeadbandPercent = cap.DeadbandPercent,
+                    DeadbandSlopePerMinute = cap.DeadbandSlopePerMinute,
+                    MaxSilenceSeconds = cap.MaxSilenceSeconds
                 });
             }
         }
@@ -317,7 +325,11 @@ public static class SensorMappingExtensions
                     MatterClusterId = capDto.MatterClusterId,
                     MatterClusterName = capDto.MatterClusterName,
                     SortOrder = capDto.SortOrder ?? sortOrder++,
-                    IsActive = capDto.IsActive ?? true
+                    IsActive = capDto.IsActive ?? true,
+                    DeadbandAbsolute = capDto.DeadbandAbsolute,
+                    DeadbandPercent = capDto.DeadbandPercent,
+                    DeadbandSlopePerMinute = capDto.DeadbandSlopePerMinute,
+                    MaxSilenceSeconds = capDto.MaxSilenceSeconds
                 };
                 sensor.Capabilities.Add(newCapability);
             }
@@ -365,6 +377,18 @@ public static class SensorMappingExtensions
 
         if (dto.IsActive.HasValue)
             capability.IsActive = dto.IsActive.Value;
+
+        if (dto.DeadbandAbsolute.HasValue)
+            capability.DeadbandAbsolute = dto.DeadbandAbsolute;
+
+        if (dto.DeadbandPercent.HasValue)
+            capability.DeadbandPercent = dto.DeadbandPercent;
+
+        if (dto.DeadbandSlopePerMinute.HasValue)
+            capability.DeadbandSlopePerMinute = dto.DeadbandSlopePerMinute;
+
+        if (dto.MaxSilenceSeconds.HasValue)
+            capability.MaxSilenceSeconds = dto.MaxSilenceSeconds;
     }
 
     /// <summary>
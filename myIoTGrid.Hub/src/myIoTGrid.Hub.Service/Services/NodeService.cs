@@ -1,3 +1,5 @@
+using System.Text;
+using System.Text.Json;
 using Microsoft.EntityFrameworkCore;
 using Microsoft.Extensions.Logging;
 using myIoTGrid.Hub.Infrastructure.Data;
@@ -478,6 +480,48 @@ public class NodeService : INodeService
             : char.ToUpperInvariant(measurementType[0]) + measurementType[1..].ToLowerInvariant();
     }
 
+    /// <summary>
+    /// Combines the diagnostic objects of a heartbeat into one JSON object.
+    /// Returns null if the node sent none (older firmware).
+    /// </summary>
+    private static string? BuildDiagnosticsJson(NodeHeartbeatDto dto, out List<string> sections)
+    {
+        var candidates = new (string Name, JsonElement? Value)[]
+        {
+            ("wifi", dto.Wifi),
+            ("pipeline", dto.Pipeline),
+            ("time", dto.Time),
+            ("sync", dto.Sync),
+            ("compression", dto.Compression),
+            ("metrics", dto.Metrics),
+            ("loop", dto.Loop)
+        };
+
+        var present = candidates
+            .Where(c => c.Value is { ValueKind: not JsonValueKind.Undefined and not JsonValueKind.Null })
+            .ToList();
+        sections = present.Select(c => c.Name).ToList();
+
+        if (present.Count == 0)
+            return null;
+
+        using var stream = new MemoryStream();
+        using (var writer = new Utf8JsonWriter(stream))
+        {
+            writer.WriteStartObject();
+            if (!string.IsNullOrEmpty(dto.WireFormat))
+                writer.WriteString("wireFormat", dto.WireFormat);
+            foreach (var (name, value) in present)
+            {
+                writer.WritePropertyName(name);
+                value!.Value.WriteTo(writer);
+            }
+            writer.WriteEndObject();
+        }
+
+        return Encoding.UTF8.GetString(stream.ToArray());
+    }
+
     /// <summary>
     /// Generates a name from the NodeId
     /// </summary>
@@ -597,9 +641,18 @@ public class NodeService : INodeService
         if (dto.BatteryLevel.HasValue)
             node.BatteryLevel = dto.BatteryLevel;
 
+        // Diagnose-Snapshot (wifi, pipeline, time, sync, compression, metrics, loop)
+        var diagnosticsJson = BuildDiagnosticsJson(dto, out var sections);
+        if (diagnosticsJson != null)
+        {
+            node.DiagnosticsJson = diagnosticsJson;
+            node.DiagnosticsReportedAt = DateTime.UtcNow;
+        }
+
         await _unitOfWork.SaveChangesAsync(ct);
 
-        _logger.LogDebug("Heartbeat processed for node {NodeId}", dto.NodeId);
+        _logger.LogDebug("Heartbeat processed for node {NodeId} (diagnostics: {Sections})",
+            dto.NodeId, sections.Count > 0 ? string.Join(", ", sections) : "none");
 
         return new NodeHeartbeatResponseDto(
             Success: true,
@@ -344,7 +344,7 @@ public class ReadingService : IReadingService
                 Guid? assignmentId = assignment?.Id;
                 var sensor = assignment?.Sensor;
                 var calibratedValue = readingValue.RawValue;
-                var unit = string.Empty;
+                var unit = readingValue.Unit ?? string.Empty;
 
                 if (assignment != null && sensor != null)
                 {
@@ -354,9 +354,17 @@ public class ReadingService : IReadingService
                     // Get unit from capability
                     var capability = sensor.Capabilities
                         .FirstOrDefault(c => c.MeasurementType.Equals(measurementType, StringComparison.OrdinalIgnoreCase));
-                    unit = capability?.Unit ?? string.Empty;
+                    if (string.IsNullOrEmpty(readingValue.Unit))
+                    {
+                        unit = capability?.Unit ?? string.Empty;
+                    }
                 }
 
+                // Capture time of the reading (offline sync), otherwise the batch time
+                var timestamp = readingValue.Timestamp.HasValue
+                    ? DateTimeOffset.FromUnixTimeSeconds(readingValue.Timestamp.Value).UtcDateTime
+                    : baseTimestamp;
+
                 var reading = new Reading
                 {
                     TenantId = tenantId,
@@ -366,7 +374,7 @@ public class ReadingService : IReadingService
                     RawValue = readingValue.RawValue,
                     Value = calibratedValue,
                     Unit = unit,
-                    Timestamp = baseTimestamp,
+                    Timestamp = timestamp,
                     IsSyncedToCloud = false
                 };
 
@@ -0,0 +1,172 @@
+using System.Text;
+using System.Text.Json;
+using FluentAssertions;
+using myIoTGrid.Hub.Interface.Formatters;
+
+namespace myIoTGrid.Hub.Interface.Tests.Formatters;
+
+/// <summary>
+/// Tests for MsgPackWireCodec.
+/// MessagePack mit Schema-Schlüsseln der Sensor-Firmware (wire_codec.cpp) ↔ JSON.
+/// </summary>
+public class MsgPackWireCodecTests
+{
+    #region Schema
+
+    [Fact]
+    public void KeyOf_MatchesFirmwareSchema()
+    {
+        // Schlüssel der Firmware (wire::Key) dürfen sich nie verschieben
+        MsgPackWireCodec.KeyOf("deviceId").Should().Be(1);
+        MsgPackWireCodec.KeyOf("value").Should().Be(3);
+        MsgPackWireCodec.KeyOf("readings").Should().Be(11);
+        MsgPackWireCodec.KeyOf("aggregationWindowSeconds").Should().Be(49);
+        MsgPackWireCodec.KeyOf("wireFormat").Should().Be(58);
+        MsgPackWireCodec.KeyOf("loop").Should().Be(67);
+    }
+
+    [Fact]
+    public void KeyOf_UnknownName_ReturnsZero()
+    {
+        MsgPackWireCodec.KeyOf("notInSchema").Should().Be(0);
+        MsgPackWireCodec.KeyName(0).Should().BeNull();
+        MsgPackWireCodec.KeyName(200).Should().BeNull();
+    }
+
+    #endregion
+
+    #region Decode
+
+    [Fact]
+    public void ToJson_FirmwareReading_UsesFieldNames()
+    {
+        // Arrange: {deviceId:"ESP32-01", type:"temperature", value:21.5f, endpointId:1}
+        var msgpack = new List<byte> { 0x84, 0x01, 0xA8 };
+        msgpack.AddRange(Encoding.UTF8.GetBytes("ESP32-01"));
+        msgpack.AddRange([0x02, 0xAB]);
+        msgpack.AddRange(Encoding.UTF8.GetBytes("temperature"));
+        msgpack.AddRange([0x03, 0xCA, 0x41, 0xAC, 0x00, 0x00]);
+        msgpack.AddRange([0x06, 0x01]);
+
+        // Act
+        var json = JsonDocument.Parse(MsgPackWireCodec.ToJson(msgpack.ToArray())).RootElement;
+
+        // Assert
+        json.GetProperty("deviceId").GetString().Should().Be("ESP32-01");
+        json.GetProperty("type").GetString().Should().Be("temperature");
+        json.GetProperty("value").GetDouble().Should().Be(21.5);
+        json.GetProperty("endpointId").GetInt32().Should().Be(1);
+    }
+
+    [Fact]
+    public void ToJson_StringKeysAndNegativeNumbers_ArePreserved()
+    {
+        // Arrange: {"custom": -5, "big": -1000, "ts": 1733000128}
+        var msgpack = new List<byte> { 0x83, 0xA6 };
+        msgpack.AddRange(Encoding.UTF8.GetBytes("custom"));
+        msgpack.Add(0xFB);
+        msgpack.Add(0xA3);
+        msgpack.AddRange(Encoding.UTF8.GetBytes("big"));
+        msgpack.AddRange([0xD1, 0xFC, 0x18]);
+        msgpack.Add(0xA2);
+        msgpack.AddRange(Encoding.UTF8.GetBytes("ts"));
+        msgpack.AddRange([0xCE, 0x67, 0x4B, 0x7B, 0xC0]);
+
+        // Act
+        var json = JsonDocument.Parse(MsgPackWireCodec.ToJson(msgpack.ToArray())).RootElement;
+
+        // Assert
+        json.GetProperty("custom").GetInt32().Should().Be(-5);
+        json.GetProperty("big").GetInt32().Should().Be(-1000);
+        json.GetProperty("ts").GetInt64().Should().Be(1733000128);
+    }
+
+    [Fact]
+    public void ToJson_TruncatedInput_Throws()
+    {
+        var act = () => MsgPackWireCodec.ToJson(new byte[] { 0x82, 0x01, 0xA8, 0x41 });
+
+        act.Should().Throw<FormatException>();
+    }
+
+    [Fact]
+    public void ToJson_TrailingBytes_Throws()
+    {
+        var act = () => MsgPackWireCodec.ToJson(new byte[] { 0xC3, 0xC3 });
+
+        act.Should().Throw<FormatException>();
+    }
+
+    [Fact]
+    public void ToJson_BinType_Throws()
+    {
+        var act = () => MsgPackWireCodec.ToJson(new byte[] { 0xC4, 0x01, 0x00 });
+
+        act.Should().Throw<FormatException>();
+    }
+
+    #endregion
+
+    #region Encode
+
+    [Fact]
+    public void FromJson_SchemaFields_UseIntegerKeys()
+    {
+        // Arrange
+        var element = JsonDocument.Parse("{\"success\":true,\"serverTime\":1733150400000}").RootElement;
+
+        // Act
+        var msgpack = MsgPackWireCodec.FromJson(element);
+
+        // Assert: fixmap(2), key 20 true, key 21 uint64
+        msgpack.Should().Equal(0x82, 0x14, 0xC3, 0x15, 0xCF, 0x00, 0x00, 0x01, 0x93, 0x87, 0xD0, 0x5E, 0x00);
+    }
+
+    [Fact]
+    public void FromJson_ToJson_RoundTrip()
+    {
+        // Arrange: Konfigurationsantwort mit Arrays, Strings > 31 Bytes, null und Double
+        const string json =
+            "{\"nodeId\":\"6f1c2a9e-0c55-4a8e-9a1d-1f2e3d4c5b6a\",\"isSimulation\":false," +
+            "\"wireFormat\":\"msgpack\",\"sensors\":[{\"endpointId\":1,\"sensorCode\":\"bme280\"," +
+            "\"i2CAddress\":null,\"offsetCorrection\":-0.35,\"gainCorrection\":1.0123456789," +
+            "\"aggregationWindowSeconds\":300,\"capabilities\":[]}],\"unknownField\":-70000}";
+        var element = JsonDocument.Parse(json).RootElement;
+
+        // Act
+        var decoded = JsonDocument.Parse(MsgPackWireCodec.ToJson(MsgPackWireCodec.FromJson(element))).RootElement;
+
+        // Assert
+        decoded.GetProperty("nodeId").GetString().Should().Be("6f1c2a9e-0c55-4a8e-9a1d-1f2e3d4c5b6a");
+        decoded.GetProperty("isSimulation").GetBoolean().Should().BeFalse();
+        decoded.GetProperty("wireFormat").GetString().Should().Be("msgpack");
+        decoded.GetProperty("unknownField").GetInt32().Should().Be(-70000);
+
+        var sensor = decoded.GetProperty("sensors")[0];
+        sensor.GetProperty("sensorCode").GetString().Should().Be("bme280");
+        sensor.GetProperty("i2CAddress").ValueKind.Should().Be(JsonValueKind.Null);
+        sensor.GetProperty("offsetCorrection").GetDouble().Should().Be(-0.35);
+        sensor.GetProperty("gainCorrection").GetDouble().Should().Be(1.0123456789);
+        sensor.GetProperty("aggregationWindowSeconds").GetInt32().Should().Be(300);
+        sensor.GetProperty("capabilities").GetArrayLength().Should().Be(0);
+    }
+
+    [Fact]
+    public void FromJson_LargeArray_UsesArray16()
+    {
+        // Arrange
+        var values = string.Join(",", Enumerable.Range(0, 20));
+        var element = JsonDocument.Parse($"[{values}]").RootElement;
+
+        // Act
+        var msgpack = MsgPackWireCodec.FromJson(element);
+
+        // Assert
+        msgpack[0].Should().Be(0xDC);
+        msgpack[1].Should().Be(0x00);
+        msgpack[2].Should().Be(20);
+        JsonDocument.Parse(MsgPackWireCodec.ToJson(msgpack)).RootElement.GetArrayLength().Should().Be(20);
+    }
+
+    #endregion
+}
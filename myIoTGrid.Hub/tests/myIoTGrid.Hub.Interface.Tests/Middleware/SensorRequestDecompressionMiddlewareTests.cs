@@ -0,0 +1,166 @@
+using System.IO.Compression;
+using System.Net;
+using System.Net.Http.Headers;
+using System.Text;
+using FluentAssertions;
+using Microsoft.AspNetCore.Builder;
+using Microsoft.AspNetCore.Hosting;
+using Microsoft.AspNetCore.Http;
+using Microsoft.AspNetCore.TestHost;
+using Microsoft.Extensions.DependencyInjection;
+using Microsoft.Extensions.Hosting;
+using myIoTGrid.Hub.Interface.Middleware;
+
+namespace myIoTGrid.Hub.Interface.Tests.Middleware;
+
+/// <summary>
+/// Tests for SensorRequestDecompressionMiddleware.
+/// Kündigt Accept-Encoding an und dekomprimiert gzip-Uploads der Sensoren.
+/// </summary>
+public class SensorRequestDecompressionMiddlewareTests
+{
+    private const string SampleJson =
+        "{\"serialNumber\":\"ESP32-0070078492CC\",\"readings\":[" +
+        "{\"sensorType\":\"temperature\",\"value\":21.5,\"unit\":\"°C\",\"endpointId\":1,\"timestamp\":1733150400}," +
+        "{\"sensorType\":\"humidity\",\"value\":45.2,\"unit\":\"%\",\"endpointId\":2,\"timestamp\":1733150400}]}";
+
+    /// <summary>
+    /// Lokaler Test-Server: Request-Body wird unverändert zurückgegeben
+    /// </summary>
+    private static async Task<IHost> StartEchoServerAsync()
+    {
+        return await new HostBuilder()
+            .ConfigureWebHost(web => web
+                .UseTestServer()
+                .ConfigureServices(services => services.AddRequestDecompression())
+                .Configure(app =>
+                {
+                    app.UseSensorRequestDecompression();
+                    app.Run(async context =>
+                    {
+                        using var reader = new StreamReader(context.Request.Body, Encoding.UTF8);
+                        var body = await reader.ReadToEndAsync();
+                        context.Response.ContentType = "application/json";
+                        await context.Response.WriteAsync(body);
+                    });
+                }))
+            .StartAsync();
+    }
+
+    private static byte[] Gzip(string text)
+    {
+        using var output = new MemoryStream();
+        using (var gzip = new GZipStream(output, CompressionLevel.Optimal))
+        {
+            var bytes = Encoding.UTF8.GetBytes(text);
+            gzip.Write(bytes, 0, bytes.Length);
+        }
+        return output.ToArray();
+    }
+
+    #region Negotiation Tests
+
+    [Fact]
+    public async Task InvokeAsync_ApiRequest_AdvertisesAcceptEncoding()
+    {
+        // Arrange
+        var context = new DefaultHttpContext();
+        context.Request.Path = "/api/nodes/heartbeat";
+        var responseFeature = new TestResponseFeature();
+        context.Features.Set<Microsoft.AspNetCore.Http.Features.IHttpResponseFeature>(responseFeature);
+
+        var middleware = new SensorRequestDecompressionMiddleware(_ => Task.CompletedTask);
+
+        // Act
+        await middleware.InvokeAsync(context);
+        await responseFeature.FireOnStartingAsync();
+
+        // Assert
+        context.Response.Headers["Accept-Encoding"].ToString()
+            .Should().Be(SensorRequestDecompressionMiddleware.SupportedEncodings);
+    }
+
+    [Fact]
+    public async Task InvokeAsync_NonApiRequest_DoesNotAdvertise()
+    {
+        // Arrange
+        var context = new DefaultHttpContext();
+        context.Request.Path = "/health";
+        var responseFeature = new TestResponseFeature();
+        context.Features.Set<Microsoft.AspNetCore.Http.Features.IHttpResponseFeature>(responseFeature);
+
+        var middleware = new SensorRequestDecompressionMiddleware(_ => Task.CompletedTask);
+
+        // Act
+        await middleware.InvokeAsync(context);
+        await responseFeature.FireOnStartingAsync();
+
+        // Assert
+        context.Response.Headers.ContainsKey("Accept-Encoding").Should().BeFalse();
+    }
+
+    #endregion
+
+    #region Round-Trip Tests
+
+    [Fact]
+    public async Task GzipRequest_IsDecompressedBeforeReachingEndpoint()
+    {
+        // Arrange
+        using var host = await StartEchoServerAsync();
+        var client = host.GetTestClient();
+
+        var content = new ByteArrayContent(Gzip(SampleJson));
+        content.Headers.ContentType = new MediaTypeHeaderValue("application/json");
+        content.Headers.ContentEncoding.Add("gzip");
+
+        // Act
+        var response = await client.PostAsync("/api/readings/batch", content);
+
+        // Assert
+        response.StatusCode.Should().Be(HttpStatusCode.OK);
+        (await response.Content.ReadAsStringAsync()).Should().Be(SampleJson);
+        response.Headers.GetValues("Accept-Encoding").Should().ContainSingle()
+            .Which.Should().Contain("gzip");
+    }
+
+    [Fact]
+    public async Task UncompressedRequest_PassesThroughUnchanged()
+    {
+        // Arrange
+        using var host = await StartEchoServerAsync();
+        var client = host.GetTestClient();
+
+        var content = new StringContent(SampleJson, Encoding.UTF8, "application/json");
+
+        // Act
+        var response = await client.PostAsync("/api/readings", content);
+
+        // Assert
+        response.StatusCode.Should().Be(HttpStatusCode.OK);
+        (await response.Content.ReadAsStringAsync()).Should().Be(SampleJson);
+    }
+
+    #endregion
+
+    /// <summary>
+    /// Response-Feature, das OnStarting-Callbacks für Unit-Tests auslösbar macht
+    /// </summary>
+    private sealed class TestResponseFeature : Microsoft.AspNetCore.Http.Features.HttpResponseFeature
+    {
+        private readonly List<(Func<object, Task> Callback, object State)> _onStarting = [];
+
+        public override void OnStarting(Func<object, Task> callback, object state)
+        {
+            _onStarting.Add((callback, state));
+        }
+
+        public async Task FireOnStartingAsync()
+        {
+            foreach (var (callback, state) in _onStarting)
+            {
+                await callback(state);
+            }
+        }
+    }
+}
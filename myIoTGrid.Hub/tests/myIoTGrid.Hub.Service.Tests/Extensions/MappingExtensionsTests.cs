@@ -1810,6 +1810,83 @@ public class MappingExtensionsTests
         sensor.Capabilities.Should().Contain(c => c.MeasurementType == "humidity");
     }
 
+    [Fact]
+    public void SensorCapability_ToDto_MapsDeadbandThresholds()
+    {
+        // Arrange
+        var capability = new SensorCapability
+        {
+            Id = Guid.NewGuid(),
+            SensorId = Guid.NewGuid(),
+            MeasurementType = "water_level",
+            DisplayName = "Wasserstand",
+            Unit = "cm",
+            DeadbandAbsolute = 2.0,
+            DeadbandSlopePerMinute = 5.0,
+            MaxSilenceSeconds = 1800
+        };
+
+        // Act
+        var result = capability.ToDto();
+
+        // Assert
+        result.DeadbandAbsolute.Should().Be(2.0);
+        result.DeadbandPercent.Should().BeNull();
+        result.DeadbandSlopePerMinute.Should().Be(5.0);
+        result.MaxSilenceSeconds.Should().Be(1800);
+    }
+
+    [Fact]
+    public void Sensor_ApplyUpdate_WithDeadband_UpdatesOnlyGivenThresholds()
+    {
+        // Arrange
+        var sensorId = Guid.NewGuid();
+        var capabilityId = Guid.NewGuid();
+        var sensor = new Sensor
+        {
+            Id = sensorId,
+            TenantId = Guid.NewGuid(),
+            Code = "test-sensor",
+            Name = "Test Sensor",
+            Category = "test",
+            Protocol = CommunicationProtocol.I2C,
+            IsActive = true,
+            CreatedAt = DateTime.UtcNow,
+            UpdatedAt = DateTime.UtcNow,
+            Capabilities = new List<SensorCapability>
+            {
+                new SensorCapability
+                {
+                    Id = capabilityId,
+                    SensorId = sensorId,
+                    MeasurementType = "temperature",
+                    DisplayName = "Temperatur",
+                    Unit = "°C",
+                    DeadbandAbsolute = 0.2,
+                    MaxSilenceSeconds = 900,
+                    IsActive = true
+                }
+            }
+        };
+
+        var updateDto = new UpdateSensorDto(
+            Capabilities: new List<UpdateSensorCapabilityDto>
+            {
+                new UpdateSensorCapabilityDto(Id: capabilityId, DeadbandAbsolute: 0.5, DeadbandPercent: 2.0)
+            }
+        );
+
+        // Act
+        sensor.ApplyUpdate(updateDto);
+
+        // Assert
+        var capability = sensor.Capabilities.Single();
+        capability.DeadbandAbsolute.Should().Be(0.5);
+        capability.DeadbandPercent.Should().Be(2.0);
+        capability.DeadbandSlopePerMinute.Should().BeNull();
+        capability.MaxSilenceSeconds.Should().Be(900);
+    }
+
     [Fact]
     public void Sensor_ApplyUpdate_DoesNotRemoveCapabilities_RemovalHandledByService()
     {
@@ -133,6 +133,35 @@ public class EffectiveConfigServiceTests
         result.GainCorrection.Should().Be(0.98);
     }
 
+    [Fact]
+    public void GetEffectiveConfig_AggregationWindowFromAssignment()
+    {
+        // Arrange
+        var sensor = CreateSensor();
+        var assignment = CreateAssignment();
+        assignment.AggregationWindowSeconds = 300;
+
+        // Act
+        var result = _sut.GetEffectiveConfig(assignment, sensor);
+
+        // Assert
+        result.AggregationWindowSeconds.Should().Be(300);
+    }
+
+    [Fact]
+    public void GetEffectiveConfig_WithoutAggregationWindow_ReturnsZero()
+    {
+        // Arrange
+        var sensor = CreateSensor();
+        var assignment = CreateAssignment();
+
+        // Act
+        var result = _sut.GetEffectiveConfig(assignment, sensor);
+
+        // Assert
+        result.AggregationWindowSeconds.Should().Be(0);
+    }
+
     #endregion
 
     #region ApplyCalibration Tests
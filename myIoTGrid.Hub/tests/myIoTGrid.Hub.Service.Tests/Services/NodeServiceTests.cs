@@ -1,3 +1,4 @@
+using System.Text.Json;
 using FluentAssertions;
 using Microsoft.EntityFrameworkCore;
 using Microsoft.Extensions.Logging;
@@ -1882,6 +1883,84 @@ public class NodeServiceTests : IDisposable
         updatedNode!.FirmwareVersion.Should().Be("1.0.0"); // Unchanged
         updatedNode.BatteryLevel.Should().Be(100); // Unchanged
         updatedNode.IsOnline.Should().BeTrue(); // Updated
+        updatedNode.DiagnosticsJson.Should().BeNull();
+        updatedNode.DiagnosticsReportedAt.Should().BeNull();
+    }
+
+    [Fact]
+    public async Task ProcessHeartbeatAsync_WithDiagnostics_StoresSnapshot()
+    {
+        // Arrange
+        var nodeId = Guid.NewGuid();
+        _context.Nodes.Add(new Node
+        {
+            Id = nodeId,
+            HubId = _hubId,
+            NodeId = "diagnostics-node",
+            Name = "Diagnostics Node",
+            CreatedAt = DateTime.UtcNow
+        });
+        await _context.SaveChangesAsync();
+
+        // Heartbeat body as sent by the firmware (api_client.cpp sendHeartbeat)
+        const string body = """
+            {"nodeId":"diagnostics-node","firmwareVersion":"1.4.0",
+             "wifi":{"rssi":-61,"reconnects":2},
+             "sync":{"pending":120,"batchSize":50},
+             "metrics":{"counters":{"http.requests":42},"gauges":{"heap.free":181234}},
+             "loop":{"maxUs":8123},
+             "wireFormat":"msgpack"}
+            """;
+        var dto = JsonSerializer.Deserialize<NodeHeartbeatDto>(body, new JsonSerializerOptions(JsonSerializerDefaults.Web))!;
+        var beforeTime = DateTime.UtcNow;
+
+        // Act
+        var result = await _sut.ProcessHeartbeatAsync(dto);
+
+        // Assert
+        result.Success.Should().BeTrue();
+
+        var updatedNode = await _context.Nodes.FindAsync(nodeId);
+        updatedNode!.DiagnosticsReportedAt.Should().NotBeNull();
+        updatedNode.DiagnosticsReportedAt.Should().BeOnOrAfter(beforeTime);
+
+        using var diagnostics = JsonDocument.Parse(updatedNode.DiagnosticsJson!);
+        var root = diagnostics.RootElement;
+        root.GetProperty("wireFormat").GetString().Should().Be("msgpack");
+        root.GetProperty("wifi").GetProperty("rssi").GetInt32().Should().Be(-61);
+        root.GetProperty("sync").GetProperty("pending").GetInt32().Should().Be(120);
+        root.GetProperty("metrics").GetProperty("counters").GetProperty("http.requests").GetInt32().Should().Be(42);
+        root.GetProperty("loop").GetProperty("maxUs").GetInt32().Should().Be(8123);
+        root.TryGetProperty("pipeline", out _).Should().BeFalse();
+    }
+
+    [Fact]
+    public async Task ProcessHeartbeatAsync_WithoutDiagnostics_KeepsLastSnapshot()
+    {
+        // Arrange
+        var nodeId = Guid.NewGuid();
+        var reportedAt = DateTime.UtcNow.AddMinutes(-5);
+        _context.Nodes.Add(new Node
+        {
+            Id = nodeId,
+            HubId = _hubId,
+            NodeId = "old-firmware-node",
+            Name = "Old Firmware Node",
+            DiagnosticsJson = """{"wifi":{"rssi":-70}}""",
+            DiagnosticsReportedAt = reportedAt,
+            CreatedAt = DateTime.UtcNow
+        });
+        await _context.SaveChangesAsync();
+
+        var dto = new NodeHeartbeatDto("old-firmware-node", "1.0.0", null);
+
+        // Act
+        await _sut.ProcessHeartbeatAsync(dto);
+
+        // Assert
+        var updatedNode = await _context.Nodes.FindAsync(nodeId);
+        updatedNode!.DiagnosticsJson.Should().Be("""{"wifi":{"rssi":-70}}""");
+        updatedNode.DiagnosticsReportedAt.Should().Be(reportedAt);
     }
 
     [Fact]
@@ -775,6 +775,99 @@ public class ReadingServiceTests : IDisposable
 
     #endregion
 
+    #region CreateBatchAsync Tests
+
+    [Fact]
+    public async Task CreateBatchAsync_WithReadingTimestamps_KeepsCaptureTimePerReading()
+    {
+        // Arrange: Offline-Sync mit Messwerten aus mehreren Stunden
+        var firstTime = new DateTime(2025, 1, 1, 8, 0, 0, DateTimeKind.Utc);
+        var secondTime = new DateTime(2025, 1, 1, 11, 30, 0, DateTimeKind.Utc);
+
+        var dto = new CreateBatchReadingsDto(
+            NodeId: "test-node",
+            HubId: null,
+            Readings: new[]
+            {
+                new ReadingValueDto(1, "temperature", 20.5, new DateTimeOffset(firstTime).ToUnixTimeSeconds()),
+                new ReadingValueDto(1, "temperature", 22.0, new DateTimeOffset(secondTime).ToUnixTimeSeconds())
+            }
+        );
+
+        // Act
+        var result = await _sut.CreateBatchAsync(dto);
+
+        // Assert
+        result.SuccessCount.Should().Be(2);
+        result.FailedCount.Should().Be(0);
+        var stored = _context.Readings.Where(r => r.NodeId == _nodeId).OrderBy(r => r.Timestamp).ToList();
+        stored.Select(r => r.Timestamp).Should().Equal(firstTime, secondTime);
+        stored.Should().OnlyContain(r => r.AssignmentId == _assignmentId && r.Unit == "°C");
+    }
+
+    [Fact]
+    public async Task CreateBatchAsync_WithoutReadingTimestamp_UsesBatchTimestamp()
+    {
+        // Arrange
+        var batchTime = new DateTime(2025, 1, 1, 12, 0, 0, DateTimeKind.Utc);
+
+        var dto = new CreateBatchReadingsDto(
+            NodeId: "test-node",
+            HubId: null,
+            Readings: new[] { new ReadingValueDto(1, "humidity", 55.0) },
+            Timestamp: batchTime
+        );
+
+        // Act
+        await _sut.CreateBatchAsync(dto);
+
+        // Assert
+        var stored = _context.Readings.Single(r => r.NodeId == _nodeId);
+        stored.Timestamp.Should().Be(batchTime);
+        stored.Unit.Should().Be("%");
+    }
+
+    [Fact]
+    public async Task CreateBatchAsync_WithNodeUnit_PrefersNodeUnit()
+    {
+        // Arrange: unbekannter Endpoint, die Einheit kommt nur vom Node
+        var dto = new CreateBatchReadingsDto(
+            NodeId: "test-node",
+            HubId: null,
+            Readings: new[] { new ReadingValueDto(9, "pressure", 1013.2, Unit: "hPa") }
+        );
+
+        // Act
+        var result = await _sut.CreateBatchAsync(dto);
+
+        // Assert
+        result.SuccessCount.Should().Be(1);
+        var stored = _context.Readings.Single(r => r.NodeId == _nodeId);
+        stored.AssignmentId.Should().BeNull();
+        stored.Unit.Should().Be("hPa");
+    }
+
+    [Fact]
+    public async Task CreateBatchAsync_WithUnknownNode_ReportsAllFailed()
+    {
+        // Arrange
+        var dto = new CreateBatchReadingsDto(
+            NodeId: "unknown-node",
+            HubId: null,
+            Readings: new[] { new ReadingValueDto(1, "temperature", 21.0) }
+        );
+
+        // Act
+        var result = await _sut.CreateBatchAsync(dto);
+
+        // Assert
+        result.SuccessCount.Should().Be(0);
+        result.FailedCount.Should().Be(1);
+        _context.Readings.Should().BeEmpty();
+    }
+
+    #endregion
+
     #region CreateFromSensorAsync Tests
 
     [Fact]
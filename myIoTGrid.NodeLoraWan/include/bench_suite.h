@@ -0,0 +1,36 @@
+/**
+ * @file bench_suite.h
+ * @brief Native Benchmark Suite
+ *
+ * Micro-benchmarks of the uplink hot paths (payload encoding,
+ * fragmentation, time-on-air, water level median), built by the
+ * native_bench env instead of the simulation (main() runs the suite
+ * and exits):
+ *
+ *   pio run -e native_bench && .pio/build/native_bench/program
+ *
+ * Each benchmark is calibrated to BENCH_MIN_SAMPLE_MS per sample and
+ * reports the median ns/op of BENCH_SAMPLES samples. A benchmark fails
+ * if it exceeds its ceiling; the exit code is 1 on any failure.
+ *
+ * @version 1.0.0
+ * @date 2025-12-17
+ *
+ * Sprint: LoRa-02 - Grid.Sensor LoRaWAN Firmware
+ */
+
+#pragma once
+
+#ifdef PLATFORM_NATIVE
+
+namespace bench {
+
+/**
+ * @brief Run all benchmarks and print the results
+ * @return true if no benchmark exceeded its ceiling
+ */
+bool runSuite();
+
+} // namespace bench
+
+#endif // PLATFORM_NATIVE
@@ -52,6 +52,15 @@
 // Uplink Port für Sensor-Daten
 #define LORAWAN_SENSOR_PORT 1
 
+// Uplink Port für aggregierte Multi-Sample Frames
+#define LORAWAN_AGGREGATED_PORT 2
+
+// Uplink Port für fragmentierte Batches (Payload > Limit der Data Rate)
+#define LORAWAN_FRAGMENT_PORT 3
+
+// Uplink Port für Energie-Diagnose
+#define LORAWAN_DIAG_PORT 4
+
 // Downlink Port für Konfiguration
 #define LORAWAN_CONFIG_PORT 10
 
@@ -217,6 +226,52 @@
 // Minimum Deep Sleep Zeit (Sekunden)
 #define MIN_DEEP_SLEEP_SECONDS 10
 
+// ============================================================
+// ENERGY PROFILER CONFIGURATION
+// ============================================================
+
+// Stromaufnahme je Phase (mA), per build_flags überschreibbar
+#ifndef POWER_CURRENT_BOOT_MA
+#define POWER_CURRENT_BOOT_MA 80.0f
+#endif
+#ifndef POWER_CURRENT_SENSOR_MA
+#define POWER_CURRENT_SENSOR_MA 95.0f     // MCU + HC-SR04/BME280
+#endif
+#ifndef POWER_CURRENT_JOIN_MA
+#define POWER_CURRENT_JOIN_MA 85.0f       // Warten auf JoinAccept (RX)
+#endif
+#ifndef POWER_CURRENT_TX_MA
+#define POWER_CURRENT_TX_MA 120.0f
+#endif
+#ifndef POWER_CURRENT_RX_MA
+#define POWER_CURRENT_RX_MA 85.0f         // RX-Fenster nach Uplink
+#endif
+#ifndef POWER_CURRENT_IDLE_MA
+#define POWER_CURRENT_IDLE_MA 80.0f
+#endif
+#ifndef POWER_CURRENT_DISPLAY_MA
+#define POWER_CURRENT_DISPLAY_MA 20.0f    // Zusätzlich, solange OLED an
+#endif
+#ifndef POWER_CURRENT_SLEEP_MA
+#define POWER_CURRENT_SLEEP_MA 0.01f      // Deep Sleep ~10 µA
+#endif
+
+// Akkukapazität für Laufzeit-Schätzung (mAh)
+#ifndef BATTERY_CAPACITY_MAH
+#define BATTERY_CAPACITY_MAH 3000
+#endif
+
+// Energie-Diagnose als eigener Uplink senden
+#ifndef ENERGY_DIAG_UPLINK_ENABLED
+#define ENERGY_DIAG_UPLINK_ENABLED false
+#endif
+
+// Diagnose-Uplink alle N Wake-Zyklen
+#define ENERGY_DIAG_INTERVAL_CYCLES 24
+
+// Maximale Wartezeit (ms) auf Duty Cycle für den Diagnose-Uplink
+#define ENERGY_DIAG_MAX_WAIT_MS 10000
+
 // ============================================================
 // PAYLOAD CONFIGURATION
 // ============================================================
@@ -224,6 +279,58 @@
 // Maximum Payload-Größe (EU868 DR0/SF12: 51 bytes, DR5/SF7: 242 bytes)
 #define MAX_PAYLOAD_SIZE 51  // Konservativ für alle Data Rates
 
+// Maximale Nutzlast je Data Rate (EU868 Regional Parameters, ohne FOpts)
+namespace PayloadLimits {
+    constexpr uint8_t EU868_MAX_PAYLOAD[] = {
+        51,   // DR0 (SF12)
+        51,   // DR1 (SF11)
+        51,   // DR2 (SF10)
+        115,  // DR3 (SF9)
+        242,  // DR4 (SF8)
+        242,  // DR5 (SF7)
+        242,  // DR6 (SF7 / 250 kHz)
+        242   // DR7 (FSK)
+    };
+}
+
+/**
+ * @brief Maximum application payload for a data rate
+ * @param dr EU868 data rate (0-7)
+ * @return Payload limit in bytes (MAX_PAYLOAD_SIZE for unknown DRs)
+ */
+inline uint8_t maxPayloadForDataRate(uint8_t dr) {
+    if (dr >= sizeof(PayloadLimits::EU868_MAX_PAYLOAD)) {
+        return MAX_PAYLOAD_SIZE;
+    }
+    return PayloadLimits::EU868_MAX_PAYLOAD[dr];
+}
+
+/**
+ * @brief Maximum application payload for the next uplink
+ *
+ * With ADR the network server can lower the data rate with any
+ * downlink, and RadioLib does not report the active one. Frames
+ * are then sized for DR0 so they fit whatever DR is in use.
+ *
+ * @param dr Data rate last set on the node
+ * @param adrEnabled true if ADR is enabled
+ * @return Payload limit in bytes
+ */
+inline uint8_t maxPayloadForUplink(uint8_t dr, bool adrEnabled) {
+    return adrEnabled ? PayloadLimits::EU868_MAX_PAYLOAD[0] : maxPayloadForDataRate(dr);
+}
+
+// Fragment-Header: [BatchId:1][Index:4 Bit | Total:4 Bit]
+#define FRAGMENT_HEADER_SIZE 2
+
+// Maximale Anzahl Fragmente pro Batch (4-Bit Feld)
+#define MAX_FRAGMENTS 15
+
+// Maximale Wartezeit (ms) auf den Duty Cycle zwischen zwei Fragmenten.
+// Ein Batch wird nur in so viele Fragmente geteilt, wie innerhalb dieser
+// Zeit gesendet werden können (1% Duty Cycle: Off-Time = 99 × Airtime).
+#define FRAGMENT_MAX_WAIT_MS 60000
+
 // Sensor Type IDs für Payload-Encoding
 namespace SensorTypeId {
     constexpr uint8_t TEMPERATURE = 0x01;
@@ -244,6 +351,34 @@ namespace SensorTypeId {
     constexpr uint8_t UNKNOWN = 0xFF;
 }
 
+// ============================================================
+// AGGREGATION CONFIGURATION
+// ============================================================
+
+// Messungen über mehrere Deep-Sleep-Zyklen sammeln und als ein Frame senden
+#ifndef LORAWAN_AGGREGATION_ENABLED
+#define LORAWAN_AGGREGATION_ENABLED false
+#endif
+
+// Maximale Anzahl Samples pro aggregiertem Frame
+#define AGGREGATION_MAX_SAMPLES 16
+
+// Maximales Alter des ältesten Samples bevor gesendet wird (Sekunden)
+#define AGGREGATION_MAX_AGE_SECONDS 3600  // 1 Stunde
+
+// RTC-Puffer für gesammelte Samples (Bytes)
+#define AGGREGATION_BUFFER_SIZE 320
+
+// ============================================================
+// BENCHMARK CONFIGURATION (native_bench)
+// ============================================================
+
+// Iterationen werden verdoppelt, bis ein Sample so lange dauert (ms)
+#define BENCH_MIN_SAMPLE_MS 50
+
+// Gemeldet wird der Median dieser Samples
+#define BENCH_SAMPLES 5
+
 // ============================================================
 // DEBUG CONFIGURATION
 // ============================================================
@@ -256,27 +391,35 @@ namespace SensorTypeId {
 // Serial Baudrate
 #define SERIAL_BAUD 115200
 
+// Debug-Ausgabe: Serial auf dem ESP32, stdout nativ (Tests, Simulation)
+#ifdef PLATFORM_NATIVE
+#include <cstdio>
+#define LOG_PRINTF printf
+#else
+#define LOG_PRINTF Serial.printf
+#endif
+
 // Debug-Makros
 #if DEBUG_LEVEL >= 1
-#define LOG_ERROR(fmt, ...) Serial.printf("[ERROR] " fmt "\n", ##__VA_ARGS__)
+#define LOG_ERROR(fmt, ...) LOG_PRINTF("[ERROR] " fmt "\n", ##__VA_ARGS__)
 #else
 #define LOG_ERROR(fmt, ...)
 #endif
 
 #if DEBUG_LEVEL >= 2
-#define LOG_WARN(fmt, ...) Serial.printf("[WARN]  " fmt "\n", ##__VA_ARGS__)
+#define LOG_WARN(fmt, ...) LOG_PRINTF("[WARN]  " fmt "\n", ##__VA_ARGS__)
 #else
 #define LOG_WARN(fmt, ...)
 #endif
 
 #if DEBUG_LEVEL >= 3
-#define LOG_INFO(fmt, ...) Serial.printf("[INFO]  " fmt "\n", ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...) LOG_PRINTF("[INFO]  " fmt "\n", ##__VA_ARGS__)
 #else
 #define LOG_INFO(fmt, ...)
 #endif
 
 #if DEBUG_LEVEL >= 4
-#define LOG_DEBUG(fmt, ...) Serial.printf("[DEBUG] " fmt "\n", ##__VA_ARGS__)
+#define LOG_DEBUG(fmt, ...) LOG_PRINTF("[DEBUG] " fmt "\n", ##__VA_ARGS__)
 #else
 #define LOG_DEBUG(fmt, ...)
 #endif
@@ -0,0 +1,165 @@
+/**
+ * @file energy_profiler.h
+ * @brief Per-Phase Energy Profiler for Battery-Powered Sensor Nodes
+ *
+ * Timestamps the phases of a wake cycle (boot, sensor warm-up, join,
+ * TX, RX windows, idle) and estimates the charge per cycle from a
+ * configurable current table (POWER_CURRENT_*_MA in config.h).
+ *
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * Sprint: LoRa-02 - Grid.Sensor LoRaWAN Firmware
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Wake Cycle Phase
+ *
+ * Phases are exclusive; the OLED display is tracked as an
+ * additional load on top of the active phase.
+ */
+enum class PowerPhase : uint8_t {
+    BOOT,           ///< Reset until sensor init
+    SENSOR,         ///< Sensor init and measurement
+    JOIN,           ///< OTAA join (excluding JoinRequest airtime)
+    TX,             ///< Radio transmitting (time-on-air)
+    RX,             ///< RX windows and radio overhead after TX
+    IDLE,           ///< Awake, no specific activity
+    COUNT
+};
+
+/**
+ * @brief Energy Profiler Class
+ *
+ * Static class (like PowerManager). The result of the last completed
+ * cycle lives in RTC memory so it can be reported after deep sleep.
+ *
+ * Diagnostic frame format (port LORAWAN_DIAG_PORT, MSB first):
+ *   [Version:1][PhaseCount:1][PhaseCount × Duration ms:2]
+ *   [Display ms:2][Sleep s:2][Charge µAh:2]
+ */
+class EnergyProfiler {
+public:
+    // === Cycle ===
+
+    /**
+     * @brief Start a new wake cycle (phase BOOT)
+     * @param fromReset true if the cycle started at reset (millis() = 0)
+     */
+    static void beginCycle(bool fromReset = false);
+
+    /**
+     * @brief Finish the cycle, compute and log the charge estimate
+     * @param sleepSeconds Deep sleep duration following this cycle
+     * @return Charge of the whole cycle in µAh
+     */
+    static uint32_t endCycle(uint32_t sleepSeconds);
+
+    // === Phases ===
+
+    /**
+     * @brief Switch to a phase
+     *
+     * Closes the running phase. For JOIN and TX the radio airtime
+     * reported by the LoRa HAL is booked as TX, the rest as JOIN / RX.
+     *
+     * @param phase Phase to enter
+     */
+    static void beginPhase(PowerPhase phase);
+
+    /**
+     * @brief Close the running phase and return to IDLE
+     */
+    static void endPhase();
+
+    /**
+     * @brief Track OLED display state (additional load)
+     * @param on true if display is on
+     */
+    static void setDisplayActive(bool on);
+
+    // === Configuration ===
+
+    /**
+     * @brief Override the current of a phase
+     * @param phase Phase
+     * @param milliAmps Current in mA
+     */
+    static void setPhaseCurrent(PowerPhase phase, float milliAmps);
+
+    /**
+     * @brief Get the configured current of a phase
+     * @param phase Phase
+     * @return Current in mA
+     */
+    static float getPhaseCurrent(PowerPhase phase);
+
+    // === Results ===
+
+    /**
+     * @brief Get duration of a phase in the running cycle
+     * @param phase Phase
+     * @return Duration in ms
+     */
+    static uint32_t getPhaseMs(PowerPhase phase);
+
+    /**
+     * @brief Get charge of the last completed cycle
+     * @return Charge in µAh (0 if none)
+     */
+    static uint32_t getLastCycleCharge();
+
+    /**
+     * @brief Get phase name for logging
+     * @param phase Phase
+     * @return Name
+     */
+    static const char* getPhaseName(PowerPhase phase);
+
+    // === Diagnostic Uplink ===
+
+    /**
+     * @brief Check if a diagnostic uplink is due
+     * @return true if enabled, a completed cycle exists and the interval elapsed
+     */
+    static bool isDiagnosticDue();
+
+    /**
+     * @brief Encode the last completed cycle as diagnostic frame
+     * @return Frame payload (empty if no completed cycle)
+     */
+    static std::vector<uint8_t> buildDiagnosticFrame();
+
+    /**
+     * @brief Restart the diagnostic interval (after successful TX)
+     */
+    static void markDiagnosticSent();
+
+private:
+    static constexpr size_t PHASE_COUNT = static_cast<size_t>(PowerPhase::COUNT);
+
+    static float phaseCurrent_[PHASE_COUNT];
+    static uint32_t phaseMs_[PHASE_COUNT];
+    static PowerPhase currentPhase_;
+    static uint32_t phaseStartMs_;
+    static uint32_t airtimeAtPhaseStart_;
+    static bool displayOn_;
+    static uint32_t displayOnSinceMs_;
+    static uint32_t displayMs_;
+
+    /**
+     * @brief Book elapsed time of the running phase
+     */
+    static void closePhase();
+
+    /**
+     * @brief Book elapsed display on-time
+     */
+    static void closeDisplay();
+};
@@ -51,6 +51,17 @@ uint32_t micros();
  */
 uint32_t timestamp();
 
+/**
+ * @brief Get RTC-backed system time
+ *
+ * Unlike timestamp() it keeps counting through deep sleep, so it can
+ * measure intervals across wake cycles. Seconds since power-on until
+ * the clock is set (NTP/downlink), Unix time afterwards.
+ *
+ * @return Seconds
+ */
+uint32_t wall_clock();
+
 // ============================================================
 // NON-VOLATILE STORAGE
 // ============================================================
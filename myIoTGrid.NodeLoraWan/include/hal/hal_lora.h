@@ -212,10 +212,36 @@ bool is_tx_ready();
 
 /**
  * @brief Get time until next transmission allowed (duty cycle)
+ *
+ * Earliest legal transmit time from the per-sub-band duty cycle
+ * ledger. The ledger survives deep sleep.
+ *
  * @return Milliseconds until next TX allowed, 0 if ready
  */
 uint32_t get_time_until_tx();
 
+// ============================================================
+// AIRTIME ACCOUNTING
+// ============================================================
+
+/**
+ * @brief Get time-on-air of the next uplink (for planning)
+ *
+ * At the data rate last set, or at DR0 while ADR is enabled: the network
+ * can lower the DR with any downlink and RadioLib does not report it.
+ * The duty cycle ledger is charged with the airtime RadioLib measured.
+ *
+ * @param len Application payload length (LoRaWAN overhead is added)
+ * @return Airtime in milliseconds
+ */
+uint32_t get_time_on_air(size_t len);
+
+/**
+ * @brief Get total airtime used since first boot
+ * @return Airtime in milliseconds
+ */
+uint32_t get_airtime_used();
+
 // ============================================================
 // DATA RECEPTION
 // ============================================================
@@ -257,6 +283,10 @@ bool set_data_rate(uint8_t dr);
 
 /**
  * @brief Get current data rate
+ *
+ * The last data rate set via set_data_rate(). With ADR enabled the
+ * network server may have lowered it since.
+ *
  * @return Current data rate value
  */
 uint8_t get_data_rate();
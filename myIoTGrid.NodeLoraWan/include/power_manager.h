@@ -77,6 +77,13 @@ public:
      */
     static uint32_t deepSleepAdaptive(uint32_t baseSeconds);
 
+    /**
+     * @brief Calculate adaptive sleep duration without sleeping
+     * @param baseSeconds Base sleep duration
+     * @return Sleep duration for the current battery level
+     */
+    static uint32_t getAdaptiveSleepSeconds(uint32_t baseSeconds);
+
     /**
      * @brief Get wake-up reason
      * @return Wake-up reason
@@ -0,0 +1,230 @@
+/**
+ * @file frame_aggregator.cpp
+ * @brief Multi-Sample Frame Aggregation Implementation
+ *
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * Sprint: LoRa-02 - Grid.Sensor LoRaWAN Firmware
+ */
+
+#ifdef PLATFORM_ESP32
+#include <Arduino.h>
+#include <esp_attr.h>
+#else
+#define RTC_DATA_ATTR
+#endif
+
+#include "frame_aggregator.h"
+#include "lora_connection.h"
+#include "hal/hal.h"
+#include "config.h"
+
+#include <algorithm>
+#include <cstring>
+
+// ============================================================
+// RTC STATE
+// ============================================================
+
+namespace {
+
+constexpr uint32_t AGGREGATION_MAGIC = 0x41474731;  // "AGG1"
+
+// Stored sample: [CaptureTime:4][Count:1][Count × Reading:3]
+constexpr size_t STORED_SAMPLE_HEADER = 5;
+
+// Frame sample: [Age:2][Count:1][Count × Reading:3]
+constexpr size_t FRAME_SAMPLE_HEADER = 3;
+
+// Frame header: [SampleCount:1]
+constexpr size_t FRAME_HEADER = 1;
+
+constexpr size_t READING_SIZE = 3;
+
+struct AggregationState {
+    uint32_t magic;
+    uint8_t sampleCount;
+    uint8_t lastReadingCount;
+    uint16_t usedBytes;
+    uint16_t frameBytes;    ///< Encoded size of all samples (without frame header)
+    uint8_t buffer[AGGREGATION_BUFFER_SIZE];
+};
+
+// Survives deep sleep on ESP32 (plain static on native)
+RTC_DATA_ATTR AggregationState rtcState;
+
+void resetState() {
+    memset(&rtcState, 0, sizeof(rtcState));
+    rtcState.magic = AGGREGATION_MAGIC;
+}
+
+uint32_t readCaptureTime(size_t offset) {
+    const uint8_t* p = &rtcState.buffer[offset];
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+} // namespace
+
+// ============================================================
+// INITIALIZATION
+// ============================================================
+
+void FrameAggregator::init() {
+    if (rtcState.magic != AGGREGATION_MAGIC ||
+        rtcState.usedBytes > AGGREGATION_BUFFER_SIZE ||
+        rtcState.sampleCount > AGGREGATION_MAX_SAMPLES) {
+        resetState();
+        LOG_DEBUG("Aggregation buffer initialized");
+        return;
+    }
+
+    if (rtcState.sampleCount > 0) {
+        LOG_INFO("Aggregation buffer restored: %u samples, %u bytes pending",
+                 rtcState.sampleCount, (unsigned)getFrameSize());
+    }
+}
+
+// ============================================================
+// SAMPLE HANDLING
+// ============================================================
+
+bool FrameAggregator::addSample(const std::vector<Reading>& readings, size_t payloadBudget) {
+    if (readings.empty()) return false;
+
+    size_t count = std::min<size_t>(readings.size(), 255);
+    size_t storedSize = STORED_SAMPLE_HEADER + count * READING_SIZE;
+
+    if (storedSize > AGGREGATION_BUFFER_SIZE ||
+        FRAME_HEADER + sampleFrameSize(count) > payloadBudget) {
+        LOG_WARN("Sample too large for aggregated frame (%zu readings)", count);
+        return false;
+    }
+
+    // Make room: evict oldest samples first
+    while (rtcState.sampleCount > 0 &&
+           (rtcState.usedBytes + storedSize > AGGREGATION_BUFFER_SIZE ||
+            rtcState.sampleCount >= AGGREGATION_MAX_SAMPLES ||
+            !fits(count, payloadBudget))) {
+        LOG_WARN("Aggregation buffer full, dropping oldest sample");
+        dropOldest();
+    }
+
+    uint8_t* p = &rtcState.buffer[rtcState.usedBytes];
+    uint32_t now = hal::wall_clock();
+
+    *p++ = (now >> 24) & 0xFF;
+    *p++ = (now >> 16) & 0xFF;
+    *p++ = (now >> 8) & 0xFF;
+    *p++ = now & 0xFF;
+    *p++ = static_cast<uint8_t>(count);
+
+    for (size_t i = 0; i < count; i++) {
+        auto encoded = LoRaConnection::encodeReading(readings[i]);
+        memcpy(p, encoded.data(), READING_SIZE);
+        p += READING_SIZE;
+    }
+
+    rtcState.usedBytes += storedSize;
+    rtcState.frameBytes += sampleFrameSize(count);
+    rtcState.lastReadingCount = static_cast<uint8_t>(count);
+    rtcState.sampleCount++;
+
+    LOG_DEBUG("Sample aggregated (%u pending, frame %u bytes)",
+              rtcState.sampleCount, (unsigned)getFrameSize());
+    return true;
+}
+
+bool FrameAggregator::fits(size_t readingCount, size_t payloadBudget) {
+    size_t frameSize = FRAME_HEADER + rtcState.frameBytes + sampleFrameSize(readingCount);
+    return frameSize <= payloadBudget;
+}
+
+bool FrameAggregator::shouldFlush(size_t payloadBudget) {
+    if (rtcState.sampleCount == 0) return false;
+
+    if (rtcState.sampleCount >= AGGREGATION_MAX_SAMPLES) return true;
+
+    if (getOldestAge() >= AGGREGATION_MAX_AGE_SECONDS) return true;
+
+    // Next sample of the same shape would not fit anymore
+    return !fits(rtcState.lastReadingCount, payloadBudget);
+}
+
+std::vector<uint8_t> FrameAggregator::buildFrame() {
+    std::vector<uint8_t> frame;
+    if (rtcState.sampleCount == 0) return frame;
+
+    frame.reserve(getFrameSize());
+    frame.push_back(rtcState.sampleCount);
+
+    uint32_t now = hal::wall_clock();
+    size_t offset = 0;
+
+    for (uint8_t i = 0; i < rtcState.sampleCount; i++) {
+        uint32_t captured = readCaptureTime(offset);
+        uint8_t count = rtcState.buffer[offset + 4];
+
+        uint32_t age = (now > captured) ? now - captured : 0;
+        if (age > 0xFFFF) age = 0xFFFF;
+
+        frame.push_back((age >> 8) & 0xFF);
+        frame.push_back(age & 0xFF);
+        frame.push_back(count);
+
+        const uint8_t* readings = &rtcState.buffer[offset + STORED_SAMPLE_HEADER];
+        frame.insert(frame.end(), readings, readings + count * READING_SIZE);
+
+        offset += STORED_SAMPLE_HEADER + count * READING_SIZE;
+    }
+
+    return frame;
+}
+
+void FrameAggregator::clear() {
+    resetState();
+}
+
+// ============================================================
+// STATUS
+// ============================================================
+
+uint8_t FrameAggregator::getSampleCount() {
+    return rtcState.sampleCount;
+}
+
+size_t FrameAggregator::getFrameSize() {
+    if (rtcState.sampleCount == 0) return 0;
+    return FRAME_HEADER + rtcState.frameBytes;
+}
+
+uint32_t FrameAggregator::getOldestAge() {
+    if (rtcState.sampleCount == 0) return 0;
+
+    uint32_t now = hal::wall_clock();
+    uint32_t captured = readCaptureTime(0);
+    return (now > captured) ? now - captured : 0;
+}
+
+// ============================================================
+// PRIVATE HELPERS
+// ============================================================
+
+size_t FrameAggregator::sampleFrameSize(size_t readingCount) {
+    return FRAME_SAMPLE_HEADER + readingCount * READING_SIZE;
+}
+
+void FrameAggregator::dropOldest() {
+    if (rtcState.sampleCount == 0) return;
+
+    uint8_t count = rtcState.buffer[4];
+    size_t storedSize = STORED_SAMPLE_HEADER + count * READING_SIZE;
+
+    memmove(rtcState.buffer, rtcState.buffer + storedSize,
+            rtcState.usedBytes - storedSize);
+
+    rtcState.usedBytes -= storedSize;
+    rtcState.frameBytes -= sampleFrameSize(count);
+    rtcState.sampleCount--;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file frame_aggregator.h
+ * @brief Multi-Sample Frame Aggregation across Deep Sleep
+ *
+ * Accumulates sensor samples in RTC memory across several deep sleep
+ * cycles and encodes them as one timestamped multi-sample frame.
+ * This amortizes the LoRaWAN header overhead and airtime over
+ * multiple measurements.
+ *
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * Sprint: LoRa-02 - Grid.Sensor LoRaWAN Firmware
+ */
+
+#pragma once
+
+#include "connection_interface.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Frame Aggregator
+ *
+ * Static class (like PowerManager) because its buffer lives in RTC
+ * memory and must survive deep sleep.
+ *
+ * Aggregated frame format (port LORAWAN_AGGREGATED_PORT):
+ *   [SampleCount:1]
+ *   SampleCount × [Age:2 (seconds before TX, MSB first)][Count:1][Count × Reading:3]
+ *
+ * Each reading uses the standard [TypeID:1][Value:2] encoding.
+ */
+class FrameAggregator {
+public:
+    // === Initialization ===
+
+    /**
+     * @brief Validate RTC buffer
+     *
+     * Resets the buffer after a cold boot (RTC memory contains garbage).
+     */
+    static void init();
+
+    // === Sample Handling ===
+
+    /**
+     * @brief Append one sample (set of readings taken at the same time)
+     *
+     * Oldest samples are evicted if the RTC buffer is full or the
+     * frame would exceed the payload budget (e.g. after failed sends).
+     *
+     * @param readings Readings of this wake cycle
+     * @param payloadBudget Maximum payload size for the current data rate
+     * @return true if the sample was stored
+     */
+    static bool addSample(const std::vector<Reading>& readings, size_t payloadBudget);
+
+    /**
+     * @brief Check if a sample would still fit into the frame
+     * @param readingCount Number of readings in the sample
+     * @param payloadBudget Maximum payload size for the current data rate
+     * @return true if it fits
+     */
+    static bool fits(size_t readingCount, size_t payloadBudget);
+
+    /**
+     * @brief Check if the frame should be sent now
+     *
+     * True when another sample of the same size would exceed the
+     * payload budget, the sample limit is reached or the oldest
+     * sample is older than AGGREGATION_MAX_AGE_SECONDS.
+     *
+     * @param payloadBudget Maximum payload size for the current data rate
+     * @return true if the frame should be flushed
+     */
+    static bool shouldFlush(size_t payloadBudget);
+
+    /**
+     * @brief Encode all pending samples as aggregated frame
+     * @return Frame payload (empty if no samples pending)
+     */
+    static std::vector<uint8_t> buildFrame();
+
+    /**
+     * @brief Discard all pending samples (after successful TX)
+     */
+    static void clear();
+
+    // === Status ===
+
+    /**
+     * @brief Get number of pending samples
+     * @return Sample count
+     */
+    static uint8_t getSampleCount();
+
+    /**
+     * @brief Get size of the frame if it were sent now
+     * @return Frame size in bytes (0 if empty)
+     */
+    static size_t getFrameSize();
+
+    /**
+     * @brief Get age of the oldest pending sample
+     * @return Age in seconds (0 if empty)
+     */
+    static uint32_t getOldestAge();
+
+private:
+    /**
+     * @brief Encoded frame size of a sample
+     * @param readingCount Number of readings
+     * @return Bytes in the aggregated frame
+     */
+    static size_t sampleFrameSize(size_t readingCount);
+
+    /**
+     * @brief Remove the oldest sample from the buffer
+     */
+    static void dropOldest();
+};
@@ -15,6 +15,7 @@
 #include "lora_connection.h"
 #include "hal/hal.h"
 #include "hal/hal_lora.h"
+#include "lora_airtime.h"
 #include "config.h"
 
 #include <algorithm>
@@ -148,24 +149,52 @@ bool LoRaConnection::sendBatch(const std::vector<Reading>& readings) {
         return true;
     }
 
-    auto payload = encodeBatch(readings);
+    auto frames = encodeBatch(readings);
+    uint8_t port = frames.size() > 1 ? LORAWAN_FRAGMENT_PORT : LORAWAN_SENSOR_PORT;
 
-    LOG_INFO("Sending batch of %zu readings (%zu bytes)",
-             readings.size(), payload.size());
+    LOG_INFO("Sending batch of %zu readings (%zu frame(s), DR%u)",
+             readings.size(), frames.size(), hal::lora::get_data_rate());
 
-    bool success = hal::lora::send(
-        LORAWAN_SENSOR_PORT,
-        payload.data(),
-        payload.size(),
-        LORAWAN_CONFIRMED_UPLINKS
-    );
+    bool success = true;
 
-    if (!success) {
-        LOG_WARN("Batch transmission failed, queueing for retry");
-        queueForRetry(payload, LORAWAN_SENSOR_PORT, LORAWAN_CONFIRMED_UPLINKS);
-    } else {
-        // Save frame counter periodically
-        if (getFrameCounter() % 10 == 0) {
+    for (size_t i = 0; i < frames.size(); i++) {
+        const auto& payload = frames[i];
+
+        if (i > 0) {
+            // Fragments must not hit the duty cycle limit: a failed fragment
+            // cannot be completed later (the retry queue is lost in deep sleep)
+            uint32_t waitMs = hal::lora::get_time_until_tx();
+            if (waitMs > FRAGMENT_MAX_WAIT_MS) {
+                LOG_WARN("Duty cycle blocks fragment %zu/%zu for %u ms, dropping rest of batch",
+                         i + 1, frames.size(), waitMs);
+                success = false;
+                break;
+            }
+            if (waitMs > 0) {
+                LOG_INFO("Fragment %zu/%zu waits %u ms for duty cycle",
+                         i + 1, frames.size(), waitMs);
+                hal::delay_ms(waitMs);
+            }
+        }
+
+        bool sent = hal::lora::send(
+            port,
+            payload.data(),
+            payload.size(),
+            LORAWAN_CONFIRMED_UPLINKS
+        );
+
+        if (!sent && port == LORAWAN_FRAGMENT_PORT) {
+            LOG_WARN("Fragment %zu/%zu failed, dropping rest of batch", i + 1, frames.size());
+            success = false;
+            break;
+        } else if (!sent) {
+            LOG_WARN("Batch transmission failed (%zu bytes), queueing for retry",
+                     payload.size());
+            queueForRetry(payload, port, LORAWAN_CONFIRMED_UPLINKS);
+            success = false;
+        } else if (getFrameCounter() % 10 == 0) {
+            // Save frame counter periodically
             credManager_.saveFrameCounters();
         }
     }
@@ -224,95 +253,73 @@ size_t LoRaConnection::getPendingCount() const {
     return txQueue_.size();
 }
 
-// ============================================================
-// PAYLOAD ENCODING
-// ============================================================
+bool LoRaConnection::sendAggregatedFrame(const std::vector<uint8_t>& frame) {
+    if (!isConnected()) {
+        LOG_ERROR("Cannot send: not connected");
+        return false;
+    }
 
-std::vector<uint8_t> LoRaConnection::encodeReading(const Reading& reading) {
-    // myIoTGrid LoRa Payload Format:
-    // [TypeID:1 byte][Value:2 bytes (int16, 2 decimal places)]
-    // Total: 3 bytes per sensor
+    if (frame.empty()) {
+        LOG_WARN("No aggregated samples to send");
+        return true;
+    }
 
-    std::vector<uint8_t> payload;
+    LOG_INFO("Sending aggregated frame (%u samples, %zu bytes)",
+             frame[0], frame.size());
 
-    uint8_t typeId = getSensorTypeId(reading.type);
+    bool success = hal::lora::send(
+        LORAWAN_AGGREGATED_PORT,
+        frame.data(),
+        frame.size(),
+        LORAWAN_CONFIRMED_UPLINKS
+    );
 
-    // Convert value to int16 with 2 decimal places
-    // Special handling for pressure (use 1 decimal place due to larger values)
-    int16_t encodedValue;
-    if (reading.type == "pressure") {
-        encodedValue = static_cast<int16_t>(reading.value * 10);  // 1 decimal
-    } else {
-        encodedValue = static_cast<int16_t>(reading.value * 100); // 2 decimals
+    if (success && getFrameCounter() % 10 == 0) {
+        credManager_.saveFrameCounters();
     }
 
-    payload.push_back(typeId);
-    payload.push_back((encodedValue >> 8) & 0xFF);  // High byte (MSB)
-    payload.push_back(encodedValue & 0xFF);          // Low byte (LSB)
-
-    return payload;
+    return success;
 }
 
-std::vector<uint8_t> LoRaConnection::encodeBatch(const std::vector<Reading>& readings) {
-    // Multiple readings concatenated
-    // Max ~51 bytes for EU868 DR0 (SF12)
-    // 3 bytes per sensor = max 17 sensors
+bool LoRaConnection::sendDiagnostics(const std::vector<uint8_t>& frame) {
+    if (!isConnected()) {
+        LOG_ERROR("Cannot send: not connected");
+        return false;
+    }
 
-    std::vector<uint8_t> payload;
+    if (frame.empty()) return true;
 
-    for (const auto& reading : readings) {
-        auto encoded = encodeReading(reading);
-        payload.insert(payload.end(), encoded.begin(), encoded.end());
+    LOG_INFO("Sending energy diagnostics (%zu bytes)", frame.size());
 
-        // Safety limit (leave room for overhead)
-        if (payload.size() >= MAX_PAYLOAD_SIZE - 3) {
-            LOG_WARN("Payload size limit reached, truncating batch");
-            break;
-        }
-    }
-
-    return payload;
+    return hal::lora::send(
+        LORAWAN_DIAG_PORT,
+        frame.data(),
+        frame.size(),
+        false
+    );
 }
 
-uint8_t LoRaConnection::getSensorTypeId(const std::string& type) {
-    if (type == "temperature")   return SensorTypeId::TEMPERATURE;
-    if (type == "humidity")      return SensorTypeId::HUMIDITY;
-    if (type == "pressure")      return SensorTypeId::PRESSURE;
-    if (type == "water_level")   return SensorTypeId::WATER_LEVEL;
-    if (type == "battery")       return SensorTypeId::BATTERY;
-    if (type == "co2")           return SensorTypeId::CO2;
-    if (type == "pm25")          return SensorTypeId::PM25;
-    if (type == "pm10")          return SensorTypeId::PM10;
-    if (type == "light")         return SensorTypeId::LIGHT;
-    if (type == "uv")            return SensorTypeId::UV;
-    if (type == "soil_moisture") return SensorTypeId::SOIL_MOISTURE;
-    if (type == "wind_speed")    return SensorTypeId::WIND_SPEED;
-    if (type == "rainfall")      return SensorTypeId::RAINFALL;
-    if (type == "rssi")          return SensorTypeId::RSSI;
-    if (type == "snr")           return SensorTypeId::SNR;
-
-    return SensorTypeId::UNKNOWN;
-}
+// ============================================================
+// PAYLOAD ENCODING
+// ============================================================
+
+// Frame encoding without radio access: lora_payload.cpp
 
-std::string LoRaConnection::getSensorTypeString(uint8_t typeId) {
-    switch (typeId) {
-        case SensorTypeId::TEMPERATURE:   return "temperature";
-        case SensorTypeId::HUMIDITY:      return "humidity";
-        case SensorTypeId::PRESSURE:      return "pressure";
-        case SensorTypeId::WATER_LEVEL:   return "water_level";
-        case SensorTypeId::BATTERY:       return "battery";
-        case SensorTypeId::CO2:           return "co2";
-        case SensorTypeId::PM25:          return "pm25";
-        case SensorTypeId::PM10:          return "pm10";
-        case SensorTypeId::LIGHT:         return "light";
-        case SensorTypeId::UV:            return "uv";
-        case SensorTypeId::SOIL_MOISTURE: return "soil_moisture";
-        case SensorTypeId::WIND_SPEED:    return "wind_speed";
-        case SensorTypeId::RAINFALL:      return "rainfall";
-        case SensorTypeId::RSSI:          return "rssi";
-        case SensorTypeId::SNR:           return "snr";
-        default:                          return "unknown";
+std::vector<std::vector<uint8_t>> LoRaConnection::encodeBatch(const std::vector<Reading>& readings) {
+    size_t maxPayload = maxPayloadForUplink(hal::lora::get_data_rate(), hal::lora::get_adr());
+
+    size_t maxFrames = framesWithinDutyCycle(
+        hal::lora::get_time_on_air(maxPayload),
+        hal::lora::DutyCycleLedger::getDutyCycleDivisor(hal::lora::EU868_DEFAULT_CHANNEL_HZ));
+
+    auto frames = encodeFrames(readings, maxPayload, nextBatchId_, maxFrames);
+    if (frames.size() > 1) {
+        LOG_INFO("Batch exceeds %zu bytes, split into %zu fragments (batch %u)",
+                 maxPayload, frames.size(), nextBatchId_);
+        nextBatchId_++;
     }
+
+    return frames;
 }
 
 // ============================================================
@@ -15,6 +15,7 @@
 
 #include "connection_interface.h"
 #include "lora_credentials.h"
+#include "config.h"
 
 #include <queue>
 #include <array>
@@ -107,17 +108,26 @@ public:
      */
     size_t getPendingCount() const;
 
-private:
-    CredentialManager credManager_;
-    ConfigCallback configCallback_;
-    bool joined_ = false;
-
-    // Retry queue
-    std::queue<PendingTx> txQueue_;
-    static constexpr uint8_t MAX_RETRIES = 3;
-    static constexpr size_t MAX_QUEUE_SIZE = 10;
+    /**
+     * @brief Send an aggregated multi-sample frame
+     *
+     * Frames are not queued for retry: the caller keeps the samples
+     * in the FrameAggregator until the send succeeds.
+     *
+     * @param frame Frame built by FrameAggregator::buildFrame()
+     * @return true if sent successfully
+     */
+    bool sendAggregatedFrame(const std::vector<uint8_t>& frame);
 
-    // === Payload Encoding ===
+    /**
+     * @brief Send an energy diagnostic frame
+     *
+     * Best effort, not queued for retry.
+     *
+     * @param frame Frame built by EnergyProfiler::buildDiagnosticFrame()
+     * @return true if sent successfully
+     */
+    bool sendDiagnostics(const std::vector<uint8_t>& frame);
 
     /**
      * @brief Encode single reading to binary payload
@@ -128,17 +138,66 @@ private:
      * @param reading Reading to encode
      * @return Encoded payload bytes
      */
-    std::vector<uint8_t> encodeReading(const Reading& reading);
+    static std::vector<uint8_t> encodeReading(const Reading& reading);
 
     /**
-     * @brief Encode multiple readings to binary payload
+     * @brief Encode readings into frames of at most maxPayload bytes
      *
-     * Concatenates encoded readings up to MAX_PAYLOAD_SIZE.
+     * If all readings fit into one frame, a single frame without header
+     * is returned (sent on LORAWAN_SENSOR_PORT). Otherwise the readings
+     * are split at reading boundaries into fragments (LORAWAN_FRAGMENT_PORT):
+     *   [BatchId:1][Index:4 Bit | Total:4 Bit][N × Reading:3]
+     * The gateway groups fragments by BatchId and orders them by Index.
+     * Readings beyond maxFrames frames (at most MAX_FRAGMENTS) are dropped;
+     * with maxFrames = 1 the first readings go out as one plain frame.
      *
      * @param readings Readings to encode
-     * @return Encoded payload bytes
+     * @param maxPayload Maximum application payload in bytes
+     * @param batchId Identifier shared by all fragments of this batch
+     * @param maxFrames Maximum number of frames (duty cycle budget)
+     * @return Encoded frames
+     */
+    static std::vector<std::vector<uint8_t>> encodeFrames(
+        const std::vector<Reading>& readings, size_t maxPayload, uint8_t batchId,
+        size_t maxFrames = MAX_FRAGMENTS);
+
+    /**
+     * @brief Number of frames the duty cycle allows in one TX window
+     *
+     * After each frame the sub-band is blocked for its off-time; frames
+     * are only planned as long as the accumulated wait stays within
+     * FRAGMENT_MAX_WAIT_MS.
+     *
+     * @param frameAirtimeMs Time-on-air of one full frame
+     * @param dutyCycleDivisor Sub-band duty cycle divisor (1% = 100)
+     * @return Frame count (1 to MAX_FRAGMENTS)
+     */
+    static size_t framesWithinDutyCycle(uint32_t frameAirtimeMs, uint16_t dutyCycleDivisor);
+
+private:
+    CredentialManager credManager_;
+    ConfigCallback configCallback_;
+    bool joined_ = false;
+    uint8_t nextBatchId_ = 0;
+
+    // Retry queue
+    std::queue<PendingTx> txQueue_;
+    static constexpr uint8_t MAX_RETRIES = 3;
+    static constexpr size_t MAX_QUEUE_SIZE = 10;
+
+    // === Payload Encoding ===
+
+    /**
+     * @brief Encode multiple readings for the current data rate
+     *
+     * Sizes frames via maxPayloadForUplink() (DR0 limit while ADR is
+     * enabled) and splits the batch into as many fragments as the
+     * duty cycle allows within FRAGMENT_MAX_WAIT_MS.
+     *
+     * @param readings Readings to encode
+     * @return One unfragmented frame, or sequenced fragments
      */
-    std::vector<uint8_t> encodeBatch(const std::vector<Reading>& readings);
+    std::vector<std::vector<uint8_t>> encodeBatch(const std::vector<Reading>& readings);
 
     /**
      * @brief Get sensor type ID for payload encoding
@@ -0,0 +1,154 @@
+/**
+ * @file lora_payload.cpp
+ * @brief LoRaWAN Payload Encoding
+ *
+ * @version 1.0.0
+ * @date 2025-12-17
+ *
+ * Static encoders of LoRaConnection. Kept apart from the radio code so
+ * the native tests link them without the HAL.
+ *
+ * Sprint: LoRa-02 - Grid.Sensor LoRaWAN Firmware
+ */
+
+#include "lora_connection.h"
+#include "config.h"
+
+#include <algorithm>
+
+// ============================================================
+// PAYLOAD ENCODING
+// ============================================================
+
+std::vector<uint8_t> LoRaConnection::encodeReading(const Reading& reading) {
+    // myIoTGrid LoRa Payload Format:
+    // [TypeID:1 byte][Value:2 bytes (int16, 2 decimal places)]
+    // Total: 3 bytes per sensor
+
+    std::vector<uint8_t> payload;
+
+    uint8_t typeId = getSensorTypeId(reading.type);
+
+    // Convert value to int16 with 2 decimal places
+    // Special handling for pressure (use 1 decimal place due to larger values)
+    int16_t encodedValue;
+    if (reading.type == "pressure") {
+        encodedValue = static_cast<int16_t>(reading.value * 10);  // 1 decimal
+    } else {
+        encodedValue = static_cast<int16_t>(reading.value * 100); // 2 decimals
+    }
+
+    payload.push_back(typeId);
+    payload.push_back((encodedValue >> 8) & 0xFF);  // High byte (MSB)
+    payload.push_back(encodedValue & 0xFF);          // Low byte (LSB)
+
+    return payload;
+}
+
+std::vector<std::vector<uint8_t>> LoRaConnection::encodeFrames(
+    const std::vector<Reading>& readings, size_t maxPayload, uint8_t batchId,
+    size_t maxFrames) {
+    // Multiple readings concatenated, 3 bytes per sensor
+    // EU868: 17 readings at DR0-2 (51 bytes), 80 readings at DR4+ (242 bytes)
+
+    constexpr size_t READING_SIZE = 3;
+    std::vector<std::vector<uint8_t>> frames;
+
+    if (readings.empty()) return frames;
+
+    size_t frameLimit = std::min<size_t>(maxFrames, MAX_FRAGMENTS);
+
+    // Everything fits (or only one frame allowed): plain frame without fragment header
+    if (readings.size() * READING_SIZE <= maxPayload || frameLimit <= 1) {
+        size_t count = std::min(readings.size(), maxPayload / READING_SIZE);
+        if (count < readings.size()) {
+            LOG_WARN("Duty cycle allows one frame, dropping %zu of %zu readings",
+                     readings.size() - count, readings.size());
+        }
+
+        std::vector<uint8_t> payload;
+        payload.reserve(count * READING_SIZE);
+        for (size_t i = 0; i < count; i++) {
+            auto encoded = encodeReading(readings[i]);
+            payload.insert(payload.end(), encoded.begin(), encoded.end());
+        }
+        frames.push_back(std::move(payload));
+        return frames;
+    }
+
+    size_t perFragment = (maxPayload - FRAGMENT_HEADER_SIZE) / READING_SIZE;
+    size_t total = (readings.size() + perFragment - 1) / perFragment;
+
+    if (total > frameLimit) {
+        LOG_WARN("Batch needs %zu fragments, dropping readings beyond %zu",
+                 total, frameLimit);
+        total = frameLimit;
+    }
+
+    for (size_t index = 0; index < total; index++) {
+        std::vector<uint8_t> payload;
+        payload.push_back(batchId);
+        payload.push_back(static_cast<uint8_t>((index << 4) | total));
+
+        size_t first = index * perFragment;
+        size_t last = std::min(first + perFragment, readings.size());
+        for (size_t i = first; i < last; i++) {
+            auto encoded = encodeReading(readings[i]);
+            payload.insert(payload.end(), encoded.begin(), encoded.end());
+        }
+
+        frames.push_back(std::move(payload));
+    }
+
+    return frames;
+}
+
+size_t LoRaConnection::framesWithinDutyCycle(uint32_t frameAirtimeMs, uint16_t dutyCycleDivisor) {
+    if (dutyCycleDivisor <= 1 || frameAirtimeMs == 0) return MAX_FRAGMENTS;
+
+    uint32_t offTimeMs = frameAirtimeMs * (dutyCycleDivisor - 1);
+    size_t frames = 1 + FRAGMENT_MAX_WAIT_MS / offTimeMs;
+
+    return std::min<size_t>(frames, MAX_FRAGMENTS);
+}
+
+uint8_t LoRaConnection::getSensorTypeId(const std::string& type) {
+    if (type == "temperature")   return SensorTypeId::TEMPERATURE;
+    if (type == "humidity")      return SensorTypeId::HUMIDITY;
+    if (type == "pressure")      return SensorTypeId::PRESSURE;
+    if (type == "water_level")   return SensorTypeId::WATER_LEVEL;
+    if (type == "battery")       return SensorTypeId::BATTERY;
+    if (type == "co2")           return SensorTypeId::CO2;
+    if (type == "pm25")          return SensorTypeId::PM25;
+    if (type == "pm10")          return SensorTypeId::PM10;
+    if (type == "light")         return SensorTypeId::LIGHT;
+    if (type == "uv")            return SensorTypeId::UV;
+    if (type == "soil_moisture") return SensorTypeId::SOIL_MOISTURE;
+    if (type == "wind_speed")    return SensorTypeId::WIND_SPEED;
+    if (type == "rainfall")      return SensorTypeId::RAINFALL;
+    if (type == "rssi")          return SensorTypeId::RSSI;
+    if (type == "snr")           return SensorTypeId::SNR;
+
+    return SensorTypeId::UNKNOWN;
+}
+
+std::string LoRaConnection::getSensorTypeString(uint8_t typeId) {
+    switch (typeId) {
+        case SensorTypeId::TEMPERATURE:   return "temperature";
+        case SensorTypeId::HUMIDITY:      return "humidity";
+        case SensorTypeId::PRESSURE:      return "pressure";
+        case SensorTypeId::WATER_LEVEL:   return "water_level";
+        case SensorTypeId::BATTERY:       return "battery";
+        case SensorTypeId::CO2:           return "co2";
+        case SensorTypeId::PM25:          return "pm25";
+        case SensorTypeId::PM10:          return "pm10";
+        case SensorTypeId::LIGHT:         return "light";
+        case SensorTypeId::UV:            return "uv";
+        case SensorTypeId::SOIL_MOISTURE: return "soil_moisture";
+        case SensorTypeId::WIND_SPEED:    return "wind_speed";
+        case SensorTypeId::RAINFALL:      return "rainfall";
+        case SensorTypeId::RSSI:          return "rssi";
+        case SensorTypeId::SNR:           return "snr";
+        default:                          return "unknown";
+    }
+}
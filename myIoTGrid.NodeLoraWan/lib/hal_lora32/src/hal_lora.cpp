@@ -14,11 +14,14 @@
 #include "hal/hal_lora.h"
 #include "hal/hal.h"
 #include "config.h"
+#include "lora_airtime.h"
 
 #include <Arduino.h>
 #include <SPI.h>
 #include <RadioLib.h>
 #include <Preferences.h>
+#include <esp_attr.h>
+#include <sys/time.h>
 
 // NVS storage for LoRaWAN session
 static Preferences loraPrefs;
@@ -55,6 +58,28 @@ static hal::lora::RxCallback rxCallback = nullptr;
 
 static int16_t lastRssi = 0;
 static int8_t lastSnr = 0;
+static uint8_t currentDataRate = LORAWAN_DEFAULT_DR;
+static bool adrEnabled = LORAWAN_ADR_ENABLED;
+
+// ============================================================
+// DUTY CYCLE LEDGER
+// ============================================================
+
+// Survives deep sleep, so off-times carry over to the next wake cycle
+RTC_DATA_ATTR static hal::lora::DutyCycleState dutyCycleState;
+static hal::lora::DutyCycleLedger dutyCycle(dutyCycleState);
+
+/**
+ * @brief Millisecond clock for the ledger
+ *
+ * Based on the RTC (gettimeofday), which keeps counting in deep sleep,
+ * unlike millis().
+ */
+static uint64_t dutyCycleNowMs() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return static_cast<uint64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+}
 
 namespace hal {
 namespace lora {
@@ -126,6 +151,8 @@ bool init() {
 
     LOG_INFO("Initializing LoRa radio (SX1262)...");
 
+    dutyCycle.begin();
+
     // Initialize radio - exactly like official example
     int16_t state = radio.begin();
     if (state != RADIOLIB_ERR_NONE) {
@@ -349,6 +376,20 @@ bool join_otaa(
     // For LoRaWAN 1.0.x: pass appKey as BOTH nwkKey and appKey (they are the same in 1.0.x)
     node->beginOTAA(appEui64, devEui64, (uint8_t*)appKey, (uint8_t*)appKey);
 
+    uint32_t waitMs = dutyCycle.timeUntilAvailable(EU868_DEFAULT_CHANNEL_HZ, dutyCycleNowMs());
+    if (waitMs > 0) {
+        currentJoinStatus = JoinStatus::NOT_JOINED;
+        lastError = LoRaError::DUTY_CYCLE_LIMITED;
+        LOG_WARN("Join deferred: duty cycle, next TX in %u ms", waitMs);
+        if (joinCallback) joinCallback(false, lastError);
+        return false;
+    }
+
+    // JoinRequest is sent on one of the default channels
+    dutyCycle.recordTransmission(EU868_DEFAULT_CHANNEL_HZ,
+        time_on_air_ms(modulation_for_dr(currentDataRate), LORAWAN_JOIN_REQUEST_BYTES),
+        dutyCycleNowMs());
+
     // Attempt OTAA join - activateOTAA returns the state
     int16_t state = node->activateOTAA();
 
@@ -448,6 +489,14 @@ bool send(
         return false;
     }
 
+    uint32_t waitMs = get_time_until_tx();
+    if (waitMs > 0) {
+        lastError = LoRaError::DUTY_CYCLE_LIMITED;
+        LOG_WARN("Cannot send: duty cycle, next TX in %u ms", waitMs);
+        if (callback) callback(false, lastError);
+        return false;
+    }
+
     // Wake radio if sleeping
     if (radioSleeping) {
         wake();
@@ -481,6 +530,16 @@ bool send(
         state = node->uplink((uint8_t*)data, len, port);
     }
 
+    // Charge the airtime RadioLib measured at the DR actually used (ADR may
+    // have lowered it); without a measurement assume the worst case.
+    // RadioLib picks one of the default channels, which all share
+    // the 868.0-868.6 MHz sub-band
+    uint32_t airtimeMs = node->getLastToA();
+    if (airtimeMs == 0) {
+        airtimeMs = get_time_on_air(len);
+    }
+    dutyCycle.recordTransmission(EU868_DEFAULT_CHANNEL_HZ, airtimeMs, dutyCycleNowMs());
+
     if (state == RADIOLIB_ERR_NONE || state == RADIOLIB_LORAWAN_NO_DOWNLINK) {
         currentTxStatus = TxStatus::TX_COMPLETE;
         lastError = LoRaError::NONE;
@@ -513,15 +572,27 @@ TxStatus get_tx_status() {
 }
 
 bool is_tx_ready() {
-    return currentTxStatus == TxStatus::IDLE ||
-           currentTxStatus == TxStatus::TX_COMPLETE ||
-           currentTxStatus == TxStatus::TX_FAILED;
+    bool idle = currentTxStatus == TxStatus::IDLE ||
+                currentTxStatus == TxStatus::TX_COMPLETE ||
+                currentTxStatus == TxStatus::TX_FAILED;
+    return idle && get_time_until_tx() == 0;
 }
 
 uint32_t get_time_until_tx() {
-    // RadioLib handles duty cycle internally
-    // Return 0 for now (ready to transmit)
-    return 0;
+    return dutyCycle.timeUntilAvailable(EU868_DEFAULT_CHANNEL_HZ, dutyCycleNowMs());
+}
+
+// ============================================================
+// AIRTIME ACCOUNTING
+// ============================================================
+
+uint32_t get_time_on_air(size_t len) {
+    // With ADR the network may have lowered the DR; plan for DR0 (as maxPayloadForUplink())
+    return time_on_air_for_dr(adrEnabled ? 0 : currentDataRate, len);
+}
+
+uint32_t get_airtime_used() {
+    return dutyCycle.getTotalAirtimeMs();
 }
 
 // ============================================================
@@ -544,18 +615,20 @@ RxStatus check_rx() {
 void set_adr(bool enable) {
     if (node != nullptr) {
         node->setADR(enable);
+        adrEnabled = enable;
         LOG_INFO("ADR %s", enable ? "enabled" : "disabled");
     }
 }
 
 bool get_adr() {
-    // RadioLib doesn't expose ADR status directly
-    return LORAWAN_ADR_ENABLED;
+    // RadioLib doesn't expose ADR status directly, track the last one we set
+    return adrEnabled;
 }
 
 bool set_data_rate(uint8_t dr) {
     if (node != nullptr) {
         node->setDatarate(dr);
+        currentDataRate = dr;
         LOG_INFO("Data rate set to DR%d", dr);
         return true;
     }
@@ -563,8 +636,9 @@ bool set_data_rate(uint8_t dr) {
 }
 
 uint8_t get_data_rate() {
-    // RadioLib doesn't expose current DR directly
-    return LORAWAN_DEFAULT_DR;
+    // RadioLib doesn't expose current DR directly, track the last one we set.
+    // With ADR the network may have changed it since (see maxPayloadForUplink()).
+    return currentDataRate;
 }
 
 bool set_tx_power(int8_t power) {
@@ -596,13 +670,11 @@ int8_t get_last_snr() {
 }
 
 uint8_t get_spreading_factor() {
-    // Default SF7 for DR5
-    return 7;
+    return modulation_for_dr(currentDataRate).spreadingFactor;
 }
 
 float get_bandwidth() {
-    // EU868 uses 125 kHz bandwidth
-    return 125.0f;
+    return modulation_for_dr(currentDataRate).bandwidthKhz;
 }
 
 uint32_t get_frame_counter_up() {
@@ -663,6 +735,9 @@ void print_status() {
     LOG_INFO("Last RSSI: %d dBm", lastRssi);
     LOG_INFO("Last SNR: %d dB", lastSnr);
     LOG_INFO("Frame Counter Up: %u", get_frame_counter_up());
+    LOG_INFO("Airtime Used: %u ms (%u TX)", dutyCycle.getTotalAirtimeMs(),
+             dutyCycle.getTransmissionCount());
+    LOG_INFO("Next TX in: %u ms", get_time_until_tx());
     LOG_INFO("Free Heap: %u bytes", hal::get_free_heap());
     LOG_INFO("=========================");
 }
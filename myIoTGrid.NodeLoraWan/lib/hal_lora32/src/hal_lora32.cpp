@@ -18,6 +18,7 @@
 #include <esp_system.h>
 #include <esp_sleep.h>
 #include <WiFi.h>
+#include <ctime>
 
 // Preferences instance for NVS
 static Preferences preferences;
@@ -50,6 +51,12 @@ uint32_t timestamp() {
     return ::millis() / 1000;
 }
 
+uint32_t wall_clock() {
+    // RTC-backed system time: keeps running through deep sleep.
+    // Counts seconds since power-on until set via NTP/downlink.
+    return static_cast<uint32_t>(time(nullptr));
+}
+
 // ============================================================
 // NON-VOLATILE STORAGE
 // ============================================================
@@ -10,9 +10,11 @@
 
 #include "hal/hal_lora.h"
 #include "hal/hal.h"
+#include "lora_airtime.h"
 
 #include <iostream>
 #include <cstring>
+#include <chrono>
 
 // ============================================================
 // STATE VARIABLES
@@ -37,6 +39,19 @@ static bool adrEnabled = true;
 static uint8_t currentDataRate = 5;
 static int8_t currentTxPower = 14;
 
+// ============================================================
+// DUTY CYCLE LEDGER
+// ============================================================
+
+// Same rules as the hardware HAL, so simulated fleets see real capacity
+static hal::lora::DutyCycleState dutyCycleState;
+static hal::lora::DutyCycleLedger dutyCycle(dutyCycleState);
+
+static uint64_t dutyCycleNowMs() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
 namespace hal {
 namespace lora {
 
@@ -84,6 +99,8 @@ bool init() {
         return true;
     }
 
+    dutyCycle.begin();
+
     std::cout << "[SIM] LoRa radio initialized (simulated)" << std::endl;
     radioInitialized = true;
     radioSleeping = false;
@@ -123,6 +140,19 @@ bool join_otaa(
     for (int i = 0; i < 8; i++) std::cout << std::hex << (int)devEui[i];
     std::cout << std::dec << std::endl;
 
+    uint32_t waitMs = dutyCycle.timeUntilAvailable(EU868_DEFAULT_CHANNEL_HZ, dutyCycleNowMs());
+    if (waitMs > 0) {
+        currentJoinStatus = JoinStatus::NOT_JOINED;
+        lastError = LoRaError::DUTY_CYCLE_LIMITED;
+        std::cout << "[SIM] Join deferred: duty cycle, next TX in " << waitMs << " ms" << std::endl;
+        if (joinCallback) joinCallback(false, lastError);
+        return false;
+    }
+
+    dutyCycle.recordTransmission(EU868_DEFAULT_CHANNEL_HZ,
+        time_on_air_ms(modulation_for_dr(currentDataRate), LORAWAN_JOIN_REQUEST_BYTES),
+        dutyCycleNowMs());
+
     // Simulate successful join
     hal::delay_ms(100);  // Simulate join delay
 
@@ -182,12 +212,25 @@ bool send(
         return false;
     }
 
+    uint32_t waitMs = get_time_until_tx();
+    if (waitMs > 0) {
+        lastError = LoRaError::DUTY_CYCLE_LIMITED;
+        std::cout << "[SIM] Uplink rejected: duty cycle, next TX in " << waitMs << " ms" << std::endl;
+        if (callback) callback(false, lastError);
+        return false;
+    }
+
     txCallback = callback;
     currentTxStatus = TxStatus::TRANSMITTING;
 
+    // The simulated network never changes the DR
+    uint32_t airtimeMs = time_on_air_for_dr(currentDataRate, len);
+    dutyCycle.recordTransmission(EU868_DEFAULT_CHANNEL_HZ, airtimeMs, dutyCycleNowMs());
+
     std::cout << "[SIM] Sending uplink (port " << (int)port
               << ", " << len << " bytes, "
-              << (confirmed ? "confirmed" : "unconfirmed") << ")" << std::endl;
+              << (confirmed ? "confirmed" : "unconfirmed")
+              << ", airtime " << airtimeMs << " ms)" << std::endl;
 
     // Print payload
     std::cout << "[SIM] Payload: ";
@@ -197,7 +240,7 @@ bool send(
     std::cout << std::endl;
 
     // Simulate transmission
-    hal::delay_ms(50);
+    hal::delay_ms(airtimeMs);
 
     frameCounterUp++;
     currentTxStatus = TxStatus::TX_COMPLETE;
@@ -222,13 +265,27 @@ TxStatus get_tx_status() {
 }
 
 bool is_tx_ready() {
-    return currentTxStatus == TxStatus::IDLE ||
-           currentTxStatus == TxStatus::TX_COMPLETE ||
-           currentTxStatus == TxStatus::TX_FAILED;
+    bool idle = currentTxStatus == TxStatus::IDLE ||
+                currentTxStatus == TxStatus::TX_COMPLETE ||
+                currentTxStatus == TxStatus::TX_FAILED;
+    return idle && get_time_until_tx() == 0;
 }
 
 uint32_t get_time_until_tx() {
-    return 0;
+    return dutyCycle.timeUntilAvailable(EU868_DEFAULT_CHANNEL_HZ, dutyCycleNowMs());
+}
+
+// ============================================================
+// AIRTIME ACCOUNTING
+// ============================================================
+
+uint32_t get_time_on_air(size_t len) {
+    // Same worst case as the hardware HAL under ADR
+    return time_on_air_for_dr(adrEnabled ? 0 : currentDataRate, len);
+}
+
+uint32_t get_airtime_used() {
+    return dutyCycle.getTotalAirtimeMs();
 }
 
 // ============================================================
@@ -289,12 +346,11 @@ int8_t get_last_snr() {
 }
 
 uint8_t get_spreading_factor() {
-    // DR5 = SF7 for EU868
-    return 12 - currentDataRate;
+    return modulation_for_dr(currentDataRate).spreadingFactor;
 }
 
 float get_bandwidth() {
-    return 125.0f;
+    return modulation_for_dr(currentDataRate).bandwidthKhz;
 }
 
 uint32_t get_frame_counter_up() {
@@ -344,6 +400,9 @@ void print_status() {
     std::cout << "Last RSSI: " << lastRssi << " dBm" << std::endl;
     std::cout << "Last SNR: " << (int)lastSnr << " dB" << std::endl;
     std::cout << "Frame Counter Up: " << frameCounterUp << std::endl;
+    std::cout << "Airtime Used: " << dutyCycle.getTotalAirtimeMs() << " ms ("
+              << dutyCycle.getTransmissionCount() << " TX)" << std::endl;
+    std::cout << "Next TX in: " << get_time_until_tx() << " ms" << std::endl;
     std::cout << "======================================" << std::endl;
 }
 
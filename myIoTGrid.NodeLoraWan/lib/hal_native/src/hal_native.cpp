@@ -56,6 +56,10 @@ uint32_t timestamp() {
     ).count();
 }
 
+uint32_t wall_clock() {
+    return timestamp();
+}
+
 // ============================================================
 // NON-VOLATILE STORAGE (Simulated)
 // ============================================================
@@ -0,0 +1,153 @@
+/**
+ * @file lora_airtime.cpp
+ * @brief LoRa Time-on-Air Calculator and EU868 Duty Cycle Ledger
+ *
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * Sprint: LoRa-02 - Grid.Sensor LoRaWAN Firmware
+ */
+
+#include "lora_airtime.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace hal {
+namespace lora {
+
+// ============================================================
+// EU868 SUB-BANDS (ETSI EN 300 220-2)
+// ============================================================
+
+namespace {
+
+constexpr uint32_t DUTY_CYCLE_MAGIC = 0x44435931;  // "DCY1"
+
+struct SubBand {
+    uint32_t minHz;
+    uint32_t maxHz;
+    uint16_t divisor;   ///< 1 / duty cycle (1% = 100)
+};
+
+constexpr SubBand SUB_BANDS[DUTY_CYCLE_BAND_COUNT] = {
+    { 863000000, 865000000, 1000 },  // 0.1%
+    { 865000000, 868000000,  100 },  // 1%
+    { 868000000, 868600000,  100 },  // 1%   (default channels 868.1/.3/.5)
+    { 868700000, 869200000, 1000 },  // 0.1%
+    { 869400000, 869650000,   10 },  // 10%  (RX2 869.525)
+    { 869700000, 870000000,  100 },  // 1%
+};
+
+// FSK (DR7): 50 kbps, preamble 5 + sync 3 + length 1 + CRC 2 bytes
+constexpr uint32_t FSK_BITRATE_KBPS = 50;
+constexpr size_t FSK_OVERHEAD_BYTES = 11;
+
+} // namespace
+
+// ============================================================
+// TIME ON AIR
+// ============================================================
+
+uint32_t time_on_air_ms(const LoRaModulation& modulation, size_t phyPayloadLen) {
+    const int sf = modulation.spreadingFactor;
+    const int crc = modulation.crcEnabled ? 1 : 0;
+    const int ih = modulation.explicitHeader ? 0 : 1;
+    const int de = modulation.lowDataRateOptimize ? 1 : 0;
+
+    const double symbolMs = static_cast<double>(1u << sf) / modulation.bandwidthKhz;
+    const double preambleMs = (modulation.preambleSymbols + 4.25) * symbolMs;
+
+    const double numerator = 8.0 * phyPayloadLen - 4.0 * sf + 28 + 16 * crc - 20 * ih;
+    const double denominator = 4.0 * (sf - 2 * de);
+    double payloadSymbols = std::ceil(numerator / denominator) * (modulation.codingRate + 4);
+    if (payloadSymbols < 0) payloadSymbols = 0;
+    payloadSymbols += 8;
+
+    return static_cast<uint32_t>(std::ceil(preambleMs + payloadSymbols * symbolMs));
+}
+
+LoRaModulation modulation_for_dr(uint8_t dr) {
+    LoRaModulation mod;
+    mod.codingRate = 1;
+    mod.preambleSymbols = 8;
+    mod.explicitHeader = true;
+    mod.crcEnabled = true;
+
+    if (dr >= 6) {
+        mod.spreadingFactor = 7;
+        mod.bandwidthKhz = 250.0f;
+    } else {
+        mod.spreadingFactor = 12 - dr;
+        mod.bandwidthKhz = 125.0f;
+    }
+
+    // Symbol time >= 16 ms (SF11/SF12 @ 125 kHz)
+    mod.lowDataRateOptimize = (mod.spreadingFactor >= 11 && mod.bandwidthKhz <= 125.0f);
+    return mod;
+}
+
+uint32_t time_on_air_for_dr(uint8_t dr, size_t appPayloadLen) {
+    size_t phyLen = appPayloadLen + LORAWAN_OVERHEAD_BYTES;
+
+    if (dr == 7) {
+        uint32_t bits = static_cast<uint32_t>((phyLen + FSK_OVERHEAD_BYTES) * 8);
+        return (bits + FSK_BITRATE_KBPS - 1) / FSK_BITRATE_KBPS;
+    }
+
+    return time_on_air_ms(modulation_for_dr(dr), phyLen);
+}
+
+// ============================================================
+// DUTY CYCLE LEDGER
+// ============================================================
+
+void DutyCycleLedger::begin() {
+    if (state_.magic != DUTY_CYCLE_MAGIC) {
+        reset();
+    }
+}
+
+void DutyCycleLedger::reset() {
+    memset(&state_, 0, sizeof(state_));
+    state_.magic = DUTY_CYCLE_MAGIC;
+}
+
+void DutyCycleLedger::recordTransmission(uint32_t frequencyHz, uint32_t airtimeMs, uint64_t nowMs) {
+    state_.totalAirtimeMs += airtimeMs;
+    state_.transmissions++;
+
+    int band = findBand(frequencyHz);
+    if (band < 0) return;
+
+    // Off-time starts after TX: now + airtime + airtime × (divisor − 1)
+    state_.bandAvailableAtMs[band] = nowMs + static_cast<uint64_t>(airtimeMs) * SUB_BANDS[band].divisor;
+}
+
+uint32_t DutyCycleLedger::timeUntilAvailable(uint32_t frequencyHz, uint64_t nowMs) const {
+    int band = findBand(frequencyHz);
+    if (band < 0) return 0;
+
+    uint64_t availableAt = state_.bandAvailableAtMs[band];
+    if (availableAt <= nowMs) return 0;
+
+    uint64_t wait = availableAt - nowMs;
+    return wait > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(wait);
+}
+
+uint16_t DutyCycleLedger::getDutyCycleDivisor(uint32_t frequencyHz) {
+    int band = findBand(frequencyHz);
+    return band < 0 ? 0 : SUB_BANDS[band].divisor;
+}
+
+int DutyCycleLedger::findBand(uint32_t frequencyHz) {
+    for (size_t i = 0; i < DUTY_CYCLE_BAND_COUNT; i++) {
+        if (frequencyHz >= SUB_BANDS[i].minHz && frequencyHz < SUB_BANDS[i].maxHz) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+} // namespace lora
+} // namespace hal
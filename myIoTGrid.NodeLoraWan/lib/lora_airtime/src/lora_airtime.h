@@ -0,0 +1,160 @@
+/**
+ * @file lora_airtime.h
+ * @brief LoRa Time-on-Air Calculator and EU868 Duty Cycle Ledger
+ *
+ * Platform-independent part of the LoRa HAL. Shared by hal_lora32
+ * (RadioLib) and hal_native (simulator) so both enforce the same
+ * regulatory limits.
+ *
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * Sprint: LoRa-02 - Grid.Sensor LoRaWAN Firmware
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace hal {
+namespace lora {
+
+// ============================================================
+// TIME ON AIR
+// ============================================================
+
+/// LoRaWAN PHY overhead: MHDR(1) + FHDR(7) + FPort(1) + MIC(4)
+constexpr size_t LORAWAN_OVERHEAD_BYTES = 13;
+
+/// PHY payload size of a JoinRequest
+constexpr size_t LORAWAN_JOIN_REQUEST_BYTES = 23;
+
+/**
+ * @brief LoRa modulation parameters
+ */
+struct LoRaModulation {
+    uint8_t spreadingFactor;    ///< SF7-SF12
+    float bandwidthKhz;         ///< 125, 250 or 500 kHz
+    uint8_t codingRate;         ///< 1-4 (4/5 - 4/8)
+    uint16_t preambleSymbols;   ///< LoRaWAN: 8
+    bool explicitHeader;        ///< LoRaWAN: true
+    bool crcEnabled;            ///< LoRaWAN uplink: true
+    bool lowDataRateOptimize;   ///< Required if symbol time >= 16 ms
+};
+
+/**
+ * @brief Calculate LoRa time-on-air (Semtech AN1200.13)
+ * @param modulation Modulation parameters
+ * @param phyPayloadLen PHY payload length in bytes
+ * @return Airtime in milliseconds (rounded up)
+ */
+uint32_t time_on_air_ms(const LoRaModulation& modulation, size_t phyPayloadLen);
+
+/**
+ * @brief Get EU868 modulation for a data rate
+ * @param dr Data rate (0-6, DR7 is FSK)
+ * @return LoRa modulation parameters
+ */
+LoRaModulation modulation_for_dr(uint8_t dr);
+
+/**
+ * @brief Calculate uplink time-on-air for an EU868 data rate
+ *
+ * Adds the LoRaWAN overhead to the application payload.
+ * DR7 (FSK 50 kbps) is handled separately.
+ *
+ * @param dr Data rate (0-7)
+ * @param appPayloadLen Application payload length in bytes
+ * @return Airtime in milliseconds
+ */
+uint32_t time_on_air_for_dr(uint8_t dr, size_t appPayloadLen);
+
+// ============================================================
+// DUTY CYCLE LEDGER
+// ============================================================
+
+/// Number of EU868 sub-bands tracked (ETSI EN 300 220)
+constexpr size_t DUTY_CYCLE_BAND_COUNT = 6;
+
+/// Default EU868 uplink channel (all 3 default channels share a sub-band)
+constexpr uint32_t EU868_DEFAULT_CHANNEL_HZ = 868100000;
+
+/**
+ * @brief Persistent duty cycle state
+ *
+ * Plain struct without constructor so it can live in RTC memory
+ * and survive deep sleep.
+ */
+struct DutyCycleState {
+    uint32_t magic;
+    uint64_t bandAvailableAtMs[DUTY_CYCLE_BAND_COUNT];  ///< Off-time end per sub-band
+    uint32_t totalAirtimeMs;                            ///< Airtime since first boot
+    uint32_t transmissions;                             ///< Transmissions since first boot
+};
+
+/**
+ * @brief Per-sub-band duty cycle ledger
+ *
+ * After a transmission of T ms in a sub-band with duty cycle d,
+ * the sub-band is blocked for T × (1/d − 1) ms (ETSI off-time).
+ */
+class DutyCycleLedger {
+public:
+    /**
+     * @brief Bind ledger to persistent state
+     *
+     * Does not modify the state; call begin() once at startup.
+     *
+     * @param state State storage (e.g. RTC memory)
+     */
+    explicit DutyCycleLedger(DutyCycleState& state) : state_(state) {}
+
+    /**
+     * @brief Validate persisted state, reset after cold boot
+     */
+    void begin();
+
+    /**
+     * @brief Clear all off-times and counters
+     */
+    void reset();
+
+    /**
+     * @brief Account a transmission
+     * @param frequencyHz Channel frequency
+     * @param airtimeMs Time-on-air of the transmission
+     * @param nowMs Start of transmission (ms clock surviving deep sleep)
+     */
+    void recordTransmission(uint32_t frequencyHz, uint32_t airtimeMs, uint64_t nowMs);
+
+    /**
+     * @brief Get time until a channel may transmit again
+     * @param frequencyHz Channel frequency
+     * @param nowMs Current time
+     * @return Milliseconds until TX allowed, 0 if allowed now
+     */
+    uint32_t timeUntilAvailable(uint32_t frequencyHz, uint64_t nowMs) const;
+
+    /**
+     * @brief Get duty cycle divisor for a frequency (1% = 100)
+     * @param frequencyHz Channel frequency
+     * @return Divisor, 0 if outside EU868 sub-bands
+     */
+    static uint16_t getDutyCycleDivisor(uint32_t frequencyHz);
+
+    uint32_t getTotalAirtimeMs() const { return state_.totalAirtimeMs; }
+    uint32_t getTransmissionCount() const { return state_.transmissions; }
+
+private:
+    DutyCycleState& state_;
+
+    /**
+     * @brief Map frequency to sub-band index
+     * @return Index, or -1 if not in a known sub-band
+     */
+    static int findBand(uint32_t frequencyHz);
+};
+
+} // namespace lora
+} // namespace hal
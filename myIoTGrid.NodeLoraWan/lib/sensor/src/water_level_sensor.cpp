@@ -170,11 +170,11 @@ void WaterLevelSensor::addToFilter(float reading) {
 }
 
 float WaterLevelSensor::getMedian() {
-    // Copy to temporary array for sorting
-    std::array<float, FILTER_SIZE> sorted = readings_;
-
     // Determine how many valid readings we have
-    size_t count = filterFilled_ ? FILTER_SIZE : readingIndex_;
+    return median(readings_, filterFilled_ ? FILTER_SIZE : readingIndex_);
+}
+
+float WaterLevelSensor::median(std::array<float, FILTER_SIZE> sorted, size_t count) {
     if (count == 0) return 0.0f;
     if (count == 1) return sorted[0];
 
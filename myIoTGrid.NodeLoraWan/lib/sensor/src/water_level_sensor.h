@@ -105,6 +105,18 @@ public:
      */
     float getLastWaterLevel() const { return lastWaterLevel_; }
 
+    // === Median Filter ===
+
+    static constexpr size_t FILTER_SIZE = WATER_LEVEL_FILTER_SIZE;
+
+    /**
+     * @brief Median of the first count values
+     * @param sorted Copy of the filter buffer, sorted in place
+     * @param count Number of valid values (0 to FILTER_SIZE)
+     * @return Median, 0 if count is 0
+     */
+    static float median(std::array<float, FILTER_SIZE> sorted, size_t count);
+
 private:
     uint8_t triggerPin_;
     uint8_t echoPin_;
@@ -119,7 +131,6 @@ private:
     float lastWaterLevel_ = 0.0f;
 
     // Median filter
-    static constexpr size_t FILTER_SIZE = WATER_LEVEL_FILTER_SIZE;
     std::array<float, FILTER_SIZE> readings_;
     size_t readingIndex_ = 0;
     bool filterFilled_ = false;
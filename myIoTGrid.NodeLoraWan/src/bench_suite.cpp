@@ -0,0 +1,141 @@
+/**
+ * @file bench_suite.cpp
+ * @brief Native Benchmark Suite Implementation
+ *
+ * @version 1.0.0
+ * @date 2025-12-17
+ *
+ * Sprint: LoRa-02 - Grid.Sensor LoRaWAN Firmware
+ */
+
+#ifdef PLATFORM_NATIVE
+
+#include "bench_suite.h"
+#include "config.h"
+#include "lora_connection.h"
+#include "lora_airtime.h"
+#include "water_level_sensor.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+/**
+ * @brief One benchmark: a single operation of a hot path
+ */
+struct Benchmark {
+    const char* name;
+    double maxNsPerOp;          // Ceiling on a desktop-class host (~10x typical)
+    std::function<void()> op;
+};
+
+// Results of the benchmarked operations end up here so they are not optimized away
+volatile size_t sink = 0;
+
+double sampleNs(const std::function<void()>& op, uint64_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; i++) op();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count();
+}
+
+/**
+ * @brief Median ns/op of BENCH_SAMPLES calibrated samples
+ */
+double measure(const Benchmark& benchmark, uint64_t& iterations) {
+    // Warm up and find the iteration count for one sample
+    const double minSampleNs = BENCH_MIN_SAMPLE_MS * 1e6;
+    iterations = 1;
+    while (sampleNs(benchmark.op, iterations) < minSampleNs && iterations < (1ULL << 40)) {
+        iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        samples.push_back(sampleNs(benchmark.op, iterations) / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+std::vector<Reading> makeBatch(size_t count) {
+    const char* types[] = {"temperature", "humidity", "pressure", "water_level", "battery"};
+    std::vector<Reading> batch;
+    for (size_t i = 0; i < count; i++) {
+        batch.push_back({"", types[i % 5], 20.0f + i * 0.37f, "", 1733150400});
+    }
+    return batch;
+}
+
+} // namespace
+
+bool runSuite() {
+    // Fixtures shared by the benchmarks
+    const Reading reading = {"", "temperature", 21.44f, "°C", 1733150400};
+    const auto batch17 = makeBatch(17);     // Fills one DR0 frame
+    const auto batch40 = makeBatch(40);     // DR5 single frame, 3 DR0 fragments
+    const uint8_t maxPayloadDr0 = maxPayloadForDataRate(0);
+    const uint8_t maxPayloadDr5 = maxPayloadForDataRate(5);
+
+    std::array<float, WaterLevelSensor::FILTER_SIZE> distances = {142.5f, 139.0f, 187.3f, 140.1f, 141.7f};
+    size_t distanceIndex = 0;
+    uint8_t dataRate = 0;
+
+    const std::vector<Benchmark> benchmarks = {
+        {"payload.encodeReading", 1000, [&]() {
+            sink += LoRaConnection::encodeReading(reading).size();
+        }},
+        {"payload.encodeFrames.dr0.17", 25000, [&]() {
+            sink += LoRaConnection::encodeFrames(batch17, maxPayloadDr0, 1).size();
+        }},
+        {"payload.encodeFrames.dr5.40", 50000, [&]() {
+            sink += LoRaConnection::encodeFrames(batch40, maxPayloadDr5, 1).size();
+        }},
+        {"payload.encodeFrames.dr0.40", 50000, [&]() {
+            sink += LoRaConnection::encodeFrames(batch40, maxPayloadDr0, 1).size();
+        }},
+        {"payload.framesWithinDutyCycle", 100, [&]() {
+            sink += LoRaConnection::framesWithinDutyCycle(400 + (sink & 0xFF), 100);
+        }},
+        {"airtime.timeOnAirForDr", 200, [&]() {
+            dataRate = (dataRate + 1) % 8;
+            sink += hal::lora::time_on_air_for_dr(dataRate, maxPayloadDr0);
+        }},
+        {"waterLevel.median", 200, [&]() {
+            // Ring buffer as in the sensor: one new distance per read
+            distances[distanceIndex] += 0.1f;
+            distanceIndex = (distanceIndex + 1) % distances.size();
+            sink += static_cast<size_t>(WaterLevelSensor::median(distances, distances.size()));
+        }},
+    };
+
+    LOG_INFO("[Bench] %zu benchmarks, median of %d samples (>= %d ms each)",
+             benchmarks.size(), BENCH_SAMPLES, BENCH_MIN_SAMPLE_MS);
+    LOG_INFO("[Bench]   %-30s %12s %12s %12s  %s", "benchmark", "iterations", "ns/op", "ceiling", "status");
+
+    bool passed = true;
+    for (const Benchmark& benchmark : benchmarks) {
+        uint64_t iterations = 0;
+        double nsPerOp = measure(benchmark, iterations);
+        bool ok = nsPerOp <= benchmark.maxNsPerOp;
+        if (!ok) passed = false;
+
+        LOG_INFO("[Bench]   %-30s %12llu %12.1f %12.0f  %s", benchmark.name,
+                 static_cast<unsigned long long>(iterations), nsPerOp, benchmark.maxNsPerOp,
+                 ok ? "ok" : "ceiling");
+    }
+
+    LOG_INFO("[Bench] %s", passed ? "PASSED" : "FAILED (ceiling exceeded)");
+    return passed;
+}
+
+} // namespace bench
+
+#endif // PLATFORM_NATIVE
@@ -25,8 +25,11 @@
 #include "oled_display.h"
 #include "power_manager.h"
 #include "lora_connection.h"
+#include "frame_aggregator.h"
+#include "energy_profiler.h"
 #include "bme280_sensor.h"
 #include "water_level_sensor.h"
+#include "bench_suite.h"
 
 // ============================================================
 // GLOBAL INSTANCES
@@ -41,6 +44,8 @@ static WaterLevelSensor* waterSensor = nullptr;
 static uint32_t txIntervalSeconds = DEFAULT_TX_INTERVAL_SECONDS;
 static uint32_t lastTxTime = 0;
 static uint32_t joinAttempts = 0;
+static bool txDeferred = false;     // TX due but blocked by duty cycle
+static bool diagPending = false;    // Energy diagnostic uplink waiting for duty cycle
 static bool hasWaterSensor = false;
 
 // State
@@ -62,11 +67,14 @@ void initHardware();
 void initSensors();
 void initLoRa();
 void runStateMachine();
-void collectAndSendReadings();
+void collectAndSendReadings(bool forceSend = false);
+bool flushAggregatedFrame();
+void sendEnergyDiagnostics();
 void updateDisplay();
 void handleButton();
 void handleSerialCommands();
 void enterDeepSleep();
+uint32_t calculateSleepSeconds();
 
 // ============================================================
 // ARDUINO ENTRY POINTS
@@ -86,6 +94,7 @@ void setup() {
 
     // Check wake-up reason
     PowerManager::init();
+    EnergyProfiler::beginCycle(true);
     WakeReason wakeReason = PowerManager::getWakeReason();
 
     if (wakeReason == WakeReason::TIMER) {
@@ -104,10 +113,15 @@ void setup() {
     initHardware();
 
     // Initialize sensors
+    EnergyProfiler::beginPhase(PowerPhase::SENSOR);
     initSensors();
+    EnergyProfiler::endPhase();
 
     // Initialize LoRa
     initLoRa();
+
+    // Restore samples aggregated before deep sleep
+    FrameAggregator::init();
 }
 
 void loop() {
@@ -128,6 +142,7 @@ void loop() {
     // Process display auto-off
     if (display != nullptr) {
         display->process();
+        EnergyProfiler::setDisplayActive(display->isOn());
     }
 
     // Small delay to prevent watchdog issues
@@ -137,16 +152,25 @@ void loop() {
 #else // PLATFORM_NATIVE
 
 int main() {
+#ifdef NATIVE_BENCH
+    // Benchmark build: run the suite instead of the simulation
+    return bench::runSuite() ? 0 : 1;
+#endif
+
     LOG_INFO("=======================================");
     LOG_INFO("  myIoTGrid NodeLoraWan v%s (Native)", FIRMWARE_VERSION);
     LOG_INFO("  Simulation Mode");
     LOG_INFO("=======================================");
 
     PowerManager::init();
+    EnergyProfiler::beginCycle(true);
 
     initHardware();
+    EnergyProfiler::beginPhase(PowerPhase::SENSOR);
     initSensors();
+    EnergyProfiler::endPhase();
     initLoRa();
+    FrameAggregator::init();
 
     // Simple main loop for simulation
     for (int i = 0; i < 100; i++) {
@@ -157,6 +181,10 @@ int main() {
             loraConnection->process();
         }
 
+        if (display != nullptr) {
+            EnergyProfiler::setDisplayActive(display->isOn());
+        }
+
         hal::delay_ms(100);
     }
 
@@ -308,7 +336,10 @@ void runStateMachine() {
 
             LOG_INFO("OTAA join attempt %u...", joinAttempts);
 
+            EnergyProfiler::beginPhase(PowerPhase::JOIN);
+
             if (loraConnection->connect()) {
+                EnergyProfiler::endPhase();
                 LOG_INFO("Joined network successfully!");
                 currentState = NodeState::OPERATIONAL;
                 hal::digital_write(LED_PIN, false);
@@ -316,10 +347,17 @@ void runStateMachine() {
                 // Show status screen
                 updateDisplay();
 
-                // Send first reading immediately
-                collectAndSendReadings();
-                lastTxTime = hal::millis();
+                // Send first reading immediately (unless the JoinRequest
+                // used up the duty cycle; OPERATIONAL sends it once legal)
+                if (hal::lora::get_time_until_tx() == 0) {
+                    collectAndSendReadings();
+                    lastTxTime = hal::millis();
+                    diagPending = EnergyProfiler::isDiagnosticDue();
+                } else {
+                    lastTxTime = hal::millis() - txIntervalSeconds * 1000;
+                }
             } else {
+                EnergyProfiler::endPhase();
                 LOG_WARN("Join failed, retrying in %u seconds", JOIN_RETRY_INTERVAL_SECONDS);
 
                 if (joinAttempts >= MAX_JOIN_RETRIES) {
@@ -341,14 +379,49 @@ void runStateMachine() {
                 uint32_t now = hal::millis();
                 uint32_t elapsed = now - lastTxTime;
 
+                // Energy diagnostics go out once the band is free again
+                if (diagPending) {
+                    uint32_t diagWaitMs = hal::lora::get_time_until_tx();
+
+                    if (diagWaitMs == 0 || diagWaitMs > ENERGY_DIAG_MAX_WAIT_MS) {
+                        if (diagWaitMs == 0) {
+                            sendEnergyDiagnostics();
+                        } else {
+                            LOG_INFO("Energy diagnostics postponed (duty cycle %u ms)", diagWaitMs);
+                        }
+                        diagPending = false;
+
+                        if (DEEP_SLEEP_ENABLED) {
+                            currentState = NodeState::SLEEPING;
+                        }
+                    }
+                    break;
+                }
+
                 // Check if it's time to transmit
                 if (elapsed >= txIntervalSeconds * 1000) {
-                    collectAndSendReadings();
-                    lastTxTime = now;
-
-                    // If deep sleep is enabled, sleep between transmissions
-                    if (DEEP_SLEEP_ENABLED) {
-                        currentState = NodeState::SLEEPING;
+                    // Aggregation only samples most cycles, so it is not gated here
+                    uint32_t dutyCycleWaitMs = LORAWAN_AGGREGATION_ENABLED ?
+                                               0 : hal::lora::get_time_until_tx();
+
+                    if (dutyCycleWaitMs == 0) {
+                        collectAndSendReadings();
+                        lastTxTime = now;
+                        txDeferred = false;
+                        diagPending = EnergyProfiler::isDiagnosticDue();
+
+                        // If deep sleep is enabled, sleep between transmissions
+                        if (DEEP_SLEEP_ENABLED && !diagPending) {
+                            currentState = NodeState::SLEEPING;
+                        }
+                    } else if (!txDeferred) {
+                        LOG_INFO("Duty cycle limit: TX deferred by %u ms", dutyCycleWaitMs);
+                        txDeferred = true;
+
+                        // Sleep until TX is legal instead of waiting awake
+                        if (DEEP_SLEEP_ENABLED && dutyCycleWaitMs > MIN_DEEP_SLEEP_SECONDS * 1000) {
+                            currentState = NodeState::SLEEPING;
+                        }
                     }
                 }
 
@@ -387,10 +460,12 @@ void runStateMachine() {
 // SENSOR READING AND TRANSMISSION
 // ============================================================
 
-void collectAndSendReadings() {
+void collectAndSendReadings(bool forceSend) {
     LOG_INFO("Collecting sensor readings...");
+    EnergyProfiler::beginPhase(PowerPhase::SENSOR);
 
     std::vector<Reading> readings;
+    bool alarmActive = false;
 
     // Read BME280
     if (bmeSensor != nullptr && bmeSensor->isReady()) {
@@ -434,6 +509,7 @@ void collectAndSendReadings() {
         // Check alarm
         if (waterSensor->isAlarmActive()) {
             LOG_WARN("  WATER LEVEL ALARM! (>%.0f cm)", waterSensor->getAlarmLevel());
+            alarmActive = true;
         }
     }
 
@@ -452,6 +528,29 @@ void collectAndSendReadings() {
         LOG_WARN("  LOW BATTERY WARNING!");
     }
 
+    EnergyProfiler::endPhase();
+
+    if (LORAWAN_AGGREGATION_ENABLED) {
+        size_t budget = maxPayloadForUplink(hal::lora::get_data_rate(), hal::lora::get_adr());
+
+        // Send what we have if this sample would overflow the frame
+        if (!FrameAggregator::fits(readings.size(), budget)) {
+            flushAggregatedFrame();
+        }
+
+        FrameAggregator::addSample(readings, budget);
+
+        // Alarms and manual triggers must not wait for the frame to fill up
+        if (alarmActive || forceSend || FrameAggregator::shouldFlush(budget)) {
+            flushAggregatedFrame();
+        } else {
+            LOG_INFO("Sample aggregated (%u pending, %zu/%zu bytes)",
+                     FrameAggregator::getSampleCount(),
+                     FrameAggregator::getFrameSize(), budget);
+        }
+        return;
+    }
+
     // Show transmitting indicator
     if (display != nullptr) {
         display->showTransmitting(true);
@@ -461,7 +560,9 @@ void collectAndSendReadings() {
     // Send readings
     LOG_INFO("Sending %zu readings via LoRaWAN...", readings.size());
 
+    EnergyProfiler::beginPhase(PowerPhase::TX);
     bool success = loraConnection->sendBatch(readings);
+    EnergyProfiler::endPhase();
 
     hal::digital_write(LED_PIN, false);
     if (display != nullptr) {
@@ -478,6 +579,59 @@ void collectAndSendReadings() {
     }
 }
 
+bool flushAggregatedFrame() {
+    if (FrameAggregator::getSampleCount() == 0) return true;
+
+    if (!loraConnection->isConnected()) {
+        LOG_WARN("Not joined, keeping %u aggregated samples",
+                 FrameAggregator::getSampleCount());
+        return false;
+    }
+
+    auto frame = FrameAggregator::buildFrame();
+
+    if (display != nullptr) {
+        display->showTransmitting(true);
+    }
+    hal::digital_write(LED_PIN, true);
+
+    EnergyProfiler::beginPhase(PowerPhase::TX);
+    bool success = loraConnection->sendAggregatedFrame(frame);
+    EnergyProfiler::endPhase();
+
+    hal::digital_write(LED_PIN, false);
+    if (display != nullptr) {
+        display->showTransmitting(false);
+    }
+
+    if (success) {
+        LOG_INFO("Aggregated frame sent (%u samples, %zu bytes)",
+                 frame[0], frame.size());
+        LOG_INFO("  Frame counter: %u", loraConnection->getFrameCounter());
+        FrameAggregator::clear();
+    } else {
+        // Samples stay in RTC memory and go out with the next frame
+        LOG_ERROR("Failed to send aggregated frame, keeping samples");
+    }
+
+    return success;
+}
+
+void sendEnergyDiagnostics() {
+    auto frame = EnergyProfiler::buildDiagnosticFrame();
+    if (frame.empty()) return;
+
+    EnergyProfiler::beginPhase(PowerPhase::TX);
+    bool success = loraConnection->sendDiagnostics(frame);
+    EnergyProfiler::endPhase();
+
+    if (success) {
+        EnergyProfiler::markDiagnosticSent();
+    } else {
+        LOG_WARN("Failed to send energy diagnostics");
+    }
+}
+
 // ============================================================
 // DISPLAY UPDATE
 // ============================================================
@@ -552,7 +706,7 @@ void handleButton() {
         } else if (pressDuration >= 1000 && pressDuration < 5000) {
             // Medium press: force transmission
             LOG_INFO("Button medium press - forcing transmission");
-            collectAndSendReadings();
+            collectAndSendReadings(true);
             lastTxTime = hal::millis();
         } else if (pressDuration >= 5000) {
             // Long press: restart device
@@ -590,22 +744,52 @@ void enterDeepSleep() {
     // Turn off display
     if (display != nullptr) {
         display->turnOff();
+        EnergyProfiler::setDisplayActive(false);
     }
 
     // Put LoRa radio to sleep
     hal::lora::sleep();
 
     // Calculate sleep duration
-    uint32_t sleepSeconds = txIntervalSeconds;
+    uint32_t sleepSeconds = calculateSleepSeconds();
 
     // Use adaptive sleep if battery is low
     if (PowerManager::isBatteryLow()) {
-        sleepSeconds = PowerManager::deepSleepAdaptive(sleepSeconds);
-    } else {
-        PowerManager::deepSleep(sleepSeconds);
+        sleepSeconds = PowerManager::getAdaptiveSleepSeconds(sleepSeconds);
     }
 
+    EnergyProfiler::endCycle(sleepSeconds);
+    PowerManager::deepSleep(sleepSeconds);
+
+#ifdef PLATFORM_NATIVE
+    // Simulated sleep returns: start the next simulated cycle
+    EnergyProfiler::beginCycle();
+    currentState = NodeState::OPERATIONAL;
+#else
     // We should never reach here (deep sleep restarts the device)
     LOG_ERROR("Deep sleep failed!");
     currentState = NodeState::OPERATIONAL;
+#endif
+}
+
+/**
+ * @brief Sleep until the next TX is both due and legal
+ *
+ * Normally the TX interval; extended if the duty cycle ledger
+ * blocks the band for longer (e.g. after large SF12 frames).
+ * A deferred TX only waits for the duty cycle.
+ */
+uint32_t calculateSleepSeconds() {
+    uint32_t sleepSeconds = txDeferred ? MIN_DEEP_SLEEP_SECONDS : txIntervalSeconds;
+
+    uint32_t dutyCycleWaitMs = hal::lora::get_time_until_tx();
+    uint32_t dutyCycleWaitSeconds = (dutyCycleWaitMs + 999) / 1000;
+
+    if (dutyCycleWaitSeconds > sleepSeconds) {
+        LOG_INFO("Duty cycle: sleeping %u s instead of %u s",
+                 dutyCycleWaitSeconds, sleepSeconds);
+        sleepSeconds = dutyCycleWaitSeconds;
+    }
+
+    return sleepSeconds;
 }
@@ -0,0 +1,278 @@
+/**
+ * @file energy_profiler.cpp
+ * @brief Per-Phase Energy Profiler Implementation
+ *
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * Sprint: LoRa-02 - Grid.Sensor LoRaWAN Firmware
+ */
+
+#ifdef PLATFORM_ESP32
+#include <Arduino.h>
+#include <esp_attr.h>
+#else
+#define RTC_DATA_ATTR
+#endif
+
+#include "energy_profiler.h"
+#include "config.h"
+#include "hal/hal.h"
+#include "hal/hal_lora.h"
+
+#include <cstring>
+
+// ============================================================
+// RTC STATE
+// ============================================================
+
+namespace {
+
+constexpr uint32_t PROFILER_MAGIC = 0x454E5231;  // "ENR1"
+constexpr uint8_t DIAG_FRAME_VERSION = 1;
+
+struct CycleRecord {
+    uint32_t magic;
+    uint32_t cycles;                ///< Completed cycles since cold boot
+    uint32_t lastDiagCycle;         ///< Cycle of last diagnostic uplink
+    uint32_t phaseMs[static_cast<size_t>(PowerPhase::COUNT)];
+    uint32_t displayMs;
+    uint32_t sleepSeconds;
+    uint32_t chargeUah;             ///< Whole cycle incl. sleep
+};
+
+// Last completed cycle, survives deep sleep on ESP32
+RTC_DATA_ATTR CycleRecord lastCycle;
+
+bool hasLastCycle() {
+    return lastCycle.magic == PROFILER_MAGIC && lastCycle.cycles > 0;
+}
+
+uint16_t clamp16(uint32_t value) {
+    return value > 0xFFFF ? 0xFFFF : static_cast<uint16_t>(value);
+}
+
+void putU16(std::vector<uint8_t>& frame, uint32_t value) {
+    uint16_t v = clamp16(value);
+    frame.push_back((v >> 8) & 0xFF);
+    frame.push_back(v & 0xFF);
+}
+
+// µAh = mA × ms / 3600
+uint32_t chargeUah(float milliAmps, uint32_t ms) {
+    return static_cast<uint32_t>(milliAmps * ms / 3600.0f + 0.5f);
+}
+
+} // namespace
+
+// ============================================================
+// STATIC MEMBER INITIALIZATION
+// ============================================================
+
+float EnergyProfiler::phaseCurrent_[PHASE_COUNT] = {
+    POWER_CURRENT_BOOT_MA,
+    POWER_CURRENT_SENSOR_MA,
+    POWER_CURRENT_JOIN_MA,
+    POWER_CURRENT_TX_MA,
+    POWER_CURRENT_RX_MA,
+    POWER_CURRENT_IDLE_MA
+};
+uint32_t EnergyProfiler::phaseMs_[PHASE_COUNT] = {};
+PowerPhase EnergyProfiler::currentPhase_ = PowerPhase::BOOT;
+uint32_t EnergyProfiler::phaseStartMs_ = 0;
+uint32_t EnergyProfiler::airtimeAtPhaseStart_ = 0;
+bool EnergyProfiler::displayOn_ = false;
+uint32_t EnergyProfiler::displayOnSinceMs_ = 0;
+uint32_t EnergyProfiler::displayMs_ = 0;
+
+// ============================================================
+// CYCLE
+// ============================================================
+
+void EnergyProfiler::beginCycle(bool fromReset) {
+    if (lastCycle.magic != PROFILER_MAGIC) {
+        memset(&lastCycle, 0, sizeof(lastCycle));
+        lastCycle.magic = PROFILER_MAGIC;
+    }
+
+    memset(phaseMs_, 0, sizeof(phaseMs_));
+    displayMs_ = 0;
+
+    // millis() starts at reset, so boot time before setup() is included
+    uint32_t now = fromReset ? 0 : hal::millis();
+    currentPhase_ = PowerPhase::BOOT;
+    phaseStartMs_ = now;
+    airtimeAtPhaseStart_ = hal::lora::get_airtime_used();
+    displayOnSinceMs_ = now;
+}
+
+uint32_t EnergyProfiler::endCycle(uint32_t sleepSeconds) {
+    closePhase();
+    closeDisplay();
+
+    uint32_t activeMs = 0;
+    uint32_t activeUah = 0;
+
+    LOG_INFO("=== Energy Profile (cycle %u) ===", lastCycle.cycles + 1);
+    for (size_t i = 0; i < PHASE_COUNT; i++) {
+        uint32_t uah = chargeUah(phaseCurrent_[i], phaseMs_[i]);
+        activeMs += phaseMs_[i];
+        activeUah += uah;
+
+        if (phaseMs_[i] > 0) {
+            LOG_INFO("  %-7s %6u ms  %6u uAh", getPhaseName(static_cast<PowerPhase>(i)),
+                     phaseMs_[i], uah);
+        }
+    }
+
+    uint32_t displayUah = chargeUah(POWER_CURRENT_DISPLAY_MA, displayMs_);
+    uint32_t sleepUah = chargeUah(POWER_CURRENT_SLEEP_MA, sleepSeconds * 1000);
+    uint32_t totalUah = activeUah + displayUah + sleepUah;
+
+    if (displayMs_ > 0) {
+        LOG_INFO("  DISPLAY %6u ms  %6u uAh", displayMs_, displayUah);
+    }
+    LOG_INFO("  SLEEP   %6u s   %6u uAh", sleepSeconds, sleepUah);
+    LOG_INFO("  Total: %u uAh per cycle (%u ms awake)", totalUah, activeMs);
+
+    // Battery life at this cycle profile
+    uint32_t cycleSeconds = sleepSeconds + activeMs / 1000;
+    if (totalUah > 0 && cycleSeconds > 0) {
+        float cyclesPerDay = 86400.0f / cycleSeconds;
+        float mahPerDay = totalUah * cyclesPerDay / 1000.0f;
+        LOG_INFO("  Estimate: %.1f mAh/day, %.0f days on %u mAh",
+                 mahPerDay, BATTERY_CAPACITY_MAH / mahPerDay, BATTERY_CAPACITY_MAH);
+    }
+
+    memcpy(lastCycle.phaseMs, phaseMs_, sizeof(phaseMs_));
+    lastCycle.displayMs = displayMs_;
+    lastCycle.sleepSeconds = sleepSeconds;
+    lastCycle.chargeUah = totalUah;
+    lastCycle.cycles++;
+
+    return totalUah;
+}
+
+// ============================================================
+// PHASES
+// ============================================================
+
+void EnergyProfiler::beginPhase(PowerPhase phase) {
+    closePhase();
+    currentPhase_ = phase;
+}
+
+void EnergyProfiler::endPhase() {
+    beginPhase(PowerPhase::IDLE);
+}
+
+void EnergyProfiler::setDisplayActive(bool on) {
+    if (on == displayOn_) return;
+
+    if (on) {
+        displayOnSinceMs_ = hal::millis();
+    } else {
+        closeDisplay();
+    }
+    displayOn_ = on;
+}
+
+void EnergyProfiler::closePhase() {
+    uint32_t now = hal::millis();
+    uint32_t elapsed = now - phaseStartMs_;
+    uint32_t airtimeNow = hal::lora::get_airtime_used();
+
+    if (currentPhase_ == PowerPhase::JOIN || currentPhase_ == PowerPhase::TX) {
+        // Split radio phases into time-on-air and waiting for RX windows
+        uint32_t airtime = airtimeNow - airtimeAtPhaseStart_;
+        if (airtime > elapsed) airtime = elapsed;
+
+        phaseMs_[static_cast<size_t>(PowerPhase::TX)] += airtime;
+        PowerPhase rest = (currentPhase_ == PowerPhase::JOIN) ? PowerPhase::JOIN : PowerPhase::RX;
+        phaseMs_[static_cast<size_t>(rest)] += elapsed - airtime;
+    } else {
+        phaseMs_[static_cast<size_t>(currentPhase_)] += elapsed;
+    }
+
+    phaseStartMs_ = now;
+    airtimeAtPhaseStart_ = airtimeNow;
+}
+
+void EnergyProfiler::closeDisplay() {
+    if (!displayOn_) return;
+
+    uint32_t now = hal::millis();
+    displayMs_ += now - displayOnSinceMs_;
+    displayOnSinceMs_ = now;
+}
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+void EnergyProfiler::setPhaseCurrent(PowerPhase phase, float milliAmps) {
+    if (phase >= PowerPhase::COUNT) return;
+    phaseCurrent_[static_cast<size_t>(phase)] = milliAmps;
+}
+
+float EnergyProfiler::getPhaseCurrent(PowerPhase phase) {
+    if (phase >= PowerPhase::COUNT) return 0.0f;
+    return phaseCurrent_[static_cast<size_t>(phase)];
+}
+
+// ============================================================
+// RESULTS
+// ============================================================
+
+uint32_t EnergyProfiler::getPhaseMs(PowerPhase phase) {
+    if (phase >= PowerPhase::COUNT) return 0;
+    return phaseMs_[static_cast<size_t>(phase)];
+}
+
+uint32_t EnergyProfiler::getLastCycleCharge() {
+    return hasLastCycle() ? lastCycle.chargeUah : 0;
+}
+
+const char* EnergyProfiler::getPhaseName(PowerPhase phase) {
+    switch (phase) {
+        case PowerPhase::BOOT:   return "BOOT";
+        case PowerPhase::SENSOR: return "SENSOR";
+        case PowerPhase::JOIN:   return "JOIN";
+        case PowerPhase::TX:     return "TX";
+        case PowerPhase::RX:     return "RX";
+        case PowerPhase::IDLE:   return "IDLE";
+        default:                 return "UNKNOWN";
+    }
+}
+
+// ============================================================
+// DIAGNOSTIC UPLINK
+// ============================================================
+
+bool EnergyProfiler::isDiagnosticDue() {
+    if (!ENERGY_DIAG_UPLINK_ENABLED || !hasLastCycle()) return false;
+    return lastCycle.cycles - lastCycle.lastDiagCycle >= ENERGY_DIAG_INTERVAL_CYCLES;
+}
+
+std::vector<uint8_t> EnergyProfiler::buildDiagnosticFrame() {
+    std::vector<uint8_t> frame;
+    if (!hasLastCycle()) return frame;
+
+    frame.reserve(2 + PHASE_COUNT * 2 + 6);
+    frame.push_back(DIAG_FRAME_VERSION);
+    frame.push_back(static_cast<uint8_t>(PHASE_COUNT));
+
+    for (size_t i = 0; i < PHASE_COUNT; i++) {
+        putU16(frame, lastCycle.phaseMs[i]);
+    }
+
+    putU16(frame, lastCycle.displayMs);
+    putU16(frame, lastCycle.sleepSeconds);
+    putU16(frame, lastCycle.chargeUah);
+
+    return frame;
+}
+
+void EnergyProfiler::markDiagnosticSent() {
+    lastCycle.lastDiagCycle = lastCycle.cycles;
+}
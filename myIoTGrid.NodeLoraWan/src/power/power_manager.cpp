@@ -93,6 +93,15 @@ void PowerManager::deepSleep(uint32_t seconds) {
 }
 
 uint32_t PowerManager::deepSleepAdaptive(uint32_t baseSeconds) {
+    uint32_t sleepSeconds = getAdaptiveSleepSeconds(baseSeconds);
+
+    // Enter deep sleep
+    deepSleep(sleepSeconds);
+
+    return sleepSeconds;
+}
+
+uint32_t PowerManager::getAdaptiveSleepSeconds(uint32_t baseSeconds) {
     uint32_t sleepSeconds = baseSeconds;
 
     // Get battery level
@@ -116,9 +125,6 @@ uint32_t PowerManager::deepSleepAdaptive(uint32_t baseSeconds) {
         sleepSeconds = MAX_TX_INTERVAL_SECONDS;
     }
 
-    // Enter deep sleep
-    deepSleep(sleepSeconds);
-
     return sleepSeconds;
 }
 
@@ -0,0 +1,136 @@
+/**
+ * @file test_lora_airtime.cpp
+ * @brief Unit Tests for LoRa Time-on-Air and Duty Cycle Ledger
+ *
+ * Reference values from the Semtech LoRa Calculator (AN1200.13):
+ * CR 4/5, 8 preamble symbols, explicit header, CRC on, 125 kHz.
+ *
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * Sprint: LoRa-02 - Grid.Sensor LoRaWAN Firmware
+ */
+
+#include <unity.h>
+#include <cstdint>
+
+#include "lora_airtime.h"
+
+using namespace hal::lora;
+
+// ============================================================
+// HELPERS
+// ============================================================
+
+LoRaModulation makeModulation(uint8_t sf, float bandwidthKhz, bool lowDataRateOptimize) {
+    LoRaModulation mod;
+    mod.spreadingFactor = sf;
+    mod.bandwidthKhz = bandwidthKhz;
+    mod.codingRate = 1;
+    mod.preambleSymbols = 8;
+    mod.explicitHeader = true;
+    mod.crcEnabled = true;
+    mod.lowDataRateOptimize = lowDataRateOptimize;
+    return mod;
+}
+
+// ============================================================
+// TIME ON AIR (Semtech LoRa Calculator, rounded up)
+// ============================================================
+
+void test_sf7_empty_frame() {
+    // 13 bytes PHY (LoRaWAN overhead only): 46.336 ms
+    TEST_ASSERT_EQUAL(47, time_on_air_ms(makeModulation(7, 125.0f, false), 13));
+}
+
+void test_sf7_max_frame() {
+    // 255 bytes PHY (242 bytes application payload): 399.616 ms
+    TEST_ASSERT_EQUAL(400, time_on_air_ms(makeModulation(7, 125.0f, false), 255));
+}
+
+void test_sf9_join_request() {
+    // 23 bytes PHY (JoinRequest): 205.824 ms
+    TEST_ASSERT_EQUAL(206, time_on_air_ms(makeModulation(9, 125.0f, false), 23));
+}
+
+void test_sf12_empty_frame() {
+    // 13 bytes PHY, low data rate optimization: 1155.072 ms
+    TEST_ASSERT_EQUAL(1156, time_on_air_ms(makeModulation(12, 125.0f, true), 13));
+}
+
+void test_sf12_max_frame() {
+    // 64 bytes PHY (51 bytes application payload): 2793.472 ms
+    TEST_ASSERT_EQUAL(2794, time_on_air_ms(makeModulation(12, 125.0f, true), 64));
+}
+
+void test_sf7_250khz_max_frame() {
+    // DR6, 255 bytes PHY: 199.808 ms
+    TEST_ASSERT_EQUAL(200, time_on_air_ms(makeModulation(7, 250.0f, false), 255));
+}
+
+void test_dr_adds_lorawan_overhead() {
+    // Application payload + 13 bytes overhead must match the PHY values above
+    TEST_ASSERT_EQUAL(2794, time_on_air_for_dr(0, 51));
+    TEST_ASSERT_EQUAL(400, time_on_air_for_dr(5, 242));
+    TEST_ASSERT_EQUAL(47, time_on_air_for_dr(5, 0));
+}
+
+void test_low_data_rate_optimize_for_slow_drs() {
+    // Symbol time >= 16 ms at SF11/SF12 (125 kHz)
+    TEST_ASSERT_TRUE(modulation_for_dr(0).lowDataRateOptimize);
+    TEST_ASSERT_TRUE(modulation_for_dr(1).lowDataRateOptimize);
+    TEST_ASSERT_FALSE(modulation_for_dr(2).lowDataRateOptimize);
+    TEST_ASSERT_FALSE(modulation_for_dr(5).lowDataRateOptimize);
+}
+
+// ============================================================
+// DUTY CYCLE LEDGER
+// ============================================================
+
+void test_ledger_off_time_one_percent() {
+    DutyCycleState state;
+    DutyCycleLedger ledger(state);
+    ledger.begin();
+    ledger.reset();
+
+    // 400 ms at 1%: airtime plus 39.6 s off-time, counted from TX start
+    ledger.recordTransmission(EU868_DEFAULT_CHANNEL_HZ, 400, 1000);
+
+    TEST_ASSERT_EQUAL(40000, ledger.timeUntilAvailable(EU868_DEFAULT_CHANNEL_HZ, 1000));
+    TEST_ASSERT_EQUAL(0, ledger.timeUntilAvailable(EU868_DEFAULT_CHANNEL_HZ, 41000));
+    TEST_ASSERT_EQUAL(400, ledger.getTotalAirtimeMs());
+}
+
+void test_ledger_duty_cycle_divisors() {
+    TEST_ASSERT_EQUAL(100, DutyCycleLedger::getDutyCycleDivisor(868100000));
+    TEST_ASSERT_EQUAL(10, DutyCycleLedger::getDutyCycleDivisor(869525000));
+    TEST_ASSERT_EQUAL(1000, DutyCycleLedger::getDutyCycleDivisor(864000000));
+}
+
+// ============================================================
+// TEST RUNNER
+// ============================================================
+
+#ifdef UNIT_TEST
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Time on air
+    RUN_TEST(test_sf7_empty_frame);
+    RUN_TEST(test_sf7_max_frame);
+    RUN_TEST(test_sf9_join_request);
+    RUN_TEST(test_sf12_empty_frame);
+    RUN_TEST(test_sf12_max_frame);
+    RUN_TEST(test_sf7_250khz_max_frame);
+    RUN_TEST(test_dr_adds_lorawan_overhead);
+    RUN_TEST(test_low_data_rate_optimize_for_slow_drs);
+
+    // Duty cycle ledger
+    RUN_TEST(test_ledger_off_time_one_percent);
+    RUN_TEST(test_ledger_duty_cycle_divisors);
+
+    return UNITY_END();
+}
+
+#endif // UNIT_TEST
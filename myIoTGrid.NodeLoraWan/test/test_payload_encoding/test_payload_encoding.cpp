@@ -16,85 +16,45 @@
 #include <cmath>
 #include <string>
 
-// Include the payload encoding logic
-// Note: In a real test, you would include the actual header
-// For this test file, we'll redefine the necessary structures and functions
+#include "config.h"
+#include "lora_connection.h"
 
 // ============================================================
-// SENSOR TYPE IDS (Copied from config.h for testing)
+// HELPERS
 // ============================================================
 
-namespace SensorTypeId {
-    constexpr uint8_t TEMPERATURE = 0x01;
-    constexpr uint8_t HUMIDITY = 0x02;
-    constexpr uint8_t PRESSURE = 0x03;
-    constexpr uint8_t WATER_LEVEL = 0x04;
-    constexpr uint8_t BATTERY = 0x05;
-    constexpr uint8_t CO2 = 0x06;
-    constexpr uint8_t PM25 = 0x07;
-    constexpr uint8_t PM10 = 0x08;
-    constexpr uint8_t UNKNOWN = 0xFF;
+// Single-frame batch at the default data rate (DR5)
+std::vector<uint8_t> encodeBatch(const std::vector<Reading>& readings) {
+    auto frames = LoRaConnection::encodeFrames(readings, maxPayloadForDataRate(5), 0);
+    return frames.empty() ? std::vector<uint8_t>() : frames[0];
 }
 
-// ============================================================
-// READING STRUCTURE
-// ============================================================
-
-struct Reading {
-    std::string deviceId;
-    std::string type;
-    float value;
-    std::string unit;
-    uint32_t timestamp;
-};
-
-// ============================================================
-// PAYLOAD ENCODING FUNCTIONS (Under Test)
-// ============================================================
-
-uint8_t getSensorTypeId(const std::string& type) {
-    if (type == "temperature")   return SensorTypeId::TEMPERATURE;
-    if (type == "humidity")      return SensorTypeId::HUMIDITY;
-    if (type == "pressure")      return SensorTypeId::PRESSURE;
-    if (type == "water_level")   return SensorTypeId::WATER_LEVEL;
-    if (type == "battery")       return SensorTypeId::BATTERY;
-    if (type == "co2")           return SensorTypeId::CO2;
-    if (type == "pm25")          return SensorTypeId::PM25;
-    if (type == "pm10")          return SensorTypeId::PM10;
-    return SensorTypeId::UNKNOWN;
-}
+// Gateway-side reassembly: strip headers, concatenate in index order
+std::vector<uint8_t> reassembleFragments(const std::vector<std::vector<uint8_t>>& fragments) {
+    std::vector<std::vector<uint8_t>> ordered(fragments.size());
+    for (const auto& fragment : fragments) {
+        size_t index = fragment[1] >> 4;
+        ordered[index].assign(fragment.begin() + FRAGMENT_HEADER_SIZE, fragment.end());
+    }
 
-std::vector<uint8_t> encodeReading(const Reading& reading) {
     std::vector<uint8_t> payload;
-
-    uint8_t typeId = getSensorTypeId(reading.type);
-
-    // Convert value to int16 with appropriate precision
-    int16_t encodedValue;
-    if (reading.type == "pressure") {
-        encodedValue = static_cast<int16_t>(reading.value * 10);  // 1 decimal
-    } else {
-        encodedValue = static_cast<int16_t>(reading.value * 100); // 2 decimals
+    for (const auto& part : ordered) {
+        payload.insert(payload.end(), part.begin(), part.end());
     }
-
-    payload.push_back(typeId);
-    payload.push_back((encodedValue >> 8) & 0xFF);  // High byte (MSB)
-    payload.push_back(encodedValue & 0xFF);          // Low byte (LSB)
-
     return payload;
 }
 
-std::vector<uint8_t> encodeBatch(const std::vector<Reading>& readings) {
-    std::vector<uint8_t> payload;
-
-    for (const auto& reading : readings) {
-        auto encoded = encodeReading(reading);
-        payload.insert(payload.end(), encoded.begin(), encoded.end());
-
-        if (payload.size() >= 48) break;  // Safety limit
+std::vector<Reading> makeTemperatureBatch(size_t count) {
+    std::vector<Reading> batch;
+    for (size_t i = 0; i < count; i++) {
+        batch.push_back({"", "temperature", 20.0f + i * 0.01f, "°C", 0});
     }
+    return batch;
+}
 
-    return payload;
+// Type ID byte the encoder writes for a sensor type
+uint8_t typeIdOf(const std::string& type) {
+    return LoRaConnection::encodeReading({"", type, 0.0f, "", 0})[0];
 }
 
 // Decoder for verification
@@ -111,13 +71,13 @@ float decodeValue(uint8_t typeId, int16_t encoded) {
 // ============================================================
 
 void test_sensor_type_ids() {
-    TEST_ASSERT_EQUAL(0x01, getSensorTypeId("temperature"));
-    TEST_ASSERT_EQUAL(0x02, getSensorTypeId("humidity"));
-    TEST_ASSERT_EQUAL(0x03, getSensorTypeId("pressure"));
-    TEST_ASSERT_EQUAL(0x04, getSensorTypeId("water_level"));
-    TEST_ASSERT_EQUAL(0x05, getSensorTypeId("battery"));
-    TEST_ASSERT_EQUAL(0x06, getSensorTypeId("co2"));
-    TEST_ASSERT_EQUAL(0xFF, getSensorTypeId("unknown_sensor"));
+    TEST_ASSERT_EQUAL(0x01, typeIdOf("temperature"));
+    TEST_ASSERT_EQUAL(0x02, typeIdOf("humidity"));
+    TEST_ASSERT_EQUAL(0x03, typeIdOf("pressure"));
+    TEST_ASSERT_EQUAL(0x04, typeIdOf("water_level"));
+    TEST_ASSERT_EQUAL(0x05, typeIdOf("battery"));
+    TEST_ASSERT_EQUAL(0x06, typeIdOf("co2"));
+    TEST_ASSERT_EQUAL(0xFF, typeIdOf("unknown_sensor"));
 }
 
 void test_single_temperature_encoding() {
@@ -125,7 +85,7 @@ void test_single_temperature_encoding() {
     r.type = "temperature";
     r.value = 18.5f;
 
-    auto payload = encodeReading(r);
+    auto payload = LoRaConnection::encodeReading(r);
 
     TEST_ASSERT_EQUAL(3, payload.size());
     TEST_ASSERT_EQUAL(0x01, payload[0]);           // Type: temperature
@@ -140,7 +100,7 @@ void test_negative_temperature_encoding() {
     r.type = "temperature";
     r.value = -5.5f;
 
-    auto payload = encodeReading(r);
+    auto payload = LoRaConnection::encodeReading(r);
 
     TEST_ASSERT_EQUAL(3, payload.size());
     TEST_ASSERT_EQUAL(0x01, payload[0]);           // Type: temperature
@@ -156,7 +116,7 @@ void test_humidity_encoding() {
     r.type = "humidity";
     r.value = 67.0f;
 
-    auto payload = encodeReading(r);
+    auto payload = LoRaConnection::encodeReading(r);
 
     TEST_ASSERT_EQUAL(3, payload.size());
     TEST_ASSERT_EQUAL(0x02, payload[0]);           // Type: humidity
@@ -172,7 +132,7 @@ void test_pressure_encoding() {
     r.type = "pressure";
     r.value = 1005.4f;
 
-    auto payload = encodeReading(r);
+    auto payload = LoRaConnection::encodeReading(r);
 
     TEST_ASSERT_EQUAL(3, payload.size());
     TEST_ASSERT_EQUAL(0x03, payload[0]);           // Type: pressure
@@ -187,7 +147,7 @@ void test_water_level_encoding() {
     r.type = "water_level";
     r.value = 85.5f;
 
-    auto payload = encodeReading(r);
+    auto payload = LoRaConnection::encodeReading(r);
 
     TEST_ASSERT_EQUAL(3, payload.size());
     TEST_ASSERT_EQUAL(0x04, payload[0]);           // Type: water_level
@@ -202,7 +162,7 @@ void test_battery_encoding() {
     r.type = "battery";
     r.value = 85.0f;
 
-    auto payload = encodeReading(r);
+    auto payload = LoRaConnection::encodeReading(r);
 
     TEST_ASSERT_EQUAL(3, payload.size());
     TEST_ASSERT_EQUAL(0x05, payload[0]);           // Type: battery
@@ -273,7 +233,7 @@ void test_decode_roundtrip_temperature() {
     r.type = "temperature";
     r.value = 23.45f;
 
-    auto payload = encodeReading(r);
+    auto payload = LoRaConnection::encodeReading(r);
 
     // Decode
     uint8_t typeId = payload[0];
@@ -289,7 +249,7 @@ void test_decode_roundtrip_pressure() {
     r.type = "pressure";
     r.value = 1013.25f;
 
-    auto payload = encodeReading(r);
+    auto payload = LoRaConnection::encodeReading(r);
 
     // Decode
     uint8_t typeId = payload[0];
@@ -301,19 +261,17 @@ void test_decode_roundtrip_pressure() {
 }
 
 void test_payload_size_limit() {
-    // Create a batch larger than the limit
-    std::vector<Reading> batch;
-    for (int i = 0; i < 20; i++) {
-        Reading r;
-        r.type = "temperature";
-        r.value = 20.0f + i;
-        batch.push_back(r);
-    }
+    // 20 readings (60 bytes) exceed the DR0 limit of 51 bytes
+    auto batch = makeTemperatureBatch(20);
 
-    auto payload = encodeBatch(batch);
+    auto frames = LoRaConnection::encodeFrames(batch, maxPayloadForDataRate(0), 7);
 
-    // Should be capped at 48 bytes (16 sensors × 3 bytes)
-    TEST_ASSERT_LESS_OR_EQUAL(48, payload.size());
+    // Nothing is dropped: split into 2 fragments, each within the limit
+    TEST_ASSERT_EQUAL(2, frames.size());
+    for (const auto& frame : frames) {
+        TEST_ASSERT_LESS_OR_EQUAL(51, frame.size());
+    }
+    TEST_ASSERT_EQUAL(60, reassembleFragments(frames).size());
 }
 
 void test_empty_batch() {
@@ -339,7 +297,7 @@ void test_unknown_sensor_type() {
     r.type = "unknown_type";
     r.value = 42.0f;
 
-    auto payload = encodeReading(r);
+    auto payload = LoRaConnection::encodeReading(r);
 
     TEST_ASSERT_EQUAL(3, payload.size());
     TEST_ASSERT_EQUAL(0xFF, payload[0]);  // Unknown type ID
@@ -350,7 +308,7 @@ void test_zero_values() {
     r.type = "temperature";
     r.value = 0.0f;
 
-    auto payload = encodeReading(r);
+    auto payload = LoRaConnection::encodeReading(r);
 
     TEST_ASSERT_EQUAL(3, payload.size());
     TEST_ASSERT_EQUAL(0x01, payload[0]);
@@ -363,7 +321,7 @@ void test_max_temperature_value() {
     r.type = "temperature";
     r.value = 85.0f;  // BME280 max
 
-    auto payload = encodeReading(r);
+    auto payload = LoRaConnection::encodeReading(r);
 
     // 85.0 * 100 = 8500 = 0x2134
     TEST_ASSERT_EQUAL(0x21, payload[1]);
@@ -375,7 +333,7 @@ void test_min_temperature_value() {
     r.type = "temperature";
     r.value = -40.0f;  // BME280 min
 
-    auto payload = encodeReading(r);
+    auto payload = LoRaConnection::encodeReading(r);
 
     // -40.0 * 100 = -4000 = 0xF060 (two's complement)
     int16_t expected = -4000;
@@ -383,6 +341,101 @@ void test_min_temperature_value() {
     TEST_ASSERT_EQUAL(expected & 0xFF, payload[2]);
 }
 
+// ============================================================
+// DATA RATE / FRAGMENTATION TESTS
+// ============================================================
+
+void verifyDataRate(uint8_t dr, size_t expectedLimit) {
+    size_t limit = maxPayloadForDataRate(dr);
+    TEST_ASSERT_EQUAL(expectedLimit, limit);
+
+    // Exactly at capacity: one frame, no fragment header
+    size_t capacity = limit / 3;
+    auto full = LoRaConnection::encodeFrames(makeTemperatureBatch(capacity), limit, 0);
+    TEST_ASSERT_EQUAL(1, full.size());
+    TEST_ASSERT_EQUAL(capacity * 3, full[0].size());
+    TEST_ASSERT_LESS_OR_EQUAL(limit, full[0].size());
+
+    // One reading more: sequenced fragments within the limit
+    auto batch = makeTemperatureBatch(capacity + 1);
+    auto fragments = LoRaConnection::encodeFrames(batch, limit, 42);
+    TEST_ASSERT_EQUAL(2, fragments.size());
+
+    for (size_t i = 0; i < fragments.size(); i++) {
+        TEST_ASSERT_LESS_OR_EQUAL(limit, fragments[i].size());
+        TEST_ASSERT_EQUAL(42, fragments[i][0]);                  // BatchId
+        TEST_ASSERT_EQUAL(i, fragments[i][1] >> 4);              // Index
+        TEST_ASSERT_EQUAL(fragments.size(), fragments[i][1] & 0x0F);  // Total
+        TEST_ASSERT_EQUAL(0, (fragments[i].size() - FRAGMENT_HEADER_SIZE) % 3);
+    }
+
+    // Reassembly yields the same bytes as an unlimited encoding
+    auto reassembled = reassembleFragments(fragments);
+    auto reference = LoRaConnection::encodeFrames(batch, 1024, 0);
+    TEST_ASSERT_EQUAL(reference[0].size(), reassembled.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(reference[0].data(), reassembled.data(), reassembled.size());
+}
+
+void test_dr0_payload_budget() { verifyDataRate(0, 51); }
+void test_dr1_payload_budget() { verifyDataRate(1, 51); }
+void test_dr2_payload_budget() { verifyDataRate(2, 51); }
+void test_dr3_payload_budget() { verifyDataRate(3, 115); }
+void test_dr4_payload_budget() { verifyDataRate(4, 242); }
+void test_dr5_payload_budget() { verifyDataRate(5, 242); }
+void test_dr6_payload_budget() { verifyDataRate(6, 242); }
+void test_dr7_payload_budget() { verifyDataRate(7, 242); }
+
+void test_unknown_data_rate_uses_conservative_limit() {
+    TEST_ASSERT_EQUAL(51, maxPayloadForDataRate(8));
+    TEST_ASSERT_EQUAL(51, maxPayloadForDataRate(15));
+}
+
+void test_adr_uses_dr0_limit() {
+    // ADR may lower the DR at any time, frames must fit DR0
+    TEST_ASSERT_EQUAL(51, maxPayloadForUplink(5, true));
+    TEST_ASSERT_EQUAL(51, maxPayloadForUplink(0, true));
+    TEST_ASSERT_EQUAL(242, maxPayloadForUplink(5, false));
+    TEST_ASSERT_EQUAL(115, maxPayloadForUplink(3, false));
+}
+
+void test_fragment_count_limit() {
+    // DR0: 16 readings per fragment, 15 fragments max = 240 readings
+    auto frames = LoRaConnection::encodeFrames(makeTemperatureBatch(300), maxPayloadForDataRate(0), 1);
+
+    TEST_ASSERT_EQUAL(MAX_FRAGMENTS, frames.size());
+    TEST_ASSERT_EQUAL(MAX_FRAGMENTS, frames.back()[1] & 0x0F);
+    TEST_ASSERT_EQUAL(240 * 3, reassembleFragments(frames).size());
+}
+
+void test_duty_cycle_frame_budget() {
+    // DR5, 242 bytes: 400 ms airtime, 39.6 s off-time at 1% -> 2 frames in 60 s
+    TEST_ASSERT_EQUAL(2, LoRaConnection::framesWithinDutyCycle(400, 100));
+
+    // DR0, 51 bytes: 2794 ms airtime, 276 s off-time -> only one frame
+    TEST_ASSERT_EQUAL(1, LoRaConnection::framesWithinDutyCycle(2794, 100));
+
+    // Short frames are capped at the 4-bit fragment limit
+    TEST_ASSERT_EQUAL(MAX_FRAGMENTS, LoRaConnection::framesWithinDutyCycle(10, 100));
+}
+
+void test_single_frame_budget_sends_plain_frame() {
+    // Only one frame allowed: first 17 readings as unfragmented DR0 frame
+    auto frames = LoRaConnection::encodeFrames(makeTemperatureBatch(20), maxPayloadForDataRate(0), 3, 1);
+
+    TEST_ASSERT_EQUAL(1, frames.size());
+    TEST_ASSERT_EQUAL(51, frames[0].size());
+    TEST_ASSERT_EQUAL_HEX8(SensorTypeId::TEMPERATURE, frames[0][0]);
+}
+
+void test_fragment_budget_limits_fragments() {
+    // 40 readings need 3 DR0 fragments, the duty cycle allows 2
+    auto frames = LoRaConnection::encodeFrames(makeTemperatureBatch(40), maxPayloadForDataRate(0), 4, 2);
+
+    TEST_ASSERT_EQUAL(2, frames.size());
+    TEST_ASSERT_EQUAL(2, frames[0][1] & 0x0F);
+    TEST_ASSERT_EQUAL(32 * 3, reassembleFragments(frames).size());
+}
+
 // ============================================================
 // TEST RUNNER
 // ============================================================
@@ -420,6 +473,22 @@ int main(int argc, char **argv) {
     RUN_TEST(test_max_temperature_value);
     RUN_TEST(test_min_temperature_value);
 
+    // Data rate budget and fragmentation tests
+    RUN_TEST(test_dr0_payload_budget);
+    RUN_TEST(test_dr1_payload_budget);
+    RUN_TEST(test_dr2_payload_budget);
+    RUN_TEST(test_dr3_payload_budget);
+    RUN_TEST(test_dr4_payload_budget);
+    RUN_TEST(test_dr5_payload_budget);
+    RUN_TEST(test_dr6_payload_budget);
+    RUN_TEST(test_dr7_payload_budget);
+    RUN_TEST(test_unknown_data_rate_uses_conservative_limit);
+    RUN_TEST(test_adr_uses_dr0_limit);
+    RUN_TEST(test_fragment_count_limit);
+    RUN_TEST(test_duty_cycle_frame_budget);
+    RUN_TEST(test_single_frame_budget_sends_plain_frame);
+    RUN_TEST(test_fragment_budget_limits_fragments);
+
     return UNITY_END();
 }
 
@@ -0,0 +1,25 @@
+/**
+ * myIoTGrid.Sensor - Pre-1.0 Arduino Core Header (native)
+ *
+ * Libraries that check ARDUINO >= 100 (TinyGPSPlus) include WProgram.h
+ * on native builds, where ARDUINO is undefined. Maps to the native HAL
+ * Arduino.h and adds the angle helpers TinyGPSPlus uses for distance and
+ * course, as functions instead of the Arduino core macros.
+ */
+
+#ifndef WPROGRAM_H
+#define WPROGRAM_H
+
+#include "Arduino.h"
+
+constexpr double TWO_PI = 6.283185307179586476925286766559;
+constexpr double DEG_TO_RAD = 0.017453292519943295769236907684886;
+constexpr double RAD_TO_DEG = 57.295779513082320876798154814105;
+
+inline double radians(double deg) { return deg * DEG_TO_RAD; }
+inline double degrees(double rad) { return rad * RAD_TO_DEG; }
+
+template<typename T>
+inline T sq(T x) { return x * x; }
+
+#endif // WPROGRAM_H
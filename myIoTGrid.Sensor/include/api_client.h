@@ -7,19 +7,44 @@
 #define API_CLIENT_H
 
 #include <Arduino.h>
+#include <ArduinoJson.h>
+#include <atomic>
 #include <functional>
+#include <mutex>
 #include <vector>
+#include "reading_aggregator.h"
+#include "wire_codec.h"
 
 /**
  * API response structure
  */
 struct ApiResponse {
     int statusCode;
-    String body;
+    String body;            // JSON text or MessagePack bytes (see contentType)
+    String contentType;
     bool success;
     String error;
+    uint32_t retryAfterMs;  // Retry-After of the response (0 = none)
 
-    ApiResponse() : statusCode(0), success(false) {}
+    ApiResponse() : statusCode(0), success(false), retryAfterMs(0) {}
+};
+
+/**
+ * Request body encoded ahead of the upload (sync read-ahead)
+ */
+struct EncodedBody {
+    std::vector<uint8_t> data;
+    bool msgPack = false;       // Wire format chosen at encode time
+};
+
+/**
+ * Result of a /api/readings/batch upload (BatchReadingsResultDto)
+ */
+struct BatchUploadResponse {
+    int statusCode = 0;         // HTTP status (0 = no response)
+    int successCount = 0;       // Readings the Hub stored
+    int failedCount = 0;        // Readings the Hub rejected
+    String error;
 };
 
 /**
@@ -27,7 +52,8 @@ struct ApiResponse {
  */
 struct HeartbeatResponse {
     bool success;
-    unsigned long serverTime;
+    uint64_t serverTimeMs;      // Hub UTC in ms (0 = not sent / unparseable)
+    uint32_t roundTripMs;       // Heartbeat request round trip
     int nextHeartbeatSeconds;
 };
 
@@ -54,6 +80,11 @@ struct SensorCapabilityConfig {
     String measurementType;
     String displayName;
     String unit;
+    // Report-by-exception (optional, see DeadbandFilter)
+    double deadbandAbsolute;        // < 0 = per-type default
+    double deadbandPercent;         // <= 0 = off
+    double deadbandSlopePerMinute;  // <= 0 = off
+    int maxSilenceSeconds;          // <= 0 = DEADBAND_MAX_SILENCE_SECONDS
 };
 
 /**
@@ -78,6 +109,7 @@ struct SensorAssignmentConfig {
     int baudRate;
     double offsetCorrection;
     double gainCorrection;
+    int aggregationWindowSeconds;   // 0 = upload every sample, >0 = upload window summary
     std::vector<SensorCapabilityConfig> capabilities;
 };
 
@@ -96,6 +128,7 @@ struct NodeConfigurationResponse {
     String error;
     // Sprint OS-01: Offline Storage
     int storageMode;  // 0=RemoteOnly, 1=LocalAndRemote, 2=LocalOnly, 3=LocalAutoSync
+    String wireFormat;  // "json" / "msgpack" (empty = firmware default)
 };
 
 /**
@@ -138,8 +171,14 @@ public:
 
     /**
      * Send heartbeat to Hub
+     * @param wifiStatsJson WiFi connect statistics JSON object (omitted if empty)
+     * @param pipelineJson Reading pipeline queue metrics JSON object (omitted if empty)
+     * @param timeJson Clock sync status JSON object (omitted if empty)
+     * @param syncJson Offline sync statistics JSON object (omitted if empty)
      */
-    HeartbeatResponse sendHeartbeat(const String& firmwareVersion = "", int batteryLevel = -1);
+    HeartbeatResponse sendHeartbeat(const String& firmwareVersion = "", int batteryLevel = -1,
+                                    const String& wifiStatsJson = "", const String& pipelineJson = "",
+                                    const String& timeJson = "", const String& syncJson = "");
 
     /**
      * Send sensor reading to Hub
@@ -147,19 +186,67 @@ public:
      * @param value The measured value
      * @param unit Unit of measurement (e.g., "°C", "%")
      * @param endpointId Optional endpoint ID to identify which sensor assignment this reading belongs to
+     * @param timestamp Capture time as Unix seconds (0 = Hub uses receive time)
+     * @param statusCode If set, receives the HTTP status (0 = no response)
+     */
+    bool sendReading(const String& sensorType, double value, const String& unit = "", int endpointId = -1,
+                     uint32_t timestamp = 0, int* statusCode = nullptr);
+
+    /**
+     * Build the body of sendReading() (CreateSensorReadingDto)
+     */
+    void buildReadingPayload(JsonDocument& doc, const String& sensorType, double value,
+                             const String& unit = "", int endpointId = -1, uint32_t timestamp = 0) const;
+
+    /**
+     * Send aggregation window summary to Hub
+     * Value is the window mean; min/max/stddev/count travel alongside.
+     * @param sensorType Measurement type
+     * @param summary Completed window summary
+     * @param unit Unit of measurement
+     * @param endpointId Optional endpoint ID
+     * @param timestamp Window end as Unix seconds (0 = Hub uses receive time)
      */
-    bool sendReading(const String& sensorType, double value, const String& unit = "", int endpointId = -1);
+    bool sendAggregatedReading(const String& sensorType, const WindowSummary& summary,
+                               const String& unit = "", int endpointId = -1, uint32_t timestamp = 0);
 
     /**
-     * Send batch of readings
+     * Start a batch body (CreateBatchReadingsDto: { NodeId, Readings[] })
+     * @return the readings array for addBatchReading()
      */
-    bool sendReadings(const String& readingsJson);
+    JsonArray beginReadingBatch(JsonDocument& doc) const;
+
+    /**
+     * Append one reading to a batch body (ReadingValueDto)
+     * @param timestamp Capture time as Unix seconds (0 = Hub uses receive time)
+     */
+    void addBatchReading(JsonArray readings, const String& sensorType, double value,
+                         const String& unit, int endpointId, uint32_t timestamp) const;
+
+    /**
+     * Encode a document in the negotiated wire format, so the upload only sends bytes
+     */
+    void encodeBody(const JsonDocument& doc, EncodedBody& body) const;
+
+    /**
+     * Send a pre-encoded batch body to /api/readings/batch
+     * A MessagePack body answered with 415 switches the client to JSON; the
+     * caller re-encodes and repeats.
+     */
+    BatchUploadResponse sendReadingBatch(const EncodedBody& body);
 
     /**
      * Fetch sensor configuration for this node
      * Returns assigned sensors with their pin configurations
+     * @param rawJson If set, receives the response body (for the NVS fast-boot cache)
+     */
+    NodeConfigurationResponse fetchConfiguration(const String& serialNumber, String* rawJson = nullptr);
+
+    /**
+     * Parse a configuration response body (fetched or cached)
      */
-    NodeConfigurationResponse fetchConfiguration(const String& serialNumber);
+    NodeConfigurationResponse parseConfiguration(const String& json);
+    NodeConfigurationResponse parseConfiguration(const JsonDocument& respDoc);
 
     /**
      * Send hardware status report to Hub (Sprint 8)
@@ -170,6 +257,7 @@ public:
      * @param detectedDevices JSON array of detected devices
      * @param storageJson Storage status JSON object
      * @param busStatusJson Bus status JSON object
+     * @param bootJson Boot timeline JSON object (omitted if empty)
      * @return true if report was sent successfully
      */
     bool sendHardwareStatus(const String& serialNumber,
@@ -177,7 +265,8 @@ public:
                             const String& hardwareType,
                             const String& detectedDevicesJson,
                             const String& storageJson,
-                            const String& busStatusJson);
+                            const String& busStatusJson,
+                            const String& bootJson = "");
 
     /**
      * Fetch debug configuration from Hub (Sprint 8: Remote Debug System)
@@ -207,22 +296,91 @@ public:
      */
     void setTimeout(int timeoutMs) { _timeout = timeoutMs; }
 
+    /**
+     * Preferred wire format for this node
+     * MSGPACK is used once the Hub has answered with application/msgpack;
+     * until then (and after a 415) requests stay JSON.
+     */
+    void setWireFormat(WireFormat format);
+    WireFormat getWireFormat() const { return _preferMsgPack ? WireFormat::MSGPACK : WireFormat::JSON; }
+
+    /**
+     * True if request bodies currently go out as MessagePack
+     */
+    bool isMsgPackActive() const { return _preferMsgPack && _hubMsgPack; }
+
+    /**
+     * Milliseconds until the Hub circuit breaker lets requests through (0 = now)
+     */
+    uint32_t getCircuitWaitMs() const;
+
 private:
     String _baseUrl;
     String _nodeId;
     String _apiKey;
     int _timeout;
     bool _configured;
+    std::mutex _httpMutex;      // One Hub request at a time (loop, network and sync callers)
+    std::atomic<bool> _preferMsgPack;   // Node setting (Accept: application/msgpack)
+    std::atomic<bool> _hubMsgPack;      // Hub answered with application/msgpack
+    std::atomic<bool> _msgPackRejected; // Hub refused a MessagePack body (until reboot)
+    std::mutex _bufferMutex;    // Guards the request body buffers (taken before _httpMutex)
+    String _requestBody;        // JSON body, REQUEST_BUFFER_SIZE reserved
+    std::vector<uint8_t> _requestPacked;    // MessagePack body
 
     /**
-     * Make HTTP GET request
+     * Make HTTP GET request (through the Hub circuit breaker)
      */
     ApiResponse httpGet(const String& path);
 
     /**
-     * Make HTTP POST request
+     * Single GET attempt (caller holds _httpMutex)
+     */
+    ApiResponse sendGet(const String& path);
+
+    /**
+     * Make HTTP POST request (through the Hub circuit breaker)
      */
     ApiResponse httpPost(const String& path, const String& body);
+    ApiResponse httpPost(const String& path, const uint8_t* data, size_t length, const char* contentType);
+
+    /**
+     * Single POST attempt (caller holds _httpMutex)
+     * @param compressed In: previous attempt was compressed (send plain now); out: this one was
+     */
+    ApiResponse sendPost(const String& path, const uint8_t* data, size_t length,
+                         const char* contentType, bool& compressed);
+
+    /**
+     * Circuit breaker gate before a request (fills a rejected response)
+     */
+    bool admitRequest(ApiResponse& rejected);
+
+    /**
+     * Feed a response (status, Retry-After) to the circuit breaker and the metrics
+     */
+    void recordResult(const ApiResponse& result, uint32_t durationMs);
+
+    /**
+     * POST a document in the negotiated wire format (JSON fallback on 415)
+     * Serializes into the reused request buffers.
+     */
+    ApiResponse postDocument(const String& path, const JsonDocument& doc);
+
+    /**
+     * Parse a response body as JSON or MessagePack (by Content-Type)
+     */
+    DeserializationError parseResponse(const ApiResponse& response, JsonDocument& doc);
+
+    /**
+     * Record the Content-Type of a Hub response (wire format negotiation)
+     */
+    void onResponseContentType(const String& contentType);
+
+    /**
+     * Add a JSON object held as text to doc[key] (raw for JSON, parsed for MessagePack)
+     */
+    void setJsonField(JsonDocument& doc, const char* key, const String& json) const;
 
     /**
      * Build full URL
@@ -0,0 +1,34 @@
+/**
+ * myIoTGrid.Sensor - Native Benchmark Suite
+ *
+ * Micro-benchmarks of the firmware hot paths, built by the native_bench
+ * env instead of the node (main() runs the suite and exits):
+ *
+ *   pio run -e native_bench && .pio/build/native_bench/program
+ *
+ * Each benchmark is calibrated to BENCH_MIN_SAMPLE_MS per sample and
+ * reports the median ns/op of BENCH_SAMPLES samples. Results go to
+ * BENCH_OUTPUT (default bench_results.json) as JSON. A benchmark fails
+ * if it exceeds its ceiling or - with BENCH_BASELINE set to the results
+ * of an earlier firmware - the baseline by more than
+ * BENCH_REGRESSION_PERCENT. The exit code is 1 on any failure.
+ */
+
+#ifndef BENCH_SUITE_H
+#define BENCH_SUITE_H
+
+#ifdef PLATFORM_NATIVE
+
+namespace bench {
+
+/**
+ * Run all benchmarks and write the results
+ * @return true if no benchmark regressed
+ */
+bool runSuite();
+
+} // namespace bench
+
+#endif // PLATFORM_NATIVE
+
+#endif // BENCH_SUITE_H
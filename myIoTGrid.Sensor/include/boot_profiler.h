@@ -0,0 +1,81 @@
+/**
+ * myIoTGrid.Sensor - Boot Profiler
+ *
+ * Records a per-phase boot timeline in microseconds (serial, debug,
+ * storage, NVS, WiFi, registration, ...) plus the time until the first
+ * reading was sent or stored. The timeline is printed on serial and
+ * included in the hardware status report.
+ */
+
+#ifndef BOOT_PROFILER_H
+#define BOOT_PROFILER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * One completed boot phase
+ */
+struct BootPhase {
+    const char* name;           // Static string
+    uint32_t durationUs;
+};
+
+/**
+ * Boot Profiler - singleton, fixed-size phase table
+ */
+class BootProfiler {
+public:
+    static BootProfiler& getInstance();
+
+    /**
+     * Start the timeline (first statement in setup())
+     */
+    void begin();
+
+    /**
+     * Close the phase running since the previous mark (ignored after first reading)
+     * @param phase Phase name (must be a static string)
+     */
+    void mark(const char* phase);
+
+    /**
+     * Record time to first delivered reading and print the timeline (once)
+     */
+    void markFirstReading();
+
+    /**
+     * Flag the boot as fast-boot (cached NVS configuration)
+     */
+    void setFastBoot(bool fastBoot) { _fastBoot = fastBoot; }
+    bool isFastBoot() const { return _fastBoot; }
+
+    bool hasFirstReading() const { return _firstReadingUs > 0; }
+    uint32_t getTimeToFirstReadingUs() const { return _firstReadingUs; }
+    uint32_t getElapsedUs() const { return _lastUs - _startUs; }
+    size_t getPhaseCount() const { return _count; }
+
+    /**
+     * Print timeline to Serial
+     */
+    void printTimeline() const;
+
+    /**
+     * Timeline as JSON object for the hardware status report
+     */
+    String toJson() const;
+
+private:
+    BootProfiler();
+    BootProfiler(const BootProfiler&) = delete;
+    BootProfiler& operator=(const BootProfiler&) = delete;
+
+    BootPhase _phases[config::BOOT_PROFILER_MAX_PHASES];
+    size_t _count;
+    uint32_t _startUs;
+    uint32_t _lastUs;
+    uint32_t _firstReadingUs;   // 0 = no reading yet
+    bool _fastBoot;
+};
+
+#endif // BOOT_PROFILER_H
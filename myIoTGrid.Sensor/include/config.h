@@ -83,6 +83,194 @@ constexpr int SD_CS_PIN = 5;              // SD Card CS (GPIO5)
 constexpr int SYNC_BUTTON_GPIO = 4;       // Sync button (GPIO4)
 constexpr int SYNC_LED_GPIO = 2;          // Sync status LED (GPIO2 = onboard LED)
 
+// ============================================================================
+// Loop Scheduler (deadline-driven main loop, light sleep between deadlines)
+// ============================================================================
+constexpr uint32_t LOOP_MAX_SLEEP_MS = 5000;            // Well below 90s watchdog
+constexpr uint32_t LOOP_BUSY_INTERVAL_MS = 10;          // Blocking states / active sync (old loop rate)
+constexpr uint32_t LOOP_BUTTON_POLL_MS = 20;            // While a button is held or WPS runs
+constexpr uint32_t LOOP_BACKGROUND_INTERVAL_MS = 100;   // SD logger queue, debug log upload
+constexpr uint32_t LOOP_SYNC_LED_INTERVAL_MS = 50;      // Sync LED blink resolution
+constexpr uint32_t LOOP_SYNC_IDLE_INTERVAL_MS = 1000;   // Sync manager without activity
+constexpr bool LOOP_LIGHT_SLEEP_ENABLED = true;         // Needs CONFIG_PM_ENABLE + tickless idle in SDK
+constexpr int LOOP_LIGHT_SLEEP_MIN_FREQ_MHZ = 40;       // XTAL frequency
+constexpr uint32_t LOOP_WAKE_PIN_POLL_MS = 200;         // Button sampling during light sleep
+
+// Loop profiler (per-task timing, see LoopProfiler)
+constexpr size_t LOOP_PROFILER_MAX_STAGES = 16;        // Tasks + sub-stages + "wake"
+constexpr size_t LOOP_PROFILER_RING_SIZE = 128;         // Runs per stage kept for p99
+constexpr uint32_t LOOP_STAGE_BUDGET_US = 50000;        // Longer runs delay every other task
+constexpr uint32_t LOOP_WAKE_BUDGET_US = 20000;         // Late wake-up against the planned deadline
+constexpr uint32_t LOOP_PROFILER_WARN_INTERVAL_MS = 60000;  // Overrun log per stage (NORMAL+)
+constexpr uint32_t LOOP_PROFILER_REPORT_MS = 60000;     // Full table (DEBUG)
+
+// ============================================================================
+// Reading Pipeline (sampling / storage / network tasks with bounded queues)
+// ============================================================================
+constexpr size_t PIPELINE_STORAGE_QUEUE_DEPTH = 32;       // Readings
+constexpr size_t PIPELINE_NETWORK_QUEUE_DEPTH = 32;       // Readings
+constexpr bool PIPELINE_STORAGE_DROP_OLDEST = false;      // SD: keep the continuous older series
+constexpr bool PIPELINE_NETWORK_DROP_OLDEST = true;       // Hub: keep the freshest readings
+constexpr uint32_t PIPELINE_SAMPLER_MAX_WAIT_MS = 1000;   // Re-check state/config at least every second
+constexpr uint32_t PIPELINE_SINK_IDLE_WAIT_MS = 1000;
+constexpr uint32_t PIPELINE_SAMPLING_TASK_STACK_SIZE = 6144;  // Bytes (sensor drivers)
+constexpr uint32_t PIPELINE_SAMPLING_TASK_PRIORITY = 4;   // Above GPS/UART tasks (3) and loop (1)
+constexpr int PIPELINE_SAMPLING_TASK_CORE = 1;            // APP core
+constexpr uint32_t PIPELINE_STORAGE_TASK_STACK_SIZE = 4096;
+constexpr uint32_t PIPELINE_STORAGE_TASK_PRIORITY = 2;
+constexpr int PIPELINE_STORAGE_TASK_CORE = 1;
+constexpr uint32_t PIPELINE_NETWORK_TASK_STACK_SIZE = 8192;   // TLS handshake
+constexpr uint32_t PIPELINE_NETWORK_TASK_PRIORITY = 2;
+constexpr int PIPELINE_NETWORK_TASK_CORE = 0;             // PRO core (WiFi stack)
+
+// ============================================================================
+// Time Service (SNTP + Hub serverTime discipline)
+// ============================================================================
+constexpr const char* TIME_NTP_SERVER_1 = "pool.ntp.org";
+constexpr const char* TIME_NTP_SERVER_2 = "time.google.com";
+constexpr const char* TIME_NTP_SERVER_3 = "time.cloudflare.com";
+constexpr uint32_t TIME_SYNC_WAIT_MS = 10000;           // Wait for first sync after WiFi connect
+constexpr uint32_t TIME_SNTP_UNCERTAINTY_MS = 50;       // Typical SNTP accuracy over WiFi
+constexpr uint32_t TIME_HUB_BASE_UNCERTAINTY_MS = 500;  // serverTime resolution + processing, plus RTT/2
+constexpr uint32_t TIME_ASSUMED_DRIFT_PPM = 50;         // Crystal tolerance until drift is measured
+constexpr uint32_t TIME_DRIFT_MIN_INTERVAL_MS = 600000; // Min. time between syncs for a drift sample
+constexpr float TIME_DRIFT_EWMA_ALPHA = 0.3f;
+constexpr float TIME_DRIFT_MAX_PPM = 500.0f;            // Larger = clock step, not drift
+constexpr uint32_t TIME_MIN_VALID_UNIX = 1700000000;    // 2023-11-14; earlier = clock not set
+
+// ============================================================================
+// HTTP Request Compression (gzip, negotiated via Hub Accept-Encoding)
+// ============================================================================
+constexpr bool HTTP_COMPRESSION_ENABLED = true;
+constexpr size_t HTTP_COMPRESSION_MIN_BYTES = 256;      // Smaller bodies: header overhead > savings
+constexpr uint8_t HTTP_COMPRESSION_WINDOW_BITS = 11;    // 2 KB window, ~10 KB heap while compressing
+
+// ============================================================================
+// Wire Format (JSON / MessagePack, per node via Hub configuration)
+// ============================================================================
+constexpr bool WIRE_FORMAT_MSGPACK_DEFAULT = false;     // Until the Hub sets "wireFormat"
+
+// ============================================================================
+// Offline Storage Retention (segment sealing, expiry, eviction; policy in storage config)
+// ============================================================================
+constexpr uint32_t RETENTION_SCAN_INTERVAL_MS = 60000;      // Seal/expire pass, earlier on low space
+constexpr uint64_t RETENTION_HEADROOM_BYTES = 1048576;      // Evict from minFree+1x to minFree+2x
+
+// ============================================================================
+// Offline Sync Pipeline (read next batch from SD while the current one uploads)
+// ============================================================================
+constexpr int SYNC_PIPELINE_MAX_DEPTH = 4;                  // Upper bound for syncPipelineDepth
+constexpr uint32_t SYNC_UPLOAD_TASK_STACK_SIZE = 8192;      // TLS handshake
+constexpr uint32_t SYNC_UPLOAD_TASK_PRIORITY = 2;
+constexpr int SYNC_UPLOAD_TASK_CORE = 0;                    // PRO core (WiFi stack)
+constexpr uint32_t SYNC_UPLOAD_IDLE_WAIT_MS = 1000;
+
+// ============================================================================
+// Adaptive Sync Batch Size (AIMD on request duration, RTT, 413, heap and RSSI)
+// ============================================================================
+constexpr int SYNC_BATCH_MIN = 5;                           // Readings
+constexpr int SYNC_BATCH_MAX = 500;
+constexpr int SYNC_BATCH_ADDITIVE_STEP = 10;                // Per clean batch
+constexpr uint32_t SYNC_BATCH_TARGET_MS = 15000;            // Longer batch request = halve (ack granularity)
+constexpr float SYNC_BATCH_RTT_SLOWDOWN = 2.0f;             // Time per reading above baseline x this = halve
+constexpr float SYNC_BATCH_RTT_EWMA_ALPHA = 0.3f;
+constexpr uint32_t SYNC_READING_HEAP_BYTES = 260;           // StoredReading + position + encoded body, per slot
+constexpr uint8_t SYNC_BATCH_HEAP_PERCENT = 25;             // Of free heap for all read-ahead slots
+constexpr int SYNC_WEAK_RSSI_DBM = -80;                     // Below: weak link cap
+constexpr int SYNC_WEAK_LINK_MAX_BATCH = 20;
+
+// ============================================================================
+// Hub Retry Policy (decorrelated jitter, shared circuit breaker, Retry-After)
+// ============================================================================
+constexpr uint32_t CIRCUIT_FAILURE_THRESHOLD = 5;           // Consecutive Hub failures until OPEN
+constexpr uint32_t CIRCUIT_OPEN_BASE_MS = 5000;             // First open period (jittered)
+constexpr uint32_t CIRCUIT_OPEN_MAX_MS = 60000;             // Open period cap (one probe per minute)
+constexpr uint32_t RETRY_AFTER_MAX_MS = 3600000;            // Ignore longer Retry-After values
+constexpr uint8_t RETRY_AFTER_JITTER_PERCENT = 20;          // Spread nodes told the same Retry-After
+constexpr uint8_t PERIODIC_JITTER_PERCENT = 10;             // Heartbeat/config poll interval +/-
+
+// ============================================================================
+// Metrics Registry
+// ============================================================================
+constexpr uint32_t METRICS_GAUGE_INTERVAL_MS = 10000;       // Heap/RSSI/backlog gauge refresh
+
+// ============================================================================
+// JSON Arena (short-lived JsonDocuments and request bodies off the heap)
+// ============================================================================
+constexpr size_t JSON_ARENA_SIZE = 16384;                   // Static, larger documents spill to heap
+constexpr size_t REQUEST_BUFFER_SIZE = 4096;                // Reserved once for JSON/MsgPack POST bodies
+constexpr size_t SYNC_STATUS_BUFFER_SIZE = 384;             // sync_status.json
+
+// ============================================================================
+// Native Benchmark Suite (pio run -e native_bench)
+// ============================================================================
+constexpr uint32_t BENCH_MIN_SAMPLE_MS = 50;                // Iterations doubled until a sample takes this long
+constexpr int BENCH_SAMPLES = 5;                            // Median of these samples is reported
+constexpr uint32_t BENCH_REGRESSION_PERCENT = 25;           // Slower than baseline by more = regression
+
+// ============================================================================
+// Sensor Trace Recording / Replay (StorageConfig.traceRecording)
+// ============================================================================
+constexpr size_t TRACE_BUFFER_BYTES = 4096;                 // RAM buffer between SD flushes; full = drop
+constexpr uint32_t TRACE_FLUSH_INTERVAL_MS = 5000;          // Flushed by the storage task
+constexpr uint32_t TRACE_MAX_FILE_BYTES = 1048576;          // Then next trace_NNN.csv
+constexpr int TRACE_MAX_FILES = 20;                         // Recording stops when all are used
+
+// ============================================================================
+// WiFi Fast Reconnect (last-good BSSID/channel/IP in NVS)
+// ============================================================================
+constexpr bool WIFI_FAST_CONNECT_ENABLED = true;
+constexpr uint32_t WIFI_FAST_CONNECT_TIMEOUT_MS = 3000;  // Then full scan
+constexpr bool WIFI_REUSE_IP_LEASE = false;              // Static IP from last lease (skips DHCP)
+constexpr uint32_t WIFI_CONNECT_POLL_MS = 20;
+constexpr const char* WIFI_FAST_NVS_NAMESPACE = "wififast";
+
+// ============================================================================
+// Boot Timeline / Fast Boot
+// ============================================================================
+constexpr uint32_t BOOT_SERIAL_WAIT_MS = 100;               // Was 1000ms; USB-serial attach only
+constexpr size_t BOOT_PROFILER_MAX_PHASES = 24;
+constexpr bool FAST_BOOT_ENABLED = true;                    // Use cached Hub URL/nodeId/config from NVS
+constexpr uint32_t BOOT_DEFERRED_WORK_TIMEOUT_MS = 60000;   // Run deferred work even without a reading
+
+// ============================================================================
+// Windowed Aggregation (window length per sensor from Hub config)
+// ============================================================================
+constexpr bool AGGREGATION_STORE_RAW_SAMPLES = true;  // Keep raw samples on SD (LOCAL_ONLY / LOCAL_AND_REMOTE)
+
+// ============================================================================
+// Report-by-Exception Deadband (thresholds per capability from Hub config)
+// ============================================================================
+constexpr bool DEADBAND_USE_TYPE_DEFAULTS = false;      // Opt-in: per-type default deadband when the Hub sets none
+constexpr uint32_t DEADBAND_MAX_SILENCE_SECONDS = 900;  // Heartbeat send after 15 min silence
+
+// ============================================================================
+// Hardware Scan (targeted scan, result cache in NVS)
+// ============================================================================
+constexpr uint32_t I2C_SCAN_CLOCK_HZ = 400000;      // Fast-mode probe clock
+constexpr uint16_t I2C_SCAN_TIMEOUT_MS = 5;         // Per-address probe timeout
+constexpr uint32_t ANALOG_SCAN_SAMPLE_DELAY_MS = 1; // Between stability samples
+constexpr bool HW_SCAN_CACHE_ENABLED = true;        // Skip scan if config CRC unchanged
+constexpr const char* HW_SCAN_NVS_NAMESPACE = "hwscan";
+
+// ============================================================================
+// GPS Ingestion (background NMEA parser task)
+// ============================================================================
+constexpr uint32_t GPS_TASK_STACK_SIZE = 4096;      // Bytes
+constexpr uint32_t GPS_TASK_PRIORITY = 3;           // Above loop task (1)
+constexpr uint32_t GPS_PUBLISH_INTERVAL_MS = 1000;  // Republish without UART data
+constexpr uint32_t GPS_MAX_FIX_AGE_MS = 5000;       // Older fields are reported invalid
+
+// ============================================================================
+// SR04M-2 UART Frame Decoder (background task)
+// ============================================================================
+constexpr int UART_EVENT_QUEUE_SIZE = 16;           // ESP-IDF UART driver events
+constexpr uint32_t SR04M2_TASK_STACK_SIZE = 3072;   // Bytes
+constexpr uint32_t SR04M2_TASK_PRIORITY = 3;        // Above loop task (1)
+constexpr size_t SR04M2_MEDIAN_WINDOW = 5;          // Frames (odd)
+constexpr uint32_t SR04M2_MAX_FRAME_AGE_MS = 1000;  // Auto-mode sends every ~100ms
+constexpr uint32_t SR04M2_FIRST_FRAME_WAIT_MS = 500; // Wait after (re)start only
+
 // Environment variable names
 constexpr const char* ENV_HUB_HOST = "HUB_HOST";
 constexpr const char* ENV_HUB_PORT = "HUB_PORT";
@@ -91,6 +279,13 @@ constexpr const char* ENV_WIFI_SSID = "WIFI_SSID";
 constexpr const char* ENV_WIFI_PASSWORD = "WIFI_PASSWORD";
 constexpr const char* ENV_DISCOVERY_ENABLED = "DISCOVERY_ENABLED";
 constexpr const char* ENV_DISCOVERY_PORT = "DISCOVERY_PORT";
+constexpr const char* ENV_METRICS_PORT = "METRICS_PORT";
+constexpr const char* ENV_ARENA_SOAK_DAYS = "ARENA_SOAK_DAYS";
+constexpr const char* ENV_BENCH_OUTPUT = "BENCH_OUTPUT";
+constexpr const char* ENV_BENCH_BASELINE = "BENCH_BASELINE";
+constexpr const char* ENV_TRACE_REPLAY = "TRACE_REPLAY";
+constexpr const char* ENV_TRACE_REPLAY_SPEED = "TRACE_REPLAY_SPEED";
+constexpr const char* ENV_TRACE_REPLAY_OUTPUT = "TRACE_REPLAY_OUTPUT";
 
 } // namespace config
 
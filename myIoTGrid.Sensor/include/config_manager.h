@@ -69,6 +69,28 @@ public:
      */
     String getSerial();
 
+    /**
+     * Cache the Hub sensor configuration (raw JSON) and the Hub URL it was
+     * fetched from (after discovery / HTTP fallback) for fast boot
+     */
+    bool saveSensorConfig(const String& json, const String& activeUrl);
+
+    /**
+     * Load the cached sensor configuration
+     * @return false if no configuration is cached
+     */
+    bool loadSensorConfig(String& json, String& activeUrl);
+
+    /**
+     * Check for a cached sensor configuration (next connect is a fast boot)
+     */
+    bool hasSensorConfig();
+
+    /**
+     * Drop the cached sensor configuration (next boot is a full boot)
+     */
+    void clearSensorConfig();
+
 private:
     static constexpr const char* NVS_NAMESPACE = "myiotgrid";
 
@@ -81,6 +103,8 @@ private:
     static constexpr const char* KEY_TARGET_MODE = "target_mode";
     static constexpr const char* KEY_TENANT_ID = "tenant_id";
     static constexpr const char* KEY_CONFIGURED = "configured";
+    static constexpr const char* KEY_SENSOR_CONFIG = "sensor_cfg";
+    static constexpr const char* KEY_ACTIVE_URL = "active_url";
 
     bool _initialized;
 };
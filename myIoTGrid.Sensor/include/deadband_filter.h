@@ -0,0 +1,122 @@
+/**
+ * myIoTGrid.Sensor - Deadband Filter
+ *
+ * Report-by-exception between reading and send/store: a sample is only
+ * forwarded if it left the deadband around the last forwarded value
+ * (absolute or relative), if it changes faster than a slope threshold,
+ * or if the capability has been silent for maxSilenceSeconds (heartbeat
+ * proving the node is alive).
+ *
+ * Thresholds come from the Hub capability config; unset values fall back
+ * to a per-measurement-type default.
+ */
+
+#ifndef DEADBAND_FILTER_H
+#define DEADBAND_FILTER_H
+
+#include <Arduino.h>
+#include <map>
+#include "api_client.h"
+
+/**
+ * Deadband thresholds for one capability (0 = criterion disabled)
+ */
+struct DeadbandParams {
+    double absolute;            // Forward if |value - lastSent| >= absolute
+    double relativePercent;     // Forward if |value - lastSent| >= % of |lastSent|
+    double slopePerMinute;      // Forward if |rate of change| >= slope (units/min)
+    uint32_t maxSilenceSeconds; // Forced forward after this silence
+
+    DeadbandParams() : absolute(0.0), relativePercent(0.0), slopePerMinute(0.0), maxSilenceSeconds(0) {}
+
+    bool isEnabled() const {
+        return absolute > 0.0 || relativePercent > 0.0 || slopePerMinute > 0.0;
+    }
+};
+
+/**
+ * Result of a filter decision
+ */
+enum class DeadbandDecision : uint8_t {
+    SEND_FIRST,         // First sample of this capability
+    SEND_CHANGED,       // Left the deadband or slope exceeded
+    SEND_HEARTBEAT,     // Max silence reached
+    SEND_UNFILTERED,    // No thresholds configured
+    SUPPRESS            // Within deadband
+};
+
+/**
+ * Deadband Filter - keyed by endpoint and measurement type
+ */
+class DeadbandFilter {
+public:
+    DeadbandFilter();
+
+    /**
+     * Build thresholds from Hub config (per-type default only with DEADBAND_USE_TYPE_DEFAULTS)
+     * @param measurementType Capability measurement type (e.g. "temperature")
+     * @param absolute Hub absolute deadband (< 0 = use type default)
+     * @param relativePercent Hub relative deadband in % (< 0 = off)
+     * @param slopePerMinute Hub slope threshold (< 0 = off)
+     * @param maxSilenceSeconds Hub max silence (<= 0 = config default)
+     */
+    static DeadbandParams resolveParams(const String& measurementType, double absolute,
+                                        double relativePercent, double slopePerMinute,
+                                        int maxSilenceSeconds);
+
+    /**
+     * Check if a configuration changes any capability threshold
+     * (endpoint and calibration changes: see schedule::samplingChanged)
+     */
+    static bool thresholdsChanged(const NodeConfigurationResponse& previous,
+                                  const NodeConfigurationResponse& next);
+
+    /**
+     * Decide whether a sample is forwarded
+     * Records the sample as sent unless the decision is SUPPRESS.
+     * @param endpointId Endpoint ID from Hub
+     * @param measurementType Capability measurement type
+     * @param value Calibrated sample value
+     * @param params Thresholds
+     * @param now Current millis()
+     */
+    DeadbandDecision evaluate(int endpointId, const String& measurementType, double value,
+                              const DeadbandParams& params, unsigned long now);
+
+    /**
+     * Check if a decision forwards the sample
+     */
+    static bool isSend(DeadbandDecision decision) { return decision != DeadbandDecision::SUPPRESS; }
+
+    /**
+     * Get decision name for logging
+     */
+    static const char* getDecisionName(DeadbandDecision decision);
+
+    /**
+     * Drop per-capability state (next sample is sent)
+     */
+    void reset();
+
+    // Counters since boot
+    unsigned long getSentCount() const { return _sent; }
+    unsigned long getSuppressedCount() const { return _suppressed; }
+    unsigned long getHeartbeatCount() const { return _heartbeats; }
+
+private:
+    struct ChannelState {
+        double lastSentValue;
+        unsigned long lastSentMs;
+        double lastValue;
+        unsigned long lastMs;
+    };
+
+    std::map<String, ChannelState> _channels;
+    unsigned long _sent;
+    unsigned long _suppressed;
+    unsigned long _heartbeats;
+
+    static String makeKey(int endpointId, const String& measurementType);
+};
+
+#endif // DEADBAND_FILTER_H
@@ -0,0 +1,145 @@
+/**
+ * myIoTGrid.Sensor - GPS NMEA Ingestion
+ *
+ * Background task that continuously feeds the GPS UART into TinyGPSPlus
+ * and publishes the latest fix as a lock-free snapshot.
+ *
+ * The task is woken by the UART receive event (HardwareSerial::onReceive),
+ * so GPS capability reads no longer drain the UART themselves and return
+ * in microseconds from the snapshot.
+ *
+ * Snapshot publishing uses a sequence lock: the single writer (ingestion
+ * task) bumps the sequence to odd, copies the data and bumps it to even.
+ * Readers retry until they observe the same even sequence before and after
+ * copying.
+ *
+ * NMEA parsing is platform-independent: on native the trace replay feeds
+ * recorded UART bytes through encode().
+ */
+
+#ifndef GPS_INGESTION_H
+#define GPS_INGESTION_H
+
+#include <Arduino.h>
+#include <TinyGPSPlus.h>
+#include <atomic>
+
+#ifdef PLATFORM_ESP32
+#include <HardwareSerial.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+/**
+ * Latest GPS fix (copied out of the ingestion task)
+ */
+struct GpsSnapshot {
+    double latitude;          // Degrees
+    double longitude;         // Degrees
+    double altitudeM;         // Meters above MSL
+    double speedKmph;         // km/h
+    double hdop;              // Horizontal dilution of precision
+    uint32_t satellites;      // Satellites in use
+    uint8_t fixType;          // 0 = none, 2 = 2D, 3 = 3D
+
+    // Validity (false if never received or older than GPS_MAX_FIX_AGE_MS)
+    bool locationValid;
+    bool altitudeValid;
+    bool speedValid;
+    bool satellitesValid;
+    bool hdopValid;
+
+    uint32_t utcDate;         // DDMMYY (0 if unknown)
+    uint32_t utcTime;         // HHMMSSCC (0 if unknown)
+    uint32_t updatedAtMs;     // millis() when snapshot was published
+    uint32_t lastSentenceMs;  // millis() of last received NMEA byte
+
+    // Statistics
+    uint32_t sentencesWithFix;
+    uint32_t failedChecksums;
+    uint32_t charsProcessed;
+};
+
+/**
+ * GPS Ingestion - Singleton owning the NMEA parser task
+ */
+class GpsIngestion {
+public:
+    /**
+     * Get singleton instance
+     */
+    static GpsIngestion& getInstance();
+
+#ifdef PLATFORM_ESP32
+    /**
+     * Start ingestion on an allocated GPS serial port
+     * @param serial HardwareSerial from UARTManager
+     * @return true if the task is running
+     */
+    bool start(HardwareSerial* serial);
+
+    /**
+     * Stop ingestion and detach from the serial port
+     * Must be called before the UART is released.
+     */
+    void stop();
+
+    /**
+     * Check if ingestion task is running
+     */
+    bool isRunning() const { return _task != nullptr; }
+#endif
+
+    /**
+     * Feed received NMEA bytes into the parser and publish
+     * (ingestion task; trace replay on native)
+     * @return Number of sentences parsed (GGA/RMC with valid checksum)
+     */
+    uint32_t encode(const uint8_t* data, size_t length);
+
+    /**
+     * Get latest fix (lock-free, safe from any task)
+     */
+    GpsSnapshot getSnapshot() const;
+
+private:
+    GpsIngestion();
+    ~GpsIngestion();
+
+    // Prevent copying
+    GpsIngestion(const GpsIngestion&) = delete;
+    GpsIngestion& operator=(const GpsIngestion&) = delete;
+
+#ifdef PLATFORM_ESP32
+    HardwareSerial* _serial;
+    TaskHandle_t _task;
+    std::atomic<bool> _stopRequested;
+#endif
+
+    // Parser state (only touched by the ingestion task)
+    TinyGPSPlus _gps;
+    uint32_t _lastByteMs;
+
+    // Published snapshot (sequence lock)
+    GpsSnapshot _snapshot;
+    std::atomic<uint32_t> _sequence;
+
+#ifdef PLATFORM_ESP32
+    /**
+     * Task entry point
+     */
+    static void taskEntry(void* param);
+
+    /**
+     * Ingestion loop: wait for UART event, drain, parse, publish
+     */
+    void run();
+#endif
+
+    /**
+     * Build snapshot from parser state and publish it
+     */
+    void publish();
+};
+
+#endif // GPS_INGESTION_H
@@ -0,0 +1,99 @@
+/**
+ * myIoTGrid.Sensor - Streaming gzip Encoder
+ *
+ * Small-footprint deflate (RFC 1951) compressor with gzip framing
+ * (RFC 1952) for HTTP request bodies. LZ77 with hash chains over a
+ * bounded sliding window, fixed Huffman codes (no dynamic trees), so the
+ * memory use is fixed at begin(): 2 * window + hash table + chain table
+ * (about 10 KB at the default 2 KB window).
+ *
+ * JSON uploads compress well even with fixed codes, because most of the
+ * payload is repeated keys ("sensorType", "endpointId", ...).
+ *
+ * Input can be written in pieces; output goes to a sink callback in
+ * small chunks as it is produced.
+ */
+
+#ifndef GZIP_ENCODER_H
+#define GZIP_ENCODER_H
+
+#include <Arduino.h>
+#include <functional>
+#include <vector>
+
+class GzipEncoder {
+public:
+    // Receives compressed output; return false to abort
+    using Sink = std::function<bool(const uint8_t* data, size_t length)>;
+
+    /**
+     * @param windowBits log2 of the LZ77 window (9..15)
+     */
+    explicit GzipEncoder(uint8_t windowBits);
+    ~GzipEncoder();
+
+    GzipEncoder(const GzipEncoder&) = delete;
+    GzipEncoder& operator=(const GzipEncoder&) = delete;
+
+    /**
+     * Allocate the window and write the gzip header
+     * @return false if out of memory
+     */
+    bool begin(Sink sink);
+
+    /**
+     * Compress the next piece of input
+     */
+    bool write(const uint8_t* data, size_t length);
+
+    /**
+     * Flush the last block and write the gzip trailer; frees the window
+     */
+    bool finish();
+
+    size_t getInputBytes() const { return _inputBytes; }
+    size_t getOutputBytes() const { return _outputBytes; }
+
+    /**
+     * Compress a complete buffer
+     * @return false if out of memory
+     */
+    static bool compress(const uint8_t* data, size_t length, std::vector<uint8_t>& out,
+                         uint8_t windowBits);
+
+private:
+    const uint32_t _windowSize;
+    uint8_t* _window;           // 2 * window: history + lookahead
+    uint16_t* _head;            // Hash -> last position + 1 (0 = none)
+    uint16_t* _prev;            // Position -> previous position + 1 with same hash
+    uint32_t _fill;             // Bytes in _window
+    uint32_t _pos;              // Next position to encode
+
+    Sink _sink;
+    uint8_t _out[128];
+    size_t _outLen;
+    uint32_t _bitBuf;
+    uint8_t _bitCount;
+    bool _ok;
+
+    uint32_t _crc;
+    size_t _inputBytes;
+    size_t _outputBytes;
+
+    void encode(bool flush);
+    void slide();
+    void insertHash(uint32_t pos);
+    uint32_t longestMatch(uint32_t pos, uint32_t maxLen, uint32_t& distance) const;
+
+    void putBits(uint32_t bits, uint8_t count);
+    void putCode(uint32_t code, uint8_t length);  // Huffman code, MSB first
+    void putLiteral(uint8_t literal);
+    void putMatch(uint32_t length, uint32_t distance);
+    void putByte(uint8_t byte);
+    void flushBits();
+    void flushOutput();
+
+    static uint32_t updateCrc(uint32_t crc, const uint8_t* data, size_t length);
+};
+
+#endif // GZIP_ENCODER_H
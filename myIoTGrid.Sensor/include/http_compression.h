@@ -0,0 +1,82 @@
+/**
+ * myIoTGrid.Sensor - HTTP Request Compression
+ *
+ * Decides per request whether a body is sent gzip-compressed and keeps
+ * the negotiation state with the Hub:
+ *
+ *   UNKNOWN ──(response with Accept-Encoding: gzip)──▶ SUPPORTED
+ *   SUPPORTED ──(compressed request rejected, 400/415)──▶ REJECTED
+ *
+ * Bodies go out uncompressed until the Hub has advertised gzip in an
+ * Accept-Encoding response header (RFC 7694), so older Hubs never see a
+ * body they cannot read. Counts raw vs. sent bytes for the heartbeat.
+ */
+
+#ifndef HTTP_COMPRESSION_H
+#define HTTP_COMPRESSION_H
+
+#include <Arduino.h>
+#include <mutex>
+#include <vector>
+#include "config.h"
+
+/**
+ * Negotiation state with the Hub
+ */
+enum class CompressionSupport : uint8_t {
+    UNKNOWN,        // No Accept-Encoding seen yet
+    SUPPORTED,      // Hub advertised gzip
+    REJECTED        // Hub refused a compressed body (until reboot)
+};
+
+/**
+ * HTTP Compression - singleton shared by ApiClient and DebugLogUploader
+ */
+class HttpCompression {
+public:
+    static HttpCompression& getInstance();
+
+    /**
+     * Compress a request body if enabled, negotiated and worthwhile
+     * @param out Receives the gzip body
+     * @return true if out should be sent with Content-Encoding: gzip
+     */
+    bool compress(const String& body, std::vector<uint8_t>& out);
+    bool compress(const uint8_t* data, size_t length, std::vector<uint8_t>& out);
+
+    /**
+     * Record the Accept-Encoding header of a Hub response (may be empty)
+     */
+    void onAcceptEncoding(const String& header);
+
+    /**
+     * A compressed request was refused; send uncompressed from now on
+     */
+    void onRejected(int statusCode);
+
+    CompressionSupport getSupport() const;
+
+    /**
+     * Sent/raw bytes of all compressed requests (1.0 = nothing compressed)
+     */
+    float getRatio() const;
+
+    /**
+     * Compression statistics JSON object (heartbeat)
+     */
+    String getStatsJson() const;
+
+private:
+    HttpCompression();
+    HttpCompression(const HttpCompression&) = delete;
+    HttpCompression& operator=(const HttpCompression&) = delete;
+
+    mutable std::mutex _mutex;
+    CompressionSupport _support;
+    uint32_t _compressedRequests;
+    uint32_t _uncompressedRequests;
+    uint64_t _rawBytes;             // Bodies before compression (compressed requests only)
+    uint64_t _sentBytes;            // Bodies as sent (compressed requests only)
+};
+
+#endif // HTTP_COMPRESSION_H
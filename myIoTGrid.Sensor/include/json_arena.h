@@ -0,0 +1,87 @@
+/**
+ * myIoTGrid.Sensor - JSON Arena Allocator
+ *
+ * Bump allocator for the short-lived JsonDocuments of the request paths
+ * (ApiClient, sync status, heartbeat stats). Every request used to build
+ * a heap document and free it again, interleaved with long-lived heap
+ * users (WiFi, log queues) - on nodes that run for weeks this splits the
+ * heap until the ~40 KB contiguous block of a TLS handshake is gone.
+ *
+ * The arena is one static block reserved at boot:
+ *   allocate    bump the top (8-byte aligned, size header per block)
+ *   deallocate  mark released, pop released blocks off the top
+ *   reallocate  grow/shrink in place if top block, else move
+ * When the last live block of a cycle is released the arena is empty
+ * again, so it never fragments. Documents that do not fit spill to the
+ * heap (counted as fallbacks in the metrics).
+ *
+ * Use for documents that die within the call that creates them:
+ *   JsonDocument doc(&JsonArena::getInstance());
+ *
+ * Thread-safe (loop, network and sync upload tasks share it).
+ */
+
+#ifndef JSON_ARENA_H
+#define JSON_ARENA_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <mutex>
+#include "config.h"
+
+/**
+ * JSON Arena - singleton ArduinoJson allocator
+ */
+class JsonArena : public ArduinoJson::Allocator {
+public:
+    static JsonArena& getInstance();
+
+    void* allocate(size_t size) override;
+    void deallocate(void* ptr) override;
+    void* reallocate(void* ptr, size_t newSize) override;
+
+    // Statistics since boot
+    size_t getPeakBytes() const { return _peak; }
+    uint32_t getFallbacks() const { return _fallbacks; }
+    uint32_t getRewinds() const { return _rewinds; }
+    size_t getUsedBytes() const { return _top; }
+    uint32_t getLiveBlocks() const { return _live; }
+
+    /**
+     * {"size","peak","live","rewinds","fallbacks"} as JSON object
+     */
+    String getStatsJson() const;
+
+private:
+    JsonArena();
+    JsonArena(const JsonArena&) = delete;
+    JsonArena& operator=(const JsonArena&) = delete;
+
+    // Precedes every block; keeps the payload 8-byte aligned
+    struct BlockHeader {
+        uint32_t size;          // Payload bytes (aligned), high bit = released
+        uint32_t prev;          // Offset + 1 of the block below (0 = bottom)
+    };
+
+    alignas(8) uint8_t _buffer[config::JSON_ARENA_SIZE];
+    size_t _top;
+    uint32_t _topBlock;         // Offset + 1 of the top block (0 = empty)
+    uint32_t _live;             // Arena blocks not yet released
+    size_t _peak;
+    uint32_t _fallbacks;
+    uint32_t _rewinds;
+    mutable std::mutex _mutex;
+
+    bool owns(const void* ptr) const {
+        return ptr >= _buffer && ptr < _buffer + sizeof(_buffer);
+    }
+
+    static BlockHeader* headerOf(uint8_t* payload) {
+        return (BlockHeader*)(payload - sizeof(BlockHeader));
+    }
+
+    void* allocateLocked(size_t size);
+    void releaseLocked(uint8_t* payload);
+};
+
+#endif // JSON_ARENA_H
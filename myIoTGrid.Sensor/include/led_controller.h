@@ -67,6 +67,12 @@ public:
      */
     void update();
 
+    /**
+     * Milliseconds until the next pattern transition (for the loop scheduler)
+     * @return 0 if update() is due, UINT32_MAX for static patterns
+     */
+    uint32_t getNextUpdateMs() const;
+
     /**
      * Turn LED on
      */
@@ -0,0 +1,105 @@
+/**
+ * myIoTGrid.Sensor - Loop Profiler
+ *
+ * Times every LoopScheduler task (and optional sub-stages inside a task,
+ * e.g. the sync manager inside "storage") plus the wake-up lateness of
+ * the loop itself. Per stage: count, min/avg/max since boot, p99 over the
+ * last LOOP_PROFILER_RING_SIZE runs and the number of budget overruns.
+ *
+ * Recording is a few additions and one store into a fixed ring buffer,
+ * so it always runs. What gets printed follows the debug level:
+ *   PRODUCTION  nothing (stats in the heartbeat only)
+ *   NORMAL      budget overruns, at most once per stage and minute
+ *   DEBUG       additionally the full table every LOOP_PROFILER_REPORT_MS
+ *
+ * Loop task only; not thread-safe.
+ */
+
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * Timing of one loop stage
+ */
+struct LoopStageStats {
+    const char* name;           // Static string
+    uint32_t budgetUs;
+    unsigned long count;
+    uint64_t totalUs;
+    uint32_t minUs;
+    uint32_t maxUs;
+    unsigned long overruns;
+    unsigned long lastWarnMs;
+    uint16_t ring[config::LOOP_PROFILER_RING_SIZE];     // Last runs in us (saturating)
+    uint16_t ringPos;
+};
+
+/**
+ * Loop Profiler - singleton, fixed stage table
+ */
+class LoopProfiler {
+public:
+    static LoopProfiler& getInstance();
+
+    /**
+     * Register a stage
+     * @param name Stage name (must be a static string)
+     * @return Stage index, -1 if the table is full
+     */
+    int addStage(const char* name, uint32_t budgetUs = config::LOOP_STAGE_BUDGET_US);
+
+    /**
+     * Record one run of a stage (ignored for index -1)
+     */
+    void record(int stage, uint32_t durationUs);
+
+    /**
+     * Record how late the loop woke up against its planned deadline
+     */
+    void recordWakeLateness(uint32_t lateUs) { record(_wakeStage, lateUs); }
+
+    /**
+     * Periodic report (DEBUG level); call once per loop pass
+     */
+    void loop(unsigned long now);
+
+    /**
+     * Per-stage {"n","avg","p99","max","over"} as JSON object (heartbeat)
+     */
+    String getStatsJson() const;
+
+    /**
+     * Print the stage table to Serial
+     */
+    void printReport() const;
+
+    /**
+     * Times the enclosing scope as one run of a stage
+     */
+    class Scope {
+    public:
+        explicit Scope(int stage) : _stage(stage), _startUs(micros()) {}
+        ~Scope() { LoopProfiler::getInstance().record(_stage, (uint32_t)(micros() - _startUs)); }
+
+    private:
+        int _stage;
+        unsigned long _startUs;
+    };
+
+private:
+    LoopProfiler();
+    LoopProfiler(const LoopProfiler&) = delete;
+    LoopProfiler& operator=(const LoopProfiler&) = delete;
+
+    LoopStageStats _stages[config::LOOP_PROFILER_MAX_STAGES];
+    size_t _count;
+    int _wakeStage;
+    unsigned long _lastReportMs;
+
+    uint32_t percentile(const LoopStageStats& stage, uint32_t permille) const;
+};
+
+#endif // LOOP_PROFILER_H
@@ -0,0 +1,115 @@
+/**
+ * myIoTGrid.Sensor - Loop Scheduler
+ *
+ * Cooperative, deadline-driven replacement for the fixed delay(10) main
+ * loop. Every subsystem registers a task that reports the milliseconds
+ * until it next needs to run; loop() runs the due tasks and then blocks
+ * until the earliest deadline or an external event (GPIO edge, WiFi
+ * event), whichever comes first.
+ *
+ * ESP32: the loop task blocks on a task notification, so FreeRTOS idles
+ * and - with power management and tickless idle in the SDK - the chip
+ * enters automatic light sleep; otherwise WiFi modem sleep still applies.
+ * Native: eventfd + poll() with the deadline as timeout.
+ */
+
+#ifndef LOOP_SCHEDULER_H
+#define LOOP_SCHEDULER_H
+
+#include <Arduino.h>
+#include <functional>
+#include <vector>
+#include "config.h"
+
+/**
+ * Loop Scheduler - singleton, tasks run in registration order
+ */
+class LoopScheduler {
+public:
+    // Deadline value for tasks that only run on external events
+    static constexpr uint32_t IDLE = UINT32_MAX;
+
+    // Milliseconds until the task is due (0 = run now, IDLE = wait for event)
+    using DeadlineFn = std::function<uint32_t(unsigned long now)>;
+    using RunFn = std::function<void(unsigned long now)>;
+
+    static LoopScheduler& getInstance();
+
+    /**
+     * Bind to the calling (loop) task and enable power management
+     * Call once at the end of setup().
+     */
+    void begin();
+
+    /**
+     * Register a task with its own deadline query (profiled as a LoopProfiler stage)
+     * @param name Task name for logging (must be a static string)
+     * @param deadline Returns ms until due; queried on every pass
+     * @param run Executed when deadline() returns 0
+     */
+    void addTask(const char* name, DeadlineFn deadline, RunFn run);
+
+    /**
+     * Register a task that runs every intervalMs
+     */
+    void addPeriodicTask(const char* name, uint32_t intervalMs, RunFn run);
+
+    /**
+     * Run all due tasks (all tasks after an external event)
+     */
+    void runDue();
+
+    /**
+     * Block until the earliest deadline or wake(), at most LOOP_MAX_SLEEP_MS
+     */
+    void sleepUntilNextDeadline();
+
+    /**
+     * Wake the loop from another task/thread (e.g. WiFi event handler)
+     */
+    void wake();
+
+    /**
+     * Wake the loop on any edge of an active-low GPIO (buttons)
+     * With light sleep the pin is sampled every LOOP_WAKE_PIN_POLL_MS instead.
+     */
+    void addWakePin(int pin);
+
+    /**
+     * Milliseconds until the earliest task deadline
+     */
+    uint32_t getNextDeadlineMs() const;
+
+    // Counters since begin()
+    unsigned long getWakeups() const { return _wakeups; }
+    unsigned long getSleptMs() const { return _sleptMs; }
+    bool isLightSleepEnabled() const { return _lightSleep; }
+
+private:
+    LoopScheduler();
+    LoopScheduler(const LoopScheduler&) = delete;
+    LoopScheduler& operator=(const LoopScheduler&) = delete;
+
+    struct Task {
+        const char* name;
+        DeadlineFn deadline;
+        RunFn run;
+        int stage;              // LoopProfiler stage (-1 = not profiled)
+    };
+
+    std::vector<Task> _tasks;
+    std::vector<int> _wakePins;
+    volatile bool _eventPending;
+    unsigned long _wakeups;
+    unsigned long _sleptMs;
+    bool _lightSleep;
+
+#ifdef PLATFORM_ESP32
+    static void onWakePin(void* arg);
+    TaskHandle_t _loopTask;
+#else
+    int _eventFd;
+#endif
+};
+
+#endif // LOOP_SCHEDULER_H
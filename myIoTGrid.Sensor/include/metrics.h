@@ -0,0 +1,157 @@
+/**
+ * myIoTGrid.Sensor - Metrics Registry
+ *
+ * One place for the performance counters of the hot paths (sensor reads,
+ * Hub requests, SD appends, loop passes, heap). All metrics are declared
+ * up front in the enums below, so an update is an array index plus one
+ * relaxed atomic add - no lookup, no lock, no allocation - and is safe
+ * from the loop, the sampling task and the sync upload task.
+ *
+ *   Counter     monotonic since boot
+ *   Gauge       last set value
+ *   Histogram   fixed buckets (per histogram), count, sum and max
+ *
+ * Exported as a compact JSON snapshot in the heartbeat ("metrics") and,
+ * on native, as Prometheus text on a local scrape port (METRICS_PORT).
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include <atomic>
+
+namespace metrics {
+
+/**
+ * Counters (append at the end, before COUNT_END)
+ */
+enum class Counter : uint8_t {
+    SENSOR_READS,
+    SENSOR_READ_ERRORS,
+    HTTP_REQUESTS,
+    HTTP_ERRORS,            // No response or non-2xx
+    HTTP_REJECTED,          // Refused locally by the circuit breaker
+    SD_APPENDS,
+    SD_APPEND_ERRORS,
+    ARENA_FALLBACKS,        // JsonArena full, block taken from heap
+    COUNT_END               // Not a metric
+};
+
+/**
+ * Gauges (refreshed by the "metrics" loop task)
+ */
+enum class Gauge : uint8_t {
+    HEAP_FREE,
+    HEAP_MIN_FREE,          // Lowest free heap since boot
+    WIFI_RSSI,
+    SYNC_PENDING,
+    LOGGING_OVERHEAD_US,    // DebugManager, total since boot
+    SD_LOG_DROPPED,         // SDLogger entries dropped
+    HEAP_LARGEST_BLOCK,     // Largest contiguous free block (fragmentation)
+    ARENA_PEAK,             // JsonArena high-water mark
+    COUNT_END
+};
+
+/**
+ * Latency histograms
+ */
+enum class Histogram : uint8_t {
+    SENSOR_READ_US,
+    HTTP_REQUEST_MS,
+    SD_APPEND_US,
+    LOOP_PASS_US,           // LoopScheduler::runDue()
+    COUNT_END
+};
+
+constexpr size_t HISTOGRAM_BUCKETS = 8;     // Plus one overflow bucket
+
+/**
+ * Metrics Registry - singleton, fixed storage for all metrics
+ */
+class Registry {
+public:
+    static Registry& getInstance();
+
+    void inc(Counter counter, uint32_t n = 1) {
+        _counters[(size_t)counter].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void set(Gauge gauge, int32_t value) {
+        _gauges[(size_t)gauge].store(value, std::memory_order_relaxed);
+        _gaugeSet[(size_t)gauge].store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * Lower a gauge to value if it is below the current one (first call sets it)
+     */
+    void setMin(Gauge gauge, int32_t value);
+
+    void observe(Histogram histogram, uint32_t value);
+
+    uint32_t get(Counter counter) const {
+        return _counters[(size_t)counter].load(std::memory_order_relaxed);
+    }
+
+    int32_t get(Gauge gauge) const {
+        return _gauges[(size_t)gauge].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Compact JSON object for the heartbeat
+     * Histograms as {"n":count,"avg":..,"p95":..,"max":..} (p95 = bucket upper bound)
+     */
+    String getSnapshotJson() const;
+
+    /**
+     * Prometheus text exposition format (version 0.0.4)
+     */
+    String getPrometheusText() const;
+
+#ifdef PLATFORM_NATIVE
+    /**
+     * Serve getPrometheusText() on GET /metrics (background thread)
+     */
+    bool startScrapeServer(uint16_t port);
+#endif
+
+private:
+    Registry();
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    struct HistogramData {
+        std::atomic<uint32_t> buckets[HISTOGRAM_BUCKETS + 1];
+        std::atomic<uint32_t> count;
+        std::atomic<uint32_t> sum;      // Wraps like a counter reset
+        std::atomic<uint32_t> max;
+    };
+
+    std::atomic<uint32_t> _counters[(size_t)Counter::COUNT_END];
+    std::atomic<int32_t> _gauges[(size_t)Gauge::COUNT_END];
+    std::atomic<bool> _gaugeSet[(size_t)Gauge::COUNT_END];    // Unset gauges are not exported
+    HistogramData _histograms[(size_t)Histogram::COUNT_END];
+
+    uint32_t percentile(const HistogramData& data, const uint32_t* bounds, uint32_t permille) const;
+};
+
+inline void inc(Counter counter, uint32_t n = 1) { Registry::getInstance().inc(counter, n); }
+inline void set(Gauge gauge, int32_t value) { Registry::getInstance().set(gauge, value); }
+inline void observe(Histogram histogram, uint32_t value) { Registry::getInstance().observe(histogram, value); }
+
+/**
+ * Records the lifetime of a scope into a *_US histogram
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram histogram) : _histogram(histogram), _startUs(micros()) {}
+    ~ScopedTimer() { observe(_histogram, (uint32_t)(micros() - _startUs)); }
+
+private:
+    Histogram _histogram;
+    unsigned long _startUs;
+};
+
+} // namespace metrics
+
+#endif // METRICS_H
@@ -0,0 +1,117 @@
+/**
+ * myIoTGrid.Sensor - Reading Aggregator
+ *
+ * Windowed on-device aggregation of sensor samples before upload.
+ * Each endpoint/capability keeps O(1) running statistics (Welford
+ * mean/variance, min, max, count, last) over a window configured by
+ * the Hub (aggregationWindowSeconds). Only the window summary is
+ * uploaded, so sampling at 1s with a 60s window cuts uplink volume
+ * ~60x while min/max still capture the extremes.
+ */
+
+#ifndef READING_AGGREGATOR_H
+#define READING_AGGREGATOR_H
+
+#include <Arduino.h>
+#include <map>
+#include <cmath>
+
+/**
+ * Running statistics of one aggregation window (Welford)
+ */
+struct WindowStats {
+    uint32_t count;
+    double mean;
+    double m2;                  // Sum of squared deviations from mean
+    double min;
+    double max;
+    double last;
+    unsigned long startMs;      // millis() of first sample in window
+
+    WindowStats() : count(0), mean(0.0), m2(0.0), min(0.0), max(0.0), last(0.0), startMs(0) {}
+
+    /**
+     * Add a sample (numerically stable single-pass update)
+     */
+    void add(double value, unsigned long now) {
+        if (count == 0) {
+            startMs = now;
+            min = value;
+            max = value;
+        } else {
+            if (value < min) min = value;
+            if (value > max) max = value;
+        }
+        count++;
+        double delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+        last = value;
+    }
+
+    /**
+     * Sample standard deviation (0 for fewer than 2 samples)
+     */
+    double stddev() const {
+        return count > 1 ? sqrt(m2 / (count - 1)) : 0.0;
+    }
+};
+
+/**
+ * Summary of a completed window (what gets uploaded)
+ */
+struct WindowSummary {
+    uint32_t count;
+    double mean;
+    double min;
+    double max;
+    double stddev;
+    double last;
+    uint32_t windowSeconds;     // Actual window length
+};
+
+/**
+ * Reading Aggregator - keyed by endpoint and measurement type
+ */
+class ReadingAggregator {
+public:
+    ReadingAggregator();
+
+    /**
+     * Add a sample and check whether its window is complete
+     * @param endpointId Endpoint ID from Hub
+     * @param measurementType Capability measurement type
+     * @param value Calibrated sample value
+     * @param windowSeconds Window length from Hub config (> 0)
+     * @param now Current millis()
+     * @param summary Filled and window restarted if complete
+     * @return true if the window is complete and summary is valid
+     */
+    bool addSample(int endpointId, const String& measurementType, double value,
+                   uint32_t windowSeconds, unsigned long now, WindowSummary& summary);
+
+    /**
+     * Drop all open windows (e.g. after configuration change)
+     */
+    void reset();
+
+    /**
+     * Number of open windows
+     */
+    size_t getWindowCount() const { return _windows.size(); }
+
+    /**
+     * Total samples added / summaries produced since boot
+     */
+    unsigned long getSampleCount() const { return _samples; }
+    unsigned long getSummaryCount() const { return _summaries; }
+
+private:
+    std::map<String, WindowStats> _windows;
+    unsigned long _samples;
+    unsigned long _summaries;
+
+    static String makeKey(int endpointId, const String& measurementType);
+};
+
+#endif // READING_AGGREGATOR_H
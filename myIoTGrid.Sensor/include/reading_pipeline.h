@@ -0,0 +1,230 @@
+/**
+ * myIoTGrid.Sensor - Reading Pipeline
+ *
+ * Splits the reading path off the Arduino loop task:
+ *
+ *   sampling task ──▶ storage queue ──▶ storage task (SD card)
+ *        │
+ *        └─────────▶ network queue ──▶ network task (Hub upload)
+ *
+ * The sampling task runs at high priority on an absolute schedule, so a
+ * slow HTTPS request or SD write no longer shifts sample times. Queues
+ * are fixed-size and have an explicit overflow policy (drop oldest or
+ * drop newest); each queue tracks depth, high-water mark, drops and
+ * enqueue-to-delivery latency.
+ *
+ * ESP32: FreeRTOS tasks and queues, network task pinned to the WiFi core.
+ * Native: the same structure with std::thread and a mutex/condvar queue.
+ */
+
+#ifndef READING_PIPELINE_H
+#define READING_PIPELINE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <functional>
+#include "config.h"
+#include "reading_aggregator.h"
+
+#ifdef PLATFORM_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#else
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#endif
+
+// Sink flags of a reading
+constexpr uint8_t PIPELINE_SINK_STORAGE = 0x01;
+constexpr uint8_t PIPELINE_SINK_NETWORK = 0x02;
+
+/**
+ * One reading on its way to storage and/or the Hub
+ * Plain data (fixed-size strings) so FreeRTOS queues can copy it.
+ */
+struct PipelineReading {
+    char measurementType[32];
+    char unit[16];
+    char label[48];             // Sensor/capability name for logging
+    int endpointId;
+    double value;               // Sample value, or window mean if aggregated
+    bool aggregated;            // summary is valid
+    bool rawSample;             // Raw sample of an aggregation window (not logged)
+    bool simulated;             // Value from the simulator
+    WindowSummary summary;
+    uint8_t sinks;              // PIPELINE_SINK_* flags
+    uint32_t sampledMs;         // millis() at sampling
+    uint32_t enqueuedMs;        // millis() at enqueue (set by queue)
+    uint64_t captureMonoMs;     // TimeService::monotonicMs() at sampling
+    uint64_t timestampMs;       // UTC ms at sampling (0 = clock not synced yet)
+
+    static PipelineReading create(const String& measurementType, const String& unit,
+                                  const String& label, int endpointId, double value, uint8_t sinks);
+
+    /**
+     * Capture time as Unix seconds (0 = clock still not synced)
+     */
+    uint32_t getUnixTimestamp() const;
+};
+
+/**
+ * What a full queue does with a new reading
+ */
+enum class QueueOverflowPolicy : uint8_t {
+    DROP_OLDEST,    // Keep the freshest readings
+    DROP_NEWEST     // Keep the continuous older series
+};
+
+/**
+ * Queue statistics since boot
+ */
+struct QueueMetrics {
+    size_t depth;
+    size_t capacity;
+    size_t highWater;
+    uint32_t enqueued;
+    uint32_t dropped;           // Overflow drops
+    uint32_t delivered;         // Sink returned true
+    uint32_t failed;            // Sink returned false
+    uint32_t avgLatencyMs;      // Enqueue to sink done (moving average)
+    uint32_t maxLatencyMs;
+};
+
+/**
+ * Fixed-size reading queue (single producer, single consumer)
+ */
+class ReadingQueue {
+public:
+    ReadingQueue(const char* name, size_t capacity, QueueOverflowPolicy policy);
+    ~ReadingQueue();
+
+    bool begin();
+
+    /**
+     * Enqueue a reading (never blocks)
+     * @return false if a reading was dropped by the overflow policy
+     */
+    bool push(const PipelineReading& reading);
+
+    /**
+     * Dequeue a reading
+     * @param timeoutMs Maximum wait
+     * @return true if a reading was dequeued
+     */
+    bool pop(PipelineReading& reading, uint32_t timeoutMs);
+
+    /**
+     * Record the sink result of a dequeued reading (latency, delivered/failed)
+     */
+    void complete(const PipelineReading& reading, bool delivered);
+
+    const char* getName() const { return _name; }
+    QueueMetrics getMetrics() const;
+
+private:
+    const char* _name;
+    size_t _capacity;
+    QueueOverflowPolicy _policy;
+
+#ifdef PLATFORM_ESP32
+    QueueHandle_t _queue;
+#else
+    std::deque<PipelineReading> _items;
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+#endif
+
+    std::atomic<uint32_t> _highWater;
+    std::atomic<uint32_t> _enqueued;
+    std::atomic<uint32_t> _dropped;
+    std::atomic<uint32_t> _delivered;
+    std::atomic<uint32_t> _failed;
+    std::atomic<uint32_t> _avgLatencyMs;
+    std::atomic<uint32_t> _maxLatencyMs;
+
+    size_t depth() const;
+};
+
+/**
+ * Reading Pipeline - singleton owning the sampling, storage and network tasks
+ */
+class ReadingPipeline {
+public:
+    // Sampling tick; returns ms until the next tick is due
+    using SampleFn = std::function<uint32_t(unsigned long now)>;
+    // Storage/network sink; returns true if the reading was delivered
+    using SinkFn = std::function<bool(const PipelineReading& reading)>;
+
+    static ReadingPipeline& getInstance();
+
+    /**
+     * Create queues and start the tasks
+     * @param sampler Called by the sampling task
+     * @param storageSink SD storage (nullptr = no storage task)
+     * @param networkSink Hub upload
+     */
+    bool begin(SampleFn sampler, SinkFn storageSink, SinkFn networkSink);
+
+    bool isRunning() const { return _running; }
+
+    /**
+     * Route a reading to its sinks (called from the sampling task)
+     * @return false if a queue dropped a reading
+     */
+    bool submit(const PipelineReading& reading);
+
+    /**
+     * Run the sampler now (e.g. after a configuration change)
+     */
+    void wakeSampler();
+
+    QueueMetrics getStorageMetrics() const { return _storageQueue.getMetrics(); }
+    QueueMetrics getNetworkMetrics() const { return _networkQueue.getMetrics(); }
+
+    // Sampling tick lateness against the schedule
+    uint32_t getLastJitterMs() const { return _lastJitterMs; }
+    uint32_t getMaxJitterMs() const { return _maxJitterMs; }
+
+    /**
+     * Queue and sampling metrics as JSON object (heartbeat)
+     */
+    String getMetricsJson() const;
+
+private:
+    ReadingPipeline();
+    ReadingPipeline(const ReadingPipeline&) = delete;
+    ReadingPipeline& operator=(const ReadingPipeline&) = delete;
+
+    ReadingQueue _storageQueue;
+    ReadingQueue _networkQueue;
+    SampleFn _sampler;
+    SinkFn _storageSink;
+    SinkFn _networkSink;
+    bool _running;
+
+    std::atomic<uint32_t> _samplingTicks;
+    std::atomic<uint32_t> _lastJitterMs;
+    std::atomic<uint32_t> _maxJitterMs;
+
+    void runSampling();
+    void runSink(ReadingQueue& queue, SinkFn& sink);
+    void waitForSampler(uint32_t waitMs);
+
+#ifdef PLATFORM_ESP32
+    static void samplingTaskEntry(void* param);
+    static void storageTaskEntry(void* param);
+    static void networkTaskEntry(void* param);
+
+    TaskHandle_t _samplingTask;
+    TaskHandle_t _storageTask;
+    TaskHandle_t _networkTask;
+#else
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCv;
+    bool _wakeRequested;
+#endif
+};
+
+#endif // READING_PIPELINE_H
@@ -0,0 +1,146 @@
+/**
+ * myIoTGrid.Sensor - Retry Policy (jittered backoff + circuit breaker)
+ *
+ * Keeps a fleet of nodes from retrying in lockstep after a Hub outage:
+ *
+ *   DecorrelatedJitter  sleep = min(cap, random(base, 3 * previous sleep))
+ *   CircuitBreaker      CLOSED ──(N consecutive Hub failures / Retry-After)──▶ OPEN
+ *                       OPEN ──(jittered open time elapsed)──▶ HALF_OPEN
+ *                       HALF_OPEN ──(single probe ok)──▶ CLOSED, else OPEN again
+ *
+ * Requests are refused locally while the breaker is open, so the Hub
+ * only sees one probe per node and open period instead of every timer
+ * and sync retry. All timing takes "now" as a parameter so the fleet
+ * test (test/test_fleet_recovery) can run the same code in virtual time.
+ */
+
+#ifndef RETRY_POLICY_H
+#define RETRY_POLICY_H
+
+#include <Arduino.h>
+#include <mutex>
+
+namespace retry {
+
+/**
+ * Per-node random seed (hardware RNG on ESP32)
+ */
+uint32_t randomSeed();
+
+/**
+ * Milliseconds from a Retry-After header (delta-seconds; HTTP-date = 0)
+ */
+uint32_t parseRetryAfterMs(const String& header);
+
+/**
+ * Interval with +/- percent uniform jitter (periodic timers)
+ */
+uint32_t jitteredInterval(uint32_t intervalMs, uint8_t percent);
+
+/**
+ * Hub is unhealthy: no response, 408, 429 or 5xx
+ */
+bool isHubFailure(int statusCode);
+
+} // namespace retry
+
+/**
+ * Decorrelated jitter backoff ("Exponential Backoff and Jitter", AWS)
+ */
+class DecorrelatedJitter {
+public:
+    DecorrelatedJitter(uint32_t baseMs, uint32_t capMs, uint32_t seed = retry::randomSeed());
+
+    void configure(uint32_t baseMs, uint32_t capMs);
+
+    /**
+     * Next delay (grows on average, never below base or above cap)
+     */
+    uint32_t next();
+
+    /**
+     * Back to base after a success
+     */
+    void reset() { _lastMs = _baseMs; }
+
+    /**
+     * Uniform random value in [lo, hi]
+     */
+    uint32_t uniform(uint32_t lo, uint32_t hi);
+
+private:
+    uint32_t _baseMs;
+    uint32_t _capMs;
+    uint32_t _lastMs;
+    uint32_t _state;            // xorshift32
+};
+
+/**
+ * Circuit breaker state
+ */
+enum class CircuitState : uint8_t {
+    CLOSED,         // Requests pass
+    OPEN,           // Requests refused until the open time elapsed
+    HALF_OPEN       // One probe request decides
+};
+
+/**
+ * Circuit Breaker - shared by all Hub requests of a node
+ */
+class CircuitBreaker {
+public:
+    CircuitBreaker(uint32_t failureThreshold, uint32_t openBaseMs, uint32_t openMaxMs,
+                   uint32_t seed = retry::randomSeed());
+
+    /**
+     * Breaker for all requests to the Hub (ApiClient, DebugLogUploader)
+     */
+    static CircuitBreaker& forHub();
+
+    /**
+     * May a request go out now? (HALF_OPEN: only the single probe)
+     */
+    bool allowRequest(unsigned long now);
+
+    /**
+     * Record the outcome of an allowed request
+     * @param hubFailure see retry::isHubFailure()
+     * @param retryAfterMs Retry-After of the response (0 = none)
+     */
+    void onResult(bool hubFailure, uint32_t retryAfterMs, unsigned long now);
+
+    CircuitState getState() const;
+
+    /**
+     * Milliseconds until requests may go out again (0 = now)
+     */
+    uint32_t getWaitMs(unsigned long now) const;
+
+    /**
+     * State and counters as JSON object (heartbeat)
+     */
+    String getStatsJson(unsigned long now) const;
+
+    static const char* getStateString(CircuitState state);
+
+private:
+    mutable std::mutex _mutex;
+    uint32_t _failureThreshold;
+    DecorrelatedJitter _openJitter;
+
+    CircuitState _state;
+    uint32_t _consecutiveFailures;
+    unsigned long _openedAt;
+    uint32_t _openMs;
+    bool _probeInFlight;
+
+    // Statistics (since boot)
+    uint32_t _opened;
+    uint32_t _rejected;
+    uint32_t _probes;
+    uint32_t _retryAfterHonored;
+
+    void open(uint32_t openMs, unsigned long now);
+};
+
+#endif // RETRY_POLICY_H
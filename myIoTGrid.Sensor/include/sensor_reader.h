@@ -42,7 +42,7 @@
 #include <VL53L0X.h>
 #include <Adafruit_ADS1X15.h>
 #include <DHT.h>
-#include <TinyGPSPlus.h>
+#include "gps_ingestion.h"
 #include <HardwareSerial.h>
 #include <driver/uart.h>  // ESP-IDF UART driver for SR04M-2
 #endif
@@ -264,8 +264,7 @@ private:
     bool _ultrasonic_ready;
 
     // NEO-6M GPS module
-    TinyGPSPlus* _gps;
-    HardwareSerial* _gpsSerial;
+    HardwareSerial* _gpsSerial;   // Owned by UARTManager, parsed by GpsIngestion
     bool _gps_ready;
     int _gps_rx_pin;
     int _gps_tx_pin;
@@ -0,0 +1,49 @@
+/**
+ * myIoTGrid.Sensor - Sensor Poll Schedule
+ *
+ * GCD-based polling: the sensor task ticks at the greatest common divisor
+ * of all sensor intervals and reads only the sensors whose own interval
+ * has elapsed.
+ *
+ * Example: sensors with 30s, 20s and 15s intervals
+ *   GCD(30, 20, 15) = 5 -> tick every 5s, read each sensor when due
+ */
+
+#ifndef SENSOR_SCHEDULE_H
+#define SENSOR_SCHEDULE_H
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+#include "api_client.h"
+
+namespace schedule {
+
+/**
+ * Greatest common divisor (Euclidean algorithm)
+ */
+int gcd(int a, int b);
+
+/**
+ * Poll interval in seconds: GCD of all active sensor intervals
+ * @param defaultIntervalSeconds Used without active sensors (<= 0 = 60)
+ */
+int pollIntervalGCD(const std::vector<SensorAssignmentConfig>& sensors, int defaultIntervalSeconds);
+
+/**
+ * Check if a sensor is due for reading based on its interval
+ * @param lastReading endpointId -> millis() of last reading
+ */
+bool isSensorDue(const SensorAssignmentConfig& sensor,
+                 const std::map<int, unsigned long>& lastReading, unsigned long now);
+
+/**
+ * Check if a configuration changes which values are sampled or how they are windowed
+ * (endpoints, sensors, intervals, aggregation windows, calibration, capabilities).
+ * The Hub resends the unchanged configuration on every poll.
+ */
+bool samplingChanged(const NodeConfigurationResponse& previous, const NodeConfigurationResponse& next);
+
+} // namespace schedule
+
+#endif // SENSOR_SCHEDULE_H
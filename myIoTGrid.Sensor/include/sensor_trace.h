@@ -0,0 +1,173 @@
+/**
+ * myIoTGrid.Sensor - Sensor Trace Recording & Replay
+ *
+ * The reading path (calibration, deadband, aggregation, pipeline, storage)
+ * could only be exercised with live hardware or the sine-plus-noise
+ * simulator. A trace captures what the hardware actually delivered in the
+ * field, so the same path can be re-run offline against real data.
+ *
+ * Trace file /iotgrid/traces/trace_NNN.csv, one record per line:
+ *   #trace v1,<firmware>                                 header
+ *   C,<json>                                             Hub sensor configuration
+ *   T,<tickMs>,<lateMs>                                  sampling tick (schedule time,
+ *                                                        lateness of the sampling task)
+ *   R,<endpointId>,<type>,<ok>,<value>,<readUs>          SensorReader result in that tick
+ *   U,<ms>,<source>,<hex>                                raw UART bytes (gps = NMEA,
+ *                                                        sr04m2 = distance frames)
+ * The configuration is repeated at the top of every file, so each file
+ * replays on its own.
+ *
+ * Recording (ESP32, StorageConfig.traceRecording): the hooks only append to
+ * a RAM buffer (never blocking on the SD card); the storage task flushes it.
+ *
+ * Replay (native, TRACE_REPLAY=<file>): every C record is applied like a
+ * fetched configuration, every T group runs readAndSendDueSensors() with
+ * the recorded tick time, and the SensorReader calls of that tick are
+ * answered from its R records. U records are fed through the GPS
+ * (TinyGPSPlus) and SR04M-2 frame decoders. TRACE_REPLAY_SPEED scales the
+ * recorded tick spacing and read durations (0 = as fast as possible).
+ */
+
+#ifndef SENSOR_TRACE_H
+#define SENSOR_TRACE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include "config.h"
+
+#ifdef PLATFORM_NATIVE
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <string>
+#endif
+
+class SDManager;
+
+/**
+ * Trace Recorder - singleton, buffers trace records and writes them to SD
+ * Hooks are safe from the sampling, GPS and SR04M-2 tasks.
+ */
+class TraceRecorder {
+public:
+    static TraceRecorder& getInstance();
+
+    /**
+     * Start recording into the next free trace_NNN.csv
+     * @return false if the SD card is unavailable or all trace files are used
+     */
+    bool begin(SDManager& sd);
+
+    bool isRecording() const { return _recording.load(std::memory_order_relaxed); }
+
+    /**
+     * Hub configuration (raw JSON); kept for the top of each file even when not recording
+     */
+    void recordConfiguration(const String& json);
+
+    void recordTick(unsigned long tickMs);
+    void recordReading(int endpointId, const String& measurementType, bool ok,
+                       double value, uint32_t readUs);
+    void recordUart(const char* source, const uint8_t* data, size_t length);
+
+    /**
+     * Flush the buffer every TRACE_FLUSH_INTERVAL_MS (storage task, holds the SD card)
+     */
+    void loop(unsigned long now);
+
+    void flush();
+
+    uint32_t getDroppedRecords() const { return _dropped; }
+    uint32_t getBytesWritten() const { return _bytesWritten; }
+
+private:
+    TraceRecorder();
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    SDManager* _sd;
+    std::atomic<bool> _recording;
+    char _buffer[config::TRACE_BUFFER_BYTES + 1];
+    size_t _used;
+    size_t _configAt;               // Buffer offset of a pending C record (SIZE_MAX = none)
+    String _configJson;
+    int _fileNumber;
+    uint32_t _fileBytes;
+    uint32_t _bytesWritten;
+    uint32_t _dropped;
+    unsigned long _lastFlushMs;
+    std::mutex _mutex;
+
+    void append(const char* record, size_t length);
+    bool openNextFile();
+    String getFilePath(int fileNumber) const;
+};
+
+#ifdef PLATFORM_NATIVE
+/**
+ * Trace Replay - native driver feeding a recorded trace through the reading path
+ */
+class TraceReplay {
+public:
+    struct Hooks {
+        std::function<bool(const String& json)> applyConfiguration;
+        std::function<void(unsigned long tickMs)> runTick;     // readAndSendDueSensors()
+    };
+
+    static TraceReplay& getInstance();
+
+    bool isActive() const { return _active; }
+
+    /**
+     * Recorded SensorReader result for the current tick
+     * @return false if the read failed in the field or the trace has none (not recorded)
+     */
+    bool nextValue(int endpointId, const String& measurementType, double& value);
+
+    /**
+     * Replay a trace file and print the summary
+     * @param speed Time scale of tick spacing and read durations (0 = no waits)
+     * @param outputPath Optional: storage rows (CSV) and UART streams (<path>.<source>)
+     * @return false if the file could not be read or a sink failed
+     */
+    bool run(const char* path, double speed, const char* outputPath, const Hooks& hooks);
+
+private:
+    TraceReplay();
+    TraceReplay(const TraceReplay&) = delete;
+    TraceReplay& operator=(const TraceReplay&) = delete;
+
+    struct RecordedRead {
+        bool ok;
+        double value;
+        uint32_t readUs;
+    };
+
+    bool _active;
+    double _speed;
+    std::map<std::string, std::deque<RecordedRead>> _pending;   // "<endpointId>/<type>" -> reads
+    std::map<std::string, FILE*> _uartFiles;
+
+    // Statistics of the current run
+    uint32_t _ticks;
+    uint32_t _configs;
+    uint32_t _reads;
+    uint32_t _failedReads;
+    uint32_t _missingReads;         // Read by the firmware, not in the trace
+    uint32_t _unusedReads;          // In the trace, not read by the firmware
+    uint32_t _uartBytes;
+    uint32_t _gpsSentences;         // NMEA sentences parsed by TinyGPSPlus
+    uint32_t _sr04m2Frames;         // SR04M-2 frames (valid or not)
+    uint32_t _maxLateMs;            // Worst sampling task lateness in the field
+    unsigned long _firstTickMs;
+    unsigned long _lastTickMs;
+
+    static std::string key(int endpointId, const char* measurementType);
+    void finishTick(unsigned long tickMs, const Hooks& hooks);
+    void replayUart(const char* source, const char* hex, const char* outputPath);
+};
+#endif
+
+#endif // SENSOR_TRACE_H
@@ -0,0 +1,189 @@
+/**
+ * myIoTGrid.Sensor - SR04M-2 UART Frame Decoder
+ *
+ * Background task that decodes the SR04M-2 / JSN-SR04T / A02YYUW
+ * auto-mode stream on the ESP-IDF UART allocated by UARTManager.
+ *
+ * Frame format: 0xFF 0xFE DIST_HIGH DIST_LOW CHECKSUM (5 bytes)
+ * Checksum = (DIST_HIGH + DIST_LOW) & 0xFF
+ *
+ * The task blocks on the UART driver event queue, feeds every received
+ * byte through a small state machine (checksum accumulated per byte) and
+ * publishes a median-filtered distance plus frame statistics. Water level
+ * reads copy the published snapshot instead of polling the UART.
+ *
+ * The frame state machine is platform-independent: on native the trace
+ * replay feeds recorded UART bytes through decode().
+ */
+
+#ifndef SR04M2_DECODER_H
+#define SR04M2_DECODER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+
+#ifdef PLATFORM_ESP32
+#include <driver/uart.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#endif
+
+/**
+ * Result of the most recent complete frame
+ */
+enum class Sr04m2FrameStatus : uint8_t {
+    NONE = 0,           // No complete frame since start
+    OK,                 // Valid, in range
+    CHECKSUM_ERROR,     // Checksum mismatch
+    OUT_OF_RANGE        // Valid checksum, distance outside 200-7500 mm
+};
+
+/**
+ * Latest decoder state (copied out of the decoder task)
+ */
+struct Sr04m2Snapshot {
+    uint16_t distanceMm;        // Median of last valid frames (0 if none)
+    uint16_t lastRawMm;         // Distance of last checksum-valid frame
+    Sr04m2FrameStatus lastStatus;
+    uint32_t updatedAtMs;       // millis() of last valid in-range frame (0 if none)
+    uint32_t startedAtMs;       // millis() when decoding started
+
+    // Statistics since start
+    uint32_t bytesReceived;
+    uint32_t framesValid;
+    uint32_t checksumErrors;
+    uint32_t outOfRange;
+    uint32_t bytesDiscarded;    // Bytes skipped while searching for header
+    uint32_t overflows;         // UART FIFO / ring buffer overflows
+};
+
+/**
+ * SR04M-2 Decoder - Singleton owning the frame decoder task
+ */
+class Sr04m2Decoder {
+public:
+    /**
+     * Get singleton instance
+     */
+    static Sr04m2Decoder& getInstance();
+
+#ifdef PLATFORM_ESP32
+    /**
+     * Start decoding on an ESP-IDF UART allocated by UARTManager
+     * @param uartNum UART number (1 or 2)
+     * @return true if the task is running
+     */
+    bool start(int uartNum);
+
+    /**
+     * Stop decoding
+     * UARTManager calls this before it deletes the driver of the decoder's UART.
+     */
+    void stop();
+
+    /**
+     * Check if decoder task is running
+     */
+    bool isRunning() const { return _task != nullptr; }
+
+    /**
+     * Check if decoder task is running on a UART
+     * @param uartNum UART number (1 or 2)
+     */
+    bool isRunningOn(int uartNum) const;
+#endif
+
+    /**
+     * Fresh statistics and filter for a new session
+     */
+    void reset();
+
+    /**
+     * Feed received bytes through the frame state machine and publish
+     * (decoder task; trace replay on native)
+     * @return Number of frames completed (valid or not)
+     */
+    uint32_t decode(const uint8_t* data, size_t length);
+
+    /**
+     * Get latest decoder state (lock-free, safe from any task)
+     */
+    Sr04m2Snapshot getSnapshot() const;
+
+private:
+    Sr04m2Decoder();
+    ~Sr04m2Decoder();
+
+    // Prevent copying
+    Sr04m2Decoder(const Sr04m2Decoder&) = delete;
+    Sr04m2Decoder& operator=(const Sr04m2Decoder&) = delete;
+
+    /**
+     * Frame parser state
+     */
+    enum class ParseState : uint8_t {
+        HEADER1,
+        HEADER2,
+        DIST_HIGH,
+        DIST_LOW,
+        CHECKSUM
+    };
+
+#ifdef PLATFORM_ESP32
+    uart_port_t _port;
+    QueueHandle_t _eventQueue;
+    TaskHandle_t _task;
+    std::atomic<bool> _stopRequested;
+#endif
+
+    // Parser state (only touched by the decoder task)
+    ParseState _state;
+    uint8_t _distHigh;
+    uint8_t _distLow;
+    uint8_t _sum;
+    uint16_t _window[config::SR04M2_MEDIAN_WINDOW];
+    size_t _windowCount;
+    size_t _windowHead;
+    Sr04m2Snapshot _working;
+
+    // Published snapshot (sequence lock)
+    Sr04m2Snapshot _snapshot;
+    std::atomic<uint32_t> _sequence;
+
+#ifdef PLATFORM_ESP32
+    /**
+     * Task entry point
+     */
+    static void taskEntry(void* param);
+
+    /**
+     * Decoder loop: wait for UART event, read, parse, publish
+     */
+    void run();
+#endif
+
+    /**
+     * Feed one byte into the frame state machine
+     * @return true if a frame was completed
+     */
+    bool feed(uint8_t byte);
+
+    /**
+     * Handle a complete frame (range check, median update)
+     */
+    void onFrame(uint16_t distanceMm);
+
+    /**
+     * Median of the filter window
+     */
+    uint16_t median() const;
+
+    /**
+     * Publish working state as snapshot
+     */
+    void publish();
+};
+
+#endif // SR04M2_DECODER_H
@@ -0,0 +1,134 @@
+/**
+ * myIoTGrid.Sensor - Time Service
+ *
+ * Maps the monotonic clock (esp_timer / steady_clock, never jumps) to UTC.
+ * The mapping is disciplined from SNTP and from the Hub's heartbeat
+ * serverTime; a sync is only accepted if it is more certain than the
+ * current estimate. Successive syncs yield a drift estimate (ppm) that
+ * is applied between syncs, and the uncertainty grows with the time
+ * since the last sync.
+ *
+ * Samples are stamped with the monotonic time at capture; the UTC stamp
+ * is taken at capture if the clock is synced, otherwise resolved later
+ * from the same monotonic time once a sync has happened (same boot).
+ */
+
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+
+#include <Arduino.h>
+#include <mutex>
+#include "config.h"
+
+/**
+ * Source of the last accepted sync
+ */
+enum class TimeSource : uint8_t {
+    NONE,
+    HUB,        // Heartbeat serverTime
+    SNTP,       // SNTP (ESP32) / host clock (native)
+};
+
+/**
+ * Time Service - singleton
+ */
+class TimeService {
+public:
+    static TimeService& getInstance();
+
+    /**
+     * Register the SNTP notification (ESP32) / adopt the host clock (native)
+     */
+    void begin();
+
+    /**
+     * Start SNTP after WiFi connected (ESP32; also sets the system clock)
+     */
+    void startSntp();
+
+    /**
+     * Wait until the clock is synced from any source
+     * @return true if synced within timeoutMs
+     */
+    bool waitForSync(uint32_t timeoutMs);
+
+    /**
+     * Discipline from an SNTP update
+     * @param epochMs UTC time in ms just set by SNTP
+     */
+    void onSntpSync(uint64_t epochMs);
+
+    /**
+     * Discipline from Hub serverTime (heartbeat response just received)
+     * @param serverTimeMs Hub UTC time in ms (0 = not present)
+     * @param roundTripMs Request round trip; the server stamp is taken as its midpoint
+     */
+    void disciplineFromHub(uint64_t serverTimeMs, uint32_t roundTripMs);
+
+    /**
+     * Monotonic milliseconds since boot (64 bit, no wrap)
+     */
+    static uint64_t monotonicMs();
+
+    bool isSynced() const;
+    TimeSource getSource() const;
+    static const char* getSourceName(TimeSource source);
+
+    /**
+     * Current UTC in ms, never decreasing between calls (0 if not synced)
+     */
+    uint64_t nowEpochMs();
+
+    /**
+     * UTC in ms of an earlier monotonic timestamp (0 if not synced)
+     */
+    uint64_t toEpochMs(uint64_t monoMs) const;
+
+    /**
+     * Current uncertainty of the UTC estimate in ms (UINT32_MAX if not synced)
+     */
+    uint32_t getUncertaintyMs() const;
+
+    float getDriftPpm() const;
+
+    /**
+     * Plausible Unix time (clock was set, not seconds since boot)
+     */
+    static bool isValidUnixTime(uint32_t unixSeconds) {
+        return unixSeconds >= config::TIME_MIN_VALID_UNIX;
+    }
+
+    /**
+     * Parse ISO 8601 UTC ("2025-01-31T12:34:56.789Z", offsets allowed) to epoch ms
+     * @return 0 on parse error
+     */
+    static uint64_t parseIso8601Ms(const char* text);
+
+    /**
+     * Clock status JSON object (heartbeat)
+     */
+    String getStatusJson() const;
+
+private:
+    TimeService();
+    TimeService(const TimeService&) = delete;
+    TimeService& operator=(const TimeService&) = delete;
+
+    mutable std::mutex _mutex;
+    TimeSource _source;
+    int64_t _offsetMs;          // epoch = mono + offset (at sync point)
+    uint64_t _syncMonoMs;       // Monotonic time of last accepted sync
+    uint32_t _syncUncertaintyMs;
+    double _driftPpm;           // Local clock fast (+) / slow (-)
+    bool _driftValid;
+    uint64_t _lastIssuedMs;     // Monotonic output guard for nowEpochMs()
+    uint32_t _syncCount;
+    uint32_t _rejectedCount;
+
+    void applySync(TimeSource source, uint64_t monoMs, uint64_t epochMs, uint32_t uncertaintyMs);
+    uint64_t toEpochMsLocked(uint64_t monoMs) const;
+    uint32_t uncertaintyAtLocked(uint64_t monoMs) const;
+    void setSystemClock(uint64_t epochMs);
+};
+
+#endif // TIME_SERVICE_H
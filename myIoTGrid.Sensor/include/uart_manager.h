@@ -20,6 +20,8 @@
 #ifdef PLATFORM_ESP32
 #include <HardwareSerial.h>
 #include <driver/uart.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 
 /**
  * UART allocation info
@@ -62,6 +64,13 @@ public:
      */
     HardwareSerial* getSerial(int uartNum);
 
+    /**
+     * Get ESP-IDF UART event queue for a UART number
+     * @param uartNum UART number (1 or 2)
+     * @return Event queue (uart_event_t) or nullptr if not allocated or using Arduino
+     */
+    QueueHandle_t getEventQueue(int uartNum);
+
     /**
      * Get UART number for a given owner
      * @param owner Owner identifier
@@ -130,6 +139,9 @@ private:
     // UART allocations (index 0 = UART1, index 1 = UART2)
     UARTAllocation _allocations[2];
 
+    // ESP-IDF driver event queues (index 0 = UART1, index 1 = UART2)
+    QueueHandle_t _eventQueues[2];
+
     // Arduino HardwareSerial instances (created on demand)
     HardwareSerial* _serial1;
     HardwareSerial* _serial2;
@@ -19,6 +19,22 @@ enum class WiFiStatus {
     FAILED
 };
 
+/**
+ * Connect-time statistics (reported in the heartbeat)
+ */
+struct WiFiConnectStats {
+    uint32_t lastConnectMs;     // Duration of the last successful connect
+    bool lastFastConnect;       // Last connect used cached BSSID/channel
+    uint32_t fastConnects;      // Connects via cached BSSID/channel
+    uint32_t fullConnects;      // Connects via full scan
+    uint32_t fastFallbacks;     // Cached attempt failed, fell back to full scan
+    uint32_t reconnects;        // Reconnect attempts after connection loss
+
+    WiFiConnectStats()
+        : lastConnectMs(0), lastFastConnect(false), fastConnects(0)
+        , fullConnects(0), fastFallbacks(0), reconnects(0) {}
+};
+
 /**
  * Callbacks
  */
@@ -35,9 +51,16 @@ public:
 
     /**
      * Connect to WiFi network
+     * Tries a direct connect with the last-good BSSID/channel (and optionally
+     * IP lease) from NVS first, falls back to a full scan.
      */
     bool connect(const String& ssid, const String& password, int timeoutMs = 15000);
 
+    /**
+     * Drop cached BSSID/channel/IP (e.g. after WiFi reset)
+     */
+    void clearFastConnectCache();
+
     /**
      * Disconnect from WiFi
      */
@@ -75,6 +98,16 @@ public:
     void onDisconnected(OnWiFiDisconnected callback);
     void onFailed(OnWiFiFailed callback);
 
+    /**
+     * Connect-time statistics
+     */
+    const WiFiConnectStats& getConnectStats() const { return _stats; }
+
+    /**
+     * Statistics as JSON object for the heartbeat
+     */
+    String getConnectStatsJson() const;
+
     /**
      * Reconnection settings
      */
@@ -88,6 +121,7 @@ private:
     bool _autoReconnect;
     unsigned long _lastReconnectAttempt;
     int _reconnectAttempts;
+    WiFiConnectStats _stats;
 
     OnWiFiConnected _onConnected;
     OnWiFiDisconnected _onDisconnected;
@@ -97,6 +131,11 @@ private:
     static constexpr unsigned long RECONNECT_INTERVAL = 5000;
 
     void attemptReconnect();
+
+    // Fast-connect cache (NVS)
+    bool tryFastConnect(const String& ssid, const String& password);
+    void saveFastConnect(const String& ssid);
+    bool waitForConnection(unsigned long timeoutMs);
 };
 
 #endif // WIFI_MANAGER_H
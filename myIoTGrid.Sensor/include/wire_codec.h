@@ -0,0 +1,138 @@
+/**
+ * myIoTGrid.Sensor - Wire Codec (JSON / MessagePack)
+ *
+ * Optional binary encoding of Hub messages (application/msgpack). Field
+ * names are replaced by small integer keys from a shared schema, so a
+ * reading like {"type":"temperature","value":21.5,"endpointId":1} loses
+ * all of its key bytes on the wire:
+ *
+ *   JSON     {"deviceId":"...","type":"temperature","value":21.5, ...}
+ *   MsgPack  {1:"...", 2:"temperature", 3:21.5, ...}   (map, fixint keys)
+ *
+ * Messages are still built and read as JsonDocument, so request builders
+ * and response parsers are the same for both formats. The schema is
+ * append-only: never renumber or reuse a key.
+ */
+
+#ifndef WIRE_CODEC_H
+#define WIRE_CODEC_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <vector>
+
+/**
+ * Encoding of request and response bodies
+ */
+enum class WireFormat : uint8_t {
+    JSON,
+    MSGPACK
+};
+
+namespace wire {
+
+constexpr const char* CONTENT_TYPE_JSON = "application/json";
+constexpr const char* CONTENT_TYPE_MSGPACK = "application/msgpack";
+
+// Shared schema: integer key -> JSON field name (index = key, 0 unused)
+enum Key : uint8_t {
+    KEY_DEVICE_ID = 1,
+    KEY_TYPE,
+    KEY_VALUE,
+    KEY_UNIT,
+    KEY_TIMESTAMP,
+    KEY_ENDPOINT_ID,
+    KEY_NODE_ID,
+    KEY_SERIAL_NUMBER,
+    KEY_FIRMWARE_VERSION,
+    KEY_BATTERY_LEVEL,
+    KEY_READINGS,
+    KEY_SENSOR_TYPE,
+    KEY_AGGREGATE,
+    KEY_COUNT,
+    KEY_MIN,
+    KEY_MAX,
+    KEY_STDDEV,
+    KEY_LAST,
+    KEY_WINDOW_SECONDS,
+    KEY_SUCCESS,
+    KEY_SERVER_TIME,
+    KEY_NEXT_HEARTBEAT_SECONDS,
+    KEY_WIFI,
+    KEY_PIPELINE,
+    KEY_TIME,
+    KEY_COMPRESSION,
+    KEY_NAME,
+    KEY_IS_SIMULATION,
+    KEY_DEFAULT_INTERVAL_SECONDS,
+    KEY_STORAGE_MODE,
+    KEY_SENSORS,
+    KEY_SENSOR_CODE,
+    KEY_SENSOR_NAME,
+    KEY_ICON,
+    KEY_COLOR,
+    KEY_IS_ACTIVE,
+    KEY_INTERVAL_SECONDS,
+    KEY_I2C_ADDRESS,
+    KEY_SDA_PIN,
+    KEY_SCL_PIN,
+    KEY_ONE_WIRE_PIN,
+    KEY_ANALOG_PIN,
+    KEY_DIGITAL_PIN,
+    KEY_TRIGGER_PIN,
+    KEY_ECHO_PIN,
+    KEY_BAUD_RATE,
+    KEY_OFFSET_CORRECTION,
+    KEY_GAIN_CORRECTION,
+    KEY_AGGREGATION_WINDOW_SECONDS,
+    KEY_CAPABILITIES,
+    KEY_MEASUREMENT_TYPE,
+    KEY_DISPLAY_NAME,
+    KEY_DEADBAND_ABSOLUTE,
+    KEY_DEADBAND_PERCENT,
+    KEY_DEADBAND_SLOPE_PER_MINUTE,
+    KEY_MAX_SILENCE_SECONDS,
+    KEY_CONFIGURATION_CHANGED,
+    KEY_WIRE_FORMAT,
+    KEY_HARDWARE_TYPE,
+    KEY_LOCATION,
+    KEY_IS_NEW_NODE,
+    KEY_MESSAGE,
+    KEY_CONNECTION,
+    KEY_ENDPOINT,
+    KEY_SYNC,
+    KEY_METRICS,
+    KEY_LOOP,
+    KEY_COUNT_END               // Not a key
+};
+
+/**
+ * JSON field name of a schema key (nullptr if unknown)
+ */
+const char* keyName(uint32_t key);
+
+/**
+ * Schema key of a JSON field name (0 if not in the schema)
+ */
+uint8_t keyOf(const char* name);
+
+/**
+ * True for "application/msgpack" (parameters ignored)
+ */
+bool isMsgPackContentType(const String& contentType);
+
+/**
+ * Encode a document as MessagePack with schema keys
+ * Field names outside the schema are sent as strings; serialized() raw
+ * JSON cannot be encoded (parse it into the document first).
+ */
+void encodeMsgPack(JsonVariantConst value, std::vector<uint8_t>& out);
+
+/**
+ * Decode MessagePack with schema keys into a document with JSON field names
+ */
+DeserializationError decodeMsgPack(const uint8_t* data, size_t length, JsonDocument& doc);
+
+} // namespace wire
+
+#endif // WIRE_CODEC_H
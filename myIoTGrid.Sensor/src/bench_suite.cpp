@@ -0,0 +1,420 @@
+/**
+ * myIoTGrid.Sensor - Native Benchmark Suite Implementation
+ */
+
+#ifdef PLATFORM_NATIVE
+
+#include "bench_suite.h"
+#include "config.h"
+#include "api_client.h"
+#include "json_arena.h"
+#include "reading_aggregator.h"
+#include "storage/reading_storage.h"
+#include "sensor_schedule.h"
+#include "serial_capture.h"
+#include "wire_codec.h"
+#include "json_serializer.h"
+#include <ArduinoJson.h>
+#include "ArduinoJsonString.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+/**
+ * One benchmark: a single operation of a hot path
+ */
+struct Benchmark {
+    const char* name;
+    double maxNsPerOp;          // Ceiling on a desktop-class host (~10x typical)
+    std::function<void()> op;
+};
+
+struct Result {
+    const char* name;
+    uint64_t iterations;        // Per sample
+    double nsPerOp;             // Median of the samples
+    double maxNsPerOp;
+    double baselineNsPerOp;     // 0 = no baseline
+    const char* status;         // "ok", "ceiling", "regressed"
+};
+
+// Results of the benchmarked operations end up here so they are not optimized away
+volatile size_t sink = 0;
+
+double sampleNs(const std::function<void()>& op, uint64_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; i++) op();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count();
+}
+
+Result measure(const Benchmark& benchmark) {
+    // Warm up and find the iteration count for one sample
+    const double minSampleNs = config::BENCH_MIN_SAMPLE_MS * 1e6;
+    uint64_t iterations = 1;
+    while (sampleNs(benchmark.op, iterations) < minSampleNs && iterations < (1ULL << 40)) {
+        iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    for (int i = 0; i < config::BENCH_SAMPLES; i++) {
+        samples.push_back(sampleNs(benchmark.op, iterations) / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Result result;
+    result.name = benchmark.name;
+    result.iterations = iterations;
+    result.nsPerOp = samples[samples.size() / 2];
+    result.maxNsPerOp = benchmark.maxNsPerOp;
+    result.baselineNsPerOp = 0;
+    result.status = result.nsPerOp > benchmark.maxNsPerOp ? "ceiling" : "ok";
+    return result;
+}
+
+/**
+ * ns/op per benchmark name from an earlier results file
+ */
+std::map<std::string, double> loadBaseline(const char* path) {
+    std::map<std::string, double> baseline;
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        Serial.printf("[Bench] Baseline %s not readable\n", path);
+        return baseline;
+    }
+
+    std::string json;
+    char buf[1024];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), file)) > 0) json.append(buf, n);
+    fclose(file);
+
+    JsonDocument doc;
+    if (deserializeJson(doc, json)) {
+        Serial.printf("[Bench] Baseline %s is not valid JSON\n", path);
+        return baseline;
+    }
+    for (JsonObjectConst entry : doc["results"].as<JsonArrayConst>()) {
+        baseline[entry["name"] | ""] = entry["nsPerOp"] | 0.0;
+    }
+    return baseline;
+}
+
+bool writeResults(const char* path, const std::vector<Result>& results, bool passed) {
+    JsonDocument doc;
+    doc["firmware"] = FIRMWARE_VERSION;
+    doc["compiler"] = __VERSION__;
+    doc["samples"] = config::BENCH_SAMPLES;
+    doc["regressionPercent"] = config::BENCH_REGRESSION_PERCENT;
+    JsonArray list = doc["results"].to<JsonArray>();
+    for (const Result& result : results) {
+        JsonObject entry = list.add<JsonObject>();
+        entry["name"] = result.name;
+        entry["iterations"] = result.iterations;
+        entry["nsPerOp"] = result.nsPerOp;
+        entry["maxNsPerOp"] = result.maxNsPerOp;
+        if (result.baselineNsPerOp > 0) {
+            entry["baselineNsPerOp"] = result.baselineNsPerOp;
+        }
+        entry["status"] = result.status;
+    }
+    doc["passed"] = passed;
+
+    std::string json;
+    serializeJsonPretty(doc, json);
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+    bool ok = fwrite(json.data(), 1, json.size(), file) == json.size();
+    fclose(file);
+    return ok;
+}
+
+SensorAssignmentConfig makeSensor(int endpointId, int intervalSeconds) {
+    SensorAssignmentConfig sensor;
+    sensor.endpointId = endpointId;
+    sensor.sensorCode = "bme280";
+    sensor.isActive = true;
+    sensor.intervalSeconds = intervalSeconds;
+    return sensor;
+}
+
+/**
+ * Sync batch body as SyncManager encodes it (CreateBatchReadingsDto)
+ */
+void buildBatch(const ApiClient& apiClient, JsonDocument& doc, int count) {
+    JsonArray readings = apiClient.beginReadingBatch(doc);
+    for (int i = 0; i < count; i++) {
+        apiClient.addBatchReading(readings, (i % 2) ? "humidity" : "temperature", 20.0 + i * 0.37,
+                                  (i % 2) ? "%" : "°C", 1 + (i % 2), 1733150400UL + (i / 2) * 60);
+    }
+}
+
+void buildHeartbeat(JsonDocument& doc) {
+    doc["nodeId"] = "ESP32-0070078492CC";
+    doc["firmwareVersion"] = "1.9.1";
+    JsonObject wifi = doc["wifi"].to<JsonObject>();
+    wifi["lastConnectMs"] = 280;
+    wifi["rssi"] = -45;
+    JsonObject time = doc["time"].to<JsonObject>();
+    time["source"] = "sntp";
+    time["synced"] = true;
+    time["uncertaintyMs"] = 68;
+    time["driftPpm"] = 12.4;
+}
+
+void buildConfiguration(JsonDocument& doc) {
+    doc["nodeId"] = "00000000-0000-0000-0000-000000000001";
+    doc["serialNumber"] = "ESP32-0070078492CC";
+    doc["name"] = "Wohnzimmer";
+    doc["isSimulation"] = false;
+    doc["defaultIntervalSeconds"] = 60;
+    doc["storageMode"] = 1;
+    JsonArray sensors = doc["sensors"].to<JsonArray>();
+    const char* codes[] = {"bme280", "ds18b20", "sht31", "bh1750"};
+    for (int i = 0; i < 4; i++) {
+        JsonObject s = sensors.add<JsonObject>();
+        s["endpointId"] = i + 1;
+        s["sensorCode"] = codes[i];
+        s["sensorName"] = codes[i];
+        s["icon"] = "thermostat";
+        s["color"] = "#FF5722";
+        s["isActive"] = true;
+        s["intervalSeconds"] = 60;
+        s["i2CAddress"] = "0x76";
+        s["sdaPin"] = 21;
+        s["sclPin"] = 22;
+        s["oneWirePin"] = -1;
+        s["analogPin"] = -1;
+        s["offsetCorrection"] = 0.0;
+        s["gainCorrection"] = 1.0;
+        s["aggregationWindowSeconds"] = 0;
+        JsonArray caps = s["capabilities"].to<JsonArray>();
+        for (int c = 0; c < 2; c++) {
+            JsonObject cap = caps.add<JsonObject>();
+            cap["measurementType"] = c ? "humidity" : "temperature";
+            cap["displayName"] = c ? "Luftfeuchte" : "Temperatur";
+            cap["unit"] = c ? "%" : "°C";
+            cap["deadbandAbsolute"] = 0.1;
+            cap["maxSilenceSeconds"] = 900;
+        }
+    }
+}
+
+/**
+ * Payload size of a message in both wire formats
+ */
+void printWireSize(const char* name, const JsonDocument& doc) {
+    std::string json;
+    serializeJson(doc, json);
+    std::vector<uint8_t> packed;
+    wire::encodeMsgPack(doc, packed);
+    Serial.printf("[Bench]   %-28s JSON %6u B  MsgPack %6u B (%3.0f%%)\n", name,
+                  (unsigned)json.length(), (unsigned)packed.size(), 100.0 * packed.size() / json.length());
+}
+
+} // namespace
+
+bool runSuite() {
+    // Fixtures shared by the benchmarks
+    StoredReading stored;
+    stored.timestamp = 1733150400;
+    stored.sensorType = "temperature";
+    stored.value = 21.4375;
+    stored.unit = "°C";
+    stored.endpointId = 3;
+    stored.synced = false;
+    const String csvLine = stored.toCsv();
+
+    const data::Reading reading("ESP32-0070078492CC", "temperature", 21.5f, "°C", 1733150400);
+    data::NodeConfig nodeConfig;
+    nodeConfig.deviceId = "ESP32-0070078492CC";
+    nodeConfig.name = "Wohnzimmer";
+    nodeConfig.location = "EG";
+    nodeConfig.connection = data::ConnectionConfig("http", "http://192.168.1.10:5002");
+    for (const char* type : {"temperature", "humidity", "pressure", "co2"}) {
+        nodeConfig.sensors.emplace_back(type, true, 21);
+    }
+
+    ApiClient apiClient;
+    apiClient.configure("http://127.0.0.1:5002", "ESP32-0070078492CC", "bench");
+
+    std::vector<SensorAssignmentConfig> sensors;
+    std::map<int, unsigned long> lastReading;
+    const int intervals[] = {30, 20, 15, 60, 120, 45, 90, 600};
+    for (int i = 0; i < 8; i++) {
+        sensors.push_back(makeSensor(i + 1, intervals[i]));
+        lastReading[i + 1] = 1000UL * i * 7;
+    }
+    unsigned long now = 0;
+
+    SerialCapture& capture = SerialCapture::getInstance();
+    capture.begin();
+    capture.setEnabled(true);
+    const char logText[] =
+        "[Sensor] temperature = 21.44 C\n"
+        "[API] Reading sent: temperature = 21.44 C\n"
+        "[Sync] Upload failed: HTTP 503\n"
+        "[Main] Heartbeat sent\n";
+    size_t logPos = 0;
+
+    ReadingAggregator aggregator;
+    WindowSummary summary;
+    unsigned long sampleMs = 0;
+
+    // Wire format fixtures: encoded once, decoded by the benchmarks
+    JsonDocument batchDoc;
+    buildBatch(apiClient, batchDoc, 50);
+    JsonDocument heartbeatDoc;
+    buildHeartbeat(heartbeatDoc);
+    JsonDocument configDoc;
+    buildConfiguration(configDoc);
+    std::string batchJson, configJson;
+    serializeJson(batchDoc, batchJson);
+    serializeJson(configDoc, configJson);
+    std::vector<uint8_t> batchPacked, configPacked;
+    wire::encodeMsgPack(batchDoc, batchPacked);
+    wire::encodeMsgPack(configDoc, configPacked);
+    EncodedBody batchBody;
+
+    const std::vector<Benchmark> benchmarks = {
+        {"storage.toCsv", 3500, [&]() {
+            sink += stored.toCsv().length();
+        }},
+        {"storage.fromCsv", 2500, [&]() {
+            sink += StoredReading::fromCsv(csvLine).endpointId;
+        }},
+        {"data.reading.roundtrip", 20000, [&]() {
+            data::Reading parsed;
+            data::JsonSerializer::deserializeReading(data::JsonSerializer::serializeReading(reading), parsed);
+            sink += parsed.timestamp;
+        }},
+        {"data.nodeConfig.roundtrip", 50000, [&]() {
+            data::NodeConfig parsed;
+            data::JsonSerializer::deserializeNodeConfig(data::JsonSerializer::serializeNodeConfig(nodeConfig), parsed);
+            sink += parsed.sensors.size();
+        }},
+        {"api.readingPayload.json", 10000, [&]() {
+            JsonDocument doc(&JsonArena::getInstance());
+            apiClient.buildReadingPayload(doc, "temperature", 21.4375, "°C", 3, 1733150400);
+            String body;
+            serializeJson(doc, body);
+            sink += body.length();
+        }},
+        {"api.readingPayload.msgpack", 10000, [&]() {
+            JsonDocument doc(&JsonArena::getInstance());
+            apiClient.buildReadingPayload(doc, "temperature", 21.4375, "°C", 3, 1733150400);
+            std::vector<uint8_t> packed;
+            wire::encodeMsgPack(doc, packed);
+            sink += packed.size();
+        }},
+        {"schedule.pollIntervalGCD", 500, [&]() {
+            sink += schedule::pollIntervalGCD(sensors, 60);
+        }},
+        {"schedule.isSensorDue.8", 600, [&]() {
+            now += 5000;
+            for (const auto& sensor : sensors) {
+                sink += schedule::isSensorDue(sensor, lastReading, now);
+            }
+        }},
+        {"capture.captureChar", 600, [&]() {
+            capture.captureChar(logText[logPos]);
+            if (++logPos == sizeof(logText) - 1) logPos = 0;
+        }},
+        {"aggregator.addSample", 600, [&]() {
+            sampleMs += 1000;
+            sink += aggregator.addSample(3, "temperature", 21.4375, 60, sampleMs, summary);
+        }},
+        {"sync.batchBody.50", 400000, [&]() {
+            // SyncManager read-ahead: build and encode one batch body
+            JsonDocument doc(&JsonArena::getInstance());
+            buildBatch(apiClient, doc, 50);
+            apiClient.encodeBody(doc, batchBody);
+            sink += batchBody.data.size();
+        }},
+        {"wire.batch50.msgpack.encode", 200000, [&]() {
+            std::vector<uint8_t> packed;
+            wire::encodeMsgPack(batchDoc, packed);
+            sink += packed.size();
+        }},
+        {"wire.batch50.json.decode", 400000, [&]() {
+            JsonDocument parsed(&JsonArena::getInstance());
+            sink += !deserializeJson(parsed, batchJson);
+        }},
+        {"wire.batch50.msgpack.decode", 300000, [&]() {
+            JsonDocument parsed(&JsonArena::getInstance());
+            sink += !wire::decodeMsgPack(batchPacked.data(), batchPacked.size(), parsed);
+        }},
+        {"wire.heartbeat.msgpack.encode", 20000, [&]() {
+            std::vector<uint8_t> packed;
+            wire::encodeMsgPack(heartbeatDoc, packed);
+            sink += packed.size();
+        }},
+        {"wire.config.json.decode", 300000, [&]() {
+            JsonDocument parsed(&JsonArena::getInstance());
+            sink += !deserializeJson(parsed, configJson);
+        }},
+        {"wire.config.msgpack.decode", 200000, [&]() {
+            JsonDocument parsed(&JsonArena::getInstance());
+            sink += !wire::decodeMsgPack(configPacked.data(), configPacked.size(), parsed);
+        }},
+    };
+
+    const char* baselinePath = std::getenv(config::ENV_BENCH_BASELINE);
+    std::map<std::string, double> baseline;
+    if (baselinePath) {
+        baseline = loadBaseline(baselinePath);
+    }
+
+    Serial.println("[Bench] Wire payload sizes");
+    printWireSize("batch (50 readings)", batchDoc);
+    printWireSize("heartbeat", heartbeatDoc);
+    printWireSize("configuration", configDoc);
+
+    Serial.printf("[Bench] %zu benchmarks, median of %d samples (>= %lu ms each)\n",
+                  benchmarks.size(), config::BENCH_SAMPLES, (unsigned long)config::BENCH_MIN_SAMPLE_MS);
+    Serial.printf("[Bench]   %-28s %12s %12s %12s  %s\n", "benchmark", "ns/op", "ceiling", "baseline", "status");
+
+    std::vector<Result> results;
+    bool passed = true;
+    for (const Benchmark& benchmark : benchmarks) {
+        Result result = measure(benchmark);
+
+        auto it = baseline.find(benchmark.name);
+        if (it != baseline.end() && it->second > 0) {
+            result.baselineNsPerOp = it->second;
+            if (result.nsPerOp > it->second * (100 + config::BENCH_REGRESSION_PERCENT) / 100.0) {
+                result.status = "regressed";
+            }
+        }
+        if (strcmp(result.status, "ok") != 0) passed = false;
+
+        Serial.printf("[Bench]   %-28s %12.1f %12.0f %12.1f  %s\n", result.name, result.nsPerOp,
+                      result.maxNsPerOp, result.baselineNsPerOp, result.status);
+        results.push_back(result);
+    }
+
+    const char* outputPath = std::getenv(config::ENV_BENCH_OUTPUT);
+    if (!outputPath) outputPath = "bench_results.json";
+    if (writeResults(outputPath, results, passed)) {
+        Serial.printf("[Bench] Results written to %s\n", outputPath);
+    } else {
+        Serial.printf("[Bench] Failed to write %s\n", outputPath);
+    }
+
+    Serial.printf("[Bench] %s\n", passed ? "PASSED" : "FAILED (ceiling or regression)");
+    return passed;
+}
+
+} // namespace bench
+
+#endif // PLATFORM_NATIVE
@@ -0,0 +1,86 @@
+/**
+ * myIoTGrid.Sensor - Boot Profiler Implementation
+ */
+
+#include "boot_profiler.h"
+
+BootProfiler& BootProfiler::getInstance() {
+    static BootProfiler instance;
+    return instance;
+}
+
+BootProfiler::BootProfiler()
+    : _count(0)
+    , _startUs(0)
+    , _lastUs(0)
+    , _firstReadingUs(0)
+    , _fastBoot(false)
+{
+}
+
+void BootProfiler::begin() {
+    _count = 0;
+    _startUs = micros();
+    _lastUs = _startUs;
+    _firstReadingUs = 0;
+}
+
+void BootProfiler::mark(const char* phase) {
+    if (hasFirstReading()) {
+        return;  // Boot is over (e.g. later WiFi reconnects)
+    }
+
+    uint32_t now = micros();
+
+    if (_count < config::BOOT_PROFILER_MAX_PHASES) {
+        _phases[_count].name = phase;
+        _phases[_count].durationUs = now - _lastUs;
+        _count++;
+    }
+    _lastUs = now;
+}
+
+void BootProfiler::markFirstReading() {
+    if (hasFirstReading()) {
+        return;
+    }
+
+    mark("first_reading");
+    _firstReadingUs = _lastUs - _startUs;
+    if (_firstReadingUs == 0) _firstReadingUs = 1;
+
+    printTimeline();
+}
+
+void BootProfiler::printTimeline() const {
+    Serial.println("[Boot] ========================================");
+    Serial.printf("[Boot] Boot timeline (%s)\n", _fastBoot ? "fast boot" : "full boot");
+
+    uint32_t offset = 0;
+    for (size_t i = 0; i < _count; i++) {
+        offset += _phases[i].durationUs;
+        Serial.printf("[Boot]   %-16s %9lu us  (t=%lu ms)\n",
+                      _phases[i].name, (unsigned long)_phases[i].durationUs,
+                      (unsigned long)(offset / 1000));
+    }
+
+    if (hasFirstReading()) {
+        Serial.printf("[Boot] Time to first reading: %lu ms\n", (unsigned long)(_firstReadingUs / 1000));
+    }
+    Serial.println("[Boot] ========================================");
+}
+
+String BootProfiler::toJson() const {
+    String json = "{";
+    json += "\"fastBoot\":" + String(_fastBoot ? "true" : "false") + ",";
+    json += "\"elapsedUs\":" + String((unsigned long)getElapsedUs()) + ",";
+    json += "\"firstReadingUs\":" + String((unsigned long)_firstReadingUs) + ",";
+    json += "\"phases\":[";
+    for (size_t i = 0; i < _count; i++) {
+        if (i > 0) json += ",";
+        json += "{\"name\":\"" + String(_phases[i].name) + "\",";
+        json += "\"us\":" + String((unsigned long)_phases[i].durationUs) + "}";
+    }
+    json += "]}";
+    return json;
+}
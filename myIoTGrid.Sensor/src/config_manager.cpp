@@ -4,6 +4,8 @@
 
 #include "config_manager.h"
 
+#include <memory>
+
 #ifdef PLATFORM_ESP32
 #include <Preferences.h>
 #include <WiFi.h>
@@ -146,3 +148,69 @@ String ConfigManager::getSerial() {
     return String("SIM-00000000-0001");
 #endif
 }
+
+bool ConfigManager::saveSensorConfig(const String& json, const String& activeUrl) {
+    if (!_initialized) {
+        return false;
+    }
+
+#ifdef PLATFORM_ESP32
+    // Skip the flash write if the Hub sent the same configuration again
+    String cachedJson;
+    String cachedUrl;
+    if (loadSensorConfig(cachedJson, cachedUrl) && cachedJson == json && cachedUrl == activeUrl) {
+        return true;
+    }
+
+    // Stored as blob: NVS strings are limited to ~4000 bytes
+    size_t written = preferences.putBytes(KEY_SENSOR_CONFIG, json.c_str(), json.length());
+    if (written != json.length()) {
+        Serial.println("[Config] Failed to cache sensor configuration");
+        return false;
+    }
+    preferences.putString(KEY_ACTIVE_URL, activeUrl);
+    Serial.printf("[Config] Sensor configuration cached (%u bytes)\n", (unsigned)written);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ConfigManager::loadSensorConfig(String& json, String& activeUrl) {
+#ifdef PLATFORM_ESP32
+    if (!_initialized || !preferences.isKey(KEY_SENSOR_CONFIG)) {
+        return false;
+    }
+
+    size_t length = preferences.getBytesLength(KEY_SENSOR_CONFIG);
+    if (length == 0) {
+        return false;
+    }
+
+    std::unique_ptr<char[]> buffer(new char[length + 1]);
+    preferences.getBytes(KEY_SENSOR_CONFIG, buffer.get(), length);
+    buffer[length] = '\0';
+    json = String(buffer.get());
+    activeUrl = preferences.getString(KEY_ACTIVE_URL, "");
+    return activeUrl.length() > 0;
+#else
+    return false;
+#endif
+}
+
+bool ConfigManager::hasSensorConfig() {
+#ifdef PLATFORM_ESP32
+    return _initialized && preferences.isKey(KEY_SENSOR_CONFIG) && preferences.isKey(KEY_ACTIVE_URL);
+#else
+    return false;
+#endif
+}
+
+void ConfigManager::clearSensorConfig() {
+#ifdef PLATFORM_ESP32
+    if (_initialized) {
+        preferences.remove(KEY_SENSOR_CONFIG);
+        preferences.remove(KEY_ACTIVE_URL);
+    }
+#endif
+}
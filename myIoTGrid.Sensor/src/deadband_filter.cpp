@@ -0,0 +1,166 @@
+/**
+ * myIoTGrid.Sensor - Deadband Filter Implementation
+ */
+
+#include "deadband_filter.h"
+#include "config.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+/**
+ * Default absolute deadband per measurement type
+ * (same type codes as the Hub / sensor type table)
+ */
+struct TypeDeadband {
+    const char* type;
+    double deadband;
+};
+
+const TypeDeadband TYPE_DEADBANDS[] = {
+    {"temperature",   0.2},     // °C
+    {"humidity",      1.0},     // %
+    {"pressure",      0.5},     // hPa
+    {"water_level",   1.0},     // cm
+    {"distance",      1.0},     // cm
+    {"co2",          25.0},     // ppm
+    {"pm25",          2.0},     // µg/m³
+    {"pm10",          3.0},     // µg/m³
+    {"soil_moisture", 1.0},     // %
+    {"uv",            0.5},     // index
+    {"battery",       1.0},     // %
+};
+
+double getTypeDeadband(const String& measurementType) {
+    String type = measurementType;
+    type.toLowerCase();
+    for (const auto& entry : TYPE_DEADBANDS) {
+        if (strcmp(type.c_str(), entry.type) == 0) {
+            return entry.deadband;
+        }
+    }
+    return 0.0;  // Unknown type: report every sample
+}
+
+} // namespace
+
+DeadbandFilter::DeadbandFilter()
+    : _sent(0)
+    , _suppressed(0)
+    , _heartbeats(0)
+{
+}
+
+DeadbandParams DeadbandFilter::resolveParams(const String& measurementType, double absolute,
+                                             double relativePercent, double slopePerMinute,
+                                             int maxSilenceSeconds) {
+    DeadbandParams params;
+
+    if (absolute >= 0.0) {
+        params.absolute = absolute;
+    } else if (config::DEADBAND_USE_TYPE_DEFAULTS) {
+        params.absolute = getTypeDeadband(measurementType);
+    }
+
+    params.relativePercent = relativePercent > 0.0 ? relativePercent : 0.0;
+    params.slopePerMinute = slopePerMinute > 0.0 ? slopePerMinute : 0.0;
+    params.maxSilenceSeconds = maxSilenceSeconds > 0
+        ? (uint32_t)maxSilenceSeconds
+        : config::DEADBAND_MAX_SILENCE_SECONDS;
+
+    return params;
+}
+
+bool DeadbandFilter::thresholdsChanged(const NodeConfigurationResponse& previous,
+                                       const NodeConfigurationResponse& next) {
+    if (previous.sensors.size() != next.sensors.size()) {
+        return true;
+    }
+
+    for (size_t i = 0; i < next.sensors.size(); i++) {
+        const auto& before = previous.sensors[i].capabilities;
+        const auto& after = next.sensors[i].capabilities;
+        if (before.size() != after.size()) {
+            return true;
+        }
+        for (size_t c = 0; c < after.size(); c++) {
+            if (before[c].deadbandAbsolute != after[c].deadbandAbsolute ||
+                before[c].deadbandPercent != after[c].deadbandPercent ||
+                before[c].deadbandSlopePerMinute != after[c].deadbandSlopePerMinute ||
+                before[c].maxSilenceSeconds != after[c].maxSilenceSeconds) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+DeadbandDecision DeadbandFilter::evaluate(int endpointId, const String& measurementType, double value,
+                                          const DeadbandParams& params, unsigned long now) {
+    String key = makeKey(endpointId, measurementType);
+    auto it = _channels.find(key);
+
+    DeadbandDecision decision;
+    if (!params.isEnabled()) {
+        decision = DeadbandDecision::SEND_UNFILTERED;
+    } else if (it == _channels.end()) {
+        decision = DeadbandDecision::SEND_FIRST;
+    } else {
+        const ChannelState& state = it->second;
+        double delta = fabs(value - state.lastSentValue);
+        decision = DeadbandDecision::SUPPRESS;
+
+        if (params.absolute > 0.0 && delta >= params.absolute) {
+            decision = DeadbandDecision::SEND_CHANGED;
+        } else if (params.relativePercent > 0.0 &&
+                   delta >= fabs(state.lastSentValue) * params.relativePercent / 100.0) {
+            decision = DeadbandDecision::SEND_CHANGED;
+        } else if (params.slopePerMinute > 0.0 && now != state.lastMs) {
+            double minutes = (now - state.lastMs) / 60000.0;
+            if (fabs(value - state.lastValue) / minutes >= params.slopePerMinute) {
+                decision = DeadbandDecision::SEND_CHANGED;
+            }
+        }
+
+        if (decision == DeadbandDecision::SUPPRESS && params.maxSilenceSeconds > 0 &&
+            now - state.lastSentMs >= (unsigned long)params.maxSilenceSeconds * 1000UL) {
+            decision = DeadbandDecision::SEND_HEARTBEAT;
+        }
+    }
+
+    ChannelState& state = _channels[key];
+    state.lastValue = value;
+    state.lastMs = now;
+
+    if (decision == DeadbandDecision::SUPPRESS) {
+        _suppressed++;
+    } else {
+        state.lastSentValue = value;
+        state.lastSentMs = now;
+        _sent++;
+        if (decision == DeadbandDecision::SEND_HEARTBEAT) _heartbeats++;
+    }
+
+    return decision;
+}
+
+const char* DeadbandFilter::getDecisionName(DeadbandDecision decision) {
+    switch (decision) {
+        case DeadbandDecision::SEND_FIRST:      return "first";
+        case DeadbandDecision::SEND_CHANGED:    return "changed";
+        case DeadbandDecision::SEND_HEARTBEAT:  return "heartbeat";
+        case DeadbandDecision::SEND_UNFILTERED: return "unfiltered";
+        case DeadbandDecision::SUPPRESS:        return "suppressed";
+        default:                                return "unknown";
+    }
+}
+
+void DeadbandFilter::reset() {
+    _channels.clear();
+}
+
+String DeadbandFilter::makeKey(int endpointId, const String& measurementType) {
+    return String(endpointId) + ":" + measurementType;
+}
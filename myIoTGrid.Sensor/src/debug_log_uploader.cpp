@@ -8,6 +8,8 @@
 
 #include "debug_log_uploader.h"
 #include "serial_capture.h"
+#include "http_compression.h"
+#include "retry_policy.h"
 #include <ArduinoJson.h>
 
 #ifdef PLATFORM_ESP32
@@ -88,6 +90,11 @@ bool DebugLogUploader::uploadNow() {
         return true;  // Nothing to upload
     }
 
+    // Logs never probe the Hub; they wait until ApiClient closed the circuit
+    if (CircuitBreaker::forHub().getState() != CircuitState::CLOSED) {
+        return false;
+    }
+
     return uploadSerialLines();
 #else
     return true;
@@ -142,11 +149,31 @@ bool DebugLogUploader::uploadSerialLines() {
     String payload;
     serializeJson(doc, payload);
 
+    // Log lines are highly repetitive ("[API] ...", "[Main] ...")
+    HttpCompression& compression = HttpCompression::getInstance();
+    std::vector<uint8_t> gzipPayload;
+    bool compressed = compression.compress(payload, gzipPayload);
+    if (compressed) {
+        http.addHeader("Content-Encoding", "gzip");
+    }
+    const char* responseHeaders[] = {"Accept-Encoding", "Retry-After"};
+    http.collectHeaders(responseHeaders, 2);
+
     _stats.uploadAttempts++;
 
-    int httpCode = http.POST(payload);
+    int httpCode = compressed ? http.POST(gzipPayload.data(), gzipPayload.size()) : http.POST(payload);
     bool success = (httpCode >= 200 && httpCode < 300);
 
+    uint32_t retryAfterMs = 0;
+    if (httpCode > 0) {
+        compression.onAcceptEncoding(http.header("Accept-Encoding"));
+        retryAfterMs = retry::parseRetryAfterMs(http.header("Retry-After"));
+    }
+    CircuitBreaker::forHub().onResult(retry::isHubFailure(httpCode), retryAfterMs, millis());
+    if (compressed && httpCode == 415) {
+        compression.onRejected(httpCode);
+    }
+
     if (success) {
         _stats.entriesUploaded += count;
         _stats.lastUploadTime = millis();
@@ -0,0 +1,193 @@
+/**
+ * myIoTGrid.Sensor - GPS NMEA Ingestion Implementation
+ */
+
+#include "gps_ingestion.h"
+#include "config.h"
+#include "sensor_trace.h"
+#include <cstring>
+
+GpsIngestion& GpsIngestion::getInstance() {
+    static GpsIngestion instance;
+    return instance;
+}
+
+GpsIngestion::GpsIngestion()
+    : _lastByteMs(0)
+    , _sequence(0)
+{
+#ifdef PLATFORM_ESP32
+    _serial = nullptr;
+    _task = nullptr;
+    _stopRequested = false;
+#endif
+    memset(&_snapshot, 0, sizeof(_snapshot));
+    _snapshot.hdop = 99.99;
+}
+
+GpsIngestion::~GpsIngestion() {
+#ifdef PLATFORM_ESP32
+    stop();
+#endif
+}
+
+uint32_t GpsIngestion::encode(const uint8_t* data, size_t length) {
+    uint32_t sentences = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (_gps.encode((char)data[i])) sentences++;
+    }
+    if (length > 0) {
+        _lastByteMs = millis();
+    }
+
+    publish();
+    return sentences;
+}
+
+#ifdef PLATFORM_ESP32
+
+bool GpsIngestion::start(HardwareSerial* serial) {
+    if (!serial) return false;
+
+    if (_task && _serial == serial) {
+        return true;  // Already running on this port
+    }
+    stop();
+
+    _serial = serial;
+    _stopRequested = false;
+
+    BaseType_t created = xTaskCreate(
+        taskEntry,
+        "gps_ingest",
+        config::GPS_TASK_STACK_SIZE,
+        this,
+        config::GPS_TASK_PRIORITY,
+        &_task
+    );
+
+    if (created != pdPASS) {
+        Serial.println("[GPS] Failed to create ingestion task!");
+        _task = nullptr;
+        _serial = nullptr;
+        return false;
+    }
+
+    // Wake the task whenever the UART driver delivers data
+    TaskHandle_t task = _task;
+    _serial->onReceive([task]() {
+        xTaskNotifyGive(task);
+    });
+
+    Serial.println("[GPS] NMEA ingestion task started");
+    return true;
+}
+
+void GpsIngestion::stop() {
+    if (!_task) return;
+
+    if (_serial) {
+        _serial->onReceive(NULL);
+    }
+
+    _stopRequested = true;
+    xTaskNotifyGive(_task);
+
+    // Task deletes itself after leaving its loop
+    uint32_t start = millis();
+    while (_task && millis() - start < 500) {
+        delay(5);
+    }
+
+    if (_task) {
+        Serial.println("[GPS] Ingestion task did not stop, deleting");
+        vTaskDelete(_task);
+        _task = nullptr;
+    }
+
+    _serial = nullptr;
+    Serial.println("[GPS] NMEA ingestion task stopped");
+}
+#endif // PLATFORM_ESP32
+
+GpsSnapshot GpsIngestion::getSnapshot() const {
+    GpsSnapshot copy;
+    uint32_t before, after;
+
+    do {
+        before = _sequence.load(std::memory_order_acquire);
+        memcpy(&copy, (const void*)&_snapshot, sizeof(copy));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = _sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    return copy;
+}
+
+#ifdef PLATFORM_ESP32
+void GpsIngestion::taskEntry(void* param) {
+    static_cast<GpsIngestion*>(param)->run();
+}
+
+void GpsIngestion::run() {
+    while (!_stopRequested) {
+        // Woken by UART event; timeout keeps validity ages current without data
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(config::GPS_PUBLISH_INTERVAL_MS));
+        if (_stopRequested) break;
+
+        // Drain in chunks; encode() publishes after each, also without
+        // data so validity ages stay current
+        uint8_t raw[64];    // NMEA bytes for parser and trace recorder
+        do {
+            size_t rawLength = 0;
+            while (rawLength < sizeof(raw) && _serial && _serial->available() > 0) {
+                raw[rawLength++] = (uint8_t)_serial->read();
+            }
+            TraceRecorder::getInstance().recordUart("gps", raw, rawLength);
+            encode(raw, rawLength);
+        } while (_serial && _serial->available() > 0);
+    }
+
+    _task = nullptr;
+    vTaskDelete(NULL);
+}
+#endif // PLATFORM_ESP32
+
+void GpsIngestion::publish() {
+    const uint32_t maxAge = config::GPS_MAX_FIX_AGE_MS;
+    GpsSnapshot next;
+
+    next.locationValid = _gps.location.isValid() && _gps.location.age() < maxAge;
+    next.altitudeValid = _gps.altitude.isValid() && _gps.altitude.age() < maxAge;
+    next.speedValid = _gps.speed.isValid() && _gps.speed.age() < maxAge;
+    next.satellitesValid = _gps.satellites.isValid() && _gps.satellites.age() < maxAge;
+    next.hdopValid = _gps.hdop.isValid() && _gps.hdop.age() < maxAge;
+
+    next.latitude = next.locationValid ? _gps.location.lat() : 0.0;
+    next.longitude = next.locationValid ? _gps.location.lng() : 0.0;
+    next.altitudeM = next.altitudeValid ? _gps.altitude.meters() : 0.0;
+    next.speedKmph = next.speedValid ? _gps.speed.kmph() : 0.0;
+    next.hdop = next.hdopValid ? _gps.hdop.hdop() : 99.99;
+    next.satellites = next.satellitesValid ? _gps.satellites.value() : 0;
+
+    // TinyGPS++ doesn't expose fix quality directly, so we infer it
+    next.fixType = 0;
+    if (next.locationValid) {
+        next.fixType = (next.satellitesValid && next.satellites >= 4) ? 3 : 2;
+    }
+
+    next.utcDate = _gps.date.isValid() ? _gps.date.value() : 0;
+    next.utcTime = _gps.time.isValid() ? _gps.time.value() : 0;
+    next.updatedAtMs = millis();
+    next.lastSentenceMs = _lastByteMs;
+
+    next.sentencesWithFix = _gps.sentencesWithFix();
+    next.failedChecksums = _gps.failedChecksum();
+    next.charsProcessed = _gps.charsProcessed();
+
+    uint32_t seq = _sequence.load(std::memory_order_relaxed);
+    _sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy((void*)&_snapshot, &next, sizeof(next));
+    _sequence.store(seq + 2, std::memory_order_release);
+}
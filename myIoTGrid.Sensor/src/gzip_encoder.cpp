@@ -0,0 +1,309 @@
+/**
+ * myIoTGrid.Sensor - Streaming gzip Encoder Implementation
+ */
+
+#include "gzip_encoder.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t MIN_MATCH = 3;
+constexpr uint32_t MAX_MATCH = 258;
+constexpr uint32_t MAX_CHAIN = 16;          // Candidates per position (speed vs. ratio)
+constexpr uint32_t HASH_BITS = 10;
+constexpr uint32_t HASH_SIZE = 1u << HASH_BITS;
+
+// RFC 1951 3.2.5: length codes 257..285 and distance codes 0..29
+const uint16_t LENGTH_BASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+const uint8_t LENGTH_EXTRA[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+const uint16_t DIST_BASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+const uint8_t DIST_EXTRA[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+// CRC-32 (IEEE), 4-bit table
+const uint32_t CRC_TABLE[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+uint8_t clampWindowBits(uint8_t bits) {
+    // >= 9: window holds a full match; <= 14: positions (2 * window) fit uint16 + 1
+    if (bits < 9) return 9;
+    if (bits > 14) return 14;
+    return bits;
+}
+
+} // namespace
+
+GzipEncoder::GzipEncoder(uint8_t windowBits)
+    : _windowSize(1u << clampWindowBits(windowBits))
+    , _window(nullptr)
+    , _head(nullptr)
+    , _prev(nullptr)
+    , _fill(0)
+    , _pos(0)
+    , _outLen(0)
+    , _bitBuf(0)
+    , _bitCount(0)
+    , _ok(false)
+    , _crc(0)
+    , _inputBytes(0)
+    , _outputBytes(0)
+{
+}
+
+GzipEncoder::~GzipEncoder() {
+    free(_window);
+    free(_head);
+    free(_prev);
+}
+
+bool GzipEncoder::begin(Sink sink) {
+    _sink = sink;
+    _fill = 0;
+    _pos = 0;
+    _outLen = 0;
+    _bitBuf = 0;
+    _bitCount = 0;
+    _crc = 0;
+    _inputBytes = 0;
+    _outputBytes = 0;
+
+    if (!_window) _window = (uint8_t*)malloc(2 * _windowSize);
+    if (!_head) _head = (uint16_t*)malloc(HASH_SIZE * sizeof(uint16_t));
+    if (!_prev) _prev = (uint16_t*)malloc(_windowSize * sizeof(uint16_t));
+    _ok = (_window && _head && _prev);
+    if (!_ok) return false;
+
+    memset(_head, 0, HASH_SIZE * sizeof(uint16_t));
+    memset(_prev, 0, _windowSize * sizeof(uint16_t));
+
+    // gzip member header: magic, deflate, no flags, no mtime, unknown OS
+    static const uint8_t header[10] = {0x1F, 0x8B, 0x08, 0x00, 0, 0, 0, 0, 0x00, 0xFF};
+    for (uint8_t b : header) putByte(b);
+
+    // One final block with fixed Huffman codes for the whole body
+    putBits(1, 1);  // BFINAL
+    putBits(1, 2);  // BTYPE = 01
+    return _ok;
+}
+
+bool GzipEncoder::write(const uint8_t* data, size_t length) {
+    if (!_ok) return false;
+
+    _crc = updateCrc(_crc, data, length);
+    _inputBytes += length;
+
+    while (length > 0 && _ok) {
+        if (_fill == 2 * _windowSize) {
+            encode(false);
+            slide();
+        }
+        size_t n = 2 * _windowSize - _fill;
+        if (n > length) n = length;
+        memcpy(_window + _fill, data, n);
+        _fill += n;
+        data += n;
+        length -= n;
+    }
+    return _ok;
+}
+
+bool GzipEncoder::finish() {
+    if (_ok) {
+        encode(true);
+        putCode(0, 7);  // End of block (256)
+        flushBits();
+
+        uint32_t trailer[2] = {_crc, (uint32_t)_inputBytes};
+        for (uint32_t value : trailer) {
+            for (int i = 0; i < 4; i++) putByte((uint8_t)(value >> (8 * i)));
+        }
+        flushOutput();
+    }
+
+    free(_window);
+    free(_head);
+    free(_prev);
+    _window = nullptr;
+    _head = nullptr;
+    _prev = nullptr;
+    return _ok;
+}
+
+void GzipEncoder::encode(bool flush) {
+    while (_pos < _fill && _ok) {
+        uint32_t available = _fill - _pos;
+        if (!flush && available < MAX_MATCH) break;   // Wait for a full lookahead
+
+        uint32_t distance = 0;
+        uint32_t length = 0;
+        if (available >= MIN_MATCH) {
+            length = longestMatch(_pos, available < MAX_MATCH ? available : MAX_MATCH, distance);
+        }
+
+        if (length >= MIN_MATCH) {
+            putMatch(length, distance);
+            for (uint32_t i = 0; i < length; i++) insertHash(_pos + i);
+            _pos += length;
+        } else {
+            putLiteral(_window[_pos]);
+            insertHash(_pos);
+            _pos++;
+        }
+    }
+}
+
+void GzipEncoder::slide() {
+    // Encoder is at least one window ahead here (lookahead < MAX_MATCH <= window)
+    memmove(_window, _window + _windowSize, _fill - _windowSize);
+    _fill -= _windowSize;
+    _pos -= _windowSize;
+
+    for (uint32_t i = 0; i < HASH_SIZE; i++) {
+        _head[i] = _head[i] > _windowSize ? _head[i] - _windowSize : 0;
+    }
+    for (uint32_t i = 0; i < _windowSize; i++) {
+        _prev[i] = _prev[i] > _windowSize ? _prev[i] - _windowSize : 0;
+    }
+}
+
+static inline uint32_t hash3(const uint8_t* p) {
+    return ((p[0] << 10) ^ (p[1] << 5) ^ p[2]) & (HASH_SIZE - 1);
+}
+
+void GzipEncoder::insertHash(uint32_t pos) {
+    if (pos + MIN_MATCH > _fill) return;
+
+    uint32_t h = hash3(_window + pos);
+    _prev[pos & (_windowSize - 1)] = _head[h];
+    _head[h] = (uint16_t)(pos + 1);
+}
+
+uint32_t GzipEncoder::longestMatch(uint32_t pos, uint32_t maxLen, uint32_t& distance) const {
+    const uint8_t* current = _window + pos;
+    uint32_t best = 0;
+    uint32_t candidate = _head[hash3(current)];
+
+    for (uint32_t chain = 0; candidate > 0 && chain < MAX_CHAIN; chain++) {
+        uint32_t cand = candidate - 1;
+        if (cand >= pos || pos - cand > _windowSize) break;
+
+        const uint8_t* match = _window + cand;
+        if (match[best] == current[best] && match[0] == current[0]) {
+            uint32_t len = 0;
+            while (len < maxLen && match[len] == current[len]) len++;
+            if (len > best) {
+                best = len;
+                distance = pos - cand;
+                if (len == maxLen) break;
+            }
+        }
+
+        candidate = _prev[cand & (_windowSize - 1)];
+    }
+    return best;
+}
+
+void GzipEncoder::putBits(uint32_t bits, uint8_t count) {
+    _bitBuf |= bits << _bitCount;
+    _bitCount += count;
+    while (_bitCount >= 8) {
+        putByte((uint8_t)_bitBuf);
+        _bitBuf >>= 8;
+        _bitCount -= 8;
+    }
+}
+
+void GzipEncoder::putCode(uint32_t code, uint8_t length) {
+    // Huffman codes are packed starting with their most significant bit
+    uint32_t reversed = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    putBits(reversed, length);
+}
+
+void GzipEncoder::putLiteral(uint8_t literal) {
+    if (literal < 144) {
+        putCode(0x30 + literal, 8);
+    } else {
+        putCode(0x190 + (literal - 144), 9);
+    }
+}
+
+void GzipEncoder::putMatch(uint32_t length, uint32_t distance) {
+    int lc = 28;
+    while (LENGTH_BASE[lc] > length) lc--;
+    uint32_t symbol = 257 + lc;
+    if (symbol < 280) {
+        putCode(symbol - 256, 7);
+    } else {
+        putCode(0xC0 + (symbol - 280), 8);
+    }
+    putBits(length - LENGTH_BASE[lc], LENGTH_EXTRA[lc]);
+
+    int dc = 29;
+    while (DIST_BASE[dc] > distance) dc--;
+    putCode(dc, 5);
+    putBits(distance - DIST_BASE[dc], DIST_EXTRA[dc]);
+}
+
+void GzipEncoder::putByte(uint8_t byte) {
+    _out[_outLen++] = byte;
+    if (_outLen == sizeof(_out)) flushOutput();
+}
+
+void GzipEncoder::flushBits() {
+    if (_bitCount > 0) {
+        putByte((uint8_t)_bitBuf);
+    }
+    _bitBuf = 0;
+    _bitCount = 0;
+}
+
+void GzipEncoder::flushOutput() {
+    if (_outLen == 0) return;
+    if (_ok && !_sink(_out, _outLen)) {
+        _ok = false;
+    }
+    _outputBytes += _outLen;
+    _outLen = 0;
+}
+
+uint32_t GzipEncoder::updateCrc(uint32_t crc, const uint8_t* data, size_t length) {
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ CRC_TABLE[crc & 0x0F];
+        crc = (crc >> 4) ^ CRC_TABLE[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+bool GzipEncoder::compress(const uint8_t* data, size_t length, std::vector<uint8_t>& out,
+                           uint8_t windowBits) {
+    out.clear();
+    out.reserve(length / 2 + 32);
+
+    GzipEncoder encoder(windowBits);
+    bool ok = encoder.begin([&out](const uint8_t* chunk, size_t n) {
+        out.insert(out.end(), chunk, chunk + n);
+        return true;
+    });
+    ok = ok && encoder.write(data, length);
+    return encoder.finish() && ok;
+}
@@ -1,11 +1,13 @@
 #include "hardware_scanner.h"
 #include "uart_manager.h"
+#include <algorithm>
 
 #ifdef PLATFORM_ESP32
 #include <Wire.h>
 #include <OneWire.h>
 #include <DallasTemperature.h>
 #include <driver/uart.h>  // For UART_PIN_NO_CHANGE
+#include <Preferences.h>
 
 // Known I2C devices database
 const I2CDevice HardwareScanner::KNOWN_I2C_DEVICES[] = {
@@ -68,7 +70,8 @@ const I2CDevice HardwareScanner::KNOWN_I2C_DEVICES[] = {
 
 const int HardwareScanner::KNOWN_I2C_DEVICE_COUNT = sizeof(KNOWN_I2C_DEVICES) / sizeof(I2CDevice);
 
-HardwareScanner::HardwareScanner() : _sdaPin(21), _sclPin(22) {
+HardwareScanner::HardwareScanner()
+    : _sdaPin(21), _sclPin(22), _lastScanDurationMs(0), _lastScanCached(false) {
 }
 
 void HardwareScanner::begin(int sdaPin, int sclPin) {
@@ -216,14 +219,17 @@ std::vector<DetectedDevice> HardwareScanner::scanOneWire(int pin) {
 }
 
 std::vector<DetectedDevice> HardwareScanner::scanAnalogPins() {
+    // ESP32 ADC1 pins (GPIO 32-39)
+    return scanAnalogPins({32, 33, 34, 35, 36, 39}, 10);
+}
+
+std::vector<DetectedDevice> HardwareScanner::scanAnalogPins(const std::vector<int>& analogPins,
+                                                            uint32_t sampleDelayMs) {
     std::vector<DetectedDevice> devices;
 
     Serial.println("[Analog] Scanning analog pins...");
     Serial.println("----------------------------------------");
 
-    // ESP32 ADC1 pins (GPIO 32-39)
-    int analogPins[] = {32, 33, 34, 35, 36, 39};
-
     for (int pin : analogPins) {
         int rawValue = analogRead(pin);
         float voltage = (rawValue / 4095.0) * 3.3;
@@ -236,7 +242,7 @@ std::vector<DetectedDevice> HardwareScanner::scanAnalogPins() {
         int readings[5];
         for (int i = 0; i < 5; i++) {
             readings[i] = analogRead(pin);
-            delay(10);
+            delay(sampleDelayMs);
         }
 
         // Calculate variance
@@ -290,6 +296,194 @@ std::vector<DetectedDevice> HardwareScanner::scanAnalogPins() {
     return devices;
 }
 
+std::vector<DetectedDevice> HardwareScanner::scanI2CKnown() {
+    std::vector<DetectedDevice> devices;
+
+    Serial.printf("[I2C] Targeted scan of known addresses at %lu kHz...\n",
+                  (unsigned long)(config::I2C_SCAN_CLOCK_HZ / 1000));
+    Serial.println("----------------------------------------");
+
+    // Fast-mode clock and short timeout: absent devices NACK immediately,
+    // a stuck bus must not stall the scan for the default 50ms per address
+    uint32_t previousClock = Wire.getClock();
+    uint16_t previousTimeout = Wire.getTimeOut();
+    Wire.setClock(config::I2C_SCAN_CLOCK_HZ);
+    Wire.setTimeOut(config::I2C_SCAN_TIMEOUT_MS);
+
+    bool probed[128] = {false};
+    int probeCount = 0;
+
+    for (int i = 0; i < KNOWN_I2C_DEVICE_COUNT; i++) {
+        uint8_t address = KNOWN_I2C_DEVICES[i].address;
+        if (probed[address]) continue;  // Some addresses are shared by several devices
+        probed[address] = true;
+        probeCount++;
+
+        Wire.beginTransmission(address);
+        if (Wire.endTransmission() != 0) continue;
+
+        I2CDevice known = identifyI2CDevice(address);
+
+        DetectedDevice device;
+        device.bus = "I2C";
+        device.address = address;
+        device.deviceName = known.name;
+        device.sensorType = known.sensorType;
+        device.pin = -1;
+        device.value = 0;
+
+        devices.push_back(device);
+
+        Serial.printf("[I2C] 0x%02X - %s (%s)\n",
+            address,
+            known.name.c_str(),
+            known.sensorType.c_str());
+    }
+
+    Wire.setClock(previousClock);
+    Wire.setTimeOut(previousTimeout);
+
+    Serial.printf("[I2C] Found %d device(s) at %d probed address(es)\n", devices.size(), probeCount);
+
+    return devices;
+}
+
+void HardwareScanner::scanTargeted(const std::vector<SensorAssignmentConfig>& configs) {
+    _lastResults.clear();
+
+    auto i2cDevices = scanI2CKnown();
+    _lastResults.insert(_lastResults.end(), i2cDevices.begin(), i2cDevices.end());
+
+    // Collect pins used by the configuration. Sensors without a pin fall
+    // back to the full pin list of their bus.
+    std::vector<int> oneWirePins;
+    std::vector<int> analogPins;
+    bool scanAllOneWire = false;
+    bool scanAllAnalog = false;
+
+    for (const auto& config : configs) {
+        if (!config.isActive) continue;
+
+        String sensorLower = config.sensorCode;
+        sensorLower.toLowerCase();
+
+        if (config.oneWirePin > 0) {
+            if (std::find(oneWirePins.begin(), oneWirePins.end(), config.oneWirePin) == oneWirePins.end()) {
+                oneWirePins.push_back(config.oneWirePin);
+            }
+        } else if (sensorLower.indexOf("ds18") >= 0) {
+            scanAllOneWire = true;
+        }
+
+        // UART sensors store their RX pin in analogPin
+        bool isUart = sensorLower.indexOf("neo") >= 0 || sensorLower.indexOf("gps") >= 0 ||
+                      sensorLower.indexOf("sr04m") >= 0;
+        if (isUart) continue;
+
+        if (config.analogPin > 0) {
+            if (std::find(analogPins.begin(), analogPins.end(), config.analogPin) == analogPins.end()) {
+                analogPins.push_back(config.analogPin);
+            }
+        } else if (sensorLower.indexOf("soil") >= 0 || sensorLower.indexOf("moisture") >= 0 ||
+                   sensorLower.indexOf("analog") >= 0) {
+            scanAllAnalog = true;
+        }
+    }
+
+    if (scanAllOneWire) {
+        oneWirePins = {4, 5, 13, 14, 15, 16, 17, 18, 19, 23, 25, 26, 27, 32, 33};
+    }
+    for (int pin : oneWirePins) {
+        auto owDevices = scanOneWire(pin);
+        _lastResults.insert(_lastResults.end(), owDevices.begin(), owDevices.end());
+    }
+
+    if (scanAllAnalog) {
+        analogPins = {32, 33, 34, 35, 36, 39};
+    }
+    if (!analogPins.empty()) {
+        auto analogDevices = scanAnalogPins(analogPins, config::ANALOG_SCAN_SAMPLE_DELAY_MS);
+        _lastResults.insert(_lastResults.end(), analogDevices.begin(), analogDevices.end());
+    }
+}
+
+bool HardwareScanner::loadScanCache(uint32_t configHash) {
+    Preferences prefs;
+    if (!prefs.begin(config::HW_SCAN_NVS_NAMESPACE, true)) {
+        return false;  // No cache written yet
+    }
+    uint32_t storedHash = prefs.getUInt("crc", 0);
+    String data = prefs.getString("devices", "");
+    prefs.end();
+
+    if (storedHash != configHash) {
+        return false;
+    }
+
+    // One device per line: bus;address;pin;rxPin;txPin;value;deviceName;sensorType
+    _lastResults.clear();
+    int start = 0;
+    while (start < (int)data.length()) {
+        int end = data.indexOf('\n', start);
+        if (end < 0) end = data.length();
+        String line = data.substring(start, end);
+        start = end + 1;
+
+        String fields[8];
+        int fieldCount = 0;
+        int pos = 0;
+        while (fieldCount < 8) {
+            int sep = fieldCount < 7 ? line.indexOf(';', pos) : -1;
+            if (fieldCount < 7 && sep < 0) break;
+            fields[fieldCount++] = sep < 0 ? line.substring(pos) : line.substring(pos, sep);
+            pos = sep + 1;
+        }
+        if (fieldCount != 8) continue;
+
+        DetectedDevice device;
+        device.bus = fields[0];
+        device.address = (uint8_t)fields[1].toInt();
+        device.pin = fields[2].toInt();
+        device.rxPin = fields[3].toInt();
+        device.txPin = fields[4].toInt();
+        device.value = fields[5].toFloat();
+        device.deviceName = fields[6];
+        device.sensorType = fields[7];
+        _lastResults.push_back(device);
+    }
+
+    return true;
+}
+
+void HardwareScanner::saveScanCache(uint32_t configHash) {
+    String data;
+    for (const auto& device : _lastResults) {
+        data += device.bus + ";" + String(device.address) + ";" + String(device.pin) + ";" +
+                String(device.rxPin) + ";" + String(device.txPin) + ";" + String(device.value, 2) + ";" +
+                device.deviceName + ";" + device.sensorType + "\n";
+    }
+
+    Preferences prefs;
+    if (!prefs.begin(config::HW_SCAN_NVS_NAMESPACE, false)) {
+        Serial.println("[HardwareScanner] Failed to open NVS for scan cache");
+        return;
+    }
+    prefs.putString("devices", data);
+    prefs.putUInt("crc", configHash);
+    prefs.end();
+
+    Serial.printf("[HardwareScanner] Cached %d device(s) for config CRC 0x%08X\n",
+                  _lastResults.size(), configHash);
+}
+
+void HardwareScanner::clearScanCache() {
+    Preferences prefs;
+    if (prefs.begin(config::HW_SCAN_NVS_NAMESPACE, false)) {
+        prefs.clear();
+        prefs.end();
+    }
+}
+
 I2CDevice HardwareScanner::identifyI2CDevice(uint8_t address) {
     for (int i = 0; i < KNOWN_I2C_DEVICE_COUNT; i++) {
         if (KNOWN_I2C_DEVICES[i].address == address) {
@@ -713,7 +907,8 @@ void HardwareScanner::debugGPS(int rxPin, int txPin, int durationSeconds) {
     Serial.println("════════════════════════════════════════════════════════════\n");
 }
 
-ValidationSummary HardwareScanner::validateConfiguration(const std::vector<SensorAssignmentConfig>& configs) {
+ValidationSummary HardwareScanner::validateConfiguration(const std::vector<SensorAssignmentConfig>& configs,
+                                                          uint32_t configHash) {
     ValidationSummary summary;
     summary.totalConfigured = 0;
     summary.foundCount = 0;
@@ -723,47 +918,61 @@ ValidationSummary HardwareScanner::validateConfiguration(const std::vector<Senso
     Serial.println("    HARDWARE VALIDATION STARTING");
     Serial.println("========================================\n");
 
-    // First, do a fresh scan of all hardware
-    scanAll();
+    unsigned long scanStart = millis();
+    bool useCache = config::HW_SCAN_CACHE_ENABLED && configHash != 0;
+    _lastScanCached = useCache && loadScanCache(configHash);
 
-    // Also scan UART for GPS and SR04M-2 if any such sensors are configured
-    for (const auto& config : configs) {
-        if (!config.isActive) continue;
+    if (_lastScanCached) {
+        // Warm boot with unchanged configuration: wiring was validated before
+        Serial.printf("[HardwareScanner] Config CRC 0x%08X unchanged - using %d cached device(s), scan skipped\n",
+                      configHash, _lastResults.size());
+    } else {
+        // Targeted scan of the buses the configuration uses
+        scanTargeted(configs);
 
-        String sensorLower = config.sensorCode;
-        sensorLower.toLowerCase();
+        // Also scan UART for GPS and SR04M-2 if any such sensors are configured
+        for (const auto& config : configs) {
+            if (!config.isActive) continue;
 
-        // Check for GPS sensors that need UART scan
-        if (sensorLower.indexOf("neo") >= 0 || sensorLower.indexOf("gps") >= 0) {
-            // Default GPS pins on ESP32
-            int rxPin = 16;  // Default RX
-            int txPin = 17;  // Default TX
+            String sensorLower = config.sensorCode;
+            sensorLower.toLowerCase();
 
-            // Use configured pins if available (stored in analogPin for RX, digitalPin for TX)
-            if (config.analogPin > 0) rxPin = config.analogPin;
-            if (config.digitalPin > 0) txPin = config.digitalPin;
+            // Check for GPS sensors that need UART scan
+            if (sensorLower.indexOf("neo") >= 0 || sensorLower.indexOf("gps") >= 0) {
+                // Default GPS pins on ESP32
+                int rxPin = 16;  // Default RX
+                int txPin = 17;  // Default TX
 
-            auto uartDevices = scanUART(rxPin, txPin);
-            _lastResults.insert(_lastResults.end(), uartDevices.begin(), uartDevices.end());
-        }
+                // Use configured pins if available (stored in analogPin for RX, digitalPin for TX)
+                if (config.analogPin > 0) rxPin = config.analogPin;
+                if (config.digitalPin > 0) txPin = config.digitalPin;
+
+                auto uartDevices = scanUART(rxPin, txPin);
+                _lastResults.insert(_lastResults.end(), uartDevices.begin(), uartDevices.end());
+            }
 
-        // Check for SR04M-2 sensors that need UART scan
-        if (sensorLower.indexOf("sr04m") >= 0) {
-            // Default SR04M-2 pins - RX only mode (auto-send sensor)
-            int rxPin = 4;   // Default RX (sensor TX -> ESP32 RX)
-            int txPin = -1;  // Not used for auto-send mode
-            int baudRate = config.baudRate;  // Use configured baud rate from database
+            // Check for SR04M-2 sensors that need UART scan
+            if (sensorLower.indexOf("sr04m") >= 0) {
+                // Default SR04M-2 pins - RX only mode (auto-send sensor)
+                int rxPin = 4;   // Default RX (sensor TX -> ESP32 RX)
+                int txPin = -1;  // Not used for auto-send mode
+                int baudRate = config.baudRate;  // Use configured baud rate from database
 
-            // Use configured pins if available (analogPin for RX, digitalPin for TX)
-            if (config.analogPin > 0) rxPin = config.analogPin;
-            if (config.digitalPin > 0) txPin = config.digitalPin;
+                // Use configured pins if available (analogPin for RX, digitalPin for TX)
+                if (config.analogPin > 0) rxPin = config.analogPin;
+                if (config.digitalPin > 0) txPin = config.digitalPin;
 
-            // Try to detect SR04M-2 (RX-only mode for auto-send sensors)
-            auto sr04m2Devices = scanSR04M2(rxPin, txPin, baudRate);
-            _lastResults.insert(_lastResults.end(), sr04m2Devices.begin(), sr04m2Devices.end());
+                // Try to detect SR04M-2 (RX-only mode for auto-send sensors)
+                auto sr04m2Devices = scanSR04M2(rxPin, txPin, baudRate);
+                _lastResults.insert(_lastResults.end(), sr04m2Devices.begin(), sr04m2Devices.end());
+            }
         }
     }
 
+    _lastScanDurationMs = millis() - scanStart;
+    Serial.printf("[HardwareScanner] Scan took %lu ms%s\n",
+                  (unsigned long)_lastScanDurationMs, _lastScanCached ? " (cached)" : "");
+
     // Now validate each configured sensor
     for (const auto& config : configs) {
         if (!config.isActive) continue;
@@ -820,6 +1029,15 @@ ValidationSummary HardwareScanner::validateConfiguration(const std::vector<Senso
         summary.results.push_back(result);
     }
 
+    // Only a complete result is cached: missing hardware is rescanned on next boot
+    if (useCache && !_lastScanCached) {
+        if (summary.allFound()) {
+            saveScanCache(configHash);
+        } else {
+            clearScanCache();
+        }
+    }
+
     // Print summary
     printValidationResults(summary);
 
@@ -970,7 +1188,8 @@ uint8_t HardwareScanner::parseI2CAddress(const String& addressStr) {
 const I2CDevice HardwareScanner::KNOWN_I2C_DEVICES[] = {};
 const int HardwareScanner::KNOWN_I2C_DEVICE_COUNT = 0;
 
-HardwareScanner::HardwareScanner() : _sdaPin(21), _sclPin(22) {}
+HardwareScanner::HardwareScanner()
+    : _sdaPin(21), _sclPin(22), _lastScanDurationMs(0), _lastScanCached(false) {}
 
 void HardwareScanner::begin(int sdaPin, int sclPin) {
     _sdaPin = sdaPin;
@@ -993,6 +1212,14 @@ std::vector<DetectedDevice> HardwareScanner::scanAnalogPins() {
     return std::vector<DetectedDevice>();
 }
 
+std::vector<DetectedDevice> HardwareScanner::scanAnalogPins(const std::vector<int>& pins, uint32_t sampleDelayMs) {
+    return std::vector<DetectedDevice>();
+}
+
+std::vector<DetectedDevice> HardwareScanner::scanI2CKnown() {
+    return std::vector<DetectedDevice>();
+}
+
 std::vector<DetectedDevice> HardwareScanner::scanUART(int rxPin, int txPin, int baudRate) {
     return std::vector<DetectedDevice>();
 }
@@ -1013,7 +1240,8 @@ void HardwareScanner::printResults(const std::vector<DetectedDevice>& devices) {
     // No-op on native platform
 }
 
-ValidationSummary HardwareScanner::validateConfiguration(const std::vector<SensorAssignmentConfig>& configs) {
+ValidationSummary HardwareScanner::validateConfiguration(const std::vector<SensorAssignmentConfig>& configs,
+                                                          uint32_t configHash) {
     // On native platform, always report all configured sensors as found (simulation mode)
     ValidationSummary summary;
     summary.totalConfigured = 0;
@@ -1044,6 +1272,10 @@ void HardwareScanner::printValidationResults(const ValidationSummary& summary) {
     // No-op on native platform
 }
 
+void HardwareScanner::clearScanCache() {
+    // No NVS on native platform
+}
+
 bool HardwareScanner::sensorMatchesDevice(const String& sensorCode, const DetectedDevice& device) {
     return false;
 }
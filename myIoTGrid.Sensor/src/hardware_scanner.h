@@ -66,11 +66,22 @@ public:
     std::vector<DetectedDevice> scanI2C();
     std::vector<DetectedDevice> scanOneWire(int pin);
     std::vector<DetectedDevice> scanAnalogPins();
+
+    // Targeted scans: only known device addresses at fast-mode clock,
+    // only the given analog pins with short settle time
+    std::vector<DetectedDevice> scanI2CKnown();
+    std::vector<DetectedDevice> scanAnalogPins(const std::vector<int>& pins, uint32_t sampleDelayMs);
     std::vector<DetectedDevice> scanUART(int rxPin, int txPin, int baudRate = 9600);
     std::vector<DetectedDevice> scanSR04M2(int rxPin, int txPin, int baudRate = 115200);
 
     // Validate configured sensors against detected hardware
-    ValidationSummary validateConfiguration(const std::vector<SensorAssignmentConfig>& configs);
+    // configHash: HardwareValidator config CRC; if it matches the NVS cache
+    // the stored results are reused and no bus is scanned (0 = always scan)
+    ValidationSummary validateConfiguration(const std::vector<SensorAssignmentConfig>& configs,
+                                            uint32_t configHash = 0);
+
+    // Drop cached scan results (next validation scans again)
+    void clearScanCache();
 
     // GPS Diagnostics - outputs raw NMEA data, satellite info, and troubleshooting tips
     void debugGPS(int rxPin = 16, int txPin = 17, int durationSeconds = 30);
@@ -84,10 +95,16 @@ public:
     // Get last scan results
     const std::vector<DetectedDevice>& getLastScanResults() const { return _lastResults; }
 
+    // Duration of last validation scan (or cache load) and whether it came from NVS
+    uint32_t getLastScanDurationMs() const { return _lastScanDurationMs; }
+    bool wasLastScanCached() const { return _lastScanCached; }
+
 private:
     int _sdaPin;
     int _sclPin;
     std::vector<DetectedDevice> _lastResults;
+    uint32_t _lastScanDurationMs;
+    bool _lastScanCached;
 
     // I2C device database
     static const I2CDevice KNOWN_I2C_DEVICES[];
@@ -101,6 +118,13 @@ private:
 
     // Helper to parse I2C address string (e.g., "0x76" -> 118)
     uint8_t parseI2CAddress(const String& addressStr);
+
+    // Targeted scan of the buses used by the configuration
+    void scanTargeted(const std::vector<SensorAssignmentConfig>& configs);
+
+    // NVS scan cache keyed by config CRC
+    bool loadScanCache(uint32_t configHash);
+    void saveScanCache(uint32_t configHash);
 };
 
 #endif // HARDWARE_SCANNER_H
@@ -0,0 +1,105 @@
+/**
+ * myIoTGrid.Sensor - HTTP Request Compression Implementation
+ */
+
+#include "http_compression.h"
+#include "gzip_encoder.h"
+
+HttpCompression& HttpCompression::getInstance() {
+    static HttpCompression instance;
+    return instance;
+}
+
+HttpCompression::HttpCompression()
+    : _support(CompressionSupport::UNKNOWN)
+    , _compressedRequests(0)
+    , _uncompressedRequests(0)
+    , _rawBytes(0)
+    , _sentBytes(0)
+{
+}
+
+bool HttpCompression::compress(const String& body, std::vector<uint8_t>& out) {
+    return compress((const uint8_t*)body.c_str(), body.length(), out);
+}
+
+bool HttpCompression::compress(const uint8_t* data, size_t length, std::vector<uint8_t>& out) {
+    bool attempt;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        attempt = config::HTTP_COMPRESSION_ENABLED &&
+                  _support == CompressionSupport::SUPPORTED &&
+                  length >= config::HTTP_COMPRESSION_MIN_BYTES;
+        if (!attempt) {
+            _uncompressedRequests++;
+            return false;
+        }
+    }
+
+    bool ok = GzipEncoder::compress(data, length, out,
+                                    config::HTTP_COMPRESSION_WINDOW_BITS);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    // Out of memory or incompressible (e.g. already short): send as is
+    if (!ok || out.size() >= length) {
+        out.clear();
+        _uncompressedRequests++;
+        return false;
+    }
+
+    _compressedRequests++;
+    _rawBytes += length;
+    _sentBytes += out.size();
+    return true;
+}
+
+void HttpCompression::onAcceptEncoding(const String& header) {
+    if (header.length() == 0) return;
+
+    String encodings = header;
+    encodings.toLowerCase();
+    if (encodings.indexOf("gzip") < 0) return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_support == CompressionSupport::UNKNOWN) {
+        _support = CompressionSupport::SUPPORTED;
+        Serial.printf("[HTTP] Hub accepts gzip request bodies%s\n",
+                      config::HTTP_COMPRESSION_ENABLED ? "" : " (compression disabled)");
+    }
+}
+
+void HttpCompression::onRejected(int statusCode) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_support != CompressionSupport::REJECTED) {
+        _support = CompressionSupport::REJECTED;
+        Serial.printf("[HTTP] Hub rejected gzip body (HTTP %d) - sending uncompressed\n", statusCode);
+    }
+}
+
+CompressionSupport HttpCompression::getSupport() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _support;
+}
+
+float HttpCompression::getRatio() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _rawBytes > 0 ? (float)_sentBytes / (float)_rawBytes : 1.0f;
+}
+
+String HttpCompression::getStatsJson() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const char* support = "unknown";
+    if (_support == CompressionSupport::SUPPORTED) support = "gzip";
+    else if (_support == CompressionSupport::REJECTED) support = "rejected";
+
+    char buf[192];
+    snprintf(buf, sizeof(buf),
+             "{\"enabled\":%s,\"hub\":\"%s\",\"compressedRequests\":%lu,\"uncompressedRequests\":%lu,"
+             "\"rawBytes\":%llu,\"sentBytes\":%llu,\"ratio\":%.3f}",
+             config::HTTP_COMPRESSION_ENABLED ? "true" : "false", support,
+             (unsigned long)_compressedRequests, (unsigned long)_uncompressedRequests,
+             (unsigned long long)_rawBytes, (unsigned long long)_sentBytes,
+             _rawBytes > 0 ? (double)_sentBytes / (double)_rawBytes : 1.0);
+    return String(buf);
+}
@@ -0,0 +1,125 @@
+/**
+ * myIoTGrid.Sensor - JSON Arena Allocator Implementation
+ */
+
+#include "json_arena.h"
+#include "metrics.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t RELEASED = 0x80000000;   // BlockHeader::size flag
+constexpr size_t ALIGN = 8;
+
+size_t alignUp(size_t size) {
+    return (size + ALIGN - 1) & ~(ALIGN - 1);
+}
+
+} // namespace
+
+JsonArena& JsonArena::getInstance() {
+    static JsonArena instance;
+    return instance;
+}
+
+JsonArena::JsonArena()
+    : _top(0)
+    , _topBlock(0)
+    , _live(0)
+    , _peak(0)
+    , _fallbacks(0)
+    , _rewinds(0)
+{
+}
+
+void* JsonArena::allocate(size_t size) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return allocateLocked(size);
+}
+
+void JsonArena::deallocate(void* ptr) {
+    if (!ptr) return;
+    if (!owns(ptr)) {
+        free(ptr);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    releaseLocked((uint8_t*)ptr);
+}
+
+void* JsonArena::reallocate(void* ptr, size_t newSize) {
+    if (!ptr) return allocate(newSize);
+    if (!owns(ptr)) return realloc(ptr, newSize);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint8_t* payload = (uint8_t*)ptr;
+    BlockHeader* header = headerOf(payload);
+    size_t oldSize = header->size & ~RELEASED;
+    size_t aligned = alignUp(newSize);
+    size_t offset = (uint8_t*)header - _buffer;
+
+    // Top block: move the top
+    if (_topBlock == offset + 1 && offset + sizeof(BlockHeader) + aligned <= sizeof(_buffer)) {
+        header->size = aligned;
+        _top = offset + sizeof(BlockHeader) + aligned;
+        if (_top > _peak) _peak = _top;
+        return ptr;
+    }
+
+    // Shrinking below the top: keep the block
+    if (aligned <= oldSize) {
+        return ptr;
+    }
+
+    void* moved = allocateLocked(newSize);
+    if (!moved) return nullptr;
+    memcpy(moved, ptr, oldSize < newSize ? oldSize : newSize);
+    releaseLocked(payload);
+    return moved;
+}
+
+void* JsonArena::allocateLocked(size_t size) {
+    size_t aligned = alignUp(size);
+    if (_top + sizeof(BlockHeader) + aligned > sizeof(_buffer)) {
+        _fallbacks++;
+        metrics::inc(metrics::Counter::ARENA_FALLBACKS);
+        return malloc(size);
+    }
+
+    BlockHeader* header = (BlockHeader*)(_buffer + _top);
+    header->size = aligned;
+    header->prev = _topBlock;
+    _topBlock = _top + 1;
+    _top += sizeof(BlockHeader) + aligned;
+    _live++;
+    if (_top > _peak) _peak = _top;
+    return header + 1;
+}
+
+void JsonArena::releaseLocked(uint8_t* payload) {
+    headerOf(payload)->size |= RELEASED;
+    _live--;
+
+    // Pop released blocks off the top; rewinds to empty with the last one
+    while (_topBlock != 0) {
+        BlockHeader* top = (BlockHeader*)(_buffer + _topBlock - 1);
+        if (!(top->size & RELEASED)) break;
+        _top = _topBlock - 1;
+        _topBlock = top->prev;
+    }
+    if (_top == 0) _rewinds++;
+}
+
+String JsonArena::getStatsJson() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    String json = "{";
+    json += "\"size\":" + String((unsigned long)sizeof(_buffer)) + ",";
+    json += "\"peak\":" + String((unsigned long)_peak) + ",";
+    json += "\"live\":" + String((unsigned long)_live) + ",";
+    json += "\"rewinds\":" + String((unsigned long)_rewinds) + ",";
+    json += "\"fallbacks\":" + String((unsigned long)_fallbacks);
+    json += "}";
+    return json;
+}
@@ -227,6 +227,37 @@ void LEDController::update() {
     }
 }
 
+uint32_t LEDController::getNextUpdateMs() const {
+    if (!_initialized) return UINT32_MAX;
+
+    unsigned long period;
+    switch (_currentPattern) {
+        case LEDPattern::SLOW_BLINK:
+            period = SLOW_BLINK_MS;
+            break;
+        case LEDPattern::FAST_BLINK:
+            period = FAST_BLINK_MS;
+            break;
+        case LEDPattern::DOUBLE_BLINK:
+        case LEDPattern::TRIPLE_BLINK:
+            period = _inPause ? PATTERN_PAUSE_MS : QUICK_BLINK_MS;
+            break;
+        case LEDPattern::HEARTBEAT:
+            period = _ledOn ? HEARTBEAT_INTERVAL_MS : HEARTBEAT_OFF_MS;
+            break;
+        case LEDPattern::RE_PAIRING_BLINK:
+            period = _inPause ? RE_PAIRING_PAUSE_MS : RE_PAIRING_BLINK_MS;
+            break;
+        case LEDPattern::OFF:
+        case LEDPattern::SOLID:
+        default:
+            return UINT32_MAX;  // Static - nothing to do until the pattern changes
+    }
+
+    unsigned long elapsed = millis() - _lastUpdate;
+    return elapsed >= period ? 0 : (uint32_t)(period - elapsed);
+}
+
 void LEDController::on() {
     setHardwareLED(true);
     _ledOn = true;
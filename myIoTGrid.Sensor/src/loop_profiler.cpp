@@ -0,0 +1,129 @@
+/**
+ * myIoTGrid.Sensor - Loop Profiler Implementation
+ */
+
+#include "loop_profiler.h"
+#include "debug_manager.h"
+#include <algorithm>
+
+LoopProfiler& LoopProfiler::getInstance() {
+    static LoopProfiler instance;
+    return instance;
+}
+
+LoopProfiler::LoopProfiler()
+    : _count(0)
+    , _wakeStage(-1)
+    , _lastReportMs(0)
+{
+    _wakeStage = addStage("wake", config::LOOP_WAKE_BUDGET_US);
+}
+
+int LoopProfiler::addStage(const char* name, uint32_t budgetUs) {
+    if (_count >= config::LOOP_PROFILER_MAX_STAGES) {
+        Serial.printf("[Profiler] Stage table full, %s not profiled\n", name);
+        return -1;
+    }
+
+    LoopStageStats& stage = _stages[_count];
+    stage.name = name;
+    stage.budgetUs = budgetUs;
+    stage.count = 0;
+    stage.totalUs = 0;
+    stage.minUs = UINT32_MAX;
+    stage.maxUs = 0;
+    stage.overruns = 0;
+    stage.lastWarnMs = 0;
+    stage.ringPos = 0;
+    return (int)_count++;
+}
+
+void LoopProfiler::record(int index, uint32_t durationUs) {
+    if (index < 0 || (size_t)index >= _count) return;
+
+    LoopStageStats& stage = _stages[index];
+    stage.count++;
+    stage.totalUs += durationUs;
+    if (durationUs < stage.minUs) stage.minUs = durationUs;
+    if (durationUs > stage.maxUs) stage.maxUs = durationUs;
+
+    stage.ring[stage.ringPos] = durationUs > UINT16_MAX ? UINT16_MAX : (uint16_t)durationUs;
+    stage.ringPos = (stage.ringPos + 1) % config::LOOP_PROFILER_RING_SIZE;
+
+    if (durationUs <= stage.budgetUs) return;
+    stage.overruns++;
+
+    if (DebugManager::getInstance().getLevel() == DebugLevel::PRODUCTION) return;
+
+    unsigned long now = millis();
+    if (stage.lastWarnMs == 0 || now - stage.lastWarnMs >= config::LOOP_PROFILER_WARN_INTERVAL_MS) {
+        stage.lastWarnMs = now;
+        Serial.printf("[Profiler] %s took %lu us (budget %lu us, %lu overruns)\n",
+                      stage.name, (unsigned long)durationUs, (unsigned long)stage.budgetUs,
+                      stage.overruns);
+    }
+}
+
+void LoopProfiler::loop(unsigned long now) {
+    if (DebugManager::getInstance().getLevel() != DebugLevel::DEBUG) return;
+
+    if (_lastReportMs == 0) {
+        _lastReportMs = now;
+    } else if (now - _lastReportMs >= config::LOOP_PROFILER_REPORT_MS) {
+        _lastReportMs = now;
+        printReport();
+    }
+}
+
+uint32_t LoopProfiler::percentile(const LoopStageStats& stage, uint32_t permille) const {
+    size_t samples = stage.count < config::LOOP_PROFILER_RING_SIZE
+                   ? stage.count : config::LOOP_PROFILER_RING_SIZE;
+    if (samples == 0) return 0;
+
+    uint16_t sorted[config::LOOP_PROFILER_RING_SIZE];
+    std::copy(stage.ring, stage.ring + samples, sorted);
+
+    size_t rank = (samples * permille + 999) / 1000;
+    if (rank > 0) rank--;
+    std::nth_element(sorted, sorted + rank, sorted + samples);
+    return sorted[rank];
+}
+
+String LoopProfiler::getStatsJson() const {
+    String json = "{";
+    bool first = true;
+    for (size_t i = 0; i < _count; i++) {
+        const LoopStageStats& stage = _stages[i];
+        if (stage.count == 0) continue;
+
+        if (!first) json += ",";
+        first = false;
+        json += "\"" + String(stage.name) + "\":{";
+        json += "\"n\":" + String(stage.count) + ",";
+        json += "\"avg\":" + String((unsigned long)(stage.totalUs / stage.count)) + ",";
+        json += "\"p99\":" + String((unsigned long)percentile(stage, 990)) + ",";
+        json += "\"max\":" + String((unsigned long)stage.maxUs) + ",";
+        json += "\"over\":" + String(stage.overruns) + "}";
+    }
+    json += "}";
+    return json;
+}
+
+void LoopProfiler::printReport() const {
+    Serial.println("[Profiler] ========================================");
+    Serial.printf("[Profiler]   %-10s %8s %8s %8s %8s %8s %6s\n",
+                  "stage", "runs", "min", "avg", "p99", "max", "over");
+
+    for (size_t i = 0; i < _count; i++) {
+        const LoopStageStats& stage = _stages[i];
+        if (stage.count == 0) continue;
+
+        Serial.printf("[Profiler]   %-10s %8lu %8lu %8lu %8lu %8lu %6lu\n",
+                      stage.name, stage.count, (unsigned long)stage.minUs,
+                      (unsigned long)(stage.totalUs / stage.count),
+                      (unsigned long)percentile(stage, 990), (unsigned long)stage.maxUs,
+                      stage.overruns);
+    }
+    Serial.println("[Profiler] (us; p99 over the last runs, saturates at 65535)");
+    Serial.println("[Profiler] ========================================");
+}
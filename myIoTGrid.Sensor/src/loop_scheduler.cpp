@@ -0,0 +1,221 @@
+/**
+ * myIoTGrid.Sensor - Loop Scheduler Implementation
+ */
+
+#include "loop_scheduler.h"
+#include "metrics.h"
+#include "loop_profiler.h"
+
+#include <memory>
+
+#ifdef PLATFORM_ESP32
+#include <esp_idf_version.h>
+#include <esp_pm.h>
+#else
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+#endif
+
+LoopScheduler& LoopScheduler::getInstance() {
+    static LoopScheduler instance;
+    return instance;
+}
+
+LoopScheduler::LoopScheduler()
+    : _eventPending(false)
+    , _wakeups(0)
+    , _sleptMs(0)
+    , _lightSleep(false)
+#ifdef PLATFORM_ESP32
+    , _loopTask(nullptr)
+#else
+    , _eventFd(-1)
+#endif
+{
+}
+
+void LoopScheduler::begin() {
+#ifdef PLATFORM_ESP32
+    _loopTask = xTaskGetCurrentTaskHandle();
+
+#if CONFIG_PM_ENABLE && CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    if (config::LOOP_LIGHT_SLEEP_ENABLED) {
+#if ESP_IDF_VERSION_MAJOR >= 5
+        esp_pm_config_t pm = {};
+#else
+        esp_pm_config_esp32_t pm = {};
+#endif
+        pm.max_freq_mhz = getCpuFrequencyMhz();
+        pm.min_freq_mhz = config::LOOP_LIGHT_SLEEP_MIN_FREQ_MHZ;
+        pm.light_sleep_enable = true;
+
+        esp_err_t err = esp_pm_configure(&pm);
+        _lightSleep = (err == ESP_OK);
+        if (!_lightSleep) {
+            Serial.printf("[Scheduler] esp_pm_configure failed: %s\n", esp_err_to_name(err));
+        }
+    }
+#endif
+
+    Serial.printf("[Scheduler] Started (%s, max sleep %lu ms)\n",
+                  _lightSleep ? "auto light sleep" : "modem sleep only",
+                  (unsigned long)config::LOOP_MAX_SLEEP_MS);
+#else
+#ifdef __linux__
+    if (_eventFd < 0) {
+        _eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+#endif
+    Serial.printf("[Scheduler] Started (max sleep %lu ms)\n", (unsigned long)config::LOOP_MAX_SLEEP_MS);
+#endif
+}
+
+void LoopScheduler::addTask(const char* name, DeadlineFn deadline, RunFn run) {
+    _tasks.push_back({name, deadline, run, LoopProfiler::getInstance().addStage(name)});
+}
+
+void LoopScheduler::addPeriodicTask(const char* name, uint32_t intervalMs, RunFn run) {
+    auto lastRun = std::make_shared<unsigned long>(millis());
+
+    addTask(name,
+        [lastRun, intervalMs](unsigned long now) -> uint32_t {
+            unsigned long elapsed = now - *lastRun;
+            return elapsed >= intervalMs ? 0 : (uint32_t)(intervalMs - elapsed);
+        },
+        [lastRun, run](unsigned long now) {
+            *lastRun = now;
+            run(now);
+        });
+}
+
+void LoopScheduler::runDue() {
+    // After a GPIO/network event every task gets a chance to look at it
+    bool runAll = _eventPending;
+    _eventPending = false;
+    metrics::ScopedTimer passTimer(metrics::Histogram::LOOP_PASS_US);
+
+    for (auto& task : _tasks) {
+        unsigned long now = millis();
+        if (runAll || task.deadline(now) == 0) {
+            LoopProfiler::Scope scope(task.stage);
+            task.run(now);
+        }
+    }
+
+    LoopProfiler::getInstance().loop(millis());
+}
+
+uint32_t LoopScheduler::getNextDeadlineMs() const {
+    unsigned long now = millis();
+    uint32_t next = IDLE;
+
+    for (const auto& task : _tasks) {
+        uint32_t due = task.deadline(now);
+        if (due < next) next = due;
+        if (next == 0) break;
+    }
+    return next;
+}
+
+void LoopScheduler::sleepUntilNextDeadline() {
+    if (_eventPending) return;
+
+    uint32_t sleepMs = getNextDeadlineMs();
+    if (sleepMs == 0) return;
+
+    if (sleepMs > config::LOOP_MAX_SLEEP_MS) {
+        sleepMs = config::LOOP_MAX_SLEEP_MS;
+    }
+    if (_lightSleep && !_wakePins.empty() && sleepMs > config::LOOP_WAKE_PIN_POLL_MS) {
+        sleepMs = config::LOOP_WAKE_PIN_POLL_MS;  // GPIO interrupts don't fire in light sleep
+    }
+
+    unsigned long start = millis();
+    unsigned long startUs = micros();
+
+#ifdef PLATFORM_ESP32
+    if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(sleepMs)) > 0) {
+        _eventPending = true;
+    }
+
+    if (_lightSleep) {
+        for (int pin : _wakePins) {
+            if (digitalRead(pin) == LOW) {
+                _eventPending = true;
+            }
+        }
+    }
+#else
+#ifdef __linux__
+    if (_eventFd >= 0) {
+        struct pollfd pfd = {_eventFd, POLLIN, 0};
+        if (poll(&pfd, 1, (int)sleepMs) > 0) {
+            uint64_t count;
+            if (read(_eventFd, &count, sizeof(count)) == sizeof(count)) {
+                _eventPending = true;
+            }
+        }
+    } else {
+        delay(sleepMs);
+    }
+#else
+    delay(sleepMs);
+#endif
+#endif
+
+    // Timed wake-ups only: how late the loop got back against its deadline
+    if (!_eventPending) {
+        uint32_t elapsedUs = micros() - startUs;
+        uint32_t plannedUs = sleepMs * 1000;
+        LoopProfiler::getInstance().recordWakeLateness(elapsedUs > plannedUs ? elapsedUs - plannedUs : 0);
+    }
+
+    _sleptMs += millis() - start;
+    _wakeups++;
+}
+
+void LoopScheduler::wake() {
+#ifdef PLATFORM_ESP32
+    if (_loopTask) {
+        xTaskNotifyGive(_loopTask);
+    }
+#else
+#ifdef __linux__
+    if (_eventFd >= 0) {
+        uint64_t one = 1;
+        (void)write(_eventFd, &one, sizeof(one));
+        return;
+    }
+#endif
+    _eventPending = true;
+#endif
+}
+
+#ifdef PLATFORM_ESP32
+void IRAM_ATTR LoopScheduler::onWakePin(void* arg) {
+    TaskHandle_t task = static_cast<LoopScheduler*>(arg)->_loopTask;
+    if (!task) return;
+
+    BaseType_t higherPriorityWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(task, &higherPriorityWoken);
+    if (higherPriorityWoken) {
+        portYIELD_FROM_ISR();
+    }
+}
+#endif
+
+void LoopScheduler::addWakePin(int pin) {
+    if (pin < 0) return;
+
+    for (int existing : _wakePins) {
+        if (existing == pin) return;
+    }
+    _wakePins.push_back(pin);
+
+#ifdef PLATFORM_ESP32
+    attachInterruptArg(digitalPinToInterrupt(pin), onWakePin, this, CHANGE);
+#endif
+}
@@ -20,6 +20,8 @@
 #include <Arduino.h>
 #include <vector>
 #include <map>
+#include <atomic>
+#include <mutex>
 #include "config.h"
 #include "state_machine.h"
 #include "config_manager.h"
@@ -30,12 +32,27 @@
 #include "hardware_scanner.h"
 #include "sensor_reader.h"
 #include "led_controller.h"
+#include "reading_aggregator.h"
+#include "deadband_filter.h"
+#include "boot_profiler.h"
+#include "loop_scheduler.h"
+#include "loop_profiler.h"
+#include "json_arena.h"
+#include "sensor_schedule.h"
+#include "bench_suite.h"
+#include "reading_pipeline.h"
+#include "time_service.h"
+#include "wire_codec.h"
+#include "retry_policy.h"
+#include "metrics.h"
+#include "sensor_trace.h"
 
 // Sprint OS-01: Offline Storage Components
 #include "storage/sd_manager.h"
 #include "storage/storage_config.h"
 #include "storage/reading_storage.h"
 #include "storage/sync_manager.h"
+#include "storage/retention_engine.h"
 #include "ui/sync_status_led.h"
 #include "ui/sync_button.h"
 
@@ -108,12 +125,15 @@ SensorSimulator sensorSimulator;
 HardwareScanner hardwareScanner;
 SensorReader sensorReader;
 LEDController ledController;
+ReadingAggregator readingAggregator;
+DeadbandFilter deadbandFilter;
 
 // Sprint OS-01: Offline Storage Instances
 SDManager sdManager;
 StorageConfigManager storageConfigManager;
 ReadingStorage readingStorage;
 SyncManager syncManager;
+RetentionEngine retentionEngine;
 SyncStatusLED syncStatusLED;
 SyncButton syncButton;
 bool offlineStorageEnabled = false;
@@ -173,6 +193,12 @@ static unsigned long lastWiFiCheck = 0;
 static unsigned long lastConfigCheck = 0;
 static unsigned long lastDebugConfigCheck = 0;
 
+// Hub polling intervals, redrawn +/- PERIODIC_JITTER_PERCENT after every run
+// so nodes that booted together (power outage) do not poll in lockstep
+static unsigned long heartbeatIntervalMs = HEARTBEAT_INTERVAL_MS;
+static unsigned long configCheckIntervalMs = CONFIG_CHECK_INTERVAL_MS;
+static unsigned long debugConfigCheckIntervalMs = DEBUG_CONFIG_CHECK_INTERVAL_MS;
+
 // Per-sensor timing for GCD-based polling
 static std::map<int, unsigned long> sensorLastReading;  // endpointId -> last reading time
 static int calculatedPollIntervalSeconds = 60;  // GCD of all sensor intervals
@@ -183,6 +209,19 @@ static bool configLoaded = false;
 static String currentSerial;
 static unsigned long lastValidatedConfigTimestamp = 0;  // Track when we last validated hardware
 
+// Boot timeline / fast boot: hardware report and debug config run after the first reading
+static bool deferredBootWorkPending = false;
+static unsigned long deferredBootWorkSince = 0;
+static bool fastBootRegistrationPending = false;  // Registration skipped by fast boot
+static std::atomic<unsigned long> readingsDelivered(0);  // Sent or stored since boot (pipeline tasks)
+
+// Sampling task vs. loop task: currentConfig, sensor state, simulator
+static std::recursive_mutex configMutex;
+#ifdef PLATFORM_ESP32
+// Storage task vs. sync manager in the loop task
+static std::mutex storageMutex;
+#endif
+
 // ============================================================================
 // URL Helper Functions
 // ============================================================================
@@ -243,61 +282,32 @@ String ensureUrlHasPort(const String& url, int defaultPort = 5002) {
 // ============================================================================
 
 /**
- * Calculate GCD (Greatest Common Divisor) of two numbers using Euclidean algorithm
- */
-int gcd(int a, int b) {
-    if (b == 0) return a;
-    return gcd(b, a % b);
-}
-
-/**
- * Calculate GCD of all sensor intervals
- * This determines the poll loop interval - only sensors due at each tick are read
- *
- * Example: Sensors with 30s, 20s, 15s intervals
- * GCD(30, 20, 15) = 5
- * Poll every 5s, but only read sensors when their interval elapsed
+ * Poll interval: GCD of all sensor intervals (see sensor_schedule.h)
+ * Only sensors due at each tick are read.
  */
 int calculatePollIntervalGCD() {
-    if (!configLoaded || currentConfig.sensors.size() == 0) {
+    if (!configLoaded) {
         return currentConfig.defaultIntervalSeconds > 0 ? currentConfig.defaultIntervalSeconds : 60;
     }
+    return schedule::pollIntervalGCD(currentConfig.sensors, currentConfig.defaultIntervalSeconds);
+}
 
-    int result = 0;
-    for (const auto& sensor : currentConfig.sensors) {
-        if (sensor.isActive && sensor.intervalSeconds > 0) {
-            if (result == 0) {
-                result = sensor.intervalSeconds;
-            } else {
-                result = gcd(result, sensor.intervalSeconds);
-            }
-        }
-    }
-
-    // Fallback to default if no active sensors with intervals
-    if (result == 0) {
-        result = currentConfig.defaultIntervalSeconds > 0 ? currentConfig.defaultIntervalSeconds : 60;
+/**
+ * Sensor poll interval (GCD of all sensor intervals)
+ */
+unsigned long getSensorPollIntervalMs() {
+    unsigned long sensorInterval = calculatedPollIntervalSeconds * 1000UL;
+    if (sensorInterval == 0) {
+        sensorInterval = SENSOR_INTERVAL_MS;
     }
-
-    return result;
+    return sensorInterval;
 }
 
 /**
  * Check if a specific sensor is due for reading based on its interval
  */
 bool isSensorDue(const SensorAssignmentConfig& sensor, unsigned long now) {
-    if (!sensor.isActive || sensor.intervalSeconds <= 0) {
-        return false;
-    }
-
-    auto it = sensorLastReading.find(sensor.endpointId);
-    if (it == sensorLastReading.end()) {
-        // First reading - sensor is due
-        return true;
-    }
-
-    unsigned long elapsed = (now - it->second) / 1000;  // Convert to seconds
-    return elapsed >= (unsigned long)sensor.intervalSeconds;
+    return schedule::isSensorDue(sensor, sensorLastReading, now);
 }
 
 /**
@@ -571,6 +581,7 @@ void checkBootButtonForFactoryReset() {
             Serial.println("========================================");
             Serial.println();
 
+            wifiManager.clearFastConnectCache();
             configManager.factoryReset();
         }
     } else if (!buttonPressed && buttonWasPressed) {
@@ -627,6 +638,7 @@ void checkBootButton() {
             }
 
             // Perform factory reset (clears NVS and restarts)
+            wifiManager.clearFastConnectCache();
             configManager.factoryReset();
             // Note: factoryReset() calls ESP.restart(), so we won't reach here
         }
@@ -813,56 +825,63 @@ void onReProvisioningConfigReceived(const BLEConfig& config) {
 // WiFi Callbacks
 // ============================================================================
 
+#ifdef PLATFORM_ESP32
+/**
+ * HTTPS self-test against httpbin.org with the embedded Root CA.
+ * Diagnostic only - runs with the deferred boot work, not in the connect path.
+ */
+void runHttpsSelfTest() {
+    Serial.println("[TEST] Testing HTTPS to httpbin.org with esp_http_client...");
+
+    esp_http_client_config_t httpConfig = {};
+    httpConfig.url = "https://httpbin.org/get";
+    httpConfig.timeout_ms = 30000;
+    httpConfig.transport_type = HTTP_TRANSPORT_OVER_SSL;
+    httpConfig.cert_pem = ISRG_ROOT_X1_CERT;  // Use embedded Let's Encrypt Root CA
+
+    esp_http_client_handle_t client = esp_http_client_init(&httpConfig);
+    if (client != nullptr) {
+        esp_err_t err = esp_http_client_perform(client);
+        if (err == ESP_OK) {
+            int statusCode = esp_http_client_get_status_code(client);
+            int contentLength = esp_http_client_get_content_length(client);
+            Serial.printf("[TEST] HTTPS success! Status: %d, Content-Length: %d\n", statusCode, contentLength);
+        } else {
+            Serial.printf("[TEST] HTTPS failed: %s (0x%x)\n", esp_err_to_name(err), err);
+        }
+        esp_http_client_cleanup(client);
+    } else {
+        Serial.println("[TEST] Failed to init HTTP client!");
+    }
+}
+#endif
+
 void onWiFiConnected(const String& ip) {
     Serial.printf("[Main] WiFi connected! IP: %s\n", ip.c_str());
+    BootProfiler::getInstance().mark("wifi");
 
 #ifdef PLATFORM_ESP32
-    // Sync time via NTP (required for SSL/TLS certificate validation)
+    // Sync time via NTP (required for SSL/TLS certificate validation and reading timestamps)
     Serial.println("[NTP] Synchronizing time...");
-    configTime(3600, 3600, "pool.ntp.org", "time.google.com", "time.cloudflare.com");
-
-    // Wait for time to be set (max 10 seconds)
-    int ntpRetries = 0;
-    while (time(nullptr) < 1000000000 && ntpRetries < 20) {
-        delay(500);
-        ntpRetries++;
-        Serial.print(".");
-    }
-    Serial.println();
-
-    if (time(nullptr) > 1000000000) {
+    TimeService& timeService = TimeService::getInstance();
+    timeService.startSntp();
+
+    // Fast boot: SNTP completes in the background; readings taken before the
+    // first sync are back-dated from the monotonic clock
+    bool fastBoot = config::FAST_BOOT_ENABLED && !apiClient.isConfigured() &&
+                    configManager.hasSensorConfig();
+    if (fastBoot) {
+        Serial.println("[NTP] Fast boot - not waiting for time sync");
+    } else if (timeService.waitForSync(config::TIME_SYNC_WAIT_MS)) {
         time_t now = time(nullptr);
         struct tm* timeinfo = localtime(&now);
         Serial.printf("[NTP] Time synchronized: %04d-%02d-%02d %02d:%02d:%02d\n",
                       timeinfo->tm_year + 1900, timeinfo->tm_mon + 1, timeinfo->tm_mday,
                       timeinfo->tm_hour, timeinfo->tm_min, timeinfo->tm_sec);
-
-        // Test HTTPS connection using ESP-IDF HTTP client with embedded Root CA
-        Serial.println("[TEST] Testing HTTPS to httpbin.org with esp_http_client...");
-
-        esp_http_client_config_t httpConfig = {};
-        httpConfig.url = "https://httpbin.org/get";
-        httpConfig.timeout_ms = 30000;
-        httpConfig.transport_type = HTTP_TRANSPORT_OVER_SSL;
-        httpConfig.cert_pem = ISRG_ROOT_X1_CERT;  // Use embedded Let's Encrypt Root CA
-
-        esp_http_client_handle_t client = esp_http_client_init(&httpConfig);
-        if (client != nullptr) {
-            esp_err_t err = esp_http_client_perform(client);
-            if (err == ESP_OK) {
-                int statusCode = esp_http_client_get_status_code(client);
-                int contentLength = esp_http_client_get_content_length(client);
-                Serial.printf("[TEST] HTTPS success! Status: %d, Content-Length: %d\n", statusCode, contentLength);
-            } else {
-                Serial.printf("[TEST] HTTPS failed: %s (0x%x)\n", esp_err_to_name(err), err);
-            }
-            esp_http_client_cleanup(client);
-        } else {
-            Serial.println("[TEST] Failed to init HTTP client!");
-        }
     } else {
-        Serial.println("[NTP] Time sync failed - SSL may not work!");
+        Serial.println("[NTP] Time sync failed - SSL may not work, using Hub time for readings");
     }
+    BootProfiler::getInstance().mark("ntp");
 #endif
 
     stateMachine.processEvent(StateEvent::WIFI_CONNECTED);
@@ -882,6 +901,35 @@ void onWiFiFailed(const String& reason) {
 // Operational Functions
 // ============================================================================
 
+/**
+ * Refresh the metrics gauges from the subsystems that keep their own stats
+ */
+void updateMetricsGauges() {
+    metrics::Registry& registry = metrics::Registry::getInstance();
+
+#ifdef PLATFORM_ESP32
+    registry.set(metrics::Gauge::HEAP_FREE, (int32_t)ESP.getFreeHeap());
+    registry.set(metrics::Gauge::HEAP_MIN_FREE, (int32_t)ESP.getMinFreeHeap());
+    registry.set(metrics::Gauge::HEAP_LARGEST_BLOCK, (int32_t)ESP.getMaxAllocHeap());
+    if (wifiManager.isConnected()) {
+        registry.set(metrics::Gauge::WIFI_RSSI, wifiManager.getRSSI());
+    }
+    if (offlineStorageEnabled) {
+        registry.set(metrics::Gauge::SD_LOG_DROPPED, (int32_t)SDLogger::getInstance().getStats().entriesDropped);
+
+        std::lock_guard<std::mutex> lock(storageMutex);
+        registry.set(metrics::Gauge::SYNC_PENDING, (int32_t)syncManager.getPendingCount());
+    }
+#else
+    uint32_t freeHeap = hal::get_free_heap();
+    registry.set(metrics::Gauge::HEAP_FREE, (int32_t)freeHeap);
+    registry.setMin(metrics::Gauge::HEAP_MIN_FREE, (int32_t)freeHeap);
+#endif
+    registry.set(metrics::Gauge::LOGGING_OVERHEAD_US,
+                 (int32_t)DebugManager::getInstance().getLoggingOverheadUs());
+    registry.set(metrics::Gauge::ARENA_PEAK, (int32_t)JsonArena::getInstance().getPeakBytes());
+}
+
 void sendHeartbeat() {
     if (!apiClient.isConfigured()) {
         return;
@@ -894,8 +942,15 @@ void sendHeartbeat() {
     }
 #endif
 
-    HeartbeatResponse response = apiClient.sendHeartbeat(FIRMWARE_VERSION);
+    HeartbeatResponse response = apiClient.sendHeartbeat(FIRMWARE_VERSION, -1,
+                                                         wifiManager.getConnectStatsJson(),
+                                                         ReadingPipeline::getInstance().getMetricsJson(),
+                                                         TimeService::getInstance().getStatusJson(),
+                                                         offlineStorageEnabled ? syncManager.getStatsJson() : String());
     if (response.success) {
+        // Fallback clock source without SNTP (e.g. UDP blocked); ignored if SNTP is more accurate
+        TimeService::getInstance().disciplineFromHub(response.serverTimeMs, response.roundTripMs);
+
         Serial.printf("[Main] Heartbeat OK, next in %d seconds\n",
                       response.nextHeartbeatSeconds);
     } else {
@@ -907,89 +962,133 @@ void sendHeartbeat() {
 static bool simulationModeLogged = false;
 
 /**
- * Fetch or refresh sensor configuration from Hub
+ * Apply a sensor configuration (fetched from Hub or cached in NVS)
  */
-void fetchSensorConfiguration() {
-    if (!apiClient.isConfigured()) {
-        return;
-    }
-
-    if (currentSerial.length() == 0) {
-        Serial.println("[Main] Serial not set, cannot fetch configuration");
-        return;
-    }
-
-    Serial.println("[Main] Fetching sensor configuration from Hub...");
+void applySensorConfiguration(const NodeConfigurationResponse& response) {
+    std::lock_guard<std::recursive_mutex> lock(configMutex);  // Sampling task reads currentConfig
 
     // Remember previous simulation state to detect changes
     bool wasSimulation = configLoaded ? currentConfig.isSimulation : false;
 
-    NodeConfigurationResponse response = apiClient.fetchConfiguration(currentSerial);
+    // The config poll resends an unchanged configuration every minute
+    bool samplingChanged = !configLoaded || schedule::samplingChanged(currentConfig, response);
+    bool thresholdsChanged = samplingChanged || DeadbandFilter::thresholdsChanged(currentConfig, response);
 
-    if (response.success) {
-        currentConfig = response;
-        configLoaded = true;
+    currentConfig = response;
+    configLoaded = true;
+
+    // Open windows and deadband baselines were started under the old configuration
+    if (samplingChanged) {
+        readingAggregator.reset();
+    }
+    if (thresholdsChanged) {
+        deadbandFilter.reset();
+    }
 
-        // Calculate GCD-based poll interval for all active sensors
-        calculatedPollIntervalSeconds = calculatePollIntervalGCD();
+    // Calculate GCD-based poll interval for all active sensors
+    calculatedPollIntervalSeconds = calculatePollIntervalGCD();
 
-        // Log sensor intervals for debugging
-        Serial.printf("[Main] Configuration updated: %d sensors\n", (int)currentConfig.sensors.size());
-        Serial.printf("[Main] Poll interval: %ds (GCD of sensor intervals)\n", calculatedPollIntervalSeconds);
-        for (const auto& sensor : currentConfig.sensors) {
-            if (sensor.isActive) {
+    // Log sensor intervals for debugging
+    Serial.printf("[Main] Configuration updated: %d sensors\n", (int)currentConfig.sensors.size());
+    Serial.printf("[Main] Poll interval: %ds (GCD of sensor intervals)\n", calculatedPollIntervalSeconds);
+    for (const auto& sensor : currentConfig.sensors) {
+        if (sensor.isActive) {
+            if (sensor.aggregationWindowSeconds > 0) {
+                Serial.printf("[Main]   - %s (Endpoint %d): every %ds, upload %ds window summary\n",
+                              sensor.sensorName.c_str(), sensor.endpointId, sensor.intervalSeconds,
+                              sensor.aggregationWindowSeconds);
+            } else {
                 Serial.printf("[Main]   - %s (Endpoint %d): every %ds\n",
                               sensor.sensorName.c_str(), sensor.endpointId, sensor.intervalSeconds);
             }
         }
+    }
 
-        // Log simulation mode change
-        if (currentConfig.isSimulation != wasSimulation || !simulationModeLogged) {
-            simulationModeLogged = false;  // Reset to log new mode in readAndSendSensors()
-            if (currentConfig.isSimulation) {
-                Serial.println("[Main] Node is in SIMULATION mode (isSimulation=true)");
-            } else {
-                Serial.println("[Main] Node is in REAL HARDWARE mode (isSimulation=false)");
-            }
+    // Log simulation mode change
+    if (currentConfig.isSimulation != wasSimulation || !simulationModeLogged) {
+        simulationModeLogged = false;  // Reset to log new mode in readAndSendSensors()
+        if (currentConfig.isSimulation) {
+            Serial.println("[Main] Node is in SIMULATION mode (isSimulation=true)");
+        } else {
+            Serial.println("[Main] Node is in REAL HARDWARE mode (isSimulation=false)");
         }
+    }
 
-        // Validate hardware configuration only when:
-        // 1. Not in simulation mode
-        // 2. Sensors are configured
-        // 3. Configuration has changed (different timestamp) or first time validation
-        if (!currentConfig.isSimulation && currentConfig.sensors.size() > 0) {
-            if (currentConfig.configurationTimestamp != lastValidatedConfigTimestamp) {
-                Serial.println("[Main] Configuration changed - validating hardware...");
-                ValidationSummary validationResult = hardwareScanner.validateConfiguration(currentConfig.sensors);
-
-                if (!validationResult.allFound()) {
-                    Serial.println("\n[Main] WARNING: Hardware validation found missing sensors!");
-                    Serial.println("[Main] Some configured sensors may not work correctly.");
-                    Serial.println("[Main] Please check your hardware connections.\n");
-                } else {
-                    Serial.println("[Main] Hardware validation successful - all sensors detected!");
-                }
-
-                // Remember this timestamp so we don't re-validate until config changes
-                lastValidatedConfigTimestamp = currentConfig.configurationTimestamp;
+    // Validate hardware configuration only when:
+    // 1. Not in simulation mode
+    // 2. Sensors are configured
+    // 3. Configuration has changed (different timestamp) or first time validation
+    if (!currentConfig.isSimulation && currentConfig.sensors.size() > 0) {
+        if (currentConfig.configurationTimestamp != lastValidatedConfigTimestamp) {
+            Serial.println("[Main] Configuration changed - validating hardware...");
+            // Config CRC keys the NVS scan cache: unchanged wiring skips the scan on warm boot
+            ValidationSummary validationResult = hardwareScanner.validateConfiguration(
+                currentConfig.sensors, HardwareValidator::calculateConfigHash(currentConfig));
+
+            if (!validationResult.allFound()) {
+                Serial.println("\n[Main] WARNING: Hardware validation found missing sensors!");
+                Serial.println("[Main] Some configured sensors may not work correctly.");
+                Serial.println("[Main] Please check your hardware connections.\n");
+            } else {
+                Serial.println("[Main] Hardware validation successful - all sensors detected!");
             }
+
+            // Remember this timestamp so we don't re-validate until config changes
+            lastValidatedConfigTimestamp = currentConfig.configurationTimestamp;
         }
+    }
 
-        // Sprint OS-01: Apply storageMode from API to storageConfigManager
+    // Sprint OS-01: Apply storageMode from API to storageConfigManager
 #ifdef PLATFORM_ESP32
-        if (offlineStorageEnabled) {
-            StorageMode apiMode = static_cast<StorageMode>(response.storageMode);
-            StorageMode currentMode = storageConfigManager.getMode();
-
-            if (apiMode != currentMode) {
-                Serial.printf("[Main] Storage Mode changed: %s -> %s (from Hub API)\n",
-                              StorageConfig::getModeString(currentMode),
-                              StorageConfig::getModeString(apiMode));
-                storageConfigManager.setMode(apiMode);
-                storageConfigManager.save(sdManager);
-            }
+    if (offlineStorageEnabled) {
+        StorageMode apiMode = static_cast<StorageMode>(response.storageMode);
+        StorageMode currentMode = storageConfigManager.getMode();
+
+        if (apiMode != currentMode) {
+            Serial.printf("[Main] Storage Mode changed: %s -> %s (from Hub API)\n",
+                          StorageConfig::getModeString(currentMode),
+                          StorageConfig::getModeString(apiMode));
+            storageConfigManager.setMode(apiMode);
+            storageConfigManager.save(sdManager);
         }
+    }
 #endif
+
+    // Wire format is a per-node Hub setting; without it the firmware default stays
+    if (response.wireFormat.length() > 0) {
+        apiClient.setWireFormat(response.wireFormat == "msgpack" ? WireFormat::MSGPACK : WireFormat::JSON);
+    }
+
+    // New poll interval takes effect on the next sampling tick
+    ReadingPipeline::getInstance().wakeSampler();
+}
+
+/**
+ * Fetch or refresh sensor configuration from Hub
+ */
+void fetchSensorConfiguration() {
+    if (!apiClient.isConfigured()) {
+        return;
+    }
+
+    if (currentSerial.length() == 0) {
+        Serial.println("[Main] Serial not set, cannot fetch configuration");
+        return;
+    }
+
+    Serial.println("[Main] Fetching sensor configuration from Hub...");
+
+    String rawJson;
+    NodeConfigurationResponse response = apiClient.fetchConfiguration(currentSerial, &rawJson);
+
+    if (response.success) {
+        applySensorConfiguration(response);
+        TraceRecorder::getInstance().recordConfiguration(rawJson);
+
+        // Cache for fast boot (skips registration and config fetch on next boot)
+        if (config::FAST_BOOT_ENABLED) {
+            configManager.saveSensorConfig(rawJson, apiClient.getBaseUrl());
+        }
     } else {
         Serial.printf("[Main] Config fetch: %s\n", response.error.c_str());
         // Don't clear configLoaded - keep using last known config
@@ -1196,6 +1295,21 @@ const char* getCurrentProfileName() {
  * @return Sensor reading value
  */
 double readSensorValueWithConfig(const String& sensorCode, const String& unit, const SensorAssignmentConfig* sensorConfig) {
+    metrics::ScopedTimer readTimer(metrics::Histogram::SENSOR_READ_US);
+    metrics::inc(metrics::Counter::SENSOR_READS);
+
+#ifdef PLATFORM_NATIVE
+    // Trace replay: the SensorReader result recorded in the field
+    if (TraceReplay::getInstance().isActive()) {
+        double value;
+        if (TraceReplay::getInstance().nextValue(sensorConfig ? sensorConfig->endpointId : -1, sensorCode, value)) {
+            return value;
+        }
+        metrics::inc(metrics::Counter::SENSOR_READ_ERRORS);
+        return -999.99;  // Error indicator value
+    }
+#endif
+
     // Use isSimulation flag from Hub configuration (not local auto-detect!)
     if (currentConfig.isSimulation) {
         // Hub says to simulate - use simulated values
@@ -1206,13 +1320,17 @@ double readSensorValueWithConfig(const String& sensorCode, const String& unit, c
     // Hub says real hardware - try to read from actual sensors using SensorReader
     if (sensorConfig != nullptr) {
         // Use the sensor configuration to read hardware
+        unsigned long readStartUs = micros();
         SensorReading reading = sensorReader.readValue(sensorCode, *sensorConfig);
+        TraceRecorder::getInstance().recordReading(sensorConfig->endpointId, sensorCode, reading.success,
+                                                   reading.value, (uint32_t)(micros() - readStartUs));
 
         if (reading.success) {
             return reading.value;
         }
 
         // Hardware reading failed - log error and fall back to simulation with warning
+        metrics::inc(metrics::Counter::SENSOR_READ_ERRORS);
         Serial.printf("[HW] Hardware read failed for %s: %s\n",
                       sensorCode.c_str(), reading.error.c_str());
         Serial.println("[HW] CRITICAL: isSimulation=false but hardware unavailable!");
@@ -1224,6 +1342,7 @@ double readSensorValueWithConfig(const String& sensorCode, const String& unit, c
     }
 
     // No sensor config provided - can't read hardware
+    metrics::inc(metrics::Counter::SENSOR_READ_ERRORS);
     Serial.printf("[HW] No sensor config for %s - cannot read hardware\n", sensorCode.c_str());
     return -999.99;  // Error indicator value
 #else
@@ -1252,6 +1371,96 @@ double readSensorValue(const String& sensorCode, const String& unit) {
     return -999.99;  // Error indicator
 }
 
+/**
+ * Sinks of a reading for the current storage mode
+ * LOCAL_AUTOSYNC stores only; the sync manager uploads stored rows.
+ */
+uint8_t getReadingSinks() {
+#ifdef PLATFORM_ESP32
+    if (!offlineStorageEnabled) {
+        return PIPELINE_SINK_NETWORK;
+    }
+
+    switch (storageConfigManager.getMode()) {
+        case StorageMode::REMOTE_ONLY:
+            return PIPELINE_SINK_NETWORK;
+        case StorageMode::LOCAL_AND_REMOTE:
+            return PIPELINE_SINK_STORAGE | (wifiManager.isConnected() ? PIPELINE_SINK_NETWORK : 0);
+        case StorageMode::LOCAL_ONLY:
+        case StorageMode::LOCAL_AUTOSYNC:
+        default:
+            return PIPELINE_SINK_STORAGE;
+    }
+#else
+    // Trace replay exercises the storage rows as well
+    return TraceReplay::getInstance().isActive() ? PIPELINE_SINK_STORAGE | PIPELINE_SINK_NETWORK
+                                                 : PIPELINE_SINK_NETWORK;
+#endif
+}
+
+/**
+ * Hand a reading to the storage/network tasks
+ */
+void submitReading(const String& measurementType, const String& unit, const String& label,
+                   int endpointId, double value, uint8_t sinks, const WindowSummary* summary = nullptr) {
+    PipelineReading reading = PipelineReading::create(measurementType, unit, label, endpointId, value, sinks);
+    reading.simulated = currentConfig.isSimulation;
+    if (summary) {
+        reading.aggregated = true;
+        reading.summary = *summary;
+    }
+    ReadingPipeline::getInstance().submit(reading);
+}
+
+/**
+ * Feed a sample into its aggregation window and upload the summary when complete.
+ * Used for sensors with aggregationWindowSeconds > 0 (from Hub config).
+ *
+ * Raw samples are kept on SD in LOCAL_ONLY / LOCAL_AND_REMOTE. In LOCAL_AUTOSYNC
+ * the window mean is stored instead, because stored rows are synced to the Hub.
+ */
+void aggregateReading(const SensorAssignmentConfig& sensor, const String& measurementType,
+                      const String& unit, const String& label, double value, unsigned long now) {
+    bool storeRaw = false;
+
+#ifdef PLATFORM_ESP32
+    StorageMode mode = offlineStorageEnabled ? storageConfigManager.getMode() : StorageMode::REMOTE_ONLY;
+    storeRaw = config::AGGREGATION_STORE_RAW_SAMPLES &&
+               (mode == StorageMode::LOCAL_ONLY || mode == StorageMode::LOCAL_AND_REMOTE);
+    if (storeRaw) {
+        PipelineReading raw = PipelineReading::create(measurementType, unit, label, sensor.endpointId,
+                                                      value, PIPELINE_SINK_STORAGE);
+        raw.rawSample = true;
+        ReadingPipeline::getInstance().submit(raw);
+    }
+#endif
+
+    WindowSummary summary;
+    if (!readingAggregator.addSample(sensor.endpointId, measurementType, value,
+                                     sensor.aggregationWindowSeconds, now, summary)) {
+        return;  // Window still open
+    }
+
+    uint8_t sinks = PIPELINE_SINK_NETWORK;
+
+#ifdef PLATFORM_ESP32
+    if (mode == StorageMode::LOCAL_ONLY) {
+        sinks = storeRaw ? 0 : PIPELINE_SINK_STORAGE;
+    } else if (mode == StorageMode::LOCAL_AUTOSYNC) {
+        sinks = PIPELINE_SINK_STORAGE;
+    } else if (!wifiManager.isConnected()) {
+        // Hub unreachable: keep the window summary on SD instead of dropping it
+        sinks = mode == StorageMode::LOCAL_AND_REMOTE ? PIPELINE_SINK_STORAGE : 0;
+    }
+#endif
+
+    if (sinks != 0) {
+        submitReading(measurementType, unit, label, sensor.endpointId, summary.mean, sinks, &summary);
+    } else if (!storeRaw) {
+        Serial.printf("[Main] Failed to send/store %s window summary\n", label.c_str());
+    }
+}
+
 /**
  * Read and send only sensors that are DUE based on their individual intervals.
  * Uses GCD-based polling: loop runs at GCD interval, only reads sensors whose time has come.
@@ -1315,6 +1524,9 @@ void readAndSendDueSensors(unsigned long now) {
 
     Serial.printf("[Main] Polling tick: %d of %d sensors due\n",
                   dueCount, (int)currentConfig.sensors.size());
+    TraceRecorder::getInstance().recordTick(now);
+
+    int suppressedCount = 0;
 
     // Read only sensors that are due
     for (const auto& sensor : currentConfig.sensors) {
@@ -1353,64 +1565,27 @@ void readAndSendDueSensors(unsigned long now) {
                 // Apply calibration corrections
                 value = (value + sensor.offsetCorrection) * sensor.gainCorrection;
 
-                // Include endpointId to identify which sensor assignment this reading belongs to
-                // Sprint OS-01: Check storage mode and WiFi availability
-                bool sentToHub = false;
-                bool storedLocally = false;
-
-#ifdef PLATFORM_ESP32
-                if (offlineStorageEnabled) {
-                    StorageMode mode = storageConfigManager.getMode();
-                    bool wifiAvailable = wifiManager.isConnected();
-
-                    // Decide where to store/send based on mode
-                    if (mode == StorageMode::LOCAL_ONLY) {
-                        // Only store locally
-                        storedLocally = readingStorage.storeReading(
-                            cap.measurementType, value, cap.unit, sensor.endpointId);
-                    } else if (mode == StorageMode::REMOTE_ONLY) {
-                        // Only send to Hub (original behavior)
-                        sentToHub = apiClient.sendReading(cap.measurementType, value, cap.unit, sensor.endpointId);
-                    } else {
-                        // LOCAL_AND_REMOTE or LOCAL_AUTOSYNC
-                        // Store locally first
-                        storedLocally = readingStorage.storeReading(
-                            cap.measurementType, value, cap.unit, sensor.endpointId);
-
-                        // Also send to Hub if WiFi available (for LOCAL_AND_REMOTE)
-                        // For LOCAL_AUTOSYNC, sync manager handles the upload
-                        if (mode == StorageMode::LOCAL_AND_REMOTE && wifiAvailable) {
-                            sentToHub = apiClient.sendReading(cap.measurementType, value, cap.unit, sensor.endpointId);
-                        }
-                    }
-                } else {
-                    // No offline storage - send directly
-                    sentToHub = apiClient.sendReading(cap.measurementType, value, cap.unit, sensor.endpointId);
+                // Windowed aggregation: only the window summary is uploaded
+                if (sensor.aggregationWindowSeconds > 0) {
+                    aggregateReading(sensor, cap.measurementType, cap.unit,
+                                     sensor.sensorName + "/" + cap.displayName, value, now);
+                    continue;
                 }
-#else
-                sentToHub = apiClient.sendReading(cap.measurementType, value, cap.unit, sensor.endpointId);
-#endif
 
-                // Log result with mode info
-                if (sentToHub && storedLocally) {
-                    Serial.printf("[Main] Sent+Stored %s/%s: %.2f %s (Endpoint %d) [LOCAL_AND_REMOTE]%s\n",
-                                  sensor.sensorName.c_str(), cap.displayName.c_str(),
-                                  value, cap.unit.c_str(), sensor.endpointId,
-                                  currentConfig.isSimulation ? " [SIM]" : " [HW]");
-                } else if (sentToHub) {
-                    Serial.printf("[Main] Sent %s/%s: %.2f %s (Endpoint %d) [REMOTE]%s\n",
-                                  sensor.sensorName.c_str(), cap.displayName.c_str(),
-                                  value, cap.unit.c_str(), sensor.endpointId,
-                                  currentConfig.isSimulation ? " [SIM]" : " [HW]");
-                } else if (storedLocally) {
-                    Serial.printf("[Main] Stored %s/%s: %.2f %s (Endpoint %d) [LOCAL]%s\n",
-                                  sensor.sensorName.c_str(), cap.displayName.c_str(),
-                                  value, cap.unit.c_str(), sensor.endpointId,
-                                  currentConfig.isSimulation ? " [SIM]" : " [HW]");
-                } else {
-                    Serial.printf("[Main] Failed to send/store %s/%s reading\n",
-                                  sensor.sensorName.c_str(), cap.measurementType.c_str());
+                // Report-by-exception: skip values within the deadband (heartbeat after max silence)
+                DeadbandParams deadband = DeadbandFilter::resolveParams(
+                    cap.measurementType, cap.deadbandAbsolute, cap.deadbandPercent,
+                    cap.deadbandSlopePerMinute, cap.maxSilenceSeconds);
+                if (!DeadbandFilter::isSend(deadbandFilter.evaluate(
+                        sensor.endpointId, cap.measurementType, value, deadband, now))) {
+                    suppressedCount++;
+                    continue;
                 }
+
+                // Sprint OS-01: storage mode decides SD and/or Hub; delivery runs in the pipeline tasks
+                submitReading(cap.measurementType, cap.unit,
+                              sensor.sensorName + "/" + cap.displayName,
+                              sensor.endpointId, value, getReadingSinks());
             }
         } else {
             // Fallback: Send single reading with sensor code as measurement type
@@ -1426,61 +1601,209 @@ void readAndSendDueSensors(unsigned long now) {
             // Apply calibration corrections
             value = (value + sensor.offsetCorrection) * sensor.gainCorrection;
 
-            // Include endpointId to identify which sensor assignment this reading belongs to
-            // Sprint OS-01: Check storage mode and WiFi availability
-            bool sentToHub = false;
-            bool storedLocally = false;
-
-#ifdef PLATFORM_ESP32
-            if (offlineStorageEnabled) {
-                StorageMode mode = storageConfigManager.getMode();
-                bool wifiAvailable = wifiManager.isConnected();
-
-                if (mode == StorageMode::LOCAL_ONLY) {
-                    storedLocally = readingStorage.storeReading(
-                        sensor.sensorCode, value, "", sensor.endpointId);
-                } else if (mode == StorageMode::REMOTE_ONLY) {
-                    sentToHub = apiClient.sendReading(sensor.sensorCode, value, "", sensor.endpointId);
-                } else {
-                    storedLocally = readingStorage.storeReading(
-                        sensor.sensorCode, value, "", sensor.endpointId);
-                    if (mode == StorageMode::LOCAL_AND_REMOTE && wifiAvailable) {
-                        sentToHub = apiClient.sendReading(sensor.sensorCode, value, "", sensor.endpointId);
-                    }
-                }
-            } else {
-                sentToHub = apiClient.sendReading(sensor.sensorCode, value, "", sensor.endpointId);
+            // Windowed aggregation: only the window summary is uploaded
+            if (sensor.aggregationWindowSeconds > 0) {
+                aggregateReading(sensor, sensor.sensorCode, "", sensor.sensorName, value, now);
+                continue;
             }
-#else
-            sentToHub = apiClient.sendReading(sensor.sensorCode, value, "", sensor.endpointId);
-#endif
 
-            if (sentToHub && storedLocally) {
-                Serial.printf("[Main] Sent+Stored %s: %.2f (Endpoint %d) [LOCAL_AND_REMOTE]%s\n",
-                              sensor.sensorName.c_str(), value, sensor.endpointId,
-                              currentConfig.isSimulation ? " [SIM]" : " [HW]");
-            } else if (sentToHub) {
-                Serial.printf("[Main] Sent %s: %.2f (Endpoint %d) [REMOTE]%s\n",
-                              sensor.sensorName.c_str(), value, sensor.endpointId,
-                              currentConfig.isSimulation ? " [SIM]" : " [HW]");
-            } else if (storedLocally) {
-                Serial.printf("[Main] Stored %s: %.2f (Endpoint %d) [LOCAL]%s\n",
-                              sensor.sensorName.c_str(), value, sensor.endpointId,
-                              currentConfig.isSimulation ? " [SIM]" : " [HW]");
-            } else {
-                Serial.printf("[Main] Failed to send/store %s reading\n", sensor.sensorName.c_str());
+            // Report-by-exception with per-type default deadband (if DEADBAND_USE_TYPE_DEFAULTS)
+            DeadbandParams deadband = DeadbandFilter::resolveParams(sensor.sensorCode, -1.0, 0.0, 0.0, 0);
+            if (!DeadbandFilter::isSend(deadbandFilter.evaluate(
+                    sensor.endpointId, sensor.sensorCode, value, deadband, now))) {
+                suppressedCount++;
+                continue;
             }
+
+            // Sprint OS-01: storage mode decides SD and/or Hub; delivery runs in the pipeline tasks
+            submitReading(sensor.sensorCode, "", sensor.sensorName,
+                          sensor.endpointId, value, getReadingSinks());
         }
     }
     // Note: No fallback - we only send readings when we have proper configuration
     // The Hub assigns sensors to nodes, so we wait for that configuration
+
+    if (suppressedCount > 0) {
+        Serial.printf("[Main] Deadband: %d unchanged reading(s) suppressed (total sent=%lu, suppressed=%lu, heartbeats=%lu)\n",
+                      suppressedCount, deadbandFilter.getSentCount(),
+                      deadbandFilter.getSuppressedCount(), deadbandFilter.getHeartbeatCount());
+    }
+}
+
+// ============================================================================
+// Reading Pipeline (sampling / storage / network tasks)
+// ============================================================================
+
+/**
+ * Count a delivered reading; the first one wakes the loop (boot timeline, deferred work)
+ */
+void onReadingDelivered() {
+    if (readingsDelivered++ == 0) {
+        LoopScheduler::getInstance().wake();
+    }
+}
+
+/**
+ * Log the sink result of a pipeline reading
+ */
+void logDelivery(const char* action, const PipelineReading& reading) {
+    unsigned long queuedMs = millis() - reading.enqueuedMs;
+    const char* source = reading.simulated ? " [SIM]" : " [HW]";
+
+    if (reading.aggregated) {
+        const WindowSummary& summary = reading.summary;
+        Serial.printf("[Main] %s window %s: mean=%.2f min=%.2f max=%.2f sd=%.2f %s (n=%u, %us, Endpoint %d, queued %lu ms)%s\n",
+                      action, reading.label, summary.mean, summary.min, summary.max, summary.stddev,
+                      reading.unit, (unsigned)summary.count, (unsigned)summary.windowSeconds,
+                      reading.endpointId, queuedMs, source);
+    } else {
+        Serial.printf("[Main] %s %s: %.2f %s (Endpoint %d, queued %lu ms)%s\n",
+                      action, reading.label, reading.value, reading.unit,
+                      reading.endpointId, queuedMs, source);
+    }
+}
+
+#ifdef PLATFORM_ESP32
+/**
+ * Storage task sink: append the reading to the SD card
+ */
+bool storePipelineReading(const PipelineReading& reading) {
+    bool stored;
+    {
+        std::lock_guard<std::mutex> lock(storageMutex);
+        stored = readingStorage.storeReading(reading.measurementType, reading.value,
+                                             reading.unit, reading.endpointId,
+                                             reading.getUnixTimestamp());
+    }
+
+    if (stored) {
+        onReadingDelivered();
+        if (!reading.rawSample) logDelivery("Stored", reading);
+    } else {
+        Serial.printf("[Main] Failed to store %s reading\n", reading.label);
+    }
+    return stored;
+}
+#endif
+
+/**
+ * Network task sink: upload the reading to the Hub
+ */
+bool sendPipelineReading(const PipelineReading& reading) {
+#ifndef PLATFORM_NATIVE
+    if (!wifiManager.isConnected()) {
+        Serial.printf("[Main] Failed to send %s reading - WiFi not connected\n", reading.label);
+        return false;
+    }
+#endif
+
+    uint32_t timestamp = reading.getUnixTimestamp();
+    bool sent = reading.aggregated
+        ? apiClient.sendAggregatedReading(reading.measurementType, reading.summary,
+                                          reading.unit, reading.endpointId, timestamp)
+        : apiClient.sendReading(reading.measurementType, reading.value,
+                                reading.unit, reading.endpointId, timestamp);
+
+    if (sent) {
+        onReadingDelivered();
+        logDelivery("Sent", reading);
+    } else {
+        Serial.printf("[Main] Failed to send %s reading\n", reading.label);
+    }
+    return sent;
+}
+
+/**
+ * Sampling task tick: read due sensors on the GCD poll schedule
+ * Ticks stay on an absolute schedule (last tick + interval) unless one was missed.
+ * @return ms until the next tick
+ */
+uint32_t runSamplingTick(unsigned long now) {
+    if (stateMachine.getState() != NodeState::OPERATIONAL) {
+        return config::PIPELINE_SAMPLER_MAX_WAIT_MS;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(configMutex);
+
+    unsigned long sensorInterval = getSensorPollIntervalMs();
+
+    // First tick right after entering operational state (time-to-first-reading)
+    if (lastSensorReading == 0 || now - lastSensorReading >= sensorInterval) {
+        if (lastSensorReading == 0 || now - lastSensorReading >= 2 * sensorInterval) {
+            lastSensorReading = now;
+        } else {
+            lastSensorReading += sensorInterval;
+        }
+        readAndSendDueSensors(lastSensorReading);
+    }
+
+    unsigned long elapsed = millis() - lastSensorReading;
+    return elapsed >= sensorInterval ? 0 : (uint32_t)(sensorInterval - elapsed);
+}
+
+/**
+ * Start sampling, storage and network tasks
+ */
+void startReadingPipeline() {
+    ReadingPipeline::SinkFn storageSink = nullptr;
+#ifdef PLATFORM_ESP32
+    if (offlineStorageEnabled) {
+        storageSink = storePipelineReading;
+    }
+#endif
+
+    if (!ReadingPipeline::getInstance().begin(runSamplingTick, storageSink, sendPipelineReading)) {
+        Serial.println("[Main] ERROR: Reading pipeline failed to start - no sensor readings!");
+        return;
+    }
+
+    // First tick right after entering operational state (time-to-first-reading)
+    stateMachine.onEnterState(NodeState::OPERATIONAL, [](NodeState previousState) {
+        ReadingPipeline::getInstance().wakeSampler();
+    });
+}
+
+#ifdef PLATFORM_NATIVE
+/**
+ * Replay a recorded sensor trace through the reading path (TRACE_REPLAY=<file>)
+ * Configurations and ticks go through the same functions as on the device.
+ * @return false if the trace could not be replayed
+ */
+bool runTraceReplay(const char* path) {
+    const char* speedEnv = std::getenv(config::ENV_TRACE_REPLAY_SPEED);
+    double speed = speedEnv ? atof(speedEnv) : 0.0;
+
+    TraceReplay::Hooks hooks;
+    hooks.applyConfiguration = [](const String& json) {
+        NodeConfigurationResponse response = apiClient.parseConfiguration(json);
+        if (!response.success) {
+            return false;
+        }
+        if (!apiClient.isConfigured()) {
+            apiClient.configure("http://trace-replay.invalid", response.nodeId, "");
+        }
+        applySensorConfiguration(response);
+        return true;
+    };
+    hooks.runTick = [](unsigned long tickMs) {
+        std::lock_guard<std::recursive_mutex> lock(configMutex);
+        readAndSendDueSensors(tickMs);
+    };
+
+    bool ok = TraceReplay::getInstance().run(path, speed, std::getenv(config::ENV_TRACE_REPLAY_OUTPUT), hooks);
+    Serial.printf("[Trace] Deadband: %lu sent, %lu suppressed, %lu heartbeats\n",
+                  deadbandFilter.getSentCount(), deadbandFilter.getSuppressedCount(),
+                  deadbandFilter.getHeartbeatCount());
+    return ok;
 }
+#endif
 
 /**
  * Send hardware status report to Hub (Sprint 8)
  * Collects detected devices, SD card status, and bus status
  */
 void sendHardwareStatusReport() {
+    std::lock_guard<std::recursive_mutex> lock(configMutex);  // currentConfig, scanner results
     Serial.println("[Main] Preparing hardware status report...");
 
     // Build detected devices JSON array
@@ -1529,6 +1852,7 @@ void sendHardwareStatusReport() {
         storageJson += "\"usedBytes\":" + String(sdManager.getUsedBytes()) + ",";
         storageJson += "\"freeBytes\":" + String(sdManager.getFreeBytes()) + ",";
         storageJson += "\"pendingSyncCount\":" + String(readingStorage.getPendingCount()) + ",";
+        storageJson += "\"retention\":" + retentionEngine.getStatsJson() + ",";
         storageJson += "\"lastSyncAt\":null,";
         storageJson += "\"lastSyncError\":null";
     } else {
@@ -1594,7 +1918,9 @@ void sendHardwareStatusReport() {
     busStatusJson += "\"oneWireAvailable\":" + String(oneWireCount > 0 ? "true" : "false") + ",";
     busStatusJson += "\"oneWireDeviceCount\":" + String(oneWireCount) + ",";
     busStatusJson += "\"uartAvailable\":" + String(uartAvailable ? "true" : "false") + ",";
-    busStatusJson += "\"gpsDetected\":" + String(gpsDetected ? "true" : "false");
+    busStatusJson += "\"gpsDetected\":" + String(gpsDetected ? "true" : "false") + ",";
+    busStatusJson += "\"scanDurationMs\":" + String(hardwareScanner.getLastScanDurationMs()) + ",";
+    busStatusJson += "\"scanCached\":" + String(hardwareScanner.wasLastScanCached() ? "true" : "false");
 #else
     busStatusJson += "\"i2cAvailable\":false,";
     busStatusJson += "\"i2cDeviceCount\":0,";
@@ -1602,7 +1928,9 @@ void sendHardwareStatusReport() {
     busStatusJson += "\"oneWireAvailable\":false,";
     busStatusJson += "\"oneWireDeviceCount\":0,";
     busStatusJson += "\"uartAvailable\":false,";
-    busStatusJson += "\"gpsDetected\":false";
+    busStatusJson += "\"gpsDetected\":false,";
+    busStatusJson += "\"scanDurationMs\":0,";
+    busStatusJson += "\"scanCached\":false";
 #endif
     busStatusJson += "}";
 
@@ -1613,7 +1941,8 @@ void sendHardwareStatusReport() {
         HARDWARE_TYPE,
         devicesJson,
         storageJson,
-        busStatusJson
+        busStatusJson,
+        BootProfiler::getInstance().toJson()
     );
 
     if (success) {
@@ -1623,6 +1952,41 @@ void sendHardwareStatusReport() {
     }
 }
 
+/**
+ * Non-critical boot work: hardware status report and debug configuration.
+ * Deferred until the first reading was sent or stored (see handleOperationalState).
+ */
+void sendBootReports() {
+    // Sprint 8: Send hardware status report
+    Serial.println("[Main] Sending hardware status report...");
+    sendHardwareStatusReport();
+
+    // Sprint 8: Fetch and apply debug configuration from Hub
+    // Note: Use nodeId (GUID) not serial number for the debug config endpoint
+    String nodeId = apiClient.getNodeId();
+    Serial.println("[Main] Fetching debug configuration from Hub...");
+    DebugConfigurationResponse debugConfig = apiClient.fetchDebugConfiguration(nodeId);
+    if (debugConfig.success) {
+        // Apply debug level to DebugManager
+        DebugLevel newLevel = static_cast<DebugLevel>(debugConfig.debugLevel);
+        DebugManager::getInstance().setLevel(newLevel);
+        DebugManager::getInstance().setRemoteLogging(debugConfig.enableRemoteLogging);
+
+        // Configure remote serial monitor (captures ALL Serial output)
+        // Note: Backend looks up by NodeId (GUID) or MacAddress, so we must send the nodeId GUID
+        if (debugConfig.enableRemoteLogging) {
+            DebugLogUploader::getInstance().begin(apiClient.getBaseUrl(), nodeId);
+            DebugLogUploader::getInstance().setEnabled(true);
+        }
+
+        Serial.printf("[Main] Debug config applied - Level: %s, Remote: %s\n",
+                      DebugManager::getInstance().getLevelString(),
+                      debugConfig.enableRemoteLogging ? "enabled" : "disabled");
+    } else {
+        Serial.println("[Main] Debug config fetch failed - using default settings");
+    }
+}
+
 bool registerWithHub() {
     if (apiClient.getBaseUrl().length() == 0) {
         Serial.println("[Main] Base URL not set for registration");
@@ -1695,34 +2059,6 @@ bool registerWithHub() {
         Serial.println("[Main] Fetching initial sensor configuration...");
         fetchSensorConfiguration();
 
-        // Sprint 8: Send hardware status report after successful registration
-        Serial.println("[Main] Sending hardware status report...");
-        sendHardwareStatusReport();
-
-        // Sprint 8: Fetch and apply debug configuration from Hub
-        // Note: Use nodeId (GUID) not serial number for the debug config endpoint
-        Serial.println("[Main] Fetching debug configuration from Hub...");
-        DebugConfigurationResponse debugConfig = apiClient.fetchDebugConfiguration(response.nodeId);
-        if (debugConfig.success) {
-            // Apply debug level to DebugManager
-            DebugLevel newLevel = static_cast<DebugLevel>(debugConfig.debugLevel);
-            DebugManager::getInstance().setLevel(newLevel);
-            DebugManager::getInstance().setRemoteLogging(debugConfig.enableRemoteLogging);
-
-            // Configure remote serial monitor (captures ALL Serial output)
-            // Note: Backend looks up by NodeId (GUID) or MacAddress, so we must send the nodeId GUID
-            if (debugConfig.enableRemoteLogging) {
-                DebugLogUploader::getInstance().begin(apiClient.getBaseUrl(), response.nodeId);
-                DebugLogUploader::getInstance().setEnabled(true);
-            }
-
-            Serial.printf("[Main] Debug config applied - Level: %s, Remote: %s\n",
-                          DebugManager::getInstance().getLevelString(),
-                          debugConfig.enableRemoteLogging ? "enabled" : "disabled");
-        } else {
-            Serial.println("[Main] Debug config fetch failed - using default settings");
-        }
-
         return true;
     } else {
         Serial.printf("[Main] Registration failed: %s\n", response.error.c_str());
@@ -1730,6 +2066,95 @@ bool registerWithHub() {
     }
 }
 
+#ifdef PLATFORM_ESP32
+/**
+ * Fast boot for provisioned nodes: reuse Hub URL, node ID and sensor
+ * configuration cached in NVS by the last successful config fetch, so the
+ * first reading does not wait for discovery, registration and config fetch.
+ * Registration runs later with the deferred boot work.
+ * @param isCloudMode Cloud nodes always use the firmware cloud URL
+ */
+bool tryFastBoot(bool isCloudMode) {
+    if (!config::FAST_BOOT_ENABLED) {
+        return false;
+    }
+
+    String cachedJson;
+    String cachedUrl;
+    if (!configManager.loadSensorConfig(cachedJson, cachedUrl)) {
+        return false;
+    }
+
+    NodeConfigurationResponse response = apiClient.parseConfiguration(cachedJson);
+    if (!response.success || response.nodeId.length() == 0) {
+        Serial.println("[Main] Cached configuration unusable - full boot");
+        configManager.clearSensorConfig();
+        return false;
+    }
+
+    String url = isCloudMode ? String(config::CLOUD_API_URL) : cachedUrl;
+    apiClient.configure(url, response.nodeId, "");
+    currentSerial = configManager.getSerial();
+
+    Serial.println("[Main] ========================================");
+    Serial.println("[Main] FAST BOOT - using cached configuration");
+    Serial.printf("[Main] Hub URL: %s\n", url.c_str());
+    Serial.printf("[Main] Node ID: %s\n", response.nodeId.c_str());
+    Serial.println("[Main] Registration deferred until first reading");
+    Serial.println("[Main] ========================================");
+
+    applySensorConfiguration(response);
+    TraceRecorder::getInstance().recordConfiguration(cachedJson);
+    fastBootRegistrationPending = true;
+    BootProfiler::getInstance().setFastBoot(true);
+    return true;
+}
+#endif
+
+/**
+ * Defer non-critical boot work until the first reading is delivered.
+ * Periodic config/debug/heartbeat checks restart from now, so they do not
+ * run ahead of the first reading either.
+ */
+void scheduleDeferredBootWork() {
+    deferredBootWorkPending = true;
+    deferredBootWorkSince = millis();
+    lastConfigCheck = deferredBootWorkSince;
+    lastDebugConfigCheck = deferredBootWorkSince;
+    lastHeartbeat = deferredBootWorkSince;
+    configCheckIntervalMs = retry::jitteredInterval(CONFIG_CHECK_INTERVAL_MS, config::PERIODIC_JITTER_PERCENT);
+    debugConfigCheckIntervalMs = retry::jitteredInterval(DEBUG_CONFIG_CHECK_INTERVAL_MS, config::PERIODIC_JITTER_PERCENT);
+    heartbeatIntervalMs = retry::jitteredInterval(HEARTBEAT_INTERVAL_MS, config::PERIODIC_JITTER_PERCENT);
+}
+
+/**
+ * Deferred boot work: registration skipped by fast boot, HTTPS self-test,
+ * hardware status report and debug configuration
+ */
+void runDeferredBootWork() {
+    deferredBootWorkPending = false;
+    Serial.println("[Main] Running deferred boot work...");
+
+    if (fastBootRegistrationPending) {
+        fastBootRegistrationPending = false;
+
+        // Announce firmware version and refresh configuration now.
+        // On failure keep the cached endpoint (registration may switch to HTTP fallback).
+        String url = apiClient.getBaseUrl();
+        String nodeId = apiClient.getNodeId();
+        if (!registerWithHub()) {
+            Serial.println("[Main] Deferred registration failed - next boot will be a full boot");
+            configManager.clearSensorConfig();
+            apiClient.configure(url, nodeId, "");
+        }
+    }
+
+#ifdef PLATFORM_ESP32
+    runHttpsSelfTest();
+#endif
+    sendBootReports();
+}
+
 bool validateApiKeyWithHub() {
     if (!apiClient.isConfigured()) {
         return false;
@@ -1948,6 +2373,8 @@ void handleConfiguredState() {
         if (apiClient.getBaseUrl().length() > 0) {
             if (registerWithHub()) {
                 nodeRegistered = true;
+                BootProfiler::getInstance().mark("registration");
+                scheduleDeferredBootWork();
                 stateMachine.processEvent(StateEvent::API_VALIDATED);
             } else {
                 // Registration failed - go to error state
@@ -2023,6 +2450,16 @@ void handleConfiguredState() {
         wifiConnecting = false;
         StoredConfig config = configManager.loadConfig();
 
+        // Fast boot: cached Hub URL, node ID and sensor config - no discovery, no registration
+        if (!nodeRegistered && tryFastBoot(config.isCloudMode())) {
+            apiConfigured = true;
+            nodeRegistered = true;
+            BootProfiler::getInstance().mark("fast_boot");
+            scheduleDeferredBootWork();
+            stateMachine.processEvent(StateEvent::API_VALIDATED);
+            return;
+        }
+
         // Check if we have a Hub/Cloud URL from BLE config (direct connection mode)
         // For Cloud mode: ALWAYS use the current firmware constant (allows URL updates via firmware)
         // For Local mode: Use the stored Hub URL from config
@@ -2080,6 +2517,8 @@ void handleConfiguredState() {
 
         if (registerWithHub()) {
             nodeRegistered = true;
+            BootProfiler::getInstance().mark("registration");
+            scheduleDeferredBootWork();
             stateMachine.processEvent(StateEvent::API_VALIDATED);
         } else {
             // Registration failed - go to error state
@@ -2089,6 +2528,35 @@ void handleConfiguredState() {
 #endif
 }
 
+/**
+ * Milliseconds until a periodic check is due
+ */
+static uint32_t remainingMs(unsigned long last, unsigned long interval, unsigned long now) {
+    unsigned long elapsed = now - last;
+    return elapsed >= interval ? 0 : (uint32_t)(interval - elapsed);
+}
+
+/**
+ * Earliest deadline of the periodic work in handleOperationalState()
+ */
+uint32_t getOperationalDeadlineMs(unsigned long now) {
+    if (readingsDelivered > 0 && !BootProfiler::getInstance().hasFirstReading()) return 0;
+
+    uint32_t next = remainingMs(lastConfigCheck, configCheckIntervalMs, now);
+    next = min(next, remainingMs(lastDebugConfigCheck, debugConfigCheckIntervalMs, now));
+    next = min(next, remainingMs(lastHeartbeat, heartbeatIntervalMs, now));
+#ifndef PLATFORM_NATIVE
+    next = min(next, remainingMs(lastWiFiCheck, WIFI_CHECK_INTERVAL_MS, now));
+#endif
+
+    if (deferredBootWorkPending) {
+        next = readingsDelivered > 0
+            ? 0
+            : min(next, remainingMs(deferredBootWorkSince, config::BOOT_DEFERRED_WORK_TIMEOUT_MS, now));
+    }
+    return next;
+}
+
 void handleOperationalState() {
     unsigned long now = millis();
 
@@ -2107,33 +2575,35 @@ void handleOperationalState() {
 #endif
 
     // Check for configuration updates periodically
-    if (now - lastConfigCheck >= CONFIG_CHECK_INTERVAL_MS) {
+    if (now - lastConfigCheck >= configCheckIntervalMs) {
         lastConfigCheck = now;
+        configCheckIntervalMs = retry::jitteredInterval(CONFIG_CHECK_INTERVAL_MS, config::PERIODIC_JITTER_PERCENT);
         fetchSensorConfiguration();
     }
 
     // Check for debug configuration updates periodically (Sprint 8)
-    if (now - lastDebugConfigCheck >= DEBUG_CONFIG_CHECK_INTERVAL_MS) {
+    if (now - lastDebugConfigCheck >= debugConfigCheckIntervalMs) {
         lastDebugConfigCheck = now;
+        debugConfigCheckIntervalMs = retry::jitteredInterval(DEBUG_CONFIG_CHECK_INTERVAL_MS, config::PERIODIC_JITTER_PERCENT);
         checkDebugConfiguration();
     }
 
     // Send heartbeat periodically
-    if (now - lastHeartbeat >= HEARTBEAT_INTERVAL_MS) {
+    if (now - lastHeartbeat >= heartbeatIntervalMs) {
         lastHeartbeat = now;
+        heartbeatIntervalMs = retry::jitteredInterval(HEARTBEAT_INTERVAL_MS, config::PERIODIC_JITTER_PERCENT);
         sendHeartbeat();
     }
 
-    // Read and send sensor data using GCD-based polling
-    // Poll loop runs at GCD interval, but only reads sensors that are due
-    unsigned long sensorInterval = calculatedPollIntervalSeconds * 1000UL;
-    if (sensorInterval == 0) {
-        sensorInterval = SENSOR_INTERVAL_MS;
+    // Sensor readings run in the sampling task (reading pipeline)
+    if (readingsDelivered > 0 && !BootProfiler::getInstance().hasFirstReading()) {
+        BootProfiler::getInstance().markFirstReading();
     }
 
-    if (now - lastSensorReading >= sensorInterval) {
-        lastSensorReading = now;
-        readAndSendDueSensors(now);
+    // Non-critical boot work after the first reading (or timeout, e.g. no sensors assigned)
+    if (deferredBootWorkPending &&
+        (readingsDelivered > 0 || now - deferredBootWorkSince >= config::BOOT_DEFERRED_WORK_TIMEOUT_MS)) {
+        runDeferredBootWork();
     }
 }
 
@@ -2267,13 +2737,194 @@ void handleRePairingState() {
 #endif
 }
 
+// ============================================================================
+// Loop Scheduler Tasks
+// ============================================================================
+
+/**
+ * Register all main loop work with its deadline
+ * Order matches the former fixed loop: buttons, simulator, state, LEDs, logging, storage.
+ */
+static unsigned long lastStateRun = 0;
+static unsigned long lastStorageRun = 0;
+
+void registerLoopTasks() {
+    LoopScheduler& scheduler = LoopScheduler::getInstance();
+
+#ifdef PLATFORM_ESP32
+    // Boot button (WPS / Factory Reset): GPIO edge wakes the loop, then poll while held
+    scheduler.addTask("buttons",
+        [](unsigned long) -> uint32_t {
+            bool active = buttonWasPressed || wpsManager.isActive() ||
+                          digitalRead(BOOT_BUTTON_PIN) == LOW;
+            return active ? config::LOOP_BUTTON_POLL_MS : LoopScheduler::IDLE;
+        },
+        [](unsigned long) {
+            NodeState currentState = stateMachine.getState();
+
+            // Factory Reset works in ALL states, WPS only in pairing states
+            if (currentState == NodeState::UNCONFIGURED || currentState == NodeState::PAIRING) {
+                checkBootButton();  // WPS + Factory Reset
+            } else {
+                // In other states, only check for Factory Reset (10 second hold)
+                checkBootButtonForFactoryReset();
+            }
+
+            // Process WPS events if active
+            if (wpsManager.isActive()) {
+                wpsManager.loop();
+            }
+        });
+    scheduler.addWakePin(BOOT_BUTTON_PIN);
+#endif
+
+    // Sensor simulator (generates smooth value transitions)
+    scheduler.addPeriodicTask("simulator", 1000, [](unsigned long) {
+        std::lock_guard<std::recursive_mutex> lock(configMutex);  // Shared with sampling task
+        sensorSimulator.update();
+    });
+
+    // State machine: operational state sleeps until its next periodic check,
+    // setup states (pairing, registration, retries) keep the old 10ms rate
+    scheduler.addTask("state",
+        [](unsigned long now) -> uint32_t {
+            if (stateMachine.getState() == NodeState::OPERATIONAL) {
+                return getOperationalDeadlineMs(now);
+            }
+            return remainingMs(lastStateRun, config::LOOP_BUSY_INTERVAL_MS, now);
+        },
+        [](unsigned long now) {
+            lastStateRun = now;
+            switch (stateMachine.getState()) {
+                case NodeState::UNCONFIGURED:
+                    handleUnconfiguredState();
+                    break;
+
+                case NodeState::PAIRING:
+                    handlePairingState();
+                    break;
+
+                case NodeState::CONFIGURED:
+                    handleConfiguredState();
+                    break;
+
+                case NodeState::OPERATIONAL:
+                    handleOperationalState();
+                    break;
+
+                case NodeState::ERROR:
+                    handleErrorState();
+                    break;
+
+                case NodeState::RE_PAIRING:
+                    handleRePairingState();
+                    break;
+            }
+        });
+
+    // Status LED (for all states) - next blink transition
+    scheduler.addTask("led",
+        [](unsigned long) -> uint32_t { return ledController.getNextUpdateMs(); },
+        [](unsigned long) { ledController.update(); });
+
+#ifdef PLATFORM_ESP32
+    // Sub-stages of the debuglog and storage tasks (profiled separately)
+    static const int sdLoggerStage = LoopProfiler::getInstance().addStage("sdlogger");
+    static const int logUploadStage = LoopProfiler::getInstance().addStage("logupload");
+    static const int syncStage = LoopProfiler::getInstance().addStage("sync");
+    static const int retentionStage = LoopProfiler::getInstance().addStage("retention");
+
+    // Sprint 8: SD logger queue and debug log uploader
+    scheduler.addPeriodicTask("debuglog", config::LOOP_BACKGROUND_INTERVAL_MS, [](unsigned long) {
+        if (offlineStorageEnabled) {
+            LoopProfiler::Scope scope(sdLoggerStage);
+            SDLogger::getInstance().loop();
+        }
+        LoopProfiler::Scope scope(logUploadStage);
+        DebugLogUploader::getInstance().loop();
+    });
+
+    // Sprint OS-01: sync button, sync LED and sync manager
+    if (offlineStorageEnabled) {
+        scheduler.addTask("storage",
+            [](unsigned long now) -> uint32_t {
+                uint32_t interval = config::LOOP_SYNC_IDLE_INTERVAL_MS;
+
+                if (syncManager.getState() == SyncState::SYNCING || syncButton.isPressed() ||
+                    digitalRead(config::SYNC_BUTTON_GPIO) == LOW) {
+                    interval = config::LOOP_BUSY_INTERVAL_MS;
+                } else if (syncStatusLED.getPattern() != SyncLedPattern::OFF &&
+                           syncStatusLED.getPattern() != SyncLedPattern::SOLID_ON) {
+                    interval = config::LOOP_SYNC_LED_INTERVAL_MS;
+                } else if (retentionEngine.isBusy()) {
+                    interval = config::LOOP_BACKGROUND_INTERVAL_MS;
+                }
+
+                return remainingMs(lastStorageRun, interval, now);
+            },
+            [](unsigned long now) {
+                lastStorageRun = now;
+                std::lock_guard<std::mutex> lock(storageMutex);  // Storage task writes readingStorage
+
+                // Update sync button (check for presses)
+                syncButton.update();
+
+                // Update sync status LED (blink patterns)
+                syncStatusLED.update();
+
+                // Run sync manager loop (handles auto-sync, retries)
+                {
+                    LoopProfiler::Scope scope(syncStage);
+                    syncManager.loop();
+                }
+
+                // One retention step (seal, expire, evict) per run
+                {
+                    LoopProfiler::Scope scope(retentionStage);
+                    retentionEngine.loop();
+                }
+
+                // Buffered sensor/UART trace records (StorageConfig.traceRecording)
+                TraceRecorder::getInstance().loop(now);
+
+                // Update LED based on sync state (if not syncing)
+                if (syncManager.getState() == SyncState::IDLE) {
+                    if (!wifiManager.isConnected()) {
+                        syncStatusLED.setNoWifi();
+                    } else if (syncManager.hasPendingReadings()) {
+                        syncStatusLED.setPendingData();
+                    } else {
+                        syncStatusLED.setAllSynced();
+                    }
+                }
+            });
+        scheduler.addWakePin(config::SYNC_BUTTON_GPIO);
+    }
+
+    // Connect/disconnect/got-IP events re-evaluate all tasks immediately
+    WiFi.onEvent([](WiFiEvent_t event, WiFiEventInfo_t info) {
+        LoopScheduler::getInstance().wake();
+    });
+#endif
+
+    // Metrics gauges (heap, RSSI, sync backlog, logging overhead)
+    updateMetricsGauges();
+    scheduler.addPeriodicTask("metrics", config::METRICS_GAUGE_INTERVAL_MS, [](unsigned long) {
+        updateMetricsGauges();
+    });
+
+    scheduler.begin();
+}
+
 // ============================================================================
 // Arduino Setup & Loop
 // ============================================================================
 
 void setup() {
+    BootProfiler::getInstance().begin();
     Serial.begin(115200);
-    delay(1000);
+    delay(config::BOOT_SERIAL_WAIT_MS);
+    BootProfiler::getInstance().mark("serial");
 
 #ifdef PLATFORM_ESP32
     // Initialize Task Watchdog (90s timeout) - resets ESP32 if stuck in HTTP request
@@ -2299,10 +2950,14 @@ void setup() {
     // Initialize HardwareValidator
     HardwareValidator::getInstance().begin();
 
+    // Reading timestamps (synced later via SNTP / Hub heartbeat)
+    TimeService::getInstance().begin();
+
     // Initialize LED controller (GPIO 2 = built-in LED on most ESP32)
     ledController.init(2, false);
     ledController.setPattern(LEDPattern::SLOW_BLINK);  // Initial pattern
     DBG_SYSTEM("LED controller initialized");
+    BootProfiler::getInstance().mark("debug");
 
     // ============================================================================
     // Sprint OS-01: Initialize Offline Storage
@@ -2325,6 +2980,12 @@ void setup() {
             if (readingStorage.init(sdManager, storageConfigManager)) {
                 Serial.println("[Main] Reading Storage initialized");
 
+                retentionEngine.init(sdManager, storageConfigManager, readingStorage);
+
+                if (storageConfigManager.getConfig().traceRecording) {
+                    TraceRecorder::getInstance().begin(sdManager);
+                }
+
                 // Initialize Sync Manager
                 if (syncManager.init(readingStorage, storageConfigManager, apiClient, wifiManager)) {
                     Serial.println("[Main] Sync Manager initialized");
@@ -2411,11 +3072,13 @@ void setup() {
     Serial.println("[Main] ========================================");
     offlineStorageEnabled = false;
 #endif
+    BootProfiler::getInstance().mark("storage");
 
     // Initialize configuration manager (NVS)
     if (!configManager.init()) {
         Serial.println("[Main] Failed to initialize NVS!");
     }
+    BootProfiler::getInstance().mark("nvs");
 
     // Setup WiFi callbacks
     wifiManager.onConnected(onWiFiConnected);
@@ -2439,6 +3102,7 @@ void setup() {
 
     // Auto-detect hardware sensors (Story 6)
     autoDetectHardware();
+    BootProfiler::getInstance().mark("sensors");
 #else
     // Native mode: Always use simulation
     sensorMode = SensorMode::SIMULATED;
@@ -2448,6 +3112,16 @@ void setup() {
     // Initialize Sensor Simulator with default profile
     // Check environment variable for profile (native) or use NORMAL
 #ifdef PLATFORM_NATIVE
+    const char* traceEnv = std::getenv(config::ENV_TRACE_REPLAY);
+    if (traceEnv && traceEnv[0] != '\0') {
+        exit(runTraceReplay(traceEnv) ? 0 : 1);
+    }
+
+    const char* metricsPortEnv = std::getenv(config::ENV_METRICS_PORT);
+    if (metricsPortEnv && atoi(metricsPortEnv) > 0) {
+        metrics::Registry::getInstance().startScrapeServer((uint16_t)atoi(metricsPortEnv));
+    }
+
     const char* profileEnv = std::getenv("SIMULATION_PROFILE");
     if (profileEnv) {
         setSimulationProfile(String(profileEnv));
@@ -2492,6 +3166,10 @@ void setup() {
 
     Serial.printf("[Main] Initial state: %s\n",
                   StateMachine::getStateName(stateMachine.getState()));
+
+    startReadingPipeline();
+    registerLoopTasks();
+    BootProfiler::getInstance().mark("setup");
 }
 
 void loop() {
@@ -2500,102 +3178,10 @@ void loop() {
     esp_task_wdt_reset();
 #endif
 
-    NodeState currentState = stateMachine.getState();
-
-#ifdef PLATFORM_ESP32
-    // Check Boot button for WPS (in UNCONFIGURED/PAIRING) or Factory Reset (any state)
-    // Factory Reset works in ALL states, WPS only in pairing states
-    if (currentState == NodeState::UNCONFIGURED || currentState == NodeState::PAIRING) {
-        checkBootButton();  // WPS + Factory Reset
-    } else {
-        // In other states, only check for Factory Reset (10 second hold)
-        checkBootButtonForFactoryReset();
-    }
-
-    // Process WPS events if active
-    if (wpsManager.isActive()) {
-        wpsManager.loop();
-    }
-#endif
-
-    // Update sensor simulator (generates smooth value transitions)
-    static unsigned long lastSimulatorUpdate = 0;
-    if (millis() - lastSimulatorUpdate >= 1000) {  // Update every second
-        lastSimulatorUpdate = millis();
-        sensorSimulator.update();
-    }
-
-    switch (currentState) {
-        case NodeState::UNCONFIGURED:
-            handleUnconfiguredState();
-            break;
-
-        case NodeState::PAIRING:
-            handlePairingState();
-            break;
-
-        case NodeState::CONFIGURED:
-            handleConfiguredState();
-            break;
-
-        case NodeState::OPERATIONAL:
-            handleOperationalState();
-            break;
-
-        case NodeState::ERROR:
-            handleErrorState();
-            break;
-
-        case NodeState::RE_PAIRING:
-            handleRePairingState();
-            break;
-    }
-
-    // Update LED controller (for all states)
-    ledController.update();
-
-    // ============================================================================
-    // Sprint 8: Update Remote Debug System Components
-    // ============================================================================
-#ifdef PLATFORM_ESP32
-    // Process SD logger queue
-    if (offlineStorageEnabled) {
-        SDLogger::getInstance().loop();
-    }
-
-    // Process debug log uploader
-    DebugLogUploader::getInstance().loop();
-#endif
-
-    // ============================================================================
-    // Sprint OS-01: Update Offline Storage Components
-    // ============================================================================
-#ifdef PLATFORM_ESP32
-    if (offlineStorageEnabled) {
-        // Update sync button (check for presses)
-        syncButton.update();
-
-        // Update sync status LED (blink patterns)
-        syncStatusLED.update();
-
-        // Run sync manager loop (handles auto-sync, retries)
-        syncManager.loop();
-
-        // Update LED based on sync state (if not syncing)
-        if (syncManager.getState() == SyncState::IDLE) {
-            if (!wifiManager.isConnected()) {
-                syncStatusLED.setNoWifi();
-            } else if (syncManager.hasPendingReadings()) {
-                syncStatusLED.setPendingData();
-            } else {
-                syncStatusLED.setAllSynced();
-            }
-        }
-    }
-#endif
-
-    // Small delay to prevent busy-looping
-    delay(10);
+    // Run due tasks, then sleep until the earliest deadline or a GPIO/WiFi event
+    LoopScheduler& scheduler = LoopScheduler::getInstance();
+    scheduler.runDue();
+    scheduler.sleepUntilNextDeadline();
 }
 
 // ============================================================================
@@ -2604,6 +3190,10 @@ void loop() {
 
 #ifdef PLATFORM_NATIVE
 int main() {
+#ifdef NATIVE_BENCH
+    // native_bench env: run the benchmark suite instead of the node
+    return bench::runSuite() ? 0 : 1;
+#endif
     setup();
     while (true) {
         loop();
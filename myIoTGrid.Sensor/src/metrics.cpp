@@ -0,0 +1,292 @@
+/**
+ * myIoTGrid.Sensor - Metrics Registry Implementation
+ */
+
+#include "metrics.h"
+#include "json_arena.h"
+#include <ArduinoJson.h>
+#ifdef PLATFORM_NATIVE
+#include "ArduinoJsonString.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#endif
+
+namespace metrics {
+
+namespace {
+
+/**
+ * Name of a metric: Prometheus (snake case, prefixed) and heartbeat JSON key
+ */
+struct MetricInfo {
+    const char* name;
+    const char* key;
+    const char* help;
+};
+
+// Index = enum value; keep in enum order
+const MetricInfo COUNTER_INFO[] = {
+    {"sensor_reads_total", "sensorReads", "Sensor reads"},
+    {"sensor_read_errors_total", "sensorErrors", "Failed hardware sensor reads"},
+    {"http_requests_total", "httpRequests", "Hub requests sent"},
+    {"http_errors_total", "httpErrors", "Hub requests without 2xx response"},
+    {"http_rejected_total", "httpRejected", "Hub requests refused by the circuit breaker"},
+    {"sd_appends_total", "sdAppends", "Readings appended to SD"},
+    {"sd_append_errors_total", "sdErrors", "Failed SD appends"},
+    {"arena_fallbacks_total", "arenaFallbacks", "JSON arena allocations served from heap"},
+};
+
+const MetricInfo GAUGE_INFO[] = {
+    {"heap_free_bytes", "heapFree", "Free heap"},
+    {"heap_min_free_bytes", "heapMinFree", "Lowest free heap since boot"},
+    {"wifi_rssi_dbm", "rssi", "WiFi RSSI"},
+    {"sync_pending_readings", "syncPending", "Readings waiting for sync"},
+    {"logging_overhead_us", "loggingUs", "Time spent in debug logging since boot"},
+    {"sd_log_dropped_entries", "sdLogDropped", "SD log entries dropped"},
+    {"heap_largest_block_bytes", "heapMaxBlock", "Largest contiguous free heap block"},
+    {"arena_peak_bytes", "arenaPeak", "JSON arena high-water mark"},
+};
+
+const MetricInfo HISTOGRAM_INFO[] = {
+    {"sensor_read_us", "sensorReadUs", "Sensor read duration"},
+    {"http_request_ms", "httpMs", "Hub request duration"},
+    {"sd_append_us", "sdAppendUs", "SD append duration"},
+    {"loop_pass_us", "loopUs", "Main loop pass duration"},
+};
+
+// Upper bounds per histogram (same unit as the histogram)
+const uint32_t HISTOGRAM_BOUNDS[][HISTOGRAM_BUCKETS] = {
+    {100, 500, 1000, 5000, 10000, 50000, 100000, 1000000},      // sensor read: I2C .. DHT/1-Wire
+    {50, 100, 250, 500, 1000, 2500, 5000, 10000},               // HTTP
+    {100, 500, 1000, 5000, 10000, 50000, 100000, 500000},       // SD append
+    {100, 500, 1000, 5000, 10000, 50000, 100000, 500000},       // loop pass
+};
+
+static_assert(sizeof(COUNTER_INFO) / sizeof(COUNTER_INFO[0]) == (size_t)Counter::COUNT_END,
+              "COUNTER_INFO out of sync with metrics::Counter");
+static_assert(sizeof(GAUGE_INFO) / sizeof(GAUGE_INFO[0]) == (size_t)Gauge::COUNT_END,
+              "GAUGE_INFO out of sync with metrics::Gauge");
+static_assert(sizeof(HISTOGRAM_INFO) / sizeof(HISTOGRAM_INFO[0]) == (size_t)Histogram::COUNT_END,
+              "HISTOGRAM_INFO out of sync with metrics::Histogram");
+static_assert(sizeof(HISTOGRAM_BOUNDS) / sizeof(HISTOGRAM_BOUNDS[0]) == (size_t)Histogram::COUNT_END,
+              "HISTOGRAM_BOUNDS out of sync with metrics::Histogram");
+
+const char PREFIX[] = "myiotgrid_";
+
+void appendHeader(String& text, const MetricInfo& info, const char* type) {
+    text += "# HELP ";
+    text += PREFIX;
+    text += info.name;
+    text += " ";
+    text += info.help;
+    text += "\n# TYPE ";
+    text += PREFIX;
+    text += info.name;
+    text += " ";
+    text += type;
+    text += "\n";
+}
+
+void appendSample(String& text, const char* name, const char* suffix, const char* labels, unsigned long value) {
+    text += PREFIX;
+    text += name;
+    text += suffix;
+    text += labels;
+    text += " ";
+    text += String(value);
+    text += "\n";
+}
+
+} // namespace
+
+Registry& Registry::getInstance() {
+    static Registry instance;
+    return instance;
+}
+
+Registry::Registry() {
+    for (auto& counter : _counters) counter.store(0);
+    for (size_t i = 0; i < (size_t)Gauge::COUNT_END; i++) {
+        _gauges[i].store(0);
+        _gaugeSet[i].store(false);
+    }
+    for (auto& histogram : _histograms) {
+        for (auto& bucket : histogram.buckets) bucket.store(0);
+        histogram.count.store(0);
+        histogram.sum.store(0);
+        histogram.max.store(0);
+    }
+}
+
+void Registry::setMin(Gauge gauge, int32_t value) {
+    size_t index = (size_t)gauge;
+    if (!_gaugeSet[index].exchange(true, std::memory_order_relaxed)) {
+        _gauges[index].store(value, std::memory_order_relaxed);
+        return;
+    }
+
+    int32_t current = _gauges[index].load(std::memory_order_relaxed);
+    while (value < current &&
+           !_gauges[index].compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void Registry::observe(Histogram histogram, uint32_t value) {
+    size_t index = (size_t)histogram;
+    HistogramData& data = _histograms[index];
+    const uint32_t* bounds = HISTOGRAM_BOUNDS[index];
+
+    size_t bucket = 0;
+    while (bucket < HISTOGRAM_BUCKETS && value > bounds[bucket]) {
+        bucket++;
+    }
+
+    data.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    data.count.fetch_add(1, std::memory_order_relaxed);
+    data.sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint32_t max = data.max.load(std::memory_order_relaxed);
+    while (value > max && !data.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+uint32_t Registry::percentile(const HistogramData& data, const uint32_t* bounds, uint32_t permille) const {
+    uint32_t count = data.count.load(std::memory_order_relaxed);
+    if (count == 0) return 0;
+
+    uint64_t target = ((uint64_t)count * permille + 999) / 1000;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += data.buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) return bounds[i];
+    }
+    return data.max.load(std::memory_order_relaxed);
+}
+
+String Registry::getSnapshotJson() const {
+    JsonDocument doc(&JsonArena::getInstance());
+
+    for (size_t i = 0; i < (size_t)Counter::COUNT_END; i++) {
+        doc[COUNTER_INFO[i].key] = _counters[i].load(std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < (size_t)Gauge::COUNT_END; i++) {
+        if (_gaugeSet[i].load(std::memory_order_relaxed)) {
+            doc[GAUGE_INFO[i].key] = _gauges[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    for (size_t i = 0; i < (size_t)Histogram::COUNT_END; i++) {
+        const HistogramData& data = _histograms[i];
+        uint32_t count = data.count.load(std::memory_order_relaxed);
+        if (count == 0) continue;
+
+        JsonObject histogram = doc[HISTOGRAM_INFO[i].key].to<JsonObject>();
+        histogram["n"] = count;
+        histogram["avg"] = data.sum.load(std::memory_order_relaxed) / count;
+        histogram["p95"] = percentile(data, HISTOGRAM_BOUNDS[i], 950);
+        histogram["max"] = data.max.load(std::memory_order_relaxed);
+    }
+
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
+
+String Registry::getPrometheusText() const {
+    String text;
+
+    for (size_t i = 0; i < (size_t)Counter::COUNT_END; i++) {
+        appendHeader(text, COUNTER_INFO[i], "counter");
+        appendSample(text, COUNTER_INFO[i].name, "", "", _counters[i].load(std::memory_order_relaxed));
+    }
+
+    for (size_t i = 0; i < (size_t)Gauge::COUNT_END; i++) {
+        if (!_gaugeSet[i].load(std::memory_order_relaxed)) continue;
+        appendHeader(text, GAUGE_INFO[i], "gauge");
+        text += PREFIX;
+        text += GAUGE_INFO[i].name;
+        text += " ";
+        text += String((long)_gauges[i].load(std::memory_order_relaxed));
+        text += "\n";
+    }
+
+    for (size_t i = 0; i < (size_t)Histogram::COUNT_END; i++) {
+        const HistogramData& data = _histograms[i];
+        appendHeader(text, HISTOGRAM_INFO[i], "histogram");
+
+        unsigned long cumulative = 0;
+        char labels[24];
+        for (size_t b = 0; b < HISTOGRAM_BUCKETS; b++) {
+            cumulative += data.buckets[b].load(std::memory_order_relaxed);
+            snprintf(labels, sizeof(labels), "{le=\"%lu\"}", (unsigned long)HISTOGRAM_BOUNDS[i][b]);
+            appendSample(text, HISTOGRAM_INFO[i].name, "_bucket", labels, cumulative);
+        }
+        cumulative += data.buckets[HISTOGRAM_BUCKETS].load(std::memory_order_relaxed);
+        appendSample(text, HISTOGRAM_INFO[i].name, "_bucket", "{le=\"+Inf\"}", cumulative);
+        appendSample(text, HISTOGRAM_INFO[i].name, "_sum", "", data.sum.load(std::memory_order_relaxed));
+        appendSample(text, HISTOGRAM_INFO[i].name, "_count", "", cumulative);
+    }
+
+    return text;
+}
+
+#ifdef PLATFORM_NATIVE
+bool Registry::startScrapeServer(uint16_t port) {
+    int server = socket(AF_INET, SOCK_STREAM, 0);
+    if (server < 0) {
+        Serial.println("[Metrics] Failed to create socket");
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+
+    if (bind(server, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(server, 4) < 0) {
+        Serial.printf("[Metrics] Cannot listen on port %u: %s\n", (unsigned)port, strerror(errno));
+        close(server);
+        return false;
+    }
+
+    std::thread([this, server]() {
+        while (true) {
+            int client = accept(server, nullptr, nullptr);
+            if (client < 0) continue;
+
+            // Request line is enough: "GET /metrics HTTP/1.1"
+            char request[512];
+            ssize_t received = recv(client, request, sizeof(request) - 1, 0);
+            request[received > 0 ? received : 0] = '\0';
+
+            String response;
+            if (strncmp(request, "GET /metrics", 12) == 0) {
+                String body = getPrometheusText();
+                response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: ";
+                response += String((unsigned long)body.length());
+                response += "\r\n\r\n";
+                response += body;
+            } else {
+                response = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+            }
+
+            send(client, response.c_str(), response.length(), MSG_NOSIGNAL);
+            close(client);
+        }
+    }).detach();
+
+    Serial.printf("[Metrics] Prometheus endpoint: http://0.0.0.0:%u/metrics\n", (unsigned)port);
+    return true;
+}
+#endif
+
+} // namespace metrics
@@ -0,0 +1,44 @@
+/**
+ * myIoTGrid.Sensor - Reading Aggregator Implementation
+ */
+
+#include "reading_aggregator.h"
+
+ReadingAggregator::ReadingAggregator()
+    : _samples(0)
+    , _summaries(0)
+{
+}
+
+bool ReadingAggregator::addSample(int endpointId, const String& measurementType, double value,
+                                  uint32_t windowSeconds, unsigned long now, WindowSummary& summary) {
+    WindowStats& stats = _windows[makeKey(endpointId, measurementType)];
+    stats.add(value, now);
+    _samples++;
+
+    unsigned long elapsed = now - stats.startMs;
+    if (elapsed < (unsigned long)windowSeconds * 1000UL) {
+        return false;
+    }
+
+    summary.count = stats.count;
+    summary.mean = stats.mean;
+    summary.min = stats.min;
+    summary.max = stats.max;
+    summary.stddev = stats.stddev();
+    summary.last = stats.last;
+    summary.windowSeconds = elapsed / 1000;
+
+    // Restart window
+    stats = WindowStats();
+    _summaries++;
+    return true;
+}
+
+void ReadingAggregator::reset() {
+    _windows.clear();
+}
+
+String ReadingAggregator::makeKey(int endpointId, const String& measurementType) {
+    return String(endpointId) + ":" + measurementType;
+}
@@ -0,0 +1,377 @@
+/**
+ * myIoTGrid.Sensor - Reading Pipeline Implementation
+ */
+
+#include "reading_pipeline.h"
+#include "time_service.h"
+
+#include <cstring>
+
+#ifndef PLATFORM_ESP32
+#include <chrono>
+#include <thread>
+#endif
+
+// ============================================================================
+// PipelineReading
+// ============================================================================
+
+PipelineReading PipelineReading::create(const String& measurementType, const String& unit,
+                                        const String& label, int endpointId, double value, uint8_t sinks) {
+    PipelineReading reading;
+    memset(&reading, 0, sizeof(reading));
+
+    strncpy(reading.measurementType, measurementType.c_str(), sizeof(reading.measurementType) - 1);
+    strncpy(reading.unit, unit.c_str(), sizeof(reading.unit) - 1);
+    strncpy(reading.label, label.c_str(), sizeof(reading.label) - 1);
+    reading.endpointId = endpointId;
+    reading.value = value;
+    reading.sinks = sinks;
+    reading.sampledMs = millis();
+
+    // Stamp at capture; an unsynced clock is resolved later from the monotonic time
+    TimeService& timeService = TimeService::getInstance();
+    reading.captureMonoMs = TimeService::monotonicMs();
+    reading.timestampMs = timeService.toEpochMs(reading.captureMonoMs);
+    return reading;
+}
+
+uint32_t PipelineReading::getUnixTimestamp() const {
+    uint64_t epochMs = timestampMs;
+    if (epochMs == 0) {
+        epochMs = TimeService::getInstance().toEpochMs(captureMonoMs);
+    }
+    return (uint32_t)(epochMs / 1000);
+}
+
+// ============================================================================
+// ReadingQueue
+// ============================================================================
+
+ReadingQueue::ReadingQueue(const char* name, size_t capacity, QueueOverflowPolicy policy)
+    : _name(name)
+    , _capacity(capacity)
+    , _policy(policy)
+#ifdef PLATFORM_ESP32
+    , _queue(nullptr)
+#endif
+    , _highWater(0)
+    , _enqueued(0)
+    , _dropped(0)
+    , _delivered(0)
+    , _failed(0)
+    , _avgLatencyMs(0)
+    , _maxLatencyMs(0)
+{
+}
+
+ReadingQueue::~ReadingQueue() {
+#ifdef PLATFORM_ESP32
+    if (_queue) {
+        vQueueDelete(_queue);
+    }
+#endif
+}
+
+bool ReadingQueue::begin() {
+#ifdef PLATFORM_ESP32
+    if (!_queue) {
+        _queue = xQueueCreate(_capacity, sizeof(PipelineReading));
+    }
+    return _queue != nullptr;
+#else
+    return true;
+#endif
+}
+
+bool ReadingQueue::push(const PipelineReading& reading) {
+    PipelineReading item = reading;
+    item.enqueuedMs = millis();
+    bool dropped = false;
+
+#ifdef PLATFORM_ESP32
+    if (!_queue) return false;
+
+    if (xQueueSend(_queue, &item, 0) != pdTRUE) {
+        dropped = true;
+        if (_policy == QueueOverflowPolicy::DROP_OLDEST) {
+            PipelineReading oldest;
+            xQueueReceive(_queue, &oldest, 0);
+            xQueueSend(_queue, &item, 0);
+        }
+    }
+#else
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_items.size() >= _capacity) {
+            dropped = true;
+            if (_policy == QueueOverflowPolicy::DROP_OLDEST) {
+                _items.pop_front();
+                _items.push_back(item);
+            }
+        } else {
+            _items.push_back(item);
+        }
+    }
+    _cv.notify_one();
+#endif
+
+    _enqueued++;
+    if (dropped) {
+        _dropped++;
+        Serial.printf("[Pipeline] %s queue full (%u) - dropped %s reading\n", _name, (unsigned)_capacity,
+                      _policy == QueueOverflowPolicy::DROP_OLDEST ? "oldest" : "newest");
+    }
+
+    uint32_t current = depth();
+    if (current > _highWater) _highWater = current;
+
+    return !dropped;
+}
+
+bool ReadingQueue::pop(PipelineReading& reading, uint32_t timeoutMs) {
+#ifdef PLATFORM_ESP32
+    if (!_queue) return false;
+    return xQueueReceive(_queue, &reading, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+#else
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!_cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return !_items.empty(); })) {
+        return false;
+    }
+    reading = _items.front();
+    _items.pop_front();
+    return true;
+#endif
+}
+
+void ReadingQueue::complete(const PipelineReading& reading, bool delivered) {
+    uint32_t latency = millis() - reading.enqueuedMs;
+
+    if (delivered) {
+        _delivered++;
+    } else {
+        _failed++;
+    }
+
+    // Moving average over ~8 readings (single consumer writes)
+    uint32_t avg = _avgLatencyMs;
+    _avgLatencyMs = avg == 0 ? latency : avg - avg / 8 + latency / 8;
+    if (latency > _maxLatencyMs) _maxLatencyMs = latency;
+}
+
+size_t ReadingQueue::depth() const {
+#ifdef PLATFORM_ESP32
+    return _queue ? uxQueueMessagesWaiting(_queue) : 0;
+#else
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _items.size();
+#endif
+}
+
+QueueMetrics ReadingQueue::getMetrics() const {
+    QueueMetrics metrics;
+    metrics.depth = depth();
+    metrics.capacity = _capacity;
+    metrics.highWater = _highWater;
+    metrics.enqueued = _enqueued;
+    metrics.dropped = _dropped;
+    metrics.delivered = _delivered;
+    metrics.failed = _failed;
+    metrics.avgLatencyMs = _avgLatencyMs;
+    metrics.maxLatencyMs = _maxLatencyMs;
+    return metrics;
+}
+
+// ============================================================================
+// ReadingPipeline
+// ============================================================================
+
+ReadingPipeline& ReadingPipeline::getInstance() {
+    static ReadingPipeline instance;
+    return instance;
+}
+
+ReadingPipeline::ReadingPipeline()
+    : _storageQueue("storage", config::PIPELINE_STORAGE_QUEUE_DEPTH,
+                    config::PIPELINE_STORAGE_DROP_OLDEST ? QueueOverflowPolicy::DROP_OLDEST
+                                                         : QueueOverflowPolicy::DROP_NEWEST)
+    , _networkQueue("network", config::PIPELINE_NETWORK_QUEUE_DEPTH,
+                    config::PIPELINE_NETWORK_DROP_OLDEST ? QueueOverflowPolicy::DROP_OLDEST
+                                                         : QueueOverflowPolicy::DROP_NEWEST)
+    , _running(false)
+    , _samplingTicks(0)
+    , _lastJitterMs(0)
+    , _maxJitterMs(0)
+#ifdef PLATFORM_ESP32
+    , _samplingTask(nullptr)
+    , _storageTask(nullptr)
+    , _networkTask(nullptr)
+#else
+    , _wakeRequested(false)
+#endif
+{
+}
+
+bool ReadingPipeline::begin(SampleFn sampler, SinkFn storageSink, SinkFn networkSink) {
+    if (_running) return true;
+
+    _sampler = sampler;
+    _storageSink = storageSink;
+    _networkSink = networkSink;
+
+    if ((_storageSink && !_storageQueue.begin()) || !_networkQueue.begin()) {
+        Serial.println("[Pipeline] Failed to create queues!");
+        return false;
+    }
+
+#ifdef PLATFORM_ESP32
+    // Sinks first, so the first sample has somewhere to go
+    if (_storageSink &&
+        xTaskCreatePinnedToCore(storageTaskEntry, "storage", config::PIPELINE_STORAGE_TASK_STACK_SIZE,
+                                this, config::PIPELINE_STORAGE_TASK_PRIORITY, &_storageTask,
+                                config::PIPELINE_STORAGE_TASK_CORE) != pdPASS) {
+        Serial.println("[Pipeline] Failed to create storage task!");
+        return false;
+    }
+
+    if (xTaskCreatePinnedToCore(networkTaskEntry, "network", config::PIPELINE_NETWORK_TASK_STACK_SIZE,
+                                this, config::PIPELINE_NETWORK_TASK_PRIORITY, &_networkTask,
+                                config::PIPELINE_NETWORK_TASK_CORE) != pdPASS) {
+        Serial.println("[Pipeline] Failed to create network task!");
+        return false;
+    }
+
+    if (xTaskCreatePinnedToCore(samplingTaskEntry, "sampling", config::PIPELINE_SAMPLING_TASK_STACK_SIZE,
+                                this, config::PIPELINE_SAMPLING_TASK_PRIORITY, &_samplingTask,
+                                config::PIPELINE_SAMPLING_TASK_CORE) != pdPASS) {
+        Serial.println("[Pipeline] Failed to create sampling task!");
+        return false;
+    }
+#else
+    if (_storageSink) {
+        std::thread([this] { runSink(_storageQueue, _storageSink); }).detach();
+    }
+    std::thread([this] { runSink(_networkQueue, _networkSink); }).detach();
+    std::thread([this] { runSampling(); }).detach();
+#endif
+
+    _running = true;
+    Serial.printf("[Pipeline] Started (storage queue %u, network queue %u)\n",
+                  _storageSink ? (unsigned)config::PIPELINE_STORAGE_QUEUE_DEPTH : 0u,
+                  (unsigned)config::PIPELINE_NETWORK_QUEUE_DEPTH);
+    return true;
+}
+
+bool ReadingPipeline::submit(const PipelineReading& reading) {
+    bool ok = true;
+
+    if ((reading.sinks & PIPELINE_SINK_STORAGE) && _storageSink) {
+        ok = _storageQueue.push(reading) && ok;
+    }
+    if (reading.sinks & PIPELINE_SINK_NETWORK) {
+        ok = _networkQueue.push(reading) && ok;
+    }
+    return ok;
+}
+
+void ReadingPipeline::wakeSampler() {
+#ifdef PLATFORM_ESP32
+    if (_samplingTask) {
+        xTaskNotifyGive(_samplingTask);
+    }
+#else
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _wakeRequested = true;
+    }
+    _wakeCv.notify_one();
+#endif
+}
+
+void ReadingPipeline::waitForSampler(uint32_t waitMs) {
+    unsigned long planned = millis() + waitMs;
+    bool woken;
+
+#ifdef PLATFORM_ESP32
+    woken = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs)) > 0;
+#else
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+    woken = _wakeCv.wait_for(lock, std::chrono::milliseconds(waitMs), [this] { return _wakeRequested; });
+    _wakeRequested = false;
+#endif
+
+    // Lateness of timed wakeups only (early wakeups are requested)
+    if (!woken) {
+        long late = (long)(millis() - planned);
+        uint32_t jitter = late > 0 ? (uint32_t)late : 0;
+        _lastJitterMs = jitter;
+        if (jitter > _maxJitterMs) _maxJitterMs = jitter;
+    }
+}
+
+void ReadingPipeline::runSampling() {
+    while (true) {
+        uint32_t waitMs = _sampler(millis());
+        _samplingTicks++;
+
+        if (waitMs > config::PIPELINE_SAMPLER_MAX_WAIT_MS) {
+            waitMs = config::PIPELINE_SAMPLER_MAX_WAIT_MS;  // Re-check state/config changes
+        }
+        waitForSampler(waitMs > 0 ? waitMs : 1);
+    }
+}
+
+void ReadingPipeline::runSink(ReadingQueue& queue, SinkFn& sink) {
+    PipelineReading reading;
+
+    while (true) {
+        if (!queue.pop(reading, config::PIPELINE_SINK_IDLE_WAIT_MS)) {
+            continue;
+        }
+        queue.complete(reading, sink(reading));
+    }
+}
+
+#ifdef PLATFORM_ESP32
+void ReadingPipeline::samplingTaskEntry(void* param) {
+    static_cast<ReadingPipeline*>(param)->runSampling();
+}
+
+void ReadingPipeline::storageTaskEntry(void* param) {
+    ReadingPipeline* self = static_cast<ReadingPipeline*>(param);
+    self->runSink(self->_storageQueue, self->_storageSink);
+}
+
+void ReadingPipeline::networkTaskEntry(void* param) {
+    ReadingPipeline* self = static_cast<ReadingPipeline*>(param);
+    self->runSink(self->_networkQueue, self->_networkSink);
+}
+#endif
+
+static String queueMetricsJson(const QueueMetrics& m) {
+    String json = "{";
+    json += "\"depth\":" + String((unsigned long)m.depth) + ",";
+    json += "\"capacity\":" + String((unsigned long)m.capacity) + ",";
+    json += "\"highWater\":" + String((unsigned long)m.highWater) + ",";
+    json += "\"enqueued\":" + String((unsigned long)m.enqueued) + ",";
+    json += "\"dropped\":" + String((unsigned long)m.dropped) + ",";
+    json += "\"delivered\":" + String((unsigned long)m.delivered) + ",";
+    json += "\"failed\":" + String((unsigned long)m.failed) + ",";
+    json += "\"avgLatencyMs\":" + String((unsigned long)m.avgLatencyMs) + ",";
+    json += "\"maxLatencyMs\":" + String((unsigned long)m.maxLatencyMs);
+    json += "}";
+    return json;
+}
+
+String ReadingPipeline::getMetricsJson() const {
+    String json = "{";
+    json += "\"samplingTicks\":" + String((unsigned long)_samplingTicks) + ",";
+    json += "\"lastJitterMs\":" + String((unsigned long)_lastJitterMs) + ",";
+    json += "\"maxJitterMs\":" + String((unsigned long)_maxJitterMs) + ",";
+    if (_storageSink) {
+        json += "\"storage\":" + queueMetricsJson(_storageQueue.getMetrics()) + ",";
+    }
+    json += "\"network\":" + queueMetricsJson(_networkQueue.getMetrics());
+    json += "}";
+    return json;
+}
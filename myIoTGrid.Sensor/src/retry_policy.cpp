@@ -0,0 +1,227 @@
+/**
+ * myIoTGrid.Sensor - Retry Policy Implementation
+ */
+
+#include "retry_policy.h"
+#include "config.h"
+#include "json_arena.h"
+#include <ArduinoJson.h>
+#ifdef PLATFORM_NATIVE
+#include "ArduinoJsonString.h"
+#include <random>
+#endif
+
+#ifdef PLATFORM_ESP32
+#include <esp_system.h>
+#endif
+
+namespace retry {
+
+uint32_t randomSeed() {
+#ifdef PLATFORM_ESP32
+    uint32_t seed = esp_random();
+#else
+    static std::random_device device;
+    uint32_t seed = device();
+#endif
+    return seed != 0 ? seed : 0x9E3779B9;   // xorshift must not start at 0
+}
+
+uint32_t parseRetryAfterMs(const String& header) {
+    String value = header;
+    value.trim();
+    if (value.length() == 0) return 0;
+
+    // Only delta-seconds; an HTTP-date would need a valid clock
+    uint64_t seconds = 0;
+    for (unsigned int i = 0; i < value.length(); i++) {
+        char c = value[i];
+        if (c < '0' || c > '9') return 0;
+        seconds = seconds * 10 + (c - '0');
+        if (seconds * 1000 > config::RETRY_AFTER_MAX_MS) return config::RETRY_AFTER_MAX_MS;
+    }
+    return (uint32_t)(seconds * 1000);
+}
+
+uint32_t jitteredInterval(uint32_t intervalMs, uint8_t percent) {
+    static DecorrelatedJitter rng(0, 0);
+    uint32_t spread = (uint32_t)((uint64_t)intervalMs * percent / 100);
+    return rng.uniform(intervalMs - spread, intervalMs + spread);
+}
+
+bool isHubFailure(int statusCode) {
+    return statusCode <= 0 || statusCode == 408 || statusCode == 429 || statusCode >= 500;
+}
+
+} // namespace retry
+
+// ============================================================================
+// DecorrelatedJitter
+// ============================================================================
+
+DecorrelatedJitter::DecorrelatedJitter(uint32_t baseMs, uint32_t capMs, uint32_t seed)
+    : _baseMs(baseMs)
+    , _capMs(capMs)
+    , _lastMs(baseMs)
+    , _state(seed != 0 ? seed : 0x9E3779B9)
+{
+}
+
+void DecorrelatedJitter::configure(uint32_t baseMs, uint32_t capMs) {
+    _baseMs = baseMs;
+    _capMs = capMs;
+    _lastMs = baseMs;
+}
+
+uint32_t DecorrelatedJitter::next() {
+    uint64_t upper = (uint64_t)_lastMs * 3;
+    if (upper > _capMs) upper = _capMs;
+    if (upper < _baseMs) upper = _baseMs;
+
+    _lastMs = uniform(_baseMs, (uint32_t)upper);
+    return _lastMs;
+}
+
+uint32_t DecorrelatedJitter::uniform(uint32_t lo, uint32_t hi) {
+    // xorshift32 (Marsaglia)
+    _state ^= _state << 13;
+    _state ^= _state >> 17;
+    _state ^= _state << 5;
+
+    if (hi <= lo) return lo;
+    return lo + (uint32_t)((uint64_t)_state * ((uint64_t)hi - lo + 1) >> 32);
+}
+
+// ============================================================================
+// CircuitBreaker
+// ============================================================================
+
+CircuitBreaker::CircuitBreaker(uint32_t failureThreshold, uint32_t openBaseMs, uint32_t openMaxMs,
+                               uint32_t seed)
+    : _failureThreshold(failureThreshold)
+    , _openJitter(openBaseMs, openMaxMs, seed)
+    , _state(CircuitState::CLOSED)
+    , _consecutiveFailures(0)
+    , _openedAt(0)
+    , _openMs(0)
+    , _probeInFlight(false)
+    , _opened(0)
+    , _rejected(0)
+    , _probes(0)
+    , _retryAfterHonored(0)
+{
+}
+
+CircuitBreaker& CircuitBreaker::forHub() {
+    static CircuitBreaker instance(config::CIRCUIT_FAILURE_THRESHOLD,
+                                   config::CIRCUIT_OPEN_BASE_MS,
+                                   config::CIRCUIT_OPEN_MAX_MS);
+    return instance;
+}
+
+bool CircuitBreaker::allowRequest(unsigned long now) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    switch (_state) {
+        case CircuitState::CLOSED:
+            return true;
+
+        case CircuitState::OPEN:
+            if (now - _openedAt < _openMs) {
+                _rejected++;
+                return false;
+            }
+            _state = CircuitState::HALF_OPEN;
+            _probeInFlight = true;
+            _probes++;
+            return true;
+
+        case CircuitState::HALF_OPEN:
+            if (_probeInFlight) {
+                _rejected++;
+                return false;
+            }
+            _probeInFlight = true;
+            _probes++;
+            return true;
+    }
+    return true;
+}
+
+void CircuitBreaker::onResult(bool hubFailure, uint32_t retryAfterMs, unsigned long now) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (retryAfterMs > 0) {
+        // Hub told us when to come back; spread the fleet behind that point
+        _retryAfterHonored++;
+        uint32_t spread = (uint32_t)((uint64_t)retryAfterMs * config::RETRY_AFTER_JITTER_PERCENT / 100);
+        open(retryAfterMs + _openJitter.uniform(0, spread), now);
+        return;
+    }
+
+    if (!hubFailure) {
+        _state = CircuitState::CLOSED;
+        _consecutiveFailures = 0;
+        _probeInFlight = false;
+        _openJitter.reset();
+        return;
+    }
+
+    if (_state == CircuitState::OPEN) {
+        return;     // Late result of a request sent before the breaker opened
+    }
+
+    _consecutiveFailures++;
+    if (_state == CircuitState::HALF_OPEN || _consecutiveFailures >= _failureThreshold) {
+        open(_openJitter.next(), now);
+    }
+}
+
+CircuitState CircuitBreaker::getState() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _state;
+}
+
+uint32_t CircuitBreaker::getWaitMs(unsigned long now) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_state != CircuitState::OPEN) return 0;
+
+    unsigned long elapsed = now - _openedAt;
+    return elapsed >= _openMs ? 0 : (uint32_t)(_openMs - elapsed);
+}
+
+String CircuitBreaker::getStatsJson(unsigned long now) const {
+    JsonDocument doc(&JsonArena::getInstance());
+    doc["state"] = getStateString(getState());
+    doc["waitMs"] = getWaitMs(now);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        doc["failures"] = _consecutiveFailures;
+        doc["opened"] = _opened;
+        doc["rejected"] = _rejected;
+        doc["probes"] = _probes;
+        doc["retryAfter"] = _retryAfterHonored;
+    }
+
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
+
+const char* CircuitBreaker::getStateString(CircuitState state) {
+    switch (state) {
+        case CircuitState::CLOSED: return "CLOSED";
+        case CircuitState::OPEN: return "OPEN";
+        case CircuitState::HALF_OPEN: return "HALF_OPEN";
+        default: return "UNKNOWN";
+    }
+}
+
+void CircuitBreaker::open(uint32_t openMs, unsigned long now) {
+    _state = CircuitState::OPEN;
+    _openedAt = now;
+    _openMs = openMs;
+    _probeInFlight = false;
+    _opened++;
+}
@@ -7,6 +7,7 @@
 #include "sensor_reader.h"
 #include "hardware_scanner.h"
 #include "uart_manager.h"
+#include "sr04m2_decoder.h"
 #include "debug_manager.h"
 
 // Default I2C pins for ESP32
@@ -38,7 +39,7 @@ SensorReader::SensorReader()
     , _ads1115_0x48_ready(false), _ads1115_0x49_ready(false)
     , _dht22(nullptr), _dht22_ready(false), _dht22_pin(-1)
     , _ultrasonic_trigger_pin(-1), _ultrasonic_echo_pin(-1), _ultrasonic_ready(false)
-    , _gps(nullptr), _gpsSerial(nullptr), _gps_ready(false), _gps_rx_pin(-1), _gps_tx_pin(-1), _gps_debug_ran(false)
+    , _gpsSerial(nullptr), _gps_ready(false), _gps_rx_pin(-1), _gps_tx_pin(-1), _gps_debug_ran(false)
     , _sr04m2Serial(nullptr), _sr04m2_ready(false), _sr04m2_rx_pin(-1), _sr04m2_tx_pin(-1)
     , _currentSdaPin(-1), _currentSclPin(-1)
 #endif
@@ -58,7 +59,8 @@ SensorReader::~SensorReader() {
     delete _sgp30; delete _vl53l0x;
     delete _ads1115_0x48; delete _ads1115_0x49;
     delete _dht22;
-    delete _gps;
+    GpsIngestion::getInstance().stop();
+    Sr04m2Decoder::getInstance().stop();
     delete _sr04m2Serial;
 #endif
 }
@@ -484,8 +486,6 @@ bool SensorReader::initGPS(int rxPin, int txPin) {
         return true;
     }
 
-    if (!_gps) _gps = new TinyGPSPlus();
-
     // Use UARTManager to allocate UART dynamically based on pins
     UARTManager& uartMgr = UARTManager::getInstance();
     int uartNum = uartMgr.allocate(rxPin, txPin, 9600, "GPS", false);  // Use Arduino API
@@ -501,6 +501,14 @@ bool SensorReader::initGPS(int rxPin, int txPin) {
         return false;
     }
 
+    // NMEA parsing runs in its own task, woken by UART receive events
+    if (!GpsIngestion::getInstance().start(_gpsSerial)) {
+        Serial.println("[SensorReader] Failed to start GPS ingestion!");
+        _gpsSerial = nullptr;
+        uartMgr.releaseByOwner("GPS");
+        return false;
+    }
+
     _gps_rx_pin = rxPin;
     _gps_tx_pin = txPin;
     _gps_ready = true;
@@ -532,6 +540,9 @@ bool SensorReader::initSR04M2(int rxPin, int txPin, int baudRate) {
     Serial.printf("[SensorReader] Initializing SR04M-2 (UART) RX=%d, TX=%s at %d baud...\n",
                   rxPin, txPin < 0 ? "none" : String(txPin).c_str(), actualBaudRate);
 
+    // Decoder must not touch the UART while it is (re)initialized
+    Sr04m2Decoder::getInstance().stop();
+
     // Use UARTManager to allocate UART dynamically based on pins
     UARTManager& uartMgr = UARTManager::getInstance();
     int uartNum = uartMgr.allocate(rxPin, txPin, actualBaudRate, "SR04M2", true);  // Use ESP-IDF API
@@ -551,6 +562,12 @@ bool SensorReader::initSR04M2(int rxPin, int txPin, int baudRate) {
         }
     }
 
+    // Frames are decoded continuously from the UART event queue
+    if (!Sr04m2Decoder::getInstance().start(uartNum)) {
+        Serial.println("[SensorReader] Failed to start SR04M-2 frame decoder!");
+        return false;
+    }
+
     _sr04m2_rx_pin = rxPin;
     _sr04m2_tx_pin = txPin;
     _sr04m2_ready = true;
@@ -1227,68 +1244,42 @@ SensorReading SensorReader::readWaterLevel(const SensorAssignmentConfig& config)
         Serial.printf("[SR04M-2] UART mode - RX=GPIO%d, TX=%s, Baud=%d (from config: %d)\n",
                       rxPin, txPin < 0 ? "none" : String(txPin).c_str(), baudRate, config.baudRate);
 
-        // Always reinitialize to apply current baud rate
-        _sr04m2_ready = false;
-        if (!initSR04M2(rxPin, txPin, baudRate)) {
-            return SensorReading("SR04M-2 not available");
+        // Reinitialize only when pins or baud rate changed (restarts the decoder)
+        if (!_sr04m2_ready || _sr04m2_rx_pin != rxPin || _sr04m2_tx_pin != txPin ||
+            sr04m2_current_baud != baudRate) {
+            _sr04m2_ready = false;
+            if (!initSR04M2(rxPin, txPin, baudRate)) {
+                return SensorReading("SR04M-2 not available");
+            }
         }
 
-        // Get UART port from UARTManager (dynamically allocated)
-        UARTManager& uartMgr = UARTManager::getInstance();
-        int uartNum_int = uartMgr.getUartForOwner("SR04M2");
-        if (uartNum_int < 0) {
-            return SensorReading("SR04M-2 UART not allocated");
-        }
-        const uart_port_t uart_num = (uartNum_int == 1) ? UART_NUM_1 : UART_NUM_2;
-
-        // Clear RX buffer first
-        uart_flush_input(uart_num);
-        delay(10);
-
-        // Wait for frame (sensor sends every ~100ms in auto-mode)
-        // Frame: 0xFF 0xFE DIST_HIGH DIST_LOW CHECKSUM
-        unsigned long startTime = millis();
-        uint8_t buffer[32];
-        int bufferPos = 0;
-        bool frameFound = false;
-        int frameStartIdx = -1;
-
-        Serial.println("[SR04M-2] Waiting for frame (0xFF 0xFE header)...");
-
-        // Read up to 500ms or until we find a valid frame
-        while (millis() - startTime < 500 && bufferPos < 30 && !frameFound) {
-            size_t buffered;
-            uart_get_buffered_data_len(uart_num, &buffered);
-
-            if (buffered > 0) {
-                uint8_t byte;
-                int len = uart_read_bytes(uart_num, &byte, 1, pdMS_TO_TICKS(10));
-                if (len > 0) {
-                    buffer[bufferPos++] = byte;
-                    Serial.printf("[SR04M-2] Byte %d: 0x%02X\n", bufferPos, byte);
-
-                    // Look for frame header 0xFF 0xFE
-                    if (bufferPos >= 2) {
-                        for (int i = 0; i <= bufferPos - 2; i++) {
-                            if (buffer[i] == 0xFF && buffer[i + 1] == 0xFE) {
-                                frameStartIdx = i;
-                                // Check if we have all 5 bytes of the frame
-                                if (bufferPos >= frameStartIdx + 5) {
-                                    frameFound = true;
-                                    Serial.printf("[SR04M-2] Frame found at position %d!\n", frameStartIdx);
-                                }
-                                break;
-                            }
-                        }
-                    }
-                }
-            }
-            delay(1);
+        // Frames are decoded continuously by the decoder task; on the first
+        // read after (re)start wait for the first frame (~100ms in auto-mode)
+        Sr04m2Decoder& decoder = Sr04m2Decoder::getInstance();
+        Sr04m2Snapshot frame = decoder.getSnapshot();
+        while (frame.lastStatus == Sr04m2FrameStatus::NONE &&
+               millis() - frame.startedAtMs < config::SR04M2_FIRST_FRAME_WAIT_MS) {
+            delay(10);
+            frame = decoder.getSnapshot();
         }
 
-        if (!frameFound) {
-            Serial.printf("[SR04M-2] No frame found in %d bytes\n", bufferPos);
-            if (bufferPos == 0) {
+        bool fresh = frame.framesValid > 0 &&
+                     millis() - frame.updatedAtMs < config::SR04M2_MAX_FRAME_AGE_MS;
+
+        if (!fresh) {
+            Serial.printf("[SR04M-2] No valid frame (bytes=%u, valid=%u, checksum errors=%u, out of range=%u, discarded=%u)\n",
+                          frame.bytesReceived, frame.framesValid, frame.checksumErrors,
+                          frame.outOfRange, frame.bytesDiscarded);
+
+            if (frame.lastStatus == Sr04m2FrameStatus::CHECKSUM_ERROR) {
+                return SensorReading("SR04M-2 checksum error");
+            }
+            if (frame.lastStatus == Sr04m2FrameStatus::OUT_OF_RANGE) {
+                Serial.printf("[SR04M-2] Out of range: %u mm (%.1f cm)\n",
+                              frame.lastRawMm, frame.lastRawMm / 10.0);
+                return SensorReading("SR04M-2 out of range");
+            }
+            if (frame.bytesReceived == 0) {
                 Serial.println("[SR04M-2] No data received - check wiring:");
                 Serial.printf("  - Sensor TX -> ESP32 GPIO %d (RX)\n", rxPin);
                 Serial.println("  - Sensor 5V -> ESP32 5V");
@@ -1300,35 +1291,11 @@ SensorReading SensorReader::readWaterLevel(const SensorAssignmentConfig& config)
             return SensorReading("SR04M-2 no valid frame");
         }
 
-        // Extract frame data
-        uint8_t header1 = buffer[frameStartIdx];     // 0xFF
-        uint8_t header2 = buffer[frameStartIdx + 1]; // 0xFE
-        uint8_t highByte = buffer[frameStartIdx + 2];
-        uint8_t lowByte = buffer[frameStartIdx + 3];
-        uint8_t checksum = buffer[frameStartIdx + 4];
-
-        Serial.printf("[SR04M-2] Frame: [0x%02X 0x%02X] H=0x%02X L=0x%02X CS=0x%02X\n",
-                      header1, header2, highByte, lowByte, checksum);
-
-        // Validate checksum: (DIST_HIGH + DIST_LOW) & 0xFF
-        uint8_t calculatedChecksum = (highByte + lowByte) & 0xFF;
-        if (calculatedChecksum != checksum) {
-            Serial.printf("[SR04M-2] Checksum error: calc=0x%02X, recv=0x%02X\n",
-                         calculatedChecksum, checksum);
-            return SensorReading("SR04M-2 checksum error");
-        }
-
-        // Calculate distance in cm (value is in mm)
-        uint16_t distance_mm = (highByte << 8) | lowByte;
-        float distance_cm = distance_mm / 10.0;
+        // Median of the last valid frames (value is in mm)
+        float distance_cm = frame.distanceMm / 10.0;
 
-        // Valid range is 20-750 cm for SR04M-2
-        if (distance_mm < 200 || distance_mm > 7500) {
-            Serial.printf("[SR04M-2] Out of range: %u mm (%.1f cm)\n", distance_mm, distance_cm);
-            return SensorReading("SR04M-2 out of range");
-        }
-
-        Serial.printf("[SR04M-2] SUCCESS! Distance: %u mm (%.2f cm)\n", distance_mm, distance_cm);
+        Serial.printf("[SR04M-2] SUCCESS! Distance: %u mm (%.2f cm, last raw %u mm)\n",
+                      frame.distanceMm, distance_cm, frame.lastRawMm);
         return SensorReading(distance_cm);
     }
 
@@ -1409,16 +1376,11 @@ SensorReading SensorReader::readLatitude(const SensorAssignmentConfig& config) {
             return SensorReading("GPS not available");
         }
 
-        // Read GPS data (up to 100ms)
-        unsigned long start = millis();
-        while (millis() - start < 100) {
-            while (_gpsSerial->available() > 0) {
-                _gps->encode(_gpsSerial->read());
-            }
-        }
+        // Latest fix from the NMEA ingestion task (no UART access here)
+        GpsSnapshot fix = GpsIngestion::getInstance().getSnapshot();
 
-        if (_gps->location.isValid()) {
-            double lat = _gps->location.lat();
+        if (fix.locationValid) {
+            double lat = fix.latitude;
             Serial.printf("[SensorReader] GPS Latitude: %.6f°\n", lat);
             return SensorReading(lat);
         }
@@ -1428,7 +1390,9 @@ SensorReading SensorReader::readLatitude(const SensorAssignmentConfig& config) {
             Serial.println("\n[SensorReader] GPS no fix detected - running diagnostics automatically...\n");
             _gps_debug_ran = true;
 
-            // Release GPS UART allocation via UARTManager to avoid conflict with debugGPS
+            // Stop ingestion and release GPS UART allocation via UARTManager
+            // to avoid conflict with debugGPS
+            GpsIngestion::getInstance().stop();
             UARTManager& uartMgr = UARTManager::getInstance();
             uartMgr.releaseByOwner("GPS");
             _gpsSerial = nullptr;
@@ -1473,16 +1437,11 @@ SensorReading SensorReader::readLongitude(const SensorAssignmentConfig& config)
             return SensorReading("GPS not available");
         }
 
-        // Read GPS data (up to 100ms)
-        unsigned long start = millis();
-        while (millis() - start < 100) {
-            while (_gpsSerial->available() > 0) {
-                _gps->encode(_gpsSerial->read());
-            }
-        }
+        // Latest fix from the NMEA ingestion task (no UART access here)
+        GpsSnapshot fix = GpsIngestion::getInstance().getSnapshot();
 
-        if (_gps->location.isValid()) {
-            double lng = _gps->location.lng();
+        if (fix.locationValid) {
+            double lng = fix.longitude;
             Serial.printf("[SensorReader] GPS Longitude: %.6f°\n", lng);
             return SensorReading(lng);
         }
@@ -1514,16 +1473,11 @@ SensorReading SensorReader::readAltitude(const SensorAssignmentConfig& config) {
             return SensorReading("GPS not available");
         }
 
-        // Read GPS data (up to 100ms)
-        unsigned long start = millis();
-        while (millis() - start < 100) {
-            while (_gpsSerial->available() > 0) {
-                _gps->encode(_gpsSerial->read());
-            }
-        }
+        // Latest fix from the NMEA ingestion task (no UART access here)
+        GpsSnapshot fix = GpsIngestion::getInstance().getSnapshot();
 
-        if (_gps->altitude.isValid()) {
-            double alt = _gps->altitude.meters();
+        if (fix.altitudeValid) {
+            double alt = fix.altitudeM;
             Serial.printf("[SensorReader] GPS Altitude: %.2f m\n", alt);
             return SensorReading(alt);
         }
@@ -1555,16 +1509,11 @@ SensorReading SensorReader::readSpeed(const SensorAssignmentConfig& config) {
             return SensorReading("GPS not available");
         }
 
-        // Read GPS data (up to 100ms)
-        unsigned long start = millis();
-        while (millis() - start < 100) {
-            while (_gpsSerial->available() > 0) {
-                _gps->encode(_gpsSerial->read());
-            }
-        }
+        // Latest fix from the NMEA ingestion task (no UART access here)
+        GpsSnapshot fix = GpsIngestion::getInstance().getSnapshot();
 
-        if (_gps->speed.isValid()) {
-            double speed = _gps->speed.kmph();
+        if (fix.speedValid) {
+            double speed = fix.speedKmph;
             Serial.printf("[SensorReader] GPS Speed: %.2f km/h\n", speed);
             return SensorReading(speed);
         }
@@ -1596,16 +1545,11 @@ SensorReading SensorReader::readGpsSatellites(const SensorAssignmentConfig& conf
             return SensorReading("GPS not available");
         }
 
-        // Read GPS data (up to 100ms)
-        unsigned long start = millis();
-        while (millis() - start < 100) {
-            while (_gpsSerial->available() > 0) {
-                _gps->encode(_gpsSerial->read());
-            }
-        }
+        // Latest fix from the NMEA ingestion task (no UART access here)
+        GpsSnapshot fix = GpsIngestion::getInstance().getSnapshot();
 
-        if (_gps->satellites.isValid()) {
-            int satellites = _gps->satellites.value();
+        if (fix.satellitesValid) {
+            int satellites = fix.satellites;
             Serial.printf("[SensorReader] GPS Satellites: %d\n", satellites);
             return SensorReading((double)satellites);
         }
@@ -1640,25 +1584,12 @@ SensorReading SensorReader::readGpsFix(const SensorAssignmentConfig& config) {
             return SensorReading("GPS not available");
         }
 
-        // Read GPS data (up to 100ms)
-        unsigned long start = millis();
-        while (millis() - start < 100) {
-            while (_gpsSerial->available() > 0) {
-                _gps->encode(_gpsSerial->read());
-            }
-        }
+        // Latest fix from the NMEA ingestion task (no UART access here)
+        GpsSnapshot fix = GpsIngestion::getInstance().getSnapshot();
 
-        // Determine fix type based on location validity and satellite count
-        // TinyGPS++ doesn't expose fix quality directly, so we infer it
-        int fixType = 0;
-        if (_gps->location.isValid()) {
-            // Has valid fix
-            if (_gps->satellites.isValid() && _gps->satellites.value() >= 4) {
-                fixType = 3; // 3D fix (4+ satellites)
-            } else {
-                fixType = 2; // 2D fix (less than 4 satellites)
-            }
-        }
+        // Fix type is inferred by the ingestion task from location validity
+        // and satellite count (3D with 4+ satellites, otherwise 2D)
+        int fixType = fix.fixType;
 
         Serial.printf("[SensorReader] GPS Fix Type: %d\n", fixType);
         return SensorReading((double)fixType);
@@ -1690,16 +1621,11 @@ SensorReading SensorReader::readGpsHdop(const SensorAssignmentConfig& config) {
             return SensorReading("GPS not available");
         }
 
-        // Read GPS data (up to 100ms)
-        unsigned long start = millis();
-        while (millis() - start < 100) {
-            while (_gpsSerial->available() > 0) {
-                _gps->encode(_gpsSerial->read());
-            }
-        }
+        // Latest fix from the NMEA ingestion task (no UART access here)
+        GpsSnapshot fix = GpsIngestion::getInstance().getSnapshot();
 
-        if (_gps->hdop.isValid()) {
-            double hdop = _gps->hdop.hdop();
+        if (fix.hdopValid) {
+            double hdop = fix.hdop;
             Serial.printf("[SensorReader] GPS HDOP: %.2f\n", hdop);
             return SensorReading(hdop);
         }
@@ -0,0 +1,77 @@
+/**
+ * myIoTGrid.Sensor - Sensor Poll Schedule Implementation
+ */
+
+#include "sensor_schedule.h"
+
+namespace schedule {
+
+int gcd(int a, int b) {
+    while (b != 0) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+int pollIntervalGCD(const std::vector<SensorAssignmentConfig>& sensors, int defaultIntervalSeconds) {
+    int result = 0;
+    for (const auto& sensor : sensors) {
+        if (sensor.isActive && sensor.intervalSeconds > 0) {
+            result = result == 0 ? sensor.intervalSeconds : gcd(result, sensor.intervalSeconds);
+        }
+    }
+
+    // Fallback to default if no active sensors with intervals
+    if (result == 0) {
+        result = defaultIntervalSeconds > 0 ? defaultIntervalSeconds : 60;
+    }
+    return result;
+}
+
+bool isSensorDue(const SensorAssignmentConfig& sensor,
+                 const std::map<int, unsigned long>& lastReading, unsigned long now) {
+    if (!sensor.isActive || sensor.intervalSeconds <= 0) {
+        return false;
+    }
+
+    auto it = lastReading.find(sensor.endpointId);
+    if (it == lastReading.end()) {
+        // First reading - sensor is due
+        return true;
+    }
+
+    unsigned long elapsed = (now - it->second) / 1000;  // Convert to seconds
+    return elapsed >= (unsigned long)sensor.intervalSeconds;
+}
+
+bool samplingChanged(const NodeConfigurationResponse& previous, const NodeConfigurationResponse& next) {
+    if (previous.isSimulation != next.isSimulation || previous.sensors.size() != next.sensors.size()) {
+        return true;
+    }
+
+    for (size_t i = 0; i < next.sensors.size(); i++) {
+        const SensorAssignmentConfig& before = previous.sensors[i];
+        const SensorAssignmentConfig& after = next.sensors[i];
+        if (before.endpointId != after.endpointId ||
+            before.sensorCode != after.sensorCode ||
+            before.isActive != after.isActive ||
+            before.intervalSeconds != after.intervalSeconds ||
+            before.aggregationWindowSeconds != after.aggregationWindowSeconds ||
+            before.offsetCorrection != after.offsetCorrection ||
+            before.gainCorrection != after.gainCorrection ||
+            before.capabilities.size() != after.capabilities.size()) {
+            return true;
+        }
+
+        for (size_t c = 0; c < after.capabilities.size(); c++) {
+            if (before.capabilities[c].measurementType != after.capabilities[c].measurementType) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace schedule
@@ -0,0 +1,563 @@
+/**
+ * myIoTGrid.Sensor - Sensor Trace Recording & Replay Implementation
+ */
+
+#include "sensor_trace.h"
+#include "storage/sd_manager.h"
+#include <cstdint>
+#include <cstring>
+#ifdef PLATFORM_NATIVE
+#include "api_client.h"
+#include "gps_ingestion.h"
+#include "json_arena.h"
+#include "reading_pipeline.h"
+#include "storage/reading_storage.h"
+#include "sr04m2_decoder.h"
+#include <ArduinoJson.h>
+#include <chrono>
+#include <cstdlib>
+#endif
+
+namespace {
+
+constexpr size_t NO_CONFIG = SIZE_MAX;     // TraceRecorder::_configAt
+constexpr size_t UART_CHUNK = 48;           // Bytes per U record
+
+} // namespace
+
+// ============================================================================
+// TraceRecorder
+// ============================================================================
+
+TraceRecorder& TraceRecorder::getInstance() {
+    static TraceRecorder instance;
+    return instance;
+}
+
+TraceRecorder::TraceRecorder()
+    : _sd(nullptr)
+    , _recording(false)
+    , _used(0)
+    , _configAt(NO_CONFIG)
+    , _fileNumber(-1)
+    , _fileBytes(0)
+    , _bytesWritten(0)
+    , _dropped(0)
+    , _lastFlushMs(0)
+{
+}
+
+bool TraceRecorder::begin(SDManager& sd) {
+    if (!sd.isAvailable()) {
+        Serial.println("[Trace] SD card not available - recording disabled");
+        return false;
+    }
+    _sd = &sd;
+    _sd->createDirectory(SD_TRACES_DIR);
+
+    // Continue after the last trace of earlier boots
+    int next = 0;
+    while (next < config::TRACE_MAX_FILES && _sd->fileExists(getFilePath(next).c_str())) {
+        next++;
+    }
+    _fileNumber = next - 1;
+    if (!openNextFile()) {
+        return false;
+    }
+
+    _recording = true;
+    Serial.printf("[Trace] Recording to %s\n", getFilePath(_fileNumber).c_str());
+    return true;
+}
+
+void TraceRecorder::recordConfiguration(const String& json) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _configJson = json;
+    _configJson.replace("\r", " ");     // One record per line
+    _configJson.replace("\n", " ");
+
+    // Written at its place between the buffered records on the next flush
+    if (isRecording() && _configAt == NO_CONFIG) {
+        _configAt = _used;
+    }
+}
+
+void TraceRecorder::recordTick(unsigned long tickMs) {
+    if (!isRecording()) return;
+
+    char record[48];
+    int length = snprintf(record, sizeof(record), "T,%lu,%lu\n", tickMs, millis() - tickMs);
+    append(record, length);
+}
+
+void TraceRecorder::recordReading(int endpointId, const String& measurementType, bool ok,
+                                  double value, uint32_t readUs) {
+    if (!isRecording()) return;
+
+    char record[96];
+    int length = snprintf(record, sizeof(record), "R,%d,%s,%d,%.17g,%lu\n",
+                          endpointId, measurementType.c_str(), ok ? 1 : 0,
+                          ok ? value : 0.0, (unsigned long)readUs);
+    if (length > 0 && (size_t)length < sizeof(record)) {
+        append(record, length);
+    }
+}
+
+void TraceRecorder::recordUart(const char* source, const uint8_t* data, size_t length) {
+    if (!isRecording()) return;
+
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    char record[32 + 2 * UART_CHUNK];
+    unsigned long now = millis();
+
+    for (size_t offset = 0; offset < length; offset += UART_CHUNK) {
+        size_t chunk = length - offset < UART_CHUNK ? length - offset : UART_CHUNK;
+        int pos = snprintf(record, 32, "U,%lu,%s,", now, source);
+        if (pos <= 0 || pos >= 32) return;
+
+        for (size_t i = 0; i < chunk; i++) {
+            record[pos++] = HEX_DIGITS[data[offset + i] >> 4];
+            record[pos++] = HEX_DIGITS[data[offset + i] & 0x0F];
+        }
+        record[pos++] = '\n';
+        append(record, pos);
+    }
+}
+
+void TraceRecorder::append(const char* record, size_t length) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_used + length > config::TRACE_BUFFER_BYTES) {
+        _dropped++;     // Storage task behind; never block the sampling/UART tasks
+        return;
+    }
+    memcpy(_buffer + _used, record, length);
+    _used += length;
+}
+
+void TraceRecorder::loop(unsigned long now) {
+    if (!isRecording() || now - _lastFlushMs < config::TRACE_FLUSH_INTERVAL_MS) {
+        return;
+    }
+    _lastFlushMs = now;
+    flush();
+}
+
+void TraceRecorder::flush() {
+    if (!isRecording()) return;
+
+    String chunk;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_used == 0 && _configAt == NO_CONFIG) {
+            return;
+        }
+
+        chunk.reserve(_used + (_configAt != NO_CONFIG ? _configJson.length() + 3 : 0));
+        _buffer[_used] = '\0';
+        if (_configAt != NO_CONFIG) {
+            char first = _buffer[_configAt];
+            _buffer[_configAt] = '\0';
+            chunk += _buffer;
+            chunk += "C,";
+            chunk += _configJson;
+            chunk += "\n";
+            _buffer[_configAt] = first;
+            chunk += _buffer + _configAt;
+        } else {
+            chunk += _buffer;
+        }
+        _used = 0;
+        _configAt = NO_CONFIG;
+    }
+
+    if (_fileBytes + chunk.length() > config::TRACE_MAX_FILE_BYTES && !openNextFile()) {
+        return;
+    }
+
+    if (!_sd->hasEnoughSpace(SD_MIN_FREE_SPACE + chunk.length()) ||
+        !_sd->appendFile(getFilePath(_fileNumber).c_str(), chunk)) {
+        Serial.println("[Trace] SD write failed or card full - recording stopped");
+        _recording = false;
+        return;
+    }
+    _fileBytes += chunk.length();
+    _bytesWritten += chunk.length();
+}
+
+bool TraceRecorder::openNextFile() {
+    if (++_fileNumber >= config::TRACE_MAX_FILES) {
+        Serial.printf("[Trace] All %d trace files used - delete %s to record again\n",
+                      config::TRACE_MAX_FILES, SD_TRACES_DIR);
+        _recording = false;
+        return false;
+    }
+
+    String header = "#trace v1," FIRMWARE_VERSION "\n";
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_configJson.length() > 0) {
+            header += "C,";
+            header += _configJson;
+            header += "\n";
+        }
+    }
+
+    if (!_sd->writeFile(getFilePath(_fileNumber).c_str(), header)) {
+        Serial.printf("[Trace] Failed to create %s\n", getFilePath(_fileNumber).c_str());
+        _recording = false;
+        return false;
+    }
+    _fileBytes = header.length();
+    return true;
+}
+
+String TraceRecorder::getFilePath(int fileNumber) const {
+    char path[48];
+    snprintf(path, sizeof(path), "%s/trace_%03d.csv", SD_TRACES_DIR, fileNumber);
+    return String(path);
+}
+
+// ============================================================================
+// TraceReplay (native)
+// ============================================================================
+
+#ifdef PLATFORM_NATIVE
+namespace {
+
+/**
+ * Replay sinks: the storage row and the upload body are built as on the
+ * device, the row goes to the output file instead of the SD card and the
+ * body is counted instead of sent.
+ */
+struct ReplaySinks {
+    ApiClient client;
+    FILE* rows = nullptr;
+    std::atomic<uint32_t> stored{0};
+    std::atomic<uint32_t> uploaded{0};
+    std::atomic<uint64_t> uploadBytes{0};
+};
+
+ReplaySinks& replaySinks() {
+    static ReplaySinks sinks;
+    return sinks;
+}
+
+bool storeReplayReading(const PipelineReading& reading) {
+    ReplaySinks& sinks = replaySinks();
+
+    StoredReading row;
+    row.timestamp = reading.getUnixTimestamp();
+    row.sensorType = reading.measurementType;
+    row.value = reading.value;
+    row.unit = reading.unit;
+    row.endpointId = reading.endpointId;
+    row.synced = false;
+    String line = row.toCsv();
+
+    if (sinks.rows) {
+        fprintf(sinks.rows, "%s\n", line.c_str());
+    }
+    sinks.stored++;
+    return true;
+}
+
+bool sendReplayReading(const PipelineReading& reading) {
+    ReplaySinks& sinks = replaySinks();
+
+    JsonDocument doc(&JsonArena::getInstance());
+    sinks.client.buildReadingPayload(doc, reading.measurementType, reading.value, reading.unit,
+                                     reading.endpointId, reading.getUnixTimestamp());
+    String body;
+    serializeJson(doc, body);
+
+    sinks.uploadBytes += body.length();
+    sinks.uploaded++;
+    return true;
+}
+
+bool queueSettled(const QueueMetrics& metrics) {
+    return metrics.delivered + metrics.failed + metrics.dropped >= metrics.enqueued;
+}
+
+void stripLineEnd(char* line) {
+    size_t length = strlen(line);
+    while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+        line[--length] = '\0';
+    }
+}
+
+} // namespace
+
+TraceReplay& TraceReplay::getInstance() {
+    static TraceReplay instance;
+    return instance;
+}
+
+TraceReplay::TraceReplay()
+    : _active(false)
+    , _speed(0)
+    , _ticks(0)
+    , _configs(0)
+    , _reads(0)
+    , _failedReads(0)
+    , _missingReads(0)
+    , _unusedReads(0)
+    , _uartBytes(0)
+    , _gpsSentences(0)
+    , _sr04m2Frames(0)
+    , _maxLateMs(0)
+    , _firstTickMs(0)
+    , _lastTickMs(0)
+{
+}
+
+std::string TraceReplay::key(int endpointId, const char* measurementType) {
+    return std::to_string(endpointId) + "/" + measurementType;
+}
+
+bool TraceReplay::nextValue(int endpointId, const String& measurementType, double& value) {
+    auto it = _pending.find(key(endpointId, measurementType.c_str()));
+    if (it == _pending.end() || it->second.empty()) {
+        _missingReads++;
+        return false;
+    }
+
+    RecordedRead read = it->second.front();
+    it->second.pop_front();
+    _reads++;
+
+    // Field read duration (sensor conversion time, I2C clock stretching, ...)
+    if (_speed > 0 && read.readUs > 0) {
+        delayMicroseconds((unsigned int)(read.readUs / _speed));
+    }
+
+    if (!read.ok) {
+        _failedReads++;
+        return false;
+    }
+    value = read.value;
+    return true;
+}
+
+void TraceReplay::finishTick(unsigned long tickMs, const Hooks& hooks) {
+    if (_speed > 0 && _ticks > 0 && tickMs > _lastTickMs) {
+        delay((unsigned long)((tickMs - _lastTickMs) / _speed));
+    }
+    if (_ticks == 0) _firstTickMs = tickMs;
+    _lastTickMs = tickMs;
+    _ticks++;
+
+    hooks.runTick(tickMs);
+
+    // Reads the firmware did not ask for (e.g. sensor due in the field but not in the replay)
+    for (auto& entry : _pending) {
+        _unusedReads += entry.second.size();
+        entry.second.clear();
+    }
+
+    // Keep the queues below half full instead of measuring overflow drops
+    ReadingPipeline& pipeline = ReadingPipeline::getInstance();
+    while (pipeline.getStorageMetrics().depth * 2 >= pipeline.getStorageMetrics().capacity ||
+           pipeline.getNetworkMetrics().depth * 2 >= pipeline.getNetworkMetrics().capacity) {
+        delay(1);
+    }
+}
+
+void TraceReplay::replayUart(const char* source, const char* hex, const char* outputPath) {
+    FILE* file = nullptr;
+    if (outputPath) {
+        auto it = _uartFiles.find(source);
+        if (it == _uartFiles.end()) {
+            std::string uartPath = std::string(outputPath) + "." + source;
+            it = _uartFiles.emplace(source, fopen(uartPath.c_str(), "wb")).first;
+        }
+        file = it->second;
+    }
+
+    bool gps = strcmp(source, "gps") == 0;
+    bool sr04m2 = strcmp(source, "sr04m2") == 0;
+    uint8_t data[UART_CHUNK];
+
+    while (hex[0] && hex[1]) {
+        size_t length = 0;
+        for (; hex[0] && hex[1] && length < sizeof(data); hex += 2) {
+            char byteHex[3] = {hex[0], hex[1], '\0'};
+            data[length++] = (uint8_t)strtoul(byteHex, nullptr, 16);
+        }
+        _uartBytes += length;
+        if (file) fwrite(data, 1, length, file);
+
+        // Same decoders as the GPS and SR04M-2 tasks in the field
+        if (gps) {
+            _gpsSentences += GpsIngestion::getInstance().encode(data, length);
+        } else if (sr04m2) {
+            _sr04m2Frames += Sr04m2Decoder::getInstance().decode(data, length);
+        }
+    }
+}
+
+bool TraceReplay::run(const char* path, double speed, const char* outputPath, const Hooks& hooks) {
+    FILE* trace = fopen(path, "r");
+    if (!trace) {
+        Serial.printf("[Trace] Cannot open %s\n", path);
+        return false;
+    }
+
+    ReplaySinks& sinks = replaySinks();
+    sinks.client.configure("http://trace-replay.invalid", "trace-replay", "");
+    if (outputPath) {
+        sinks.rows = fopen(outputPath, "w");
+        if (!sinks.rows) {
+            Serial.printf("[Trace] Cannot write %s\n", outputPath);
+        }
+    }
+
+    // Sampling runs here; the pipeline only carries the readings to the sinks
+    ReadingPipeline& pipeline = ReadingPipeline::getInstance();
+    if (!pipeline.begin([](unsigned long) -> uint32_t { return config::PIPELINE_SAMPLER_MAX_WAIT_MS; },
+                        storeReplayReading, sendReplayReading)) {
+        fclose(trace);
+        return false;
+    }
+
+    _active = true;
+    _speed = speed;
+    Sr04m2Decoder::getInstance().reset();
+    Serial.printf("[Trace] Replaying %s (speed %s)\n", path, speed > 0 ? String(speed).c_str() : "max");
+
+    auto start = std::chrono::steady_clock::now();
+    bool tickOpen = false;
+    unsigned long tickMs = 0;
+    uint32_t lineNumber = 0;
+    uint32_t malformed = 0;
+    char* line = nullptr;
+    size_t capacity = 0;
+
+    while (getline(&line, &capacity, trace) > 0) {
+        lineNumber++;
+        stripLineEnd(line);
+
+        switch (line[0]) {
+            case '#':
+                if (lineNumber == 1 && strncmp(line, "#trace v1", 9) != 0) {
+                    Serial.printf("[Trace] Unknown trace version: %s\n", line);
+                }
+                break;
+
+            case 'C':
+                if (tickOpen) finishTick(tickMs, hooks);
+                tickOpen = false;
+                if (hooks.applyConfiguration(String(line + 2))) {
+                    _configs++;
+                } else {
+                    Serial.printf("[Trace] Line %lu: configuration rejected\n", (unsigned long)lineNumber);
+                }
+                break;
+
+            case 'T': {
+                unsigned long nextTickMs = 0;
+                unsigned long lateMs = 0;
+                if (sscanf(line, "T,%lu,%lu", &nextTickMs, &lateMs) < 1) {
+                    malformed++;
+                    break;
+                }
+                if (tickOpen) finishTick(tickMs, hooks);
+                tickOpen = true;
+                tickMs = nextTickMs;
+                if (lateMs > _maxLateMs) _maxLateMs = (uint32_t)lateMs;
+                break;
+            }
+
+            case 'R': {
+                int endpointId = 0;
+                char type[32];
+                int ok = 0;
+                RecordedRead read;
+                unsigned long readUs = 0;
+                if (sscanf(line, "R,%d,%31[^,],%d,%lf,%lu", &endpointId, type, &ok, &read.value, &readUs) != 5) {
+                    malformed++;
+                    break;
+                }
+                read.ok = ok != 0;
+                read.readUs = (uint32_t)readUs;
+                _pending[key(endpointId, type)].push_back(read);
+                break;
+            }
+
+            case 'U': {
+                unsigned long ms = 0;
+                char source[16];
+                int hexStart = 0;
+                if (sscanf(line, "U,%lu,%15[^,],%n", &ms, source, &hexStart) < 2 || hexStart == 0) {
+                    malformed++;
+                    break;
+                }
+                replayUart(source, line + hexStart, outputPath);
+                break;
+            }
+
+            default:
+                if (line[0] != '\0') malformed++;
+                break;
+        }
+    }
+    if (tickOpen) finishTick(tickMs, hooks);
+    free(line);
+    fclose(trace);
+
+    // Let the sinks drain the queues
+    while (!queueSettled(pipeline.getStorageMetrics()) || !queueSettled(pipeline.getNetworkMetrics())) {
+        delay(1);
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double fieldSeconds = _ticks > 1 ? (_lastTickMs - _firstTickMs) / 1000.0 : 0;
+
+    if (sinks.rows) fclose(sinks.rows);
+    for (auto& entry : _uartFiles) {
+        if (entry.second) fclose(entry.second);
+    }
+    _active = false;
+
+    QueueMetrics storage = pipeline.getStorageMetrics();
+    QueueMetrics network = pipeline.getNetworkMetrics();
+    Serial.println("[Trace] ========================================");
+    Serial.printf("[Trace] %lu ticks, %lu configurations, %.1f s field time in %.3f s (%.0fx)\n",
+                  (unsigned long)_ticks, (unsigned long)_configs, fieldSeconds, wallSeconds,
+                  wallSeconds > 0 ? fieldSeconds / wallSeconds : 0.0);
+    Serial.printf("[Trace] Reads: %lu replayed (%lu failed in the field), %lu not in trace, %lu unused\n",
+                  (unsigned long)_reads, (unsigned long)_failedReads,
+                  (unsigned long)_missingReads, (unsigned long)_unusedReads);
+    Serial.printf("[Trace] Field sampling lateness: max %lu ms\n", (unsigned long)_maxLateMs);
+    Serial.printf("[Trace] Storage: %lu rows (%lu dropped), upload: %lu bodies, %llu bytes (%lu dropped)\n",
+                  (unsigned long)sinks.stored.load(), (unsigned long)storage.dropped,
+                  (unsigned long)sinks.uploaded.load(), (unsigned long long)sinks.uploadBytes.load(),
+                  (unsigned long)network.dropped);
+    if (_uartBytes > 0) {
+        Serial.printf("[Trace] UART: %lu bytes%s\n", (unsigned long)_uartBytes,
+                      outputPath ? " exported" : "");
+    }
+    GpsSnapshot gps = GpsIngestion::getInstance().getSnapshot();
+    if (gps.charsProcessed > 0) {
+        Serial.printf("[Trace] GPS: %lu sentences (%lu with fix, %lu checksum errors), last fix %s\n",
+                      (unsigned long)_gpsSentences, (unsigned long)gps.sentencesWithFix,
+                      (unsigned long)gps.failedChecksums,
+                      gps.locationValid ? (String(gps.latitude, 6) + "," + String(gps.longitude, 6) +
+                                           " (" + String(gps.satellites) + " satellites)").c_str()
+                                        : "none");
+    }
+    Sr04m2Snapshot sr04m2 = Sr04m2Decoder::getInstance().getSnapshot();
+    if (sr04m2.bytesReceived > 0) {
+        Serial.printf("[Trace] SR04M-2: %lu frames (%lu valid, %lu checksum errors, %lu out of range, "
+                      "%lu bytes discarded), median %u mm\n",
+                      (unsigned long)_sr04m2Frames, (unsigned long)sr04m2.framesValid,
+                      (unsigned long)sr04m2.checksumErrors, (unsigned long)sr04m2.outOfRange,
+                      (unsigned long)sr04m2.bytesDiscarded, (unsigned)sr04m2.distanceMm);
+    }
+    if (malformed > 0) {
+        Serial.printf("[Trace] %lu malformed lines skipped\n", (unsigned long)malformed);
+    }
+    Serial.println("[Trace] ========================================");
+
+    return _ticks > 0;
+}
+#endif // PLATFORM_NATIVE
@@ -0,0 +1,296 @@
+/**
+ * myIoTGrid.Sensor - SR04M-2 UART Frame Decoder Implementation
+ */
+
+#include "sr04m2_decoder.h"
+#include "uart_manager.h"
+#include "sensor_trace.h"
+#include <cstring>
+
+namespace {
+
+constexpr uint8_t FRAME_HEADER1 = 0xFF;
+constexpr uint8_t FRAME_HEADER2 = 0xFE;
+constexpr uint16_t MIN_DISTANCE_MM = 200;   // 20 cm
+constexpr uint16_t MAX_DISTANCE_MM = 7500;  // 750 cm
+
+} // namespace
+
+Sr04m2Decoder& Sr04m2Decoder::getInstance() {
+    static Sr04m2Decoder instance;
+    return instance;
+}
+
+Sr04m2Decoder::Sr04m2Decoder()
+    : _state(ParseState::HEADER1)
+    , _distHigh(0)
+    , _distLow(0)
+    , _sum(0)
+    , _windowCount(0)
+    , _windowHead(0)
+    , _sequence(0)
+{
+#ifdef PLATFORM_ESP32
+    _port = UART_NUM_2;
+    _eventQueue = nullptr;
+    _task = nullptr;
+    _stopRequested = false;
+#endif
+    memset(_window, 0, sizeof(_window));
+    memset(&_working, 0, sizeof(_working));
+    memset(&_snapshot, 0, sizeof(_snapshot));
+}
+
+Sr04m2Decoder::~Sr04m2Decoder() {
+#ifdef PLATFORM_ESP32
+    stop();
+#endif
+}
+
+void Sr04m2Decoder::reset() {
+    _state = ParseState::HEADER1;
+    _windowCount = 0;
+    _windowHead = 0;
+    memset(&_working, 0, sizeof(_working));
+    _working.startedAtMs = millis();
+    publish();
+}
+
+uint32_t Sr04m2Decoder::decode(const uint8_t* data, size_t length) {
+    uint32_t frames = 0;
+    _working.bytesReceived += length;
+    for (size_t i = 0; i < length; i++) {
+        if (feed(data[i])) frames++;
+    }
+    if (frames > 0) publish();
+    return frames;
+}
+
+#ifdef PLATFORM_ESP32
+
+bool Sr04m2Decoder::start(int uartNum) {
+    QueueHandle_t queue = UARTManager::getInstance().getEventQueue(uartNum);
+    if (!queue) {
+        Serial.printf("[SR04M-2] No event queue for UART%d\n", uartNum);
+        return false;
+    }
+
+    uart_port_t port = (uartNum == 1) ? UART_NUM_1 : UART_NUM_2;
+    if (_task && _port == port && _eventQueue == queue) {
+        return true;  // Already running on this UART
+    }
+    stop();
+
+    _port = port;
+    _eventQueue = queue;
+    _stopRequested = false;
+
+    // Fresh statistics and filter for the new session
+    reset();
+
+    uart_flush_input(_port);
+    xQueueReset(_eventQueue);
+
+    BaseType_t created = xTaskCreate(
+        taskEntry,
+        "sr04m2_dec",
+        config::SR04M2_TASK_STACK_SIZE,
+        this,
+        config::SR04M2_TASK_PRIORITY,
+        &_task
+    );
+
+    if (created != pdPASS) {
+        Serial.println("[SR04M-2] Failed to create decoder task!");
+        _task = nullptr;
+        _eventQueue = nullptr;
+        return false;
+    }
+
+    Serial.printf("[SR04M-2] Frame decoder started on UART%d\n", uartNum);
+    return true;
+}
+
+void Sr04m2Decoder::stop() {
+    if (!_task) return;
+
+    _stopRequested = true;
+
+    // Task polls the stop flag between queue waits
+    uint32_t start = millis();
+    while (_task && millis() - start < 500) {
+        delay(5);
+    }
+
+    if (_task) {
+        Serial.println("[SR04M-2] Decoder task did not stop, deleting");
+        vTaskDelete(_task);
+        _task = nullptr;
+    }
+
+    _eventQueue = nullptr;
+    Serial.println("[SR04M-2] Frame decoder stopped");
+}
+
+bool Sr04m2Decoder::isRunningOn(int uartNum) const {
+    uart_port_t port = (uartNum == 1) ? UART_NUM_1 : UART_NUM_2;
+    return _task != nullptr && _port == port;
+}
+#endif // PLATFORM_ESP32
+
+Sr04m2Snapshot Sr04m2Decoder::getSnapshot() const {
+    Sr04m2Snapshot copy;
+    uint32_t before, after;
+
+    do {
+        before = _sequence.load(std::memory_order_acquire);
+        memcpy(&copy, (const void*)&_snapshot, sizeof(copy));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = _sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    return copy;
+}
+
+#ifdef PLATFORM_ESP32
+void Sr04m2Decoder::taskEntry(void* param) {
+    static_cast<Sr04m2Decoder*>(param)->run();
+}
+
+void Sr04m2Decoder::run() {
+    uart_event_t event;
+    uint8_t buffer[64];
+
+    while (!_stopRequested) {
+        if (xQueueReceive(_eventQueue, &event, pdMS_TO_TICKS(100)) != pdTRUE) {
+            continue;
+        }
+
+        switch (event.type) {
+            case UART_DATA: {
+                size_t remaining = event.size;
+                while (remaining > 0) {
+                    size_t chunk = remaining < sizeof(buffer) ? remaining : sizeof(buffer);
+                    int len = uart_read_bytes(_port, buffer, chunk, 0);
+                    if (len <= 0) break;
+
+                    TraceRecorder::getInstance().recordUart("sr04m2", buffer, len);
+                    decode(buffer, len);
+                    remaining -= len;
+                }
+                break;
+            }
+
+            case UART_FIFO_OVF:
+            case UART_BUFFER_FULL:
+                // Data lost, resynchronize on next header
+                uart_flush_input(_port);
+                xQueueReset(_eventQueue);
+                _state = ParseState::HEADER1;
+                _working.overflows++;
+                publish();
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    _task = nullptr;
+    vTaskDelete(NULL);
+}
+#endif // PLATFORM_ESP32
+
+bool Sr04m2Decoder::feed(uint8_t byte) {
+    switch (_state) {
+        case ParseState::HEADER1:
+            if (byte == FRAME_HEADER1) {
+                _state = ParseState::HEADER2;
+            } else {
+                _working.bytesDiscarded++;
+            }
+            return false;
+
+        case ParseState::HEADER2:
+            if (byte == FRAME_HEADER2) {
+                _state = ParseState::DIST_HIGH;
+            } else if (byte != FRAME_HEADER1) {
+                // 0xFF 0xFF keeps us waiting for 0xFE
+                _working.bytesDiscarded += 2;
+                _state = ParseState::HEADER1;
+            } else {
+                _working.bytesDiscarded++;
+            }
+            return false;
+
+        case ParseState::DIST_HIGH:
+            _distHigh = byte;
+            _sum = byte;
+            _state = ParseState::DIST_LOW;
+            return false;
+
+        case ParseState::DIST_LOW:
+            _distLow = byte;
+            _sum += byte;
+            _state = ParseState::CHECKSUM;
+            return false;
+
+        case ParseState::CHECKSUM:
+            _state = ParseState::HEADER1;
+            if (byte != _sum) {
+                _working.checksumErrors++;
+                _working.lastStatus = Sr04m2FrameStatus::CHECKSUM_ERROR;
+                return true;
+            }
+            onFrame(((uint16_t)_distHigh << 8) | _distLow);
+            return true;
+    }
+
+    return false;
+}
+
+void Sr04m2Decoder::onFrame(uint16_t distanceMm) {
+    _working.lastRawMm = distanceMm;
+
+    // Valid range is 20-750 cm for SR04M-2
+    if (distanceMm < MIN_DISTANCE_MM || distanceMm > MAX_DISTANCE_MM) {
+        _working.outOfRange++;
+        _working.lastStatus = Sr04m2FrameStatus::OUT_OF_RANGE;
+        return;
+    }
+
+    _window[_windowHead] = distanceMm;
+    _windowHead = (_windowHead + 1) % config::SR04M2_MEDIAN_WINDOW;
+    if (_windowCount < config::SR04M2_MEDIAN_WINDOW) _windowCount++;
+
+    _working.framesValid++;
+    _working.lastStatus = Sr04m2FrameStatus::OK;
+    _working.distanceMm = median();
+    _working.updatedAtMs = millis();
+}
+
+uint16_t Sr04m2Decoder::median() const {
+    uint16_t sorted[config::SR04M2_MEDIAN_WINDOW];
+    memcpy(sorted, _window, _windowCount * sizeof(uint16_t));
+
+    // Insertion sort, window is tiny
+    for (size_t i = 1; i < _windowCount; i++) {
+        uint16_t v = sorted[i];
+        size_t j = i;
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+
+    return sorted[_windowCount / 2];
+}
+
+void Sr04m2Decoder::publish() {
+    uint32_t seq = _sequence.load(std::memory_order_relaxed);
+    _sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy((void*)&_snapshot, &_working, sizeof(_working));
+    _sequence.store(seq + 2, std::memory_order_release);
+}
@@ -0,0 +1,152 @@
+/**
+ * myIoTGrid.Sensor - Sync Batch Sizer Implementation
+ */
+
+#include "batch_sizer.h"
+#include "config.h"
+#include "json_arena.h"
+#include <ArduinoJson.h>
+#ifdef PLATFORM_NATIVE
+#include "ArduinoJsonString.h"
+#endif
+
+BatchSizer::BatchSizer()
+    : _window(config::SYNC_BATCH_MIN)
+    , _ceiling(0)
+    , _lastSize(0)
+    , _lastLimit(BatchLimit::WINDOW)
+    , _rttEwmaMs(0)
+    , _rttBaselineMs(0)
+    , _rttBaselineSize(0)
+    , _throughput(0)
+    , _batches(0)
+    , _increases(0)
+    , _decreases(0)
+    , _rejected413(0)
+    , _minSize(0)
+    , _maxSize(0)
+{
+}
+
+void BatchSizer::reset(int initialSize) {
+    _window = initialSize;
+    if (_window < config::SYNC_BATCH_MIN) _window = config::SYNC_BATCH_MIN;
+    if (_window > config::SYNC_BATCH_MAX) _window = config::SYNC_BATCH_MAX;
+}
+
+int BatchSizer::nextSize(uint32_t freeHeap, int rssi, int slots, bool drain) {
+    int size = drain ? config::SYNC_BATCH_MAX : _window;
+    BatchLimit limit = drain ? BatchLimit::MAX : BatchLimit::WINDOW;
+
+    if (size > config::SYNC_BATCH_MAX) {
+        size = config::SYNC_BATCH_MAX;
+        limit = BatchLimit::MAX;
+    }
+
+    if (_ceiling > 0 && size > _ceiling) {
+        size = _ceiling;
+        limit = BatchLimit::CEILING;
+    }
+
+    if (rssi > -100 && rssi < config::SYNC_WEAK_RSSI_DBM && size > config::SYNC_WEAK_LINK_MAX_BATCH) {
+        size = config::SYNC_WEAK_LINK_MAX_BATCH;
+        limit = BatchLimit::RSSI;
+    }
+
+    // All read-ahead slots together stay within a share of the free heap
+    uint32_t heapBudget = freeHeap / 100 * config::SYNC_BATCH_HEAP_PERCENT;
+    int heapMax = (int)(heapBudget / (config::SYNC_READING_HEAP_BYTES * (slots > 0 ? slots : 1)));
+    if (size > heapMax) {
+        size = heapMax;
+        limit = BatchLimit::HEAP;
+    }
+
+    if (size < config::SYNC_BATCH_MIN) {
+        size = config::SYNC_BATCH_MIN;
+        limit = BatchLimit::MIN;
+    }
+
+    _lastSize = size;
+    _lastLimit = limit;
+    if (_minSize == 0 || size < _minSize) _minSize = size;
+    if (size > _maxSize) _maxSize = size;
+    return size;
+}
+
+void BatchSizer::onBatchResult(int requested, int synced, uint32_t durationMs, int statusCode) {
+    if (requested <= 0) return;
+    _batches++;
+
+    // Request time per reading and throughput (accepted batches only)
+    float rttMs = 0;
+    if (synced > 0 && durationMs > 0) {
+        rttMs = (float)durationMs / synced;
+        _rttEwmaMs = _rttEwmaMs <= 0 ? rttMs
+                   : config::SYNC_BATCH_RTT_EWMA_ALPHA * rttMs + (1 - config::SYNC_BATCH_RTT_EWMA_ALPHA) * _rttEwmaMs;
+        if (_rttBaselineMs <= 0 || rttMs < _rttBaselineMs) {
+            _rttBaselineMs = rttMs;
+            _rttBaselineSize = synced;
+        }
+
+        float throughput = synced * 1000.0f / durationMs;
+        _throughput = _throughput <= 0 ? throughput
+                    : config::SYNC_BATCH_RTT_EWMA_ALPHA * throughput + (1 - config::SYNC_BATCH_RTT_EWMA_ALPHA) * _throughput;
+    }
+
+    if (statusCode == 413) {
+        // Hub limit: stay below the rejected size from now on
+        _rejected413++;
+        _ceiling = requested / 2;
+        if (_ceiling < config::SYNC_BATCH_MIN) _ceiling = config::SYNC_BATCH_MIN;
+    }
+
+    // Time per reading falls as the request overhead spreads over more readings,
+    // so it only says "link got slower" at the baseline size or above
+    bool slow = durationMs > config::SYNC_BATCH_TARGET_MS ||
+                (rttMs > 0 && synced >= _rttBaselineSize &&
+                 rttMs > _rttBaselineMs * config::SYNC_BATCH_RTT_SLOWDOWN);
+
+    if (synced < requested || slow) {
+        // Multiplicative decrease
+        _window = requested / 2;
+        if (_window < config::SYNC_BATCH_MIN) _window = config::SYNC_BATCH_MIN;
+        _decreases++;
+    } else if (requested >= _window) {
+        // Additive increase (only if the window was actually used)
+        _window += config::SYNC_BATCH_ADDITIVE_STEP;
+        if (_window > config::SYNC_BATCH_MAX) _window = config::SYNC_BATCH_MAX;
+        _increases++;
+    }
+}
+
+const char* BatchSizer::getLimitString(BatchLimit limit) {
+    switch (limit) {
+        case BatchLimit::WINDOW: return "window";
+        case BatchLimit::MIN: return "min";
+        case BatchLimit::MAX: return "max";
+        case BatchLimit::HEAP: return "heap";
+        case BatchLimit::RSSI: return "rssi";
+        case BatchLimit::CEILING: return "413";
+        default: return "unknown";
+    }
+}
+
+String BatchSizer::getStatsJson() const {
+    JsonDocument doc(&JsonArena::getInstance());
+    doc["batchWindow"] = _window;
+    doc["batchSize"] = _lastSize;
+    doc["batchLimit"] = getLimitString(_lastLimit);
+    doc["batchMin"] = _minSize;
+    doc["batchMax"] = _maxSize;
+    doc["batchCeiling"] = _ceiling;
+    doc["batches"] = _batches;
+    doc["increases"] = _increases;
+    doc["decreases"] = _decreases;
+    doc["rejected413"] = _rejected413;
+    doc["rttMs"] = (uint32_t)(_rttEwmaMs + 0.5f);
+    doc["readingsPerSecond"] = (int)(_throughput * 100 + 0.5f) / 100.0;
+
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
@@ -0,0 +1,96 @@
+/**
+ * myIoTGrid.Sensor - Sync Batch Sizer
+ *
+ * Adapts the number of readings per sync batch AIMD-style:
+ *
+ *   clean batch, fast enough       size += SYNC_BATCH_ADDITIVE_STEP
+ *   failure, slow batch, RTT rise  size /= 2
+ *   HTTP 413                       size /= 2, and never above that again
+ *
+ * A batch is one /api/readings/batch request. "Slow" means the request took
+ * longer than SYNC_BATCH_TARGET_MS; "RTT rise" means its time per reading
+ * exceeds the best one seen at the same or a smaller size (smaller batches
+ * spread the fixed request overhead over fewer readings and are not compared).
+ *
+ * On top of that, every batch is bounded by SYNC_BATCH_MIN/MAX, the free
+ * heap (all read-ahead slots together) and a cap for weak WiFi links.
+ * Part of Sprint OS-01: Offline-Speicher Implementation
+ */
+
+#ifndef BATCH_SIZER_H
+#define BATCH_SIZER_H
+
+#include <Arduino.h>
+
+/**
+ * What limited the last chosen batch size
+ */
+enum class BatchLimit : uint8_t {
+    WINDOW,         // AIMD window itself
+    MIN,            // SYNC_BATCH_MIN
+    MAX,            // SYNC_BATCH_MAX
+    HEAP,           // Free heap
+    RSSI,           // Weak WiFi link
+    CEILING         // Hub rejected a larger batch (413)
+};
+
+/**
+ * Batch Sizer - AIMD batch size for SyncManager
+ */
+class BatchSizer {
+public:
+    BatchSizer();
+
+    /**
+     * Start value of the window (StorageConfig::batchSize)
+     */
+    void reset(int initialSize);
+
+    /**
+     * Batch size for the next read
+     * @param freeHeap free heap in bytes
+     * @param rssi WiFi RSSI in dBm (<= -100 = unknown)
+     * @param slots batches held at the same time (pipeline depth)
+     * @param drain use the largest allowed size instead of the window (forced sync)
+     */
+    int nextSize(uint32_t freeHeap, int rssi, int slots, bool drain);
+
+    /**
+     * Feed back the result of an uploaded batch
+     * @param requested readings in the batch
+     * @param synced readings the Hub accepted
+     * @param durationMs upload time of the batch
+     * @param statusCode HTTP status of the failing request (0 = none)
+     */
+    void onBatchResult(int requested, int synced, uint32_t durationMs, int statusCode);
+
+    int getWindow() const { return _window; }
+    int getLastSize() const { return _lastSize; }
+
+    /**
+     * Chosen sizes, limits and throughput as JSON object
+     */
+    String getStatsJson() const;
+
+    static const char* getLimitString(BatchLimit limit);
+
+private:
+    int _window;                // AIMD window (readings)
+    int _ceiling;               // After 413 (0 = none)
+    int _lastSize;
+    BatchLimit _lastLimit;
+
+    float _rttEwmaMs;           // Request time per reading
+    float _rttBaselineMs;       // Lowest time per reading seen (0 = none yet)
+    int _rttBaselineSize;       // Batch size of that measurement
+    float _throughput;          // Readings per second (EWMA)
+
+    unsigned long _batches;
+    unsigned long _increases;
+    unsigned long _decreases;
+    unsigned long _rejected413;
+    int _minSize;               // Smallest / largest size handed out
+    int _maxSize;
+};
+
+#endif // BATCH_SIZER_H
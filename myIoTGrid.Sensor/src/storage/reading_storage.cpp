@@ -3,6 +3,8 @@
  */
 
 #include "reading_storage.h"
+#include "metrics.h"
+#include "json_arena.h"
 #include <ArduinoJson.h>
 #ifdef PLATFORM_NATIVE
 #include "ArduinoJsonString.h"
@@ -13,7 +15,13 @@ ReadingStorage::ReadingStorage()
     : _sdManager(nullptr)
     , _configManager(nullptr)
     , _lastFlush(0)
+    , _activeSeq(0)
+    , _activeSegmentBytes(0)
+    , _activeSegmentOpenedMs(0)
+    , _cursorOffset(0)
+    , _layoutVersion(0)
 {
+    _statusBuffer.reserve(config::SYNC_STATUS_BUFFER_SIZE);
 }
 
 bool ReadingStorage::init(SDManager& sdManager, StorageConfigManager& configManager) {
@@ -25,9 +33,13 @@ bool ReadingStorage::init(SDManager& sdManager, StorageConfigManager& configMana
         return false;
     }
 
-    // Load sync status
+    // Load sync status (including the sync cursor)
     loadSyncStatus();
 
+    // Continue today's last segment, seal what a previous run finished
+    resumeActiveSegment();
+    sealSyncedSegments();
+
     // Update pending count
     updatePendingCount();
 
@@ -54,15 +66,19 @@ bool ReadingStorage::storeReading(const StoredReading& reading) {
         }
     }
 
-    // Get filename for today
-    String filename = getTodayFilename();
-
-    // Append reading to file
+    // Append reading to the active segment
+    String filename = ensureSegment();
     String line = reading.toCsv() + "\n";
-    if (!_sdManager->appendFile(filename.c_str(), line)) {
+    unsigned long appendStart = micros();
+    bool appended = _sdManager->appendFile(filename.c_str(), line);
+    metrics::observe(metrics::Histogram::SD_APPEND_US, (uint32_t)(micros() - appendStart));
+    if (!appended) {
+        metrics::inc(metrics::Counter::SD_APPEND_ERRORS);
         Serial.printf("[ReadingStorage] Failed to write to %s\n", filename.c_str());
         return false;
     }
+    metrics::inc(metrics::Counter::SD_APPENDS);
+    _activeSegmentBytes += line.length();
 
     // Update status
     _syncStatus.totalReadings++;
@@ -83,9 +99,9 @@ bool ReadingStorage::storeReading(const StoredReading& reading) {
 }
 
 bool ReadingStorage::storeReading(const String& sensorType, double value,
-                                  const String& unit, int endpointId) {
+                                  const String& unit, int endpointId, unsigned long timestamp) {
     StoredReading reading;
-    reading.timestamp = time(nullptr); // Unix timestamp
+    reading.timestamp = timestamp > 0 ? timestamp : time(nullptr); // Unix timestamp
     reading.sensorType = sensorType;
     reading.value = value;
     reading.unit = unit;
@@ -96,69 +112,104 @@ bool ReadingStorage::storeReading(const String& sensorType, double value,
 }
 
 std::vector<StoredReading> ReadingStorage::getPendingReadings(int maxCount) {
-    std::vector<StoredReading> pendingReadings;
+    _lastBatch = PendingBatch();
+    readPendingBatch(maxCount, nullptr, _lastBatch);
+    return _lastBatch.readings;
+}
 
-    if (!_sdManager || !_sdManager->isAvailable()) {
-        return pendingReadings;
-    }
+int ReadingStorage::markAsSynced(const std::vector<StoredReading>& readings) {
+    int markedCount = acknowledgeBatch(_lastBatch, readings.size());
+    _lastBatch = PendingBatch();
+    return markedCount;
+}
 
-    // First check for pending batch files
-    std::vector<String> batchFiles = getPendingBatchFiles();
-    if (!batchFiles.empty()) {
-        // Read from first batch file
-        return readBatchFile(batchFiles[0]);
+void ReadingStorage::readPendingBatch(int maxCount, const PendingBatch* after, PendingBatch& batch) {
+    batch.layoutVersion = _layoutVersion;
+
+    if (!_sdManager || !_sdManager->isAvailable() || maxCount <= 0) {
+        return;
+    }
+    if (after && after->layoutVersion != _layoutVersion) {
+        return;  // Segments changed under the read-ahead, continue after the next ack
     }
 
-    // Otherwise scan CSV files for unsynced readings
-    _sdManager->listDirectory(SD_READINGS_DIR, [&](const String& name, size_t size, bool isDir) {
-        if (isDir) return;
-        if (!name.endsWith(".csv")) return;
-        if (name.endsWith("_synced.csv")) return; // Skip synced files
+    // Pending batch files first (oldest first)
+    if (!after || after->batchFile.length() > 0) {
+        for (const String& batchFile : getPendingBatchFiles()) {
+            if (after && strcmp(batchFile.c_str(), after->batchFile.c_str()) <= 0) continue;
 
-        if ((int)pendingReadings.size() >= maxCount) return;
+            batch.readings = readBatchFile(batchFile);
+            batch.batchFile = batchFile;
+            return;
+        }
+    }
 
-        String filepath = String(SD_READINGS_DIR) + "/" + name;
-        String content = _sdManager->readFile(filepath.c_str());
+    // Then the segments, at the sync cursor or behind the batch in flight
+    String startKey;
+    uint32_t startOffset = 0;
+    if (after && after->batchFile.length() == 0 && after->scanEnd.path.length() > 0) {
+        int slash = after->scanEnd.path.lastIndexOf('/');
+        startKey = segmentKey(after->scanEnd.path.substring(slash + 1));
+        startOffset = after->scanEnd.offset;
+    }
 
-        int startIdx = 0;
-        while (startIdx < (int)content.length() && (int)pendingReadings.size() < maxCount) {
-            int endIdx = content.indexOf('\n', startIdx);
-            if (endIdx < 0) endIdx = content.length();
+    for (const SegmentInfo& segment : listSegments()) {
+        if (segment.sealed) continue;
 
-            String line = content.substring(startIdx, endIdx);
-            line.trim();
+        uint32_t offset = getSyncedOffset(segment);
+        if (startKey.length() > 0) {
+            int position = strcmp(segmentKey(segment.name).c_str(), startKey.c_str());
+            if (position < 0) continue;
+            if (position == 0 && startOffset > offset) offset = startOffset;
+        }
+        if (offset >= segment.size) continue;
 
-            if (line.length() > 0) {
-                StoredReading reading = StoredReading::fromCsv(line);
-                if (!reading.synced && reading.timestamp > 0) {
-                    pendingReadings.push_back(reading);
-                }
+        scanSegment(segment.path, offset, [&](const StoredReading& reading, uint32_t end) {
+            batch.scanEnd = SegmentPosition{segment.path, end};
+            if (!reading.synced && reading.timestamp > 0) {
+                batch.readings.push_back(reading);
+                batch.ends.push_back(batch.scanEnd);
             }
+            return (int)batch.readings.size() < maxCount;
+        });
 
-            startIdx = endIdx + 1;
-        }
-    });
-
-    return pendingReadings;
+        if ((int)batch.readings.size() >= maxCount) break;
+    }
 }
 
-int ReadingStorage::markAsSynced(const std::vector<StoredReading>& readings) {
-    if (readings.empty()) return 0;
-
-    // For simplicity, we'll create a synced batch file and mark readings
-    // In production, you'd update the original files
+int ReadingStorage::acknowledgeBatch(const PendingBatch& batch, size_t syncedCount) {
+    if (batch.readings.empty() || syncedCount == 0) return 0;
 
-    int markedCount = readings.size();
+    if (syncedCount > batch.readings.size()) {
+        syncedCount = batch.readings.size();
+    }
 
-    _syncStatus.syncedReadings += markedCount;
-    _syncStatus.pendingReadings -= markedCount;
-    if (_syncStatus.pendingReadings < 0) {
-        _syncStatus.pendingReadings = 0;
+    if (batch.batchFile.length() > 0) {
+        // Batch files are only complete or not at all
+        if (syncedCount == batch.readings.size()) {
+            deletePendingBatch(batch.batchFile);
+        }
+    } else if (batch.layoutVersion != _layoutVersion) {
+        Serial.println("[ReadingStorage] Segments changed during sync, readings will be sent again");
+        return 0;
+    } else {
+        // Synced readings are a prefix of the batch; if all of them made it,
+        // skipped lines behind the last one count as done too
+        const SegmentPosition& position = (syncedCount == batch.ends.size())
+                                          ? batch.scanEnd : batch.ends[syncedCount - 1];
+        _cursorSegment = position.path;
+        _cursorOffset = position.offset;
+
+        sealSyncedSegments();
     }
 
+    _syncStatus.syncedReadings += syncedCount;
+    _syncStatus.pendingReadings = _syncStatus.pendingReadings > syncedCount
+                                  ? _syncStatus.pendingReadings - syncedCount : 0;
+
     saveSyncStatus();
 
-    return markedCount;
+    return syncedCount;
 }
 
 void ReadingStorage::recordSyncFailure(const String& error) {
@@ -174,11 +225,7 @@ void ReadingStorage::recordSyncSuccess(int syncedCount) {
     _syncStatus.consecutiveFailures = 0;
     _syncStatus.lastError = "";
     _syncStatus.lastSyncTimestamp = time(nullptr);
-    _syncStatus.syncedReadings += syncedCount;
-    _syncStatus.pendingReadings -= syncedCount;
-    if (_syncStatus.pendingReadings < 0) {
-        _syncStatus.pendingReadings = 0;
-    }
+    // Counts were already moved by acknowledgeBatch()
     saveSyncStatus();
 
     Serial.printf("[ReadingStorage] Sync success: %d readings synced\n", syncedCount);
@@ -189,7 +236,7 @@ bool ReadingStorage::saveSyncStatus() {
         return false;
     }
 
-    JsonDocument doc;
+    JsonDocument doc(&JsonArena::getInstance());
     doc["totalReadings"] = _syncStatus.totalReadings;
     doc["syncedReadings"] = _syncStatus.syncedReadings;
     doc["pendingReadings"] = _syncStatus.pendingReadings;
@@ -197,11 +244,13 @@ bool ReadingStorage::saveSyncStatus() {
     doc["lastReadingTimestamp"] = _syncStatus.lastReadingTimestamp;
     doc["consecutiveFailures"] = _syncStatus.consecutiveFailures;
     doc["lastError"] = _syncStatus.lastError;
+    doc["cursorSegment"] = _cursorSegment;
+    doc["cursorOffset"] = _cursorOffset;
 
-    String content;
-    serializeJsonPretty(doc, content);
+    _statusBuffer = "";
+    serializeJson(doc, _statusBuffer);
 
-    return _sdManager->writeFile(SD_SYNC_STATUS_FILE, content);
+    return _sdManager->writeFile(SD_SYNC_STATUS_FILE, _statusBuffer);
 }
 
 bool ReadingStorage::loadSyncStatus() {
@@ -214,7 +263,7 @@ bool ReadingStorage::loadSyncStatus() {
         return false;
     }
 
-    JsonDocument doc;
+    JsonDocument doc(&JsonArena::getInstance());
     DeserializationError error = deserializeJson(doc, content);
     if (error) {
         Serial.printf("[ReadingStorage] Failed to parse sync status: %s\n", error.c_str());
@@ -228,6 +277,8 @@ bool ReadingStorage::loadSyncStatus() {
     _syncStatus.lastReadingTimestamp = doc["lastReadingTimestamp"] | 0UL;
     _syncStatus.consecutiveFailures = doc["consecutiveFailures"] | 0;
     _syncStatus.lastError = doc["lastError"].as<String>();
+    _cursorSegment = doc["cursorSegment"] | "";
+    _cursorOffset = doc["cursorOffset"] | 0UL;
 
     return true;
 }
@@ -243,7 +294,7 @@ String ReadingStorage::createPendingBatch(const std::vector<StoredReading>& read
              SD_PENDING_DIR, (unsigned long)time(nullptr));
 
     // Create JSON batch
-    JsonDocument doc;
+    JsonDocument doc(&JsonArena::getInstance());
     JsonArray arr = doc.to<JsonArray>();
 
     for (const auto& reading : readings) {
@@ -307,7 +358,7 @@ std::vector<StoredReading> ReadingStorage::readBatchFile(const String& batchFile
         return readings;
     }
 
-    JsonDocument doc;
+    JsonDocument doc(&JsonArena::getInstance());
     DeserializationError error = deserializeJson(doc, content);
     if (error) {
         Serial.printf("[ReadingStorage] Failed to parse batch file: %s\n", error.c_str());
@@ -346,58 +397,236 @@ void ReadingStorage::updatePendingCount() {
         pendingCount += readings.size();
     }
 
-    // Count unsynced readings in CSV files
+    // Count unsynced readings behind the sync cursor
+    for (const SegmentInfo& segment : listSegments()) {
+        if (segment.sealed) continue;
+
+        uint32_t offset = getSyncedOffset(segment);
+        if (offset >= segment.size) continue;
+
+        scanSegment(segment.path, offset, [&](const StoredReading& reading, uint32_t) {
+            if (!reading.synced && reading.timestamp > 0) {
+                pendingCount++;
+            }
+            return true;
+        });
+    }
+
+    _syncStatus.pendingReadings = pendingCount;
+    Serial.printf("[ReadingStorage] Updated pending count: %lu\n", pendingCount);
+}
+
+String ReadingStorage::todayString() {
+    time_t now = time(nullptr);
+    struct tm* timeinfo = localtime(&now);
+
+    char date[16];
+    snprintf(date, sizeof(date), "%04d%02d%02d",
+             timeinfo->tm_year + 1900, timeinfo->tm_mon + 1, timeinfo->tm_mday);
+    return String(date);
+}
+
+String ReadingStorage::ensureSegment() {
+    const StorageConfig& config = _configManager->getConfig();
+    String today = todayString();
+
+    bool rotate = _activeSegment.length() == 0 || _activeDate != today ||
+                  (config.segmentMaxBytes > 0 && _activeSegmentBytes >= config.segmentMaxBytes) ||
+                  (config.segmentMaxSeconds > 0 &&
+                   millis() - _activeSegmentOpenedMs >= config.segmentMaxSeconds * 1000UL);
+    if (!rotate) {
+        return _activeSegment;
+    }
+
+    _activeSeq = (_activeDate == today) ? _activeSeq + 1 : 1;
+    _activeDate = today;
+
+    char filename[64];
+    snprintf(filename, sizeof(filename), "%s/readings_%s_%03d.csv",
+             SD_READINGS_DIR, today.c_str(), _activeSeq);
+    _activeSegment = String(filename);
+    _activeSegmentBytes = 0;
+    _activeSegmentOpenedMs = millis();
+
+    Serial.printf("[ReadingStorage] New segment: %s\n", filename);
+    return _activeSegment;
+}
+
+void ReadingStorage::resumeActiveSegment() {
+    String today = todayString();
+    String prefix = "readings_" + today + "_";
+
+    for (const SegmentInfo& segment : listSegments()) {
+        if (!segment.name.startsWith(prefix.c_str())) continue;
+
+        String key = segmentKey(segment.name);
+        int seq = key.substring(prefix.length()).toInt();
+        if (seq < _activeSeq) continue;
+
+        _activeDate = today;
+        _activeSeq = seq;
+        bool appendable = !segment.sealed && !segment.downsampled &&
+                          segment.size < _configManager->getConfig().segmentMaxBytes;
+        _activeSegment = appendable ? segment.path : String();
+        _activeSegmentBytes = appendable ? segment.size : 0;
+    }
+
+    // Age limit restarts with the boot
+    _activeSegmentOpenedMs = millis();
+    if (_activeSegment.length() > 0) {
+        Serial.printf("[ReadingStorage] Resuming segment: %s (%lu bytes)\n",
+                      _activeSegment.c_str(), (unsigned long)_activeSegmentBytes);
+    }
+}
+
+String ReadingStorage::segmentKey(const String& name) {
+    String key = name;
+    if (key.endsWith(".csv")) key = key.substring(0, key.length() - 4);
+    if (key.endsWith("_synced")) key = key.substring(0, key.length() - 7);
+    if (key.endsWith("_ds")) key = key.substring(0, key.length() - 3);
+    if (key.length() == 17) key += "_000";  // readings_YYYYMMDD (legacy day file)
+    return key;
+}
+
+int ReadingStorage::compareToCursor(const String& name) const {
+    if (_cursorSegment.length() == 0) return 1;  // Nothing synced yet
+
+    int slash = _cursorSegment.lastIndexOf('/');
+    String cursorKey = segmentKey(_cursorSegment.substring(slash + 1));
+    String key = segmentKey(name);
+    if (key == cursorKey) return 0;
+    return strcmp(key.c_str(), cursorKey.c_str()) < 0 ? -1 : 1;
+}
+
+std::vector<SegmentInfo> ReadingStorage::listSegments() {
+    std::vector<SegmentInfo> segments;
+
+    if (!_sdManager || !_sdManager->isAvailable()) {
+        return segments;
+    }
+
     _sdManager->listDirectory(SD_READINGS_DIR, [&](const String& name, size_t size, bool isDir) {
         if (isDir) return;
-        if (!name.endsWith(".csv")) return;
-        if (name.endsWith("_synced.csv")) return;
+        if (!name.startsWith("readings_") || !name.endsWith(".csv")) return;
+
+        SegmentInfo segment;
+        segment.name = name;
+        segment.path = String(SD_READINGS_DIR) + "/" + name;
+        segment.size = size;
+        segment.sealed = name.endsWith("_synced.csv");
+        segment.downsampled = name.indexOf("_ds") > 0;
+        segment.active = (segment.path == _activeSegment);
+        segments.push_back(segment);
+    });
+
+    std::sort(segments.begin(), segments.end(), [](const SegmentInfo& a, const SegmentInfo& b) {
+        return strcmp(segmentKey(a.name).c_str(), segmentKey(b.name).c_str()) < 0;
+    });
+
+    return segments;
+}
 
-        String filepath = String(SD_READINGS_DIR) + "/" + name;
-        String content = _sdManager->readFile(filepath.c_str());
+uint32_t ReadingStorage::getSyncedOffset(const SegmentInfo& segment) const {
+    if (segment.sealed) return segment.size;
 
-        int startIdx = 0;
-        while (startIdx < (int)content.length()) {
-            int endIdx = content.indexOf('\n', startIdx);
-            if (endIdx < 0) endIdx = content.length();
+    int position = compareToCursor(segment.name);
+    if (position < 0) return segment.size;
+    if (position == 0) return _cursorOffset;
+    return 0;
+}
+
+void ReadingStorage::scanSegment(const String& path, uint32_t offset,
+                                 const std::function<bool(const StoredReading&, uint32_t)>& callback) {
+    String carry;               // Incomplete line from the previous chunk
+    uint32_t carryStart = offset;
+
+    while (true) {
+        String chunk = _sdManager->readFileRange(path.c_str(), carryStart + carry.length(), SCAN_CHUNK_BYTES);
+        if (chunk.length() == 0) break;
+
+        String buffer = carry + chunk;
+        int lineStart = 0;
+        while (true) {
+            int lineEnd = buffer.indexOf('\n', lineStart);
+            if (lineEnd < 0) break;
 
-            String line = content.substring(startIdx, endIdx);
+            String line = buffer.substring(lineStart, lineEnd);
             line.trim();
+            lineStart = lineEnd + 1;
 
-            if (line.length() > 0) {
-                // Check if synced flag is 0
-                int lastComma = line.lastIndexOf(',');
-                if (lastComma > 0 && line.substring(lastComma + 1).toInt() == 0) {
-                    pendingCount++;
-                }
+            if (line.length() > 0 &&
+                !callback(StoredReading::fromCsv(line), carryStart + (uint32_t)lineStart)) {
+                return;
             }
+        }
 
-            startIdx = endIdx + 1;
+        // A trailing line without newline (interrupted write) is never reported
+        carryStart += lineStart;
+        carry = buffer.substring(lineStart);
+        if (chunk.length() < SCAN_CHUNK_BYTES) break;
+    }
+}
+
+int ReadingStorage::sealSyncedSegments() {
+    int sealed = 0;
+
+    for (const SegmentInfo& segment : listSegments()) {
+        if (segment.sealed || segment.active) continue;
+        if (getSyncedOffset(segment) < segment.size) continue;
+
+        String sealedPath = segment.path.substring(0, segment.path.length() - 4) + "_synced.csv";
+        if (_sdManager->renameFile(segment.path.c_str(), sealedPath.c_str())) {
+            Serial.printf("[ReadingStorage] Sealed segment: %s\n", segment.name.c_str());
+            sealed++;
         }
-    });
+    }
 
-    _syncStatus.pendingReadings = pendingCount;
-    Serial.printf("[ReadingStorage] Updated pending count: %lu\n", pendingCount);
+    return sealed;
 }
 
-String ReadingStorage::getTodayFilename() const {
-    time_t now = time(nullptr);
-    struct tm* timeinfo = localtime(&now);
+bool ReadingStorage::replaceSegment(const SegmentInfo& segment, const String& content,
+                                    unsigned long removedReadings) {
+    String base = segment.path.substring(0, segment.path.length() - 4);
+    if (base.endsWith("_ds")) base = base.substring(0, base.length() - 3);
+    String newPath = base + "_ds.csv";
 
-    char filename[64];
-    snprintf(filename, sizeof(filename), "%s/readings_%04d%02d%02d.csv",
-             SD_READINGS_DIR,
-             timeinfo->tm_year + 1900,
-             timeinfo->tm_mon + 1,
-             timeinfo->tm_mday);
+    if (!_sdManager->writeFile(newPath.c_str(), content)) {
+        _sdManager->deleteFile(newPath.c_str());
+        return false;
+    }
+    if (!_sdManager->deleteFile(segment.path.c_str())) {
+        _sdManager->deleteFile(newPath.c_str());
+        return false;
+    }
 
-    return String(filename);
+    _layoutVersion++;
+
+    // New file holds only the unsynced part
+    if (compareToCursor(segment.name) == 0) {
+        _cursorSegment = newPath;
+        _cursorOffset = 0;
+    }
+
+    _syncStatus.pendingReadings = _syncStatus.pendingReadings > removedReadings
+                                  ? _syncStatus.pendingReadings - removedReadings : 0;
+    saveSyncStatus();
+    return true;
 }
 
-String ReadingStorage::getFilenameForDate(int year, int month, int day) const {
-    char filename[64];
-    snprintf(filename, sizeof(filename), "%s/readings_%04d%02d%02d.csv",
-             SD_READINGS_DIR, year, month, day);
-    return String(filename);
+bool ReadingStorage::dropSegment(const SegmentInfo& segment, unsigned long pendingReadings) {
+    if (!_sdManager->deleteFile(segment.path.c_str())) {
+        return false;
+    }
+    if (!segment.sealed) {
+        _layoutVersion++;
+    }
+
+    if (pendingReadings > 0) {
+        _syncStatus.pendingReadings = _syncStatus.pendingReadings > pendingReadings
+                                      ? _syncStatus.pendingReadings - pendingReadings : 0;
+        saveSyncStatus();
+    }
+    return true;
 }
 
 bool ReadingStorage::parseDateFromFilename(const String& filename, int& year, int& month, int& day) {
@@ -9,6 +9,7 @@
 #define READING_STORAGE_H
 
 #include <Arduino.h>
+#include <functional>
 #include <vector>
 #include "sd_manager.h"
 #include "storage_config.h"
@@ -71,6 +72,46 @@ struct StoredReading {
     }
 };
 
+/**
+ * Segment - One readings file in SD_READINGS_DIR
+ *
+ *   readings_YYYYMMDD_NNN.csv         appended to until size/age limit or midnight
+ *   readings_YYYYMMDD_NNN_ds.csv      unsynced part replaced by window means
+ *   readings_YYYYMMDD_NNN_synced.csv  sealed: every reading reached the Hub
+ *
+ * Legacy day files (readings_YYYYMMDD.csv) are handled as segment 000.
+ */
+struct SegmentInfo {
+    String path;
+    String name;
+    uint32_t size;
+    bool sealed;
+    bool downsampled;
+    bool active;                // Currently appended to (never evicted)
+};
+
+/**
+ * Position in a segment (end of a line)
+ */
+struct SegmentPosition {
+    String path;
+    uint32_t offset;
+};
+
+/**
+ * Pending Batch - Readings read ahead of the sync cursor
+ * Batches are acknowledged in the order they were read.
+ */
+struct PendingBatch {
+    std::vector<StoredReading> readings;
+    std::vector<SegmentPosition> ends;  // After each reading
+    SegmentPosition scanEnd;            // After the last line looked at
+    String batchFile;                   // Pending batch file ("" = segments)
+    uint32_t layoutVersion;             // Segment layout the positions refer to
+
+    PendingBatch() : scanEnd{String(), 0}, layoutVersion(0) {}
+};
+
 /**
  * Sync Status - Overall sync statistics
  */
@@ -125,10 +166,11 @@ public:
      * @param value reading value
      * @param unit unit of measurement
      * @param endpointId endpoint ID
+     * @param timestamp capture time as Unix seconds (0 = now)
      * @return true if stored successfully
      */
     bool storeReading(const String& sensorType, double value,
-                      const String& unit, int endpointId);
+                      const String& unit, int endpointId, unsigned long timestamp = 0);
 
     /**
      * Get pending readings for sync (oldest first)
@@ -144,6 +186,22 @@ public:
      */
     int markAsSynced(const std::vector<StoredReading>& readings);
 
+    /**
+     * Read the next batch of pending readings (sync read-ahead)
+     * @param maxCount maximum number of readings
+     * @param after batch still in flight to continue behind (nullptr = start at the sync cursor)
+     * @param batch receives readings and their positions (empty = nothing more)
+     */
+    void readPendingBatch(int maxCount, const PendingBatch* after, PendingBatch& batch);
+
+    /**
+     * Advance the sync cursor past the first syncedCount readings of a batch
+     * Batches must be acknowledged in read order; a batch read before a
+     * segment was downsampled or dropped is not acknowledged (sent again).
+     * @return number marked as synced
+     */
+    int acknowledgeBatch(const PendingBatch& batch, size_t syncedCount);
+
     /**
      * Get sync status
      */
@@ -166,8 +224,9 @@ public:
     void recordSyncFailure(const String& error);
 
     /**
-     * Record sync success
-     * @param syncedCount number synced
+     * Record sync success (failure state and timestamp only; the counts
+     * are updated per batch by acknowledgeBatch())
+     * @param syncedCount number synced (for the log)
      */
     void recordSyncSuccess(int syncedCount);
 
@@ -211,28 +270,100 @@ public:
     void updatePendingCount();
 
     /**
-     * Get today's filename
+     * Get the segment new readings are appended to (empty before the first reading)
+     */
+    String getActiveSegment() const { return _activeSegment; }
+
+    /**
+     * List all segments, oldest first
+     */
+    std::vector<SegmentInfo> listSegments();
+
+    /**
+     * Bytes of a segment that already reached the Hub (sync cursor)
      */
-    String getTodayFilename() const;
+    uint32_t getSyncedOffset(const SegmentInfo& segment) const;
+
+    /**
+     * Read a segment line by line (2 KB chunks, no full-file buffer)
+     * @param offset first byte (start of a line)
+     * @param callback reading and file offset after its line; return false to stop
+     */
+    void scanSegment(const String& path, uint32_t offset,
+                     const std::function<bool(const StoredReading&, uint32_t)>& callback);
+
+    /**
+     * Seal closed segments the sync cursor has passed (rename to *_synced.csv)
+     * @return number of segments sealed
+     */
+    int sealSyncedSegments();
+
+    /**
+     * Replace the unsynced part of a segment (retention downsampling)
+     * @param content CSV lines that replace everything after the sync cursor
+     * @param removedReadings pending readings that disappear with the replacement
+     */
+    bool replaceSegment(const SegmentInfo& segment, const String& content, unsigned long removedReadings);
+
+    /**
+     * Delete a segment (retention eviction)
+     * @param pendingReadings unsynced readings lost with it
+     */
+    bool dropSegment(const SegmentInfo& segment, unsigned long pendingReadings);
+
+    /**
+     * Order key of a segment name (suffixes stripped, legacy day file = segment 000)
+     */
+    static String segmentKey(const String& name);
 
 private:
     SDManager* _sdManager;
     StorageConfigManager* _configManager;
     SyncStatus _syncStatus;
-    String _currentDayFile;
     unsigned long _lastFlush;
 
+    // Active segment
+    String _activeSegment;
+    String _activeDate;                 // YYYYMMDD of _activeSegment
+    int _activeSeq;                     // NNN of _activeSegment
+    uint32_t _activeSegmentBytes;
+    unsigned long _activeSegmentOpenedMs;
+
+    // Sync cursor: everything before it reached the Hub (persisted in sync status)
+    String _cursorSegment;
+    uint32_t _cursorOffset;
+
+    // Bumped when a segment is replaced or dropped (invalidates read-ahead)
+    uint32_t _layoutVersion;
+
+    // sync_status.json is rewritten on every sync step: reuse one buffer
+    String _statusBuffer;
+
+    // Batch handed out by the last getPendingReadings()
+    PendingBatch _lastBatch;
+
     static const unsigned long FLUSH_INTERVAL_MS = 10000; // 10 seconds
+    static const size_t SCAN_CHUNK_BYTES = 2048;
+
+    /**
+     * Segment to append to (rotates on size, age or date change)
+     */
+    String ensureSegment();
+
+    /**
+     * Pick up today's last segment after a reboot
+     */
+    void resumeActiveSegment();
 
     /**
-     * Get filename for a specific date
+     * Current local date as YYYYMMDD
      */
-    String getFilenameForDate(int year, int month, int day) const;
+    static String todayString();
 
     /**
-     * Ensure current day's file is open
+     * Position of a segment relative to the sync cursor (<0 before, 0 at, >0 after)
      */
-    bool ensureDayFile();
+    int compareToCursor(const String& name) const;
 
     /**
      * Parse date from filename
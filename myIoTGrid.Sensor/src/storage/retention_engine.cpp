@@ -0,0 +1,279 @@
+/**
+ * myIoTGrid.Sensor - Retention Engine Implementation
+ */
+
+#include "retention_engine.h"
+#include "config.h"
+#include "time_service.h"
+#include <ArduinoJson.h>
+#ifdef PLATFORM_NATIVE
+#include "ArduinoJsonString.h"
+#endif
+#include <map>
+#include <time.h>
+
+namespace {
+
+/**
+ * Running mean of one (window, endpoint, type) bucket
+ */
+struct WindowBucket {
+    StoredReading first;
+    double sum;
+    unsigned long count;
+};
+
+} // namespace
+
+RetentionEngine::RetentionEngine()
+    : _sdManager(nullptr)
+    , _configManager(nullptr)
+    , _storage(nullptr)
+    , _phase(RetentionPhase::IDLE)
+    , _scanRequested(true)
+    , _lastScan(0)
+    , _index(0)
+    , _segmentCount(0)
+    , _sealedCount(0)
+    , _expiredCount(0)
+    , _evictedCount(0)
+    , _downsampledCount(0)
+    , _droppedReadings(0)
+{
+}
+
+bool RetentionEngine::init(SDManager& sdManager,
+                           StorageConfigManager& configManager,
+                           ReadingStorage& storage) {
+    _sdManager = &sdManager;
+    _configManager = &configManager;
+    _storage = &storage;
+
+    Serial.printf("[Retention] Initialized - policy: %s, segment: %lu bytes / %lu s\n",
+                  StorageConfig::getRetentionPolicyString(_configManager->getConfig().retentionPolicy),
+                  (unsigned long)_configManager->getConfig().segmentMaxBytes,
+                  (unsigned long)_configManager->getConfig().segmentMaxSeconds);
+
+    return true;
+}
+
+void RetentionEngine::loop() {
+    if (!_storage || !_sdManager || !_sdManager->isAvailable()) return;
+
+    switch (_phase) {
+        case RetentionPhase::IDLE:
+            if (_scanRequested || millis() - _lastScan >= config::RETENTION_SCAN_INTERVAL_MS ||
+                isBelowFreeTarget(1)) {
+                _scanRequested = false;
+                _lastScan = millis();
+                _phase = RetentionPhase::SCAN;
+            }
+            break;
+
+        case RetentionPhase::SCAN:
+            scan();
+            _phase = RetentionPhase::EXPIRE;
+            break;
+
+        case RetentionPhase::EXPIRE:
+            if (!expireNext()) {
+                _segments.clear();
+                _phase = isBelowFreeTarget(1) ? RetentionPhase::EVICT : RetentionPhase::IDLE;
+            }
+            break;
+
+        case RetentionPhase::EVICT:
+            if (!isBelowFreeTarget(2) || !evictNext()) {
+                _phase = RetentionPhase::IDLE;
+            }
+            break;
+    }
+}
+
+const char* RetentionEngine::getPhaseString() const {
+    switch (_phase) {
+        case RetentionPhase::IDLE: return "IDLE";
+        case RetentionPhase::SCAN: return "SCAN";
+        case RetentionPhase::EXPIRE: return "EXPIRE";
+        case RetentionPhase::EVICT: return "EVICT";
+        default: return "UNKNOWN";
+    }
+}
+
+String RetentionEngine::getStatsJson() const {
+    JsonDocument doc;
+    doc["policy"] = _configManager
+        ? StorageConfig::getRetentionPolicyString(_configManager->getConfig().retentionPolicy)
+        : "unknown";
+    doc["phase"] = getPhaseString();
+    doc["segments"] = _segmentCount;
+    doc["sealed"] = _sealedCount;
+    doc["expired"] = _expiredCount;
+    doc["evicted"] = _evictedCount;
+    doc["downsampled"] = _downsampledCount;
+    doc["droppedReadings"] = _droppedReadings;
+
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
+
+void RetentionEngine::scan() {
+    _sealedCount += _storage->sealSyncedSegments();
+    _segments = _storage->listSegments();
+    _segmentCount = _segments.size();
+    _index = 0;
+    _expireBefore = "";
+
+    const StorageConfig& cfg = _configManager->getConfig();
+    time_t now = time(nullptr);
+    if (!cfg.autoCleanup || cfg.keepSyncedDays <= 0 || !TimeService::isValidUnixTime((uint32_t)now)) {
+        return;  // No age expiry without a real date
+    }
+
+    time_t cutoff = now - (time_t)cfg.keepSyncedDays * 86400;
+    struct tm* timeinfo = localtime(&cutoff);
+    char date[16];
+    snprintf(date, sizeof(date), "%04d%02d%02d",
+             timeinfo->tm_year + 1900, timeinfo->tm_mon + 1, timeinfo->tm_mday);
+    _expireBefore = String(date);
+}
+
+bool RetentionEngine::expireNext() {
+    if (_expireBefore.length() == 0) return false;
+
+    while (_index < _segments.size()) {
+        const SegmentInfo& segment = _segments[_index++];
+        if (!segment.sealed) continue;
+
+        if (segmentDate(segment.name) >= _expireBefore) {
+            return false;  // Sorted oldest first: nothing older follows
+        }
+
+        if (_storage->dropSegment(segment, 0)) {
+            Serial.printf("[Retention] Expired %s\n", segment.name.c_str());
+            _expiredCount++;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+bool RetentionEngine::evictNext() {
+    RetentionPolicy policy = _configManager->getConfig().retentionPolicy;
+    std::vector<SegmentInfo> segments = _storage->listSegments();
+
+    // 1. Oldest sealed segment: already on the Hub
+    for (const SegmentInfo& segment : segments) {
+        if (!segment.sealed) continue;
+        if (_storage->dropSegment(segment, 0)) {
+            Serial.printf("[Retention] Evicted %s\n", segment.name.c_str());
+            _evictedCount++;
+            return true;
+        }
+        return false;
+    }
+
+    if (policy == RetentionPolicy::SYNCED_ONLY) {
+        Serial.println("[Retention] Low space, only unsynced data left (policy: synced_only)");
+        return false;
+    }
+
+    // 2. Oldest unsynced segment that still holds raw readings
+    for (const SegmentInfo& segment : segments) {
+        if (segment.sealed || segment.active || segment.downsampled) continue;
+        return downsample(segment);
+    }
+
+    if (policy != RetentionPolicy::DROP_OLDEST) {
+        Serial.println("[Retention] Low space, all unsynced segments downsampled");
+        return false;
+    }
+
+    // 3. Oldest unsynced segment, readings are lost
+    for (const SegmentInfo& segment : segments) {
+        if (segment.sealed || segment.active) continue;
+
+        unsigned long pending = 0;
+        _storage->scanSegment(segment.path, _storage->getSyncedOffset(segment),
+                              [&](const StoredReading& reading, uint32_t) {
+            if (!reading.synced && reading.timestamp > 0) pending++;
+            return true;
+        });
+
+        if (_storage->dropSegment(segment, pending)) {
+            Serial.printf("[Retention] Dropped %s (%lu unsynced readings)\n",
+                          segment.name.c_str(), pending);
+            _evictedCount++;
+            _droppedReadings += pending;
+            return true;
+        }
+        return false;
+    }
+
+    return false;
+}
+
+bool RetentionEngine::downsample(const SegmentInfo& segment) {
+    unsigned long window = _configManager->getConfig().downsampleWindowSeconds;
+    if (window == 0) window = 1;
+
+    // Key: window start, endpoint, type (ordered, so output stays chronological)
+    std::map<std::string, WindowBucket> buckets;
+    unsigned long readingCount = 0;
+
+    _storage->scanSegment(segment.path, _storage->getSyncedOffset(segment),
+                          [&](const StoredReading& reading, uint32_t) {
+        if (reading.synced || reading.timestamp == 0) return true;
+
+        char key[96];
+        snprintf(key, sizeof(key), "%010lu|%d|%s",
+                 (reading.timestamp / window) * window, reading.endpointId, reading.sensorType.c_str());
+
+        auto it = buckets.find(key);
+        if (it == buckets.end()) {
+            WindowBucket bucket;
+            bucket.first = reading;
+            bucket.first.timestamp = (reading.timestamp / window) * window;
+            bucket.sum = reading.value;
+            bucket.count = 1;
+            buckets.emplace(key, bucket);
+        } else {
+            it->second.sum += reading.value;
+            it->second.count++;
+        }
+        readingCount++;
+        return true;
+    });
+
+    String content;
+    for (const auto& entry : buckets) {
+        StoredReading mean = entry.second.first;
+        mean.value = entry.second.sum / entry.second.count;
+        content += mean.toCsv() + "\n";
+    }
+
+    unsigned long removed = readingCount - buckets.size();
+    if (!_storage->replaceSegment(segment, content, removed)) {
+        Serial.printf("[Retention] Failed to downsample %s\n", segment.name.c_str());
+        return false;
+    }
+
+    Serial.printf("[Retention] Downsampled %s: %lu -> %u readings (%lu s windows)\n",
+                  segment.name.c_str(), readingCount, (unsigned)buckets.size(), window);
+    _downsampledCount++;
+    _droppedReadings += removed;
+    return true;
+}
+
+bool RetentionEngine::isBelowFreeTarget(int headroomFactor) const {
+    uint64_t target = _configManager->getConfig().minFreeBytes +
+                      (uint64_t)headroomFactor * config::RETENTION_HEADROOM_BYTES;
+    return !_sdManager->hasEnoughSpace(target);
+}
+
+String RetentionEngine::segmentDate(const String& name) {
+    // readings_YYYYMMDD...
+    return name.substring(9, 17);
+}
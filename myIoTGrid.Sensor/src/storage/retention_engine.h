@@ -0,0 +1,133 @@
+/**
+ * myIoTGrid.Sensor - Retention Engine
+ *
+ * Keeps the readings directory within its limits without blocking the
+ * sampling loop. Each loop() call does at most one file operation:
+ *
+ *   SCAN     seal fully synced segments, list segments (oldest first)
+ *   EXPIRE   delete sealed segments older than keepSyncedDays
+ *   EVICT    while free space is below minFreeBytes + headroom:
+ *              1. delete the oldest sealed segment
+ *              2. downsample the oldest unsynced segment (DOWNSAMPLE, DROP_OLDEST)
+ *              3. delete the oldest unsynced segment (DROP_OLDEST)
+ *
+ * Part of Sprint OS-01: Offline-Speicher Implementation
+ */
+
+#ifndef RETENTION_ENGINE_H
+#define RETENTION_ENGINE_H
+
+#include <Arduino.h>
+#include <vector>
+#include "reading_storage.h"
+#include "sd_manager.h"
+#include "storage_config.h"
+
+/**
+ * Retention phase
+ */
+enum class RetentionPhase {
+    IDLE,           // Waiting for the next scan
+    SCAN,           // Seal and list segments
+    EXPIRE,         // Age-based deletion of sealed segments
+    EVICT           // Space-based eviction
+};
+
+/**
+ * Retention Engine - Incremental segment retention
+ */
+class RetentionEngine {
+public:
+    RetentionEngine();
+
+    /**
+     * Initialize the retention engine
+     * @param sdManager reference to SD manager
+     * @param configManager reference to config manager
+     * @param storage reference to reading storage
+     */
+    bool init(SDManager& sdManager,
+              StorageConfigManager& configManager,
+              ReadingStorage& storage);
+
+    /**
+     * Process one retention step (call in loop)
+     */
+    void loop();
+
+    /**
+     * Start a scan on the next loop() call
+     */
+    void triggerScan() { _scanRequested = true; }
+
+    /**
+     * True while a pass is running (call loop() again soon)
+     */
+    bool isBusy() const { return _phase != RetentionPhase::IDLE; }
+
+    /**
+     * Get current phase as string
+     */
+    const char* getPhaseString() const;
+
+    /**
+     * Get retention statistics as JSON object
+     */
+    String getStatsJson() const;
+
+private:
+    SDManager* _sdManager;
+    StorageConfigManager* _configManager;
+    ReadingStorage* _storage;
+
+    RetentionPhase _phase;
+    bool _scanRequested;
+    unsigned long _lastScan;
+
+    std::vector<SegmentInfo> _segments;     // Snapshot of the current pass
+    size_t _index;                          // Next segment for EXPIRE
+    String _expireBefore;                   // YYYYMMDD, empty = no age expiry
+
+    // Statistics (since boot)
+    unsigned long _segmentCount;
+    unsigned long _sealedCount;
+    unsigned long _expiredCount;
+    unsigned long _evictedCount;
+    unsigned long _downsampledCount;
+    unsigned long _droppedReadings;
+
+    /**
+     * Seal and list segments, prepare EXPIRE
+     */
+    void scan();
+
+    /**
+     * Delete the next expired sealed segment
+     * @return false when no segment is left to check
+     */
+    bool expireNext();
+
+    /**
+     * Free space by one eviction step
+     * @return false when nothing more can (or needs to) be evicted
+     */
+    bool evictNext();
+
+    /**
+     * Replace the unsynced part of a segment by per-window means
+     */
+    bool downsample(const SegmentInfo& segment);
+
+    /**
+     * Check free space against minFreeBytes + headroom
+     * @param headroomFactor multiples of RETENTION_HEADROOM_BYTES
+     */
+    bool isBelowFreeTarget(int headroomFactor) const;
+
+    /**
+     * Date part (YYYYMMDD) of a segment name
+     */
+    static String segmentDate(const String& name);
+};
+
+#endif // RETENTION_ENGINE_H
@@ -322,6 +322,31 @@ String SDManager::readFile(const char* path) {
 #endif
 }
 
+String SDManager::readFileRange(const char* path, uint64_t offset, size_t maxBytes) {
+#ifdef PLATFORM_ESP32
+    if (_status != SDStatus::MOUNTED) return "";
+
+    File file = SD.open(path, FILE_READ);
+    if (!file) {
+        return "";
+    }
+
+    String content;
+    if (offset < file.size() && file.seek(offset)) {
+        std::vector<uint8_t> buf(maxBytes);
+        size_t n = file.read(buf.data(), maxBytes);
+        content.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            content += (char)buf[i];
+        }
+    }
+    file.close();
+    return content;
+#else
+    return "";
+#endif
+}
+
 bool SDManager::renameFile(const char* oldPath, const char* newPath) {
 #ifdef PLATFORM_ESP32
     if (_status != SDStatus::MOUNTED) return false;
@@ -413,9 +438,9 @@ uint64_t SDManager::cleanupOldFiles(uint64_t targetFreeBytes) {
         root.close();
     }
 
-    // Sort by date (oldest first)
+    // Sort by date and segment number (oldest first)
     std::sort(files.begin(), files.end(), [](const FileInfo& a, const FileInfo& b) {
-        return a.date < b.date;
+        return a.date != b.date ? a.date < b.date : a.path < b.path;
     });
 
     // Delete oldest files until we have enough space
@@ -44,6 +44,7 @@
 #define SD_PENDING_DIR      "/iotgrid/pending"
 #define SD_CONFIG_FILE      "/iotgrid/config.json"
 #define SD_SYNC_STATUS_FILE "/iotgrid/sync_status.json"
+#define SD_TRACES_DIR       "/iotgrid/traces"
 
 // Minimum free space to keep (bytes) - 1 MB
 #define SD_MIN_FREE_SPACE   1048576
@@ -181,6 +182,15 @@ public:
      */
     String readFile(const char* path);
 
+    /**
+     * Read part of a file
+     * @param path file path
+     * @param offset first byte to read
+     * @param maxBytes maximum number of bytes
+     * @return content (shorter than maxBytes at end of file, empty on error)
+     */
+    String readFileRange(const char* path, uint64_t offset, size_t maxBytes);
+
     /**
      * Rename/move file
      * @param oldPath current path
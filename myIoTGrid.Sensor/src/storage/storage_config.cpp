@@ -56,6 +56,10 @@ bool StorageConfigManager::load(SDManager& sdManager) {
         _config.syncIntervalMs = doc["syncIntervalMs"].as<unsigned long>();
     }
 
+    if (doc.containsKey("syncPipelineDepth")) {
+        _config.syncPipelineDepth = doc["syncPipelineDepth"].as<int>();
+    }
+
     if (doc.containsKey("maxRetries")) {
         _config.maxRetries = doc["maxRetries"].as<int>();
     }
@@ -80,6 +84,25 @@ bool StorageConfigManager::load(SDManager& sdManager) {
         _config.minFreeBytes = doc["minFreeBytes"].as<uint64_t>();
     }
 
+    if (doc.containsKey("segmentMaxBytes")) {
+        _config.segmentMaxBytes = doc["segmentMaxBytes"].as<uint32_t>();
+    }
+
+    if (doc.containsKey("segmentMaxSeconds")) {
+        _config.segmentMaxSeconds = doc["segmentMaxSeconds"].as<uint32_t>();
+    }
+
+    if (doc.containsKey("retentionPolicy")) {
+        const char* policyStr = doc["retentionPolicy"].as<const char*>();
+        if (policyStr) {
+            _config.retentionPolicy = StorageConfig::parseRetentionPolicy(String(policyStr));
+        }
+    }
+
+    if (doc.containsKey("downsampleWindowSeconds")) {
+        _config.downsampleWindowSeconds = doc["downsampleWindowSeconds"].as<int>();
+    }
+
     if (doc.containsKey("enableStatusLed")) {
         _config.enableStatusLed = doc["enableStatusLed"].as<bool>();
     }
@@ -88,6 +111,10 @@ bool StorageConfigManager::load(SDManager& sdManager) {
         _config.enableSyncButton = doc["enableSyncButton"].as<bool>();
     }
 
+    if (doc.containsKey("traceRecording")) {
+        _config.traceRecording = doc["traceRecording"].as<bool>();
+    }
+
     Serial.println("[StorageConfig] Configuration loaded from SD card");
     printConfig();
     return true;
@@ -106,14 +133,20 @@ bool StorageConfigManager::save(SDManager& sdManager) {
     doc["syncStrategy"] = StorageConfig::getSyncStrategyString(_config.syncStrategy);
     doc["batchSize"] = _config.batchSize;
     doc["syncIntervalMs"] = _config.syncIntervalMs;
+    doc["syncPipelineDepth"] = _config.syncPipelineDepth;
     doc["maxRetries"] = _config.maxRetries;
     doc["initialRetryDelayMs"] = _config.initialRetryDelayMs;
     doc["maxRetryDelayMs"] = _config.maxRetryDelayMs;
     doc["autoCleanup"] = _config.autoCleanup;
     doc["keepSyncedDays"] = _config.keepSyncedDays;
     doc["minFreeBytes"] = _config.minFreeBytes;
+    doc["segmentMaxBytes"] = _config.segmentMaxBytes;
+    doc["segmentMaxSeconds"] = _config.segmentMaxSeconds;
+    doc["retentionPolicy"] = StorageConfig::getRetentionPolicyString(_config.retentionPolicy);
+    doc["downsampleWindowSeconds"] = _config.downsampleWindowSeconds;
     doc["enableStatusLed"] = _config.enableStatusLed;
     doc["enableSyncButton"] = _config.enableSyncButton;
+    doc["traceRecording"] = _config.traceRecording;
 
     // Serialize to string
     String content;
@@ -136,9 +169,16 @@ void StorageConfigManager::printConfig() const {
                   StorageConfig::getSyncStrategyString(_config.syncStrategy));
     Serial.printf("  Batch Size: %d\n", _config.batchSize);
     Serial.printf("  Sync Interval: %lu ms\n", _config.syncIntervalMs);
+    Serial.printf("  Sync Pipeline Depth: %d\n", _config.syncPipelineDepth);
     Serial.printf("  Max Retries: %d\n", _config.maxRetries);
     Serial.printf("  Auto Cleanup: %s\n", _config.autoCleanup ? "yes" : "no");
     Serial.printf("  Keep Synced Days: %d\n", _config.keepSyncedDays);
+    Serial.printf("  Segments: %lu bytes / %lu s\n",
+                  (unsigned long)_config.segmentMaxBytes, (unsigned long)_config.segmentMaxSeconds);
+    Serial.printf("  Retention Policy: %s (window %ds)\n",
+                  StorageConfig::getRetentionPolicyString(_config.retentionPolicy),
+                  _config.downsampleWindowSeconds);
     Serial.printf("  Status LED: %s\n", _config.enableStatusLed ? "enabled" : "disabled");
     Serial.printf("  Sync Button: %s\n", _config.enableSyncButton ? "enabled" : "disabled");
+    Serial.printf("  Trace Recording: %s\n", _config.traceRecording ? "enabled" : "disabled");
 }
@@ -72,6 +72,27 @@ enum class SyncStrategy {
     MANUAL
 };
 
+/**
+ * Retention Policy - What the retention engine may remove when space runs low
+ * Synced segments are always evicted first (oldest first).
+ */
+enum class RetentionPolicy {
+    /**
+     * SYNCED_ONLY: Never touch unsynced readings (storing fails when full)
+     */
+    SYNCED_ONLY,
+
+    /**
+     * DOWNSAMPLE: Then replace the oldest unsynced segments by window means (DEFAULT)
+     */
+    DOWNSAMPLE,
+
+    /**
+     * DROP_OLDEST: Then delete the oldest unsynced segments as a last resort
+     */
+    DROP_OLDEST
+};
+
 /**
  * Storage Configuration
  */
@@ -81,8 +102,9 @@ struct StorageConfig {
 
     // Sync settings
     SyncStrategy syncStrategy = SyncStrategy::IMMEDIATE;
-    int batchSize = 50;                         // Readings per sync batch
+    int batchSize = 50;                         // Start value, adapted per batch (BatchSizer)
     unsigned long syncIntervalMs = 60000;       // 1 minute for scheduled sync
+    int syncPipelineDepth = 2;                  // Batches read ahead incl. the one in flight (1 = serial)
 
     // Retry settings
     int maxRetries = 5;                         // Max retries before giving up
@@ -94,9 +116,16 @@ struct StorageConfig {
     int keepSyncedDays = 7;                     // Keep synced files for X days
     uint64_t minFreeBytes = 1048576;            // 1 MB minimum free space
 
+    // Segment / retention settings
+    uint32_t segmentMaxBytes = 65536;           // Rotate segment at 64 KB
+    uint32_t segmentMaxSeconds = 86400;         // ... or after 1 day (and at midnight)
+    RetentionPolicy retentionPolicy = RetentionPolicy::DOWNSAMPLE;
+    int downsampleWindowSeconds = 900;          // Unsynced readings -> 15 min means
+
     // Feature flags
     bool enableStatusLed = true;
     bool enableSyncButton = true;
+    bool traceRecording = false;                // Record sensor/UART traces to /iotgrid/traces
 
     /**
      * Get mode as string
@@ -122,6 +151,28 @@ struct StorageConfig {
         return StorageMode::LOCAL_AUTOSYNC; // Default
     }
 
+    /**
+     * Get retention policy as string
+     */
+    static const char* getRetentionPolicyString(RetentionPolicy policy) {
+        switch (policy) {
+            case RetentionPolicy::SYNCED_ONLY: return "SYNCED_ONLY";
+            case RetentionPolicy::DOWNSAMPLE: return "DOWNSAMPLE";
+            case RetentionPolicy::DROP_OLDEST: return "DROP_OLDEST";
+            default: return "UNKNOWN";
+        }
+    }
+
+    /**
+     * Parse retention policy from string
+     */
+    static RetentionPolicy parseRetentionPolicy(const String& str) {
+        if (str == "SYNCED_ONLY") return RetentionPolicy::SYNCED_ONLY;
+        if (str == "DOWNSAMPLE") return RetentionPolicy::DOWNSAMPLE;
+        if (str == "DROP_OLDEST") return RetentionPolicy::DROP_OLDEST;
+        return RetentionPolicy::DOWNSAMPLE; // Default
+    }
+
     /**
      * Get sync strategy as string
      */
@@ -5,6 +5,16 @@
 #include "sync_manager.h"
 #include "api_client.h"
 #include "wifi_manager.h"
+#include "time_service.h"
+#include "json_arena.h"
+#include "config.h"
+#include "hal/hal.h"
+#include "retry_policy.h"
+
+#ifndef PLATFORM_ESP32
+#include <chrono>
+#include <thread>
+#endif
 
 SyncManager::SyncManager()
     : _storage(nullptr)
@@ -15,10 +25,20 @@ SyncManager::SyncManager()
     , _retryCount(0)
     , _currentRetryDelay(0)
     , _nextRetryTime(0)
+    , _retryJitter(0, 0)
+    , _waitingForHub(false)
     , _lastSyncAttempt(0)
     , _lastScheduledSync(0)
     , _forceSyncAll(false)
     , _wasWifiConnected(false)
+    , _uploadSlot(nullptr)
+    , _cancelUpload(false)
+    , _runActive(false)
+    , _runFailed(false)
+    , _readExhausted(false)
+#ifdef PLATFORM_ESP32
+    , _uploadTask(nullptr)
+#endif
 {
     _lastResult.success = false;
     _lastResult.syncedCount = 0;
@@ -36,6 +56,12 @@ bool SyncManager::init(ReadingStorage& storage,
 
     _wasWifiConnected = isWifiAvailable();
 
+    _batchSizer.reset(_configManager->getConfig().batchSize);
+
+    if (!startUploader()) {
+        return false;
+    }
+
     Serial.println("[SyncManager] Initialized");
     Serial.printf("[SyncManager] Mode: %s\n",
                   StorageConfig::getModeString(_configManager->getMode()));
@@ -77,6 +103,17 @@ void SyncManager::loop() {
             break;
 
         case SyncState::WAITING:
+            // Hub reachable again (another request closed the circuit): retry soon,
+            // spread over one initial delay so the fleet does not sync at once
+            if (_waitingForHub && CircuitBreaker::forHub().getState() == CircuitState::CLOSED) {
+                _waitingForHub = false;
+                unsigned long soon = millis() +
+                    _retryJitter.uniform(0, _configManager->getConfig().initialRetryDelayMs);
+                if (soon < _nextRetryTime) {
+                    _nextRetryTime = soon;
+                }
+            }
+
             // Waiting for retry
             if (millis() >= _nextRetryTime) {
                 if (isWifiAvailable()) {
@@ -89,16 +126,15 @@ void SyncManager::loop() {
             break;
 
         case SyncState::SYNCING:
-            // Perform sync
-            if (isWifiAvailable()) {
-                if (_onSyncStart) _onSyncStart();
-
-                _lastResult = performSync();
-                _lastSyncAttempt = millis();
-
-                if (_lastResult.success) {
-                    handleSyncSuccess(_lastResult.syncedCount);
+            // Run the sync pipeline (a running upload finishes even if WiFi drops)
+            if (_runActive) {
+                processPipeline();
+            } else if (isWifiAvailable()) {
+                if (startRun()) {
+                    processPipeline();
                 } else {
+                    _lastResult = _runResult;
+                    _lastSyncAttempt = millis();
                     handleSyncError(_lastResult.error);
                 }
             } else {
@@ -152,6 +188,7 @@ void SyncManager::resetRetries() {
     _retryCount = 0;
     _currentRetryDelay = 0;
     _nextRetryTime = 0;
+    _waitingForHub = false;
     if (_state == SyncState::ERROR || _state == SyncState::WAITING) {
         _state = SyncState::IDLE;
     }
@@ -162,105 +199,251 @@ bool SyncManager::isWifiAvailable() const {
     return _wifiManager->isConnected();
 }
 
-SyncResult SyncManager::performSync() {
-    SyncResult result;
-    result.success = false;
-    result.syncedCount = 0;
-    result.failedCount = 0;
+bool SyncManager::startRun() {
+    _runResult = SyncResult{false, 0, 0, String()};
 
     if (!_storage || !_apiClient) {
-        result.error = "Not initialized";
-        return result;
+        _runResult.error = "Not initialized";
+        return false;
     }
 
-    if (!isWifiAvailable()) {
-        result.error = "WiFi not available";
-        return result;
+    if (!_apiClient->isConfigured()) {
+        _runResult.error = "API client not configured";
+        return false;
     }
 
-    // Get pending readings
-    int batchSize = _forceSyncAll ? 1000 : _configManager->getConfig().batchSize;
-    std::vector<StoredReading> pendingReadings = _storage->getPendingReadings(batchSize);
+    _runActive = true;
+    _runFailed = false;
+    _readExhausted = false;
 
-    if (pendingReadings.empty()) {
-        result.success = true;
-        result.error = "No pending readings";
-        Serial.println("[SyncManager] No pending readings to sync");
-        return result;
+    if (_onSyncStart) _onSyncStart();
+    return true;
+}
+
+void SyncManager::processPipeline() {
+    const StorageConfig& config = _configManager->getConfig();
+
+    // Acknowledge finished batches strictly in read order
+    while (!_runFailed && !_slots.empty() && _slots.front().state.load() == SyncSlot::DONE) {
+        SyncSlot& slot = _slots.front();
+
+        if (slot.result.syncedCount > 0) {
+            _storage->acknowledgeBatch(slot.batch, slot.result.syncedCount);
+        }
+        _batchSizer.onBatchResult(slot.batch.readings.size(), slot.result.syncedCount,
+                                  slot.result.durationMs, slot.result.statusCode);
+        _runResult.syncedCount += slot.result.syncedCount;
+        _runResult.failedCount += slot.result.failedCount;
+
+        if (slot.result.failedCount > 0 || !slot.result.success) {
+            // Later batches may have arrived, but the cursor must not skip this gap
+            _runFailed = true;
+            _runResult.error = slot.result.error;
+        }
+        _slots.pop_front();
+
+        if (_onSyncProgress) {
+            _onSyncProgress(_runResult.syncedCount, _runResult.syncedCount + getPendingCount());
+        }
     }
 
-    Serial.printf("[SyncManager] Syncing %d readings...\n", pendingReadings.size());
+    // Done or failed: let the upload task finish first
+    if (_runFailed || (_readExhausted && _slots.empty())) {
+        if (_uploadSlot.load() != nullptr) {
+            _cancelUpload = true;
+            return;
+        }
+        finishRun();
+        return;
+    }
 
-    // Send batch
-    result = sendBatch(pendingReadings);
+    // Read ahead (one SD batch per step)
+    int depth = config.syncPipelineDepth;
+    if (depth < 1) depth = 1;
+    if (depth > config::SYNC_PIPELINE_MAX_DEPTH) depth = config::SYNC_PIPELINE_MAX_DEPTH;
+
+    if (!_readExhausted && (int)_slots.size() < depth) {
+        // Forced sync drains with the largest batch heap and link allow
+        int batchSize = _batchSizer.nextSize(hal::get_free_heap(),
+                                             _wifiManager ? _wifiManager->getRSSI() : -100,
+                                             depth, _forceSyncAll);
+        const PendingBatch* after = _slots.empty() ? nullptr : &_slots.back().batch;
+        _slots.emplace_back();
+        _storage->readPendingBatch(batchSize, after, _slots.back().batch);
+
+        if (_slots.back().batch.readings.empty()) {
+            _slots.pop_back();
+            _readExhausted = true;
+        } else {
+            encodeBatch(_slots.back());
+        }
+    }
+
+    // Hand the oldest waiting batch to the upload task
+    if (_uploadSlot.load() == nullptr) {
+        for (SyncSlot& slot : _slots) {
+            if (slot.state.load() != SyncSlot::READY) continue;
+
+            Serial.printf("[SyncManager] Syncing %d readings (window %d)...\n",
+                          (int)slot.batch.readings.size(), _batchSizer.getWindow());
+            slot.state = SyncSlot::UPLOADING;
+            _cancelUpload = false;
+            _uploadSlot = &slot;
+#ifdef PLATFORM_ESP32
+            xTaskNotifyGive(_uploadTask);
+#else
+            _uploadCv.notify_one();
+#endif
+            break;
+        }
+    }
+}
 
-    // Reset force flag
+void SyncManager::finishRun() {
+    _slots.clear();
+    _runActive = false;
     _forceSyncAll = false;
 
-    return result;
+    if (_runResult.syncedCount == 0 && _runResult.failedCount == 0 && !_runFailed) {
+        _runResult.success = true;
+        _runResult.error = "No pending readings";
+        Serial.println("[SyncManager] No pending readings to sync");
+    } else {
+        _runResult.success = (_runResult.failedCount == 0 || _runResult.syncedCount > 0);
+        Serial.printf("[SyncManager] Sync result: %d synced, %d failed\n",
+                      _runResult.syncedCount, _runResult.failedCount);
+    }
+
+    _lastResult = _runResult;
+    _lastSyncAttempt = millis();
+
+    if (_lastResult.success) {
+        handleSyncSuccess(_lastResult.syncedCount);
+    } else {
+        handleSyncError(_lastResult.error);
+    }
 }
 
-SyncResult SyncManager::sendBatch(const std::vector<StoredReading>& readings) {
-    SyncResult result;
-    result.success = false;
-    result.syncedCount = 0;
-    result.failedCount = 0;
+bool SyncManager::startUploader() {
+#ifdef PLATFORM_ESP32
+    if (_uploadTask) return true;
 
-    if (!_apiClient || !_apiClient->isConfigured()) {
-        result.error = "API client not configured";
-        return result;
+    if (xTaskCreatePinnedToCore(uploadTaskEntry, "sync", config::SYNC_UPLOAD_TASK_STACK_SIZE,
+                                this, config::SYNC_UPLOAD_TASK_PRIORITY, &_uploadTask,
+                                config::SYNC_UPLOAD_TASK_CORE) != pdPASS) {
+        Serial.println("[SyncManager] Failed to create upload task!");
+        return false;
     }
+#else
+    static bool started = false;
+    if (started) return true;
 
-    // Send each reading
-    // TODO: Implement batch API endpoint for efficiency
-    int successCount = 0;
-    int failCount = 0;
+    std::thread([this] { runUploader(); }).detach();
+    started = true;
+#endif
+    return true;
+}
 
-    for (size_t i = 0; i < readings.size(); i++) {
-        const auto& reading = readings[i];
+#ifdef PLATFORM_ESP32
+void SyncManager::uploadTaskEntry(void* param) {
+    static_cast<SyncManager*>(param)->runUploader();
+}
+#endif
+
+void SyncManager::runUploader() {
+    while (true) {
+#ifdef PLATFORM_ESP32
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(config::SYNC_UPLOAD_IDLE_WAIT_MS));
+#else
+        {
+            std::unique_lock<std::mutex> lock(_uploadMutex);
+            _uploadCv.wait_for(lock, std::chrono::milliseconds(config::SYNC_UPLOAD_IDLE_WAIT_MS),
+                               [this] { return _uploadSlot.load() != nullptr; });
+        }
+#endif
 
-        // Report progress
-        if (_onSyncProgress) {
-            _onSyncProgress(i + 1, readings.size());
+        SyncSlot* slot = _uploadSlot.load();
+        if (!slot || slot->state.load() != SyncSlot::UPLOADING) {
+            continue;
         }
 
-        // Send reading
-        bool sent = _apiClient->sendReading(
-            reading.sensorType,
-            reading.value,
-            reading.unit,
-            reading.endpointId
-        );
+        slot->result = sendBatch(*slot);
+        slot->state = SyncSlot::DONE;
+        _uploadSlot = nullptr;  // Slot belongs to loop() again
+    }
+}
 
-        if (sent) {
-            successCount++;
-        } else {
-            failCount++;
-            // Stop on first failure for now
-            // Could implement partial sync later
-            if (failCount >= 3) {
-                result.error = "Multiple send failures";
-                break;
-            }
-        }
+String SyncManager::getStatsJson() const {
+    String json = "{";
+    json += "\"state\":\"" + String(getStateString()) + "\",";
+    json += "\"pending\":" + String(getPendingCount()) + ",";
+    json += "\"lastSynced\":" + String(_lastResult.syncedCount) + ",";
+    json += "\"lastFailed\":" + String(_lastResult.failedCount) + ",";
+    json += "\"retryDelayMs\":" + String(_currentRetryDelay) + ",";
+    json += "\"circuit\":" + CircuitBreaker::forHub().getStatsJson(millis()) + ",";
+
+    // Batch sizer fields are merged into the same object
+    String batchJson = _batchSizer.getStatsJson();
+    json += batchJson.substring(1);
+    return json;
+}
 
-        // Small delay between requests to avoid overwhelming the server
-        delay(50);
+void SyncManager::encodeBatch(SyncSlot& slot) {
+    JsonDocument doc(&JsonArena::getInstance());
+    JsonArray readings = _apiClient->beginReadingBatch(doc);
+
+    for (const StoredReading& reading : slot.batch.readings) {
+        // Capture time (stored before any clock sync: Hub receive time)
+        _apiClient->addBatchReading(readings, reading.sensorType, reading.value, reading.unit,
+                                    reading.endpointId,
+                                    TimeService::isValidUnixTime(reading.timestamp) ? reading.timestamp : 0);
     }
 
-    result.syncedCount = successCount;
-    result.failedCount = failCount;
-    result.success = (failCount == 0 || successCount > 0);
+    _apiClient->encodeBody(doc, slot.body);
+}
 
-    if (result.success && successCount > 0) {
-        // Mark readings as synced
-        std::vector<StoredReading> syncedReadings(readings.begin(),
-                                                   readings.begin() + successCount);
-        _storage->markAsSynced(syncedReadings);
+SyncResult SyncManager::sendBatch(SyncSlot& slot) {
+    SyncResult result;
+    result.success = false;
+    result.syncedCount = 0;
+    result.failedCount = 0;
+
+    int count = (int)slot.batch.readings.size();
+    if (_cancelUpload) {
+        result.error = "Sync cancelled";
+        return result;
     }
 
-    Serial.printf("[SyncManager] Batch result: %d synced, %d failed\n",
-                  successCount, failCount);
+    unsigned long start = millis();
+    BatchUploadResponse response = _apiClient->sendReadingBatch(slot.body);
+
+    if (response.statusCode == 415 && slot.body.msgPack) {
+        // Hub cannot read MessagePack: the client switched to JSON, repeat once
+        encodeBatch(slot);
+        response = _apiClient->sendReadingBatch(slot.body);
+    }
+
+    result.durationMs = millis() - start;
+    result.statusCode = response.statusCode;
+
+    if (response.successCount > 0) {
+        // The Hub has decided on every reading in the body: readings it rejected
+        // would be rejected again, resending the stored ones would duplicate them
+        result.syncedCount = count;
+        result.success = true;
+        result.statusCode = 0;
+        if (response.failedCount > 0) {
+            Serial.printf("[SyncManager] Hub rejected %d of %d readings: %s\n",
+                          response.failedCount, count, response.error.c_str());
+        }
+    } else {
+        // Nothing stored (HTTP error, unknown node): keep the whole batch
+        result.failedCount = count;
+        result.error = response.error.length() > 0 ? response.error : String("Send failed");
+    }
+
+    Serial.printf("[SyncManager] Batch result: %d synced, %d failed (%lu ms)\n",
+                  result.syncedCount, result.failedCount, (unsigned long)result.durationMs);
 
     return result;
 }
@@ -268,12 +451,16 @@ SyncResult SyncManager::sendBatch(const std::vector<StoredReading>& readings) {
 unsigned long SyncManager::calculateRetryDelay() {
     const StorageConfig& config = _configManager->getConfig();
 
-    // Exponential backoff
-    unsigned long delay = config.initialRetryDelayMs * (1 << _retryCount);
+    // Decorrelated jitter: nodes that failed together do not retry together
+    if (_retryCount <= 1) {
+        _retryJitter.configure(config.initialRetryDelayMs, config.maxRetryDelayMs);
+    }
+    unsigned long delay = _retryJitter.next();
 
-    // Cap at max delay
-    if (delay > config.maxRetryDelayMs) {
-        delay = config.maxRetryDelayMs;
+    // No point in retrying while the Hub circuit is open
+    unsigned long circuitWait = _apiClient->getCircuitWaitMs();
+    if (delay < circuitWait) {
+        delay = circuitWait;
     }
 
     return delay;
@@ -320,6 +507,7 @@ void SyncManager::handleSyncError(const String& error) {
     _retryCount++;
     _currentRetryDelay = calculateRetryDelay();
     _nextRetryTime = millis() + _currentRetryDelay;
+    _waitingForHub = CircuitBreaker::forHub().getState() != CircuitState::CLOSED;
 
     const StorageConfig& config = _configManager->getConfig();
 
@@ -346,6 +534,7 @@ void SyncManager::handleSyncError(const String& error) {
 void SyncManager::handleSyncSuccess(int syncedCount) {
     _retryCount = 0;
     _currentRetryDelay = 0;
+    _waitingForHub = false;
     _lastScheduledSync = millis();
 
     _storage->recordSyncSuccess(syncedCount);
@@ -3,18 +3,35 @@
  *
  * Manages automatic synchronization of local readings to the Hub API.
  * Part of Sprint OS-01: Offline-Speicher Implementation
+ *
+ * Sync runs as a pipeline: loop() reads the next batch from SD and encodes
+ * its /api/readings/batch body while an upload task sends the current one,
+ * up to syncPipelineDepth batches ahead. Batches are acknowledged strictly in read order, so the sync
+ * cursor only moves over readings the Hub has confirmed without a gap.
  */
 
 #ifndef SYNC_MANAGER_H
 #define SYNC_MANAGER_H
 
 #include <Arduino.h>
+#include <atomic>
+#include <deque>
 #include <functional>
+#include "api_client.h"
+#include "batch_sizer.h"
+#include "retry_policy.h"
 #include "reading_storage.h"
 #include "storage_config.h"
 
+#ifdef PLATFORM_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
 // Forward declarations
-class ApiClient;
 class WiFiManager;
 
 /**
@@ -35,6 +52,8 @@ struct SyncResult {
     int syncedCount;
     int failedCount;
     String error;
+    uint32_t durationMs = 0;    // Upload time (single batch)
+    int statusCode = 0;         // HTTP status of the failed request (0 = none)
 };
 
 /**
@@ -133,7 +152,26 @@ public:
      */
     bool isWifiAvailable() const;
 
+    /**
+     * Sync state, batch sizes and throughput as JSON object (heartbeat)
+     */
+    String getStatsJson() const;
+
 private:
+    /**
+     * One batch in the sync pipeline
+     */
+    struct SyncSlot {
+        enum State : uint8_t { READY, UPLOADING, DONE };
+
+        PendingBatch batch;
+        EncodedBody body;               // Request body, encoded on read-ahead
+        SyncResult result;
+        std::atomic<uint8_t> state;     // Written by loop (READY/UPLOADING) and upload task (DONE)
+
+        SyncSlot() : result{false, 0, 0, String()}, state(READY) {}
+    };
+
     ReadingStorage* _storage;
     StorageConfigManager* _configManager;
     ApiClient* _apiClient;
@@ -146,6 +184,8 @@ private:
     int _retryCount;
     unsigned long _currentRetryDelay;
     unsigned long _nextRetryTime;
+    DecorrelatedJitter _retryJitter;    // initialRetryDelayMs .. maxRetryDelayMs
+    bool _waitingForHub;                // Failed while the Hub circuit was open
 
     // Sync timing
     unsigned long _lastSyncAttempt;
@@ -161,20 +201,65 @@ private:
     // WiFi state tracking
     bool _wasWifiConnected;
 
+    // Pipeline (slots in read order; deque keeps slot addresses stable)
+    std::deque<SyncSlot> _slots;
+    std::atomic<SyncSlot*> _uploadSlot;     // Slot the upload task works on (nullptr = idle)
+    std::atomic<bool> _cancelUpload;
+    bool _runActive;
+    bool _runFailed;
+    bool _readExhausted;
+    SyncResult _runResult;
+    BatchSizer _batchSizer;
+
+#ifdef PLATFORM_ESP32
+    TaskHandle_t _uploadTask;
+    static void uploadTaskEntry(void* param);
+#else
+    std::mutex _uploadMutex;
+    std::condition_variable _uploadCv;
+#endif
+
+    /**
+     * Start a sync run
+     * @return false if sync is not possible (result in _runResult)
+     */
+    bool startRun();
+
+    /**
+     * One pipeline step: acknowledge, read ahead, hand a batch to the upload task
+     */
+    void processPipeline();
+
+    /**
+     * End the sync run (upload task idle) and report its result
+     */
+    void finishRun();
+
+    /**
+     * Start the upload task
+     */
+    bool startUploader();
+
+    /**
+     * Upload task body
+     */
+    void runUploader();
+
     /**
-     * Perform the actual sync operation
+     * Encode the batch as one CreateBatchReadingsDto body (read-ahead)
      */
-    SyncResult performSync();
+    void encodeBatch(SyncSlot& slot);
 
     /**
-     * Send batch to API
-     * @param readings readings to send
+     * Send batch to API in one request (upload task)
+     * The Hub stores the whole body or, if it stores nothing, the batch fails.
+     * @param slot batch with its encoded body
      * @return sync result
      */
-    SyncResult sendBatch(const std::vector<StoredReading>& readings);
+    SyncResult sendBatch(SyncSlot& slot);
 
     /**
-     * Calculate next retry delay (exponential backoff)
+     * Calculate next retry delay (decorrelated jitter, at least the circuit wait)
      */
     unsigned long calculateRetryDelay();
 
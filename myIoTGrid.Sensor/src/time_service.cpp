@@ -0,0 +1,316 @@
+/**
+ * myIoTGrid.Sensor - Time Service Implementation
+ */
+
+#include "time_service.h"
+
+#include <sys/time.h>
+#include <time.h>
+
+#ifdef PLATFORM_ESP32
+#include <esp_sntp.h>
+#include <esp_timer.h>
+#else
+#include <chrono>
+#endif
+
+namespace {
+
+// Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant's algorithm)
+int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = (unsigned)(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+uint64_t systemClockEpochMs() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return (uint64_t)tv.tv_sec * 1000ULL + (uint64_t)(tv.tv_usec / 1000);
+}
+
+#ifdef PLATFORM_ESP32
+void onSntpNotification(struct timeval* tv) {
+    uint64_t epochMs = (uint64_t)tv->tv_sec * 1000ULL + (uint64_t)(tv->tv_usec / 1000);
+    TimeService::getInstance().onSntpSync(epochMs);
+}
+#endif
+
+} // namespace
+
+TimeService& TimeService::getInstance() {
+    static TimeService instance;
+    return instance;
+}
+
+TimeService::TimeService()
+    : _source(TimeSource::NONE)
+    , _offsetMs(0)
+    , _syncMonoMs(0)
+    , _syncUncertaintyMs(UINT32_MAX)
+    , _driftPpm(0.0)
+    , _driftValid(false)
+    , _lastIssuedMs(0)
+    , _syncCount(0)
+    , _rejectedCount(0)
+{
+}
+
+uint64_t TimeService::monotonicMs() {
+#ifdef PLATFORM_ESP32
+    return (uint64_t)(esp_timer_get_time() / 1000);
+#else
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void TimeService::begin() {
+#ifdef PLATFORM_ESP32
+    sntp_set_time_sync_notification_cb(onSntpNotification);
+
+    // RTC time survives a software reset; only trust it once re-synced
+    Serial.println("[Time] Waiting for SNTP / Hub time");
+#else
+    // Host clock is NTP-disciplined by the OS
+    onSntpSync(systemClockEpochMs());
+#endif
+}
+
+void TimeService::startSntp() {
+#ifdef PLATFORM_ESP32
+    // Offsets only affect localtime() (logs); time() and all stamps stay UTC
+    configTime(3600, 3600, config::TIME_NTP_SERVER_1, config::TIME_NTP_SERVER_2, config::TIME_NTP_SERVER_3);
+    Serial.printf("[Time] SNTP started (%s)\n", config::TIME_NTP_SERVER_1);
+#endif
+}
+
+bool TimeService::waitForSync(uint32_t timeoutMs) {
+    unsigned long start = millis();
+    while (!isSynced()) {
+        if (millis() - start >= timeoutMs) {
+            return false;
+        }
+        delay(100);
+    }
+    return true;
+}
+
+void TimeService::onSntpSync(uint64_t epochMs) {
+    uint64_t mono = monotonicMs();
+    std::lock_guard<std::mutex> lock(_mutex);
+    applySync(TimeSource::SNTP, mono, epochMs, config::TIME_SNTP_UNCERTAINTY_MS);
+}
+
+void TimeService::disciplineFromHub(uint64_t serverTimeMs, uint32_t roundTripMs) {
+    if (serverTimeMs < (uint64_t)config::TIME_MIN_VALID_UNIX * 1000ULL) {
+        return;
+    }
+
+    uint64_t mono = monotonicMs();
+    // Server stamp was taken somewhere within the round trip; assume the midpoint
+    uint64_t epochMs = serverTimeMs + roundTripMs / 2;
+    uint32_t uncertainty = config::TIME_HUB_BASE_UNCERTAINTY_MS + roundTripMs / 2;
+
+    bool setClock = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // Only replace a better estimate (e.g. recent SNTP) if it has decayed below ours
+        if (_source != TimeSource::NONE && uncertaintyAtLocked(mono) <= uncertainty) {
+            _rejectedCount++;
+            return;
+        }
+
+        setClock = (_source != TimeSource::SNTP);
+        applySync(TimeSource::HUB, mono, epochMs, uncertainty);
+    }
+
+    // Without SNTP, also set the system clock so time() is usable (SD file names)
+    if (setClock) {
+        setSystemClock(epochMs);
+    }
+}
+
+void TimeService::applySync(TimeSource source, uint64_t monoMs, uint64_t epochMs, uint32_t uncertaintyMs) {
+    int64_t newOffset = (int64_t)epochMs - (int64_t)monoMs;
+
+    // Drift: offset change between two syncs over the elapsed monotonic time.
+    // Positive = local clock runs fast (offset shrinks).
+    if (_source != TimeSource::NONE && monoMs > _syncMonoMs &&
+        monoMs - _syncMonoMs >= config::TIME_DRIFT_MIN_INTERVAL_MS) {
+        double elapsed = (double)(monoMs - _syncMonoMs);
+        double ppm = (double)(_offsetMs - newOffset) / elapsed * 1e6;
+
+        if (ppm > -config::TIME_DRIFT_MAX_PPM && ppm < config::TIME_DRIFT_MAX_PPM) {
+            _driftPpm = _driftValid
+                ? _driftPpm + config::TIME_DRIFT_EWMA_ALPHA * (ppm - _driftPpm)
+                : ppm;
+            _driftValid = true;
+        }
+    }
+
+    if (_source == TimeSource::NONE) {
+        time_t seconds = (time_t)(epochMs / 1000);
+        struct tm tm;
+        gmtime_r(&seconds, &tm);
+        Serial.printf("[Time] Synced via %s: %04d-%02d-%02d %02d:%02d:%02d UTC (±%lu ms)\n",
+                      getSourceName(source),
+                      tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                      tm.tm_hour, tm.tm_min, tm.tm_sec, (unsigned long)uncertaintyMs);
+    }
+
+    _source = source;
+    _offsetMs = newOffset;
+    _syncMonoMs = monoMs;
+    _syncUncertaintyMs = uncertaintyMs;
+    _syncCount++;
+}
+
+void TimeService::setSystemClock(uint64_t epochMs) {
+    struct timeval tv;
+    tv.tv_sec = (time_t)(epochMs / 1000);
+    tv.tv_usec = (suseconds_t)((epochMs % 1000) * 1000);
+#ifdef PLATFORM_ESP32
+    settimeofday(&tv, nullptr);
+#else
+    (void)tv;   // Never touch the host clock
+#endif
+}
+
+bool TimeService::isSynced() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _source != TimeSource::NONE;
+}
+
+TimeSource TimeService::getSource() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _source;
+}
+
+const char* TimeService::getSourceName(TimeSource source) {
+    switch (source) {
+        case TimeSource::HUB: return "hub";
+        case TimeSource::SNTP: return "sntp";
+        default: return "none";
+    }
+}
+
+uint64_t TimeService::toEpochMsLocked(uint64_t monoMs) const {
+    if (_source == TimeSource::NONE) return 0;
+
+    // Correct the measured drift since the sync point
+    int64_t sinceSync = (int64_t)monoMs - (int64_t)_syncMonoMs;
+    int64_t correction = _driftValid ? (int64_t)((double)sinceSync * _driftPpm / 1e6) : 0;
+    int64_t epoch = (int64_t)monoMs + _offsetMs - correction;
+    return epoch > 0 ? (uint64_t)epoch : 0;
+}
+
+uint32_t TimeService::uncertaintyAtLocked(uint64_t monoMs) const {
+    if (_source == TimeSource::NONE) return UINT32_MAX;
+
+    uint64_t sinceSync = monoMs > _syncMonoMs ? monoMs - _syncMonoMs : _syncMonoMs - monoMs;
+    // Residual drift: the estimate error once measured, the crystal tolerance before
+    double ppm = _driftValid ? config::TIME_ASSUMED_DRIFT_PPM / 5.0 : config::TIME_ASSUMED_DRIFT_PPM;
+    double total = _syncUncertaintyMs + (double)sinceSync * ppm / 1e6;
+    return total >= (double)UINT32_MAX ? UINT32_MAX : (uint32_t)total;
+}
+
+uint64_t TimeService::nowEpochMs() {
+    uint64_t mono = monotonicMs();
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    uint64_t epoch = toEpochMsLocked(mono);
+    if (epoch == 0) return 0;
+
+    // A re-sync may step the clock back; never hand out earlier times
+    if (epoch < _lastIssuedMs) {
+        epoch = _lastIssuedMs;
+    }
+    _lastIssuedMs = epoch;
+    return epoch;
+}
+
+uint64_t TimeService::toEpochMs(uint64_t monoMs) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return toEpochMsLocked(monoMs);
+}
+
+uint32_t TimeService::getUncertaintyMs() const {
+    uint64_t mono = monotonicMs();
+    std::lock_guard<std::mutex> lock(_mutex);
+    return uncertaintyAtLocked(mono);
+}
+
+float TimeService::getDriftPpm() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (float)_driftPpm;
+}
+
+uint64_t TimeService::parseIso8601Ms(const char* text) {
+    if (!text) return 0;
+
+    int year, month, day, hour, minute, second;
+    int consumed = 0;
+    if (sscanf(text, "%4d-%2d-%2dT%2d:%2d:%2d%n",
+               &year, &month, &day, &hour, &minute, &second, &consumed) != 6) {
+        return 0;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 ||
+        hour > 23 || minute > 59 || second > 60) {
+        return 0;
+    }
+
+    const char* p = text + consumed;
+
+    // Fraction (.NET sends up to 7 digits)
+    uint32_t millisPart = 0;
+    if (*p == '.') {
+        p++;
+        uint32_t scale = 100;
+        while (*p >= '0' && *p <= '9') {
+            millisPart += (uint32_t)(*p - '0') * scale;
+            scale /= 10;
+            p++;
+        }
+    }
+
+    // Zone: Z, +hh:mm / -hh:mm; none = UTC
+    int64_t offsetMinutes = 0;
+    if (*p == '+' || *p == '-') {
+        int sign = (*p == '-') ? -1 : 1;
+        int oh = 0, om = 0;
+        if (sscanf(p + 1, "%2d:%2d", &oh, &om) < 1) return 0;
+        offsetMinutes = sign * (oh * 60 + om);
+    }
+
+    int64_t days = daysFromCivil(year, (unsigned)month, (unsigned)day);
+    int64_t seconds = days * 86400 + hour * 3600 + minute * 60 + second - offsetMinutes * 60;
+    if (seconds <= 0) return 0;
+
+    return (uint64_t)seconds * 1000ULL + millisPart;
+}
+
+String TimeService::getStatusJson() const {
+    uint64_t mono = monotonicMs();
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    char buf[192];
+    if (_source == TimeSource::NONE) {
+        snprintf(buf, sizeof(buf), "{\"source\":\"none\",\"synced\":false}");
+    } else {
+        snprintf(buf, sizeof(buf),
+                 "{\"source\":\"%s\",\"synced\":true,\"uncertaintyMs\":%lu,"
+                 "\"driftPpm\":%.1f,\"lastSyncAgeSeconds\":%lu,\"syncs\":%lu,\"rejected\":%lu}",
+                 getSourceName(_source),
+                 (unsigned long)uncertaintyAtLocked(mono),
+                 _driftValid ? _driftPpm : 0.0,
+                 (unsigned long)((mono - _syncMonoMs) / 1000),
+                 (unsigned long)_syncCount,
+                 (unsigned long)_rejectedCount);
+    }
+    return String(buf);
+}
@@ -5,6 +5,8 @@
  */
 
 #include "uart_manager.h"
+#include "sr04m2_decoder.h"
+#include "config.h"
 
 #ifdef PLATFORM_ESP32
 
@@ -26,6 +28,7 @@ UARTManager::UARTManager()
         _allocations[i].owner = "";
         _allocations[i].serial = nullptr;
         _allocations[i].useEspIdf = false;
+        _eventQueues[i] = nullptr;
     }
 }
 
@@ -153,8 +156,9 @@ bool UARTManager::initEspIdf(int uartNum, int rxPin, int txPin, int baudRate) {
         return false;
     }
 
-    // Install UART driver with RX buffer
-    err = uart_driver_install(uart_port, 256, 0, 0, NULL, 0);
+    // Install UART driver with RX buffer and event queue (for frame decoders)
+    err = uart_driver_install(uart_port, 256, 0, config::UART_EVENT_QUEUE_SIZE,
+                              &_eventQueues[uartNum - 1], 0);
     if (err != ESP_OK) {
         Serial.printf("[UARTManager] uart_driver_install failed: %d\n", err);
         return false;
@@ -172,8 +176,17 @@ void UARTManager::endUart(int uartNum) {
     int idx = uartNum - 1;
 
     if (_allocations[idx].useEspIdf) {
+        // The decoder task blocks on the driver's event queue, which
+        // uart_driver_delete() frees: stop it first
+        Sr04m2Decoder& decoder = Sr04m2Decoder::getInstance();
+        if (decoder.isRunningOn(uartNum)) {
+            Serial.printf("[UARTManager] Stopping SR04M-2 decoder on UART%d\n", uartNum);
+            decoder.stop();
+        }
+
         uart_port_t uart_port = (uartNum == 1) ? UART_NUM_1 : UART_NUM_2;
         uart_driver_delete(uart_port);
+        _eventQueues[idx] = nullptr;  // Freed by the driver
     } else {
         HardwareSerial* serial = _allocations[idx].serial;
         if (serial) {
@@ -194,6 +207,16 @@ HardwareSerial* UARTManager::getSerial(int uartNum) {
     return _allocations[idx].serial;
 }
 
+QueueHandle_t UARTManager::getEventQueue(int uartNum) {
+    if (uartNum < 1 || uartNum > 2) return nullptr;
+    int idx = uartNum - 1;
+
+    if (_allocations[idx].uartNum < 0) return nullptr;
+    if (!_allocations[idx].useEspIdf) return nullptr;
+
+    return _eventQueues[idx];
+}
+
 int UARTManager::getUartForOwner(const String& owner) {
     for (int i = 0; i < 2; i++) {
         if (_allocations[i].uartNum > 0 && _allocations[i].owner == owner) {
@@ -3,9 +3,11 @@
  */
 
 #include "wifi_manager.h"
+#include "config.h"
 
 #ifdef PLATFORM_ESP32
 #include <WiFi.h>
+#include <Preferences.h>
 #endif
 
 WiFiManager::WiFiManager()
@@ -24,20 +26,32 @@ bool WiFiManager::connect(const String& ssid, const String& password, int timeou
     Serial.printf("[WiFi] Connecting to %s...\n", ssid.c_str());
 
 #ifdef PLATFORM_ESP32
+    WiFi.persistent(false);  // Credentials live in ConfigManager - no flash write per begin()
     WiFi.mode(WIFI_STA);
-    WiFi.begin(ssid.c_str(), password.c_str());
 
     unsigned long start = millis();
-    while (WiFi.status() != WL_CONNECTED && (millis() - start) < timeoutMs) {
-        delay(500);
-        Serial.print(".");
+    bool fastConnect = tryFastConnect(ssid, password);
+    if (!fastConnect) {
+        WiFi.begin(ssid.c_str(), password.c_str());
+        waitForConnection(timeoutMs);
     }
     Serial.println();
 
     if (WiFi.status() == WL_CONNECTED) {
         _status = WiFiStatus::CONNECTED;
+        _stats.lastConnectMs = millis() - start;
+        _stats.lastFastConnect = fastConnect;
+        if (fastConnect) {
+            _stats.fastConnects++;
+        } else {
+            _stats.fullConnects++;
+        }
+
         String ip = WiFi.localIP().toString();
-        Serial.printf("[WiFi] Connected! IP: %s\n", ip.c_str());
+        Serial.printf("[WiFi] Connected! IP: %s (%lu ms, %s)\n", ip.c_str(),
+                      (unsigned long)_stats.lastConnectMs, fastConnect ? "fast connect" : "full scan");
+
+        saveFastConnect(ssid);
 
         if (_onConnected) {
             _onConnected(ip);
@@ -135,6 +149,7 @@ void WiFiManager::attemptReconnect() {
 
     _reconnectAttempts++;
     _lastReconnectAttempt = millis();
+    _stats.reconnects++;
 
     Serial.printf("[WiFi] Reconnect attempt %d/%d\n", _reconnectAttempts, MAX_RECONNECT_ATTEMPTS);
 
@@ -154,3 +169,144 @@ void WiFiManager::onDisconnected(OnWiFiDisconnected callback) {
 void WiFiManager::onFailed(OnWiFiFailed callback) {
     _onFailed = callback;
 }
+
+String WiFiManager::getConnectStatsJson() const {
+    String json = "{";
+    json += "\"lastConnectMs\":" + String((unsigned long)_stats.lastConnectMs) + ",";
+    json += "\"lastFastConnect\":" + String(_stats.lastFastConnect ? "true" : "false") + ",";
+    json += "\"fastConnects\":" + String((unsigned long)_stats.fastConnects) + ",";
+    json += "\"fullConnects\":" + String((unsigned long)_stats.fullConnects) + ",";
+    json += "\"fastFallbacks\":" + String((unsigned long)_stats.fastFallbacks) + ",";
+    json += "\"reconnects\":" + String((unsigned long)_stats.reconnects) + ",";
+    json += "\"rssi\":" + String(getRSSI());
+    json += "}";
+    return json;
+}
+
+#ifdef PLATFORM_ESP32
+bool WiFiManager::waitForConnection(unsigned long timeoutMs) {
+    unsigned long start = millis();
+    unsigned long lastDot = start;
+
+    // Short poll: association often completes in a few hundred ms
+    while (WiFi.status() != WL_CONNECTED && (millis() - start) < timeoutMs) {
+        delay(config::WIFI_CONNECT_POLL_MS);
+        if (millis() - lastDot >= 500) {
+            lastDot = millis();
+            Serial.print(".");
+        }
+    }
+    return WiFi.status() == WL_CONNECTED;
+}
+
+bool WiFiManager::tryFastConnect(const String& ssid, const String& password) {
+    if (!config::WIFI_FAST_CONNECT_ENABLED) {
+        return false;
+    }
+
+    Preferences prefs;
+    if (!prefs.begin(config::WIFI_FAST_NVS_NAMESPACE, true)) {
+        return false;  // Nothing cached yet
+    }
+
+    String cachedSsid = prefs.getString("ssid", "");
+    uint8_t bssid[6];
+    bool haveBssid = prefs.isKey("bssid") && prefs.getBytes("bssid", bssid, sizeof(bssid)) == sizeof(bssid);
+    int32_t channel = prefs.getUChar("channel", 0);
+    uint32_t ip = prefs.getUInt("ip", 0);
+    uint32_t gateway = prefs.getUInt("gw", 0);
+    uint32_t subnet = prefs.getUInt("mask", 0);
+    uint32_t dns = prefs.getUInt("dns", 0);
+    prefs.end();
+
+    if (cachedSsid != ssid || !haveBssid || channel == 0) {
+        return false;
+    }
+
+    bool reuseLease = config::WIFI_REUSE_IP_LEASE && ip != 0;
+    if (reuseLease) {
+        WiFi.config(IPAddress(ip), IPAddress(gateway), IPAddress(subnet), IPAddress(dns));
+    }
+
+    Serial.printf("[WiFi] Fast connect: BSSID %02X:%02X:%02X:%02X:%02X:%02X, channel %d%s\n",
+                  bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5],
+                  (int)channel, reuseLease ? ", cached IP" : "");
+
+    // Direct connect: no channel scan
+    WiFi.begin(ssid.c_str(), password.c_str(), channel, bssid);
+    if (waitForConnection(config::WIFI_FAST_CONNECT_TIMEOUT_MS)) {
+        return true;
+    }
+
+    Serial.println();
+    Serial.println("[WiFi] Fast connect failed - falling back to full scan");
+    _stats.fastFallbacks++;
+    WiFi.disconnect();
+    if (reuseLease) {
+        WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);  // Back to DHCP
+    }
+    return false;
+}
+
+void WiFiManager::saveFastConnect(const String& ssid) {
+    if (!config::WIFI_FAST_CONNECT_ENABLED) {
+        return;
+    }
+
+    uint8_t* bssid = WiFi.BSSID();
+    if (bssid == nullptr) {
+        return;
+    }
+
+    uint8_t channel = (uint8_t)WiFi.channel();
+    uint32_t ip = (uint32_t)WiFi.localIP();
+
+    Preferences prefs;
+    if (!prefs.begin(config::WIFI_FAST_NVS_NAMESPACE, false)) {
+        return;
+    }
+
+    // Only write on change (flash wear)
+    uint8_t cachedBssid[6];
+    bool changed = prefs.getString("ssid", "") != ssid ||
+                   prefs.getUChar("channel", 0) != channel ||
+                   prefs.getUInt("ip", 0) != ip ||
+                   !prefs.isKey("bssid") ||
+                   prefs.getBytes("bssid", cachedBssid, sizeof(cachedBssid)) != sizeof(cachedBssid) ||
+                   memcmp(cachedBssid, bssid, sizeof(cachedBssid)) != 0;
+
+    if (changed) {
+        prefs.putString("ssid", ssid);
+        prefs.putBytes("bssid", bssid, 6);
+        prefs.putUChar("channel", channel);
+        prefs.putUInt("ip", ip);
+        prefs.putUInt("gw", (uint32_t)WiFi.gatewayIP());
+        prefs.putUInt("mask", (uint32_t)WiFi.subnetMask());
+        prefs.putUInt("dns", (uint32_t)WiFi.dnsIP());
+        Serial.printf("[WiFi] Fast-connect cache updated (channel %d)\n", channel);
+    }
+    prefs.end();
+}
+
+void WiFiManager::clearFastConnectCache() {
+    Preferences prefs;
+    if (prefs.begin(config::WIFI_FAST_NVS_NAMESPACE, false)) {
+        prefs.clear();
+        prefs.end();
+    }
+}
+#else
+bool WiFiManager::waitForConnection(unsigned long timeoutMs) {
+    return _status == WiFiStatus::CONNECTED;
+}
+
+bool WiFiManager::tryFastConnect(const String& ssid, const String& password) {
+    return false;
+}
+
+void WiFiManager::saveFastConnect(const String& ssid) {
+}
+
+void WiFiManager::clearFastConnectCache() {
+}
+#endif
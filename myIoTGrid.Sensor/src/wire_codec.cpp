@@ -0,0 +1,334 @@
+/**
+ * myIoTGrid.Sensor - Wire Codec Implementation
+ */
+
+#include "wire_codec.h"
+
+#include <climits>
+#include <cstring>
+#include <string>
+
+namespace wire {
+
+namespace {
+
+// Index = schema key (see wire::Key); append only
+const char* const KEY_NAMES[] = {
+    nullptr,
+    "deviceId", "type", "value", "unit", "timestamp", "endpointId",
+    "nodeId", "serialNumber", "firmwareVersion", "batteryLevel",
+    "readings", "sensorType", "aggregate", "count", "min", "max", "stddev", "last", "windowSeconds",
+    "success", "serverTime", "nextHeartbeatSeconds", "wifi", "pipeline", "time", "compression",
+    "name", "isSimulation", "defaultIntervalSeconds", "storageMode", "sensors",
+    "sensorCode", "sensorName", "icon", "color", "isActive", "intervalSeconds", "i2CAddress",
+    "sdaPin", "sclPin", "oneWirePin", "analogPin", "digitalPin", "triggerPin", "echoPin", "baudRate",
+    "offsetCorrection", "gainCorrection", "aggregationWindowSeconds",
+    "capabilities", "measurementType", "displayName",
+    "deadbandAbsolute", "deadbandPercent", "deadbandSlopePerMinute", "maxSilenceSeconds",
+    "configurationChanged", "wireFormat", "hardwareType",
+    "location", "isNewNode", "message", "connection", "endpoint",
+    "sync", "metrics", "loop",
+};
+
+static_assert(sizeof(KEY_NAMES) / sizeof(KEY_NAMES[0]) == KEY_COUNT_END,
+              "wire schema names out of sync with wire::Key");
+
+constexpr int MAX_DEPTH = 10;
+
+// ----------------------------------------------------------------------------
+// Encoder
+// ----------------------------------------------------------------------------
+
+void putBigEndian(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for (int i = bytes - 1; i >= 0; i--) {
+        out.push_back((uint8_t)(value >> (8 * i)));
+    }
+}
+
+void putUnsigned(std::vector<uint8_t>& out, uint64_t value) {
+    if (value < 0x80) {
+        out.push_back((uint8_t)value);                  // positive fixint
+    } else if (value <= 0xFF) {
+        out.push_back(0xCC); putBigEndian(out, value, 1);
+    } else if (value <= 0xFFFF) {
+        out.push_back(0xCD); putBigEndian(out, value, 2);
+    } else if (value <= 0xFFFFFFFFULL) {
+        out.push_back(0xCE); putBigEndian(out, value, 4);
+    } else {
+        out.push_back(0xCF); putBigEndian(out, value, 8);
+    }
+}
+
+void putSigned(std::vector<uint8_t>& out, int64_t value) {
+    if (value >= 0) {
+        putUnsigned(out, (uint64_t)value);
+    } else if (value >= -32) {
+        out.push_back((uint8_t)(int8_t)value);          // negative fixint
+    } else if (value >= INT8_MIN) {
+        out.push_back(0xD0); putBigEndian(out, (uint8_t)(int8_t)value, 1);
+    } else if (value >= INT16_MIN) {
+        out.push_back(0xD1); putBigEndian(out, (uint16_t)(int16_t)value, 2);
+    } else if (value >= INT32_MIN) {
+        out.push_back(0xD2); putBigEndian(out, (uint32_t)(int32_t)value, 4);
+    } else {
+        out.push_back(0xD3); putBigEndian(out, (uint64_t)value, 8);
+    }
+}
+
+void putFloat(std::vector<uint8_t>& out, double value) {
+    float narrow = (float)value;
+    if ((double)narrow == value) {
+        uint32_t bits;
+        memcpy(&bits, &narrow, sizeof(bits));
+        out.push_back(0xCA); putBigEndian(out, bits, 4);
+    } else {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        out.push_back(0xCB); putBigEndian(out, bits, 8);
+    }
+}
+
+void putString(std::vector<uint8_t>& out, const char* str, size_t length) {
+    if (length < 32) {
+        out.push_back((uint8_t)(0xA0 | length));
+    } else if (length <= 0xFF) {
+        out.push_back(0xD9); putBigEndian(out, length, 1);
+    } else if (length <= 0xFFFF) {
+        out.push_back(0xDA); putBigEndian(out, length, 2);
+    } else {
+        out.push_back(0xDB); putBigEndian(out, length, 4);
+    }
+    out.insert(out.end(), (const uint8_t*)str, (const uint8_t*)str + length);
+}
+
+void putContainerHeader(std::vector<uint8_t>& out, size_t count, uint8_t fixBase, uint8_t code16) {
+    if (count < 16) {
+        out.push_back((uint8_t)(fixBase | count));
+    } else if (count <= 0xFFFF) {
+        out.push_back(code16); putBigEndian(out, count, 2);
+    } else {
+        out.push_back((uint8_t)(code16 + 1)); putBigEndian(out, count, 4);
+    }
+}
+
+void encodeValue(JsonVariantConst value, std::vector<uint8_t>& out, int depth) {
+    if (depth > MAX_DEPTH || value.isNull()) {
+        out.push_back(0xC0);
+    } else if (value.is<bool>()) {
+        out.push_back(value.as<bool>() ? 0xC3 : 0xC2);
+    } else if (value.is<JsonObjectConst>()) {
+        JsonObjectConst obj = value.as<JsonObjectConst>();
+        putContainerHeader(out, obj.size(), 0x80, 0xDE);
+        for (JsonPairConst kv : obj) {
+            const char* name = kv.key().c_str();
+            uint8_t key = keyOf(name);
+            if (key != 0) {
+                putUnsigned(out, key);
+            } else {
+                putString(out, name, strlen(name));
+            }
+            encodeValue(kv.value(), out, depth + 1);
+        }
+    } else if (value.is<JsonArrayConst>()) {
+        JsonArrayConst arr = value.as<JsonArrayConst>();
+        putContainerHeader(out, arr.size(), 0x90, 0xDC);
+        for (JsonVariantConst item : arr) {
+            encodeValue(item, out, depth + 1);
+        }
+    } else if (value.is<long>()) {
+        putSigned(out, value.as<long>());
+    } else if (value.is<unsigned long>()) {
+        putUnsigned(out, value.as<unsigned long>());
+    } else if (value.is<double>()) {
+        putFloat(out, value.as<double>());
+    } else if (value.is<const char*>()) {
+        const char* str = value.as<const char*>();
+        putString(out, str, strlen(str));
+    } else {
+        out.push_back(0xC0);    // serialized() raw JSON
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Decoder
+// ----------------------------------------------------------------------------
+
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t length) : _p(data), _end(data + length) {}
+
+    bool atEnd() const { return _p == _end; }
+
+    DeserializationError readValue(JsonVariant dst, int depth) {
+        if (depth > MAX_DEPTH) return DeserializationError::TooDeep;
+
+        uint8_t code;
+        if (!take(code)) return DeserializationError::IncompleteInput;
+
+        if (code < 0x80) { dst.set((long)code); return DeserializationError::Ok; }
+        if (code >= 0xE0) { dst.set((long)(int8_t)code); return DeserializationError::Ok; }
+        if ((code & 0xF0) == 0x80) return readMap(dst, code & 0x0F, depth);
+        if ((code & 0xF0) == 0x90) return readArray(dst, code & 0x0F, depth);
+        if ((code & 0xE0) == 0xA0) return readString(dst, code & 0x1F);
+
+        uint64_t n;
+        switch (code) {
+            case 0xC0: dst.set(nullptr); return DeserializationError::Ok;
+            case 0xC2: dst.set(false); return DeserializationError::Ok;
+            case 0xC3: dst.set(true); return DeserializationError::Ok;
+            case 0xCA: {
+                if (!readBigEndian(n, 4)) break;
+                uint32_t bits = (uint32_t)n;
+                float f;
+                memcpy(&f, &bits, sizeof(f));
+                dst.set((double)f);
+                return DeserializationError::Ok;
+            }
+            case 0xCB: {
+                if (!readBigEndian(n, 8)) break;
+                double d;
+                memcpy(&d, &n, sizeof(d));
+                dst.set(d);
+                return DeserializationError::Ok;
+            }
+            case 0xCC: case 0xCD: case 0xCE: case 0xCF:
+                if (!readBigEndian(n, 1 << (code - 0xCC))) break;
+                setUnsigned(dst, n);
+                return DeserializationError::Ok;
+            case 0xD0: case 0xD1: case 0xD2: case 0xD3: {
+                int bytes = 1 << (code - 0xD0);
+                if (!readBigEndian(n, bytes)) break;
+                int shift = 64 - 8 * bytes;
+                int64_t v = (int64_t)(n << shift) >> shift;     // Sign-extend
+                if (v >= LONG_MIN && v <= LONG_MAX) dst.set((long)v);
+                else dst.set((double)v);
+                return DeserializationError::Ok;
+            }
+            case 0xD9: case 0xDA: case 0xDB:
+                if (!readBigEndian(n, 1 << (code - 0xD9))) break;
+                return readString(dst, n);
+            case 0xDC: case 0xDD:
+                if (!readBigEndian(n, code == 0xDC ? 2 : 4)) break;
+                return readArray(dst, n, depth);
+            case 0xDE: case 0xDF:
+                if (!readBigEndian(n, code == 0xDE ? 2 : 4)) break;
+                return readMap(dst, n, depth);
+            default:
+                return DeserializationError::InvalidInput;  // bin, ext
+        }
+        return DeserializationError::IncompleteInput;
+    }
+
+private:
+    const uint8_t* _p;
+    const uint8_t* _end;
+
+    bool take(uint8_t& byte) {
+        if (_p >= _end) return false;
+        byte = *_p++;
+        return true;
+    }
+
+    bool readBigEndian(uint64_t& value, int bytes) {
+        if (_end - _p < bytes) return false;
+        value = 0;
+        for (int i = 0; i < bytes; i++) value = (value << 8) | *_p++;
+        return true;
+    }
+
+    static void setUnsigned(JsonVariant dst, uint64_t n) {
+        if (n <= ULONG_MAX) dst.set((unsigned long)n);
+        else dst.set((double)n);
+    }
+
+    bool readRaw(uint64_t length, std::string& out) {
+        if ((uint64_t)(_end - _p) < length) return false;
+        out.assign((const char*)_p, (size_t)length);
+        _p += length;
+        return true;
+    }
+
+    DeserializationError readString(JsonVariant dst, uint64_t length) {
+        std::string str;
+        if (!readRaw(length, str)) return DeserializationError::IncompleteInput;
+        dst.set(str);
+        return DeserializationError::Ok;
+    }
+
+    DeserializationError readArray(JsonVariant dst, uint64_t count, int depth) {
+        JsonArray arr = dst.to<JsonArray>();
+        for (uint64_t i = 0; i < count; i++) {
+            DeserializationError err = readValue(arr.add<JsonVariant>(), depth + 1);
+            if (err) return err;
+        }
+        return DeserializationError::Ok;
+    }
+
+    DeserializationError readMap(JsonVariant dst, uint64_t count, int depth) {
+        JsonObject obj = dst.to<JsonObject>();
+        for (uint64_t i = 0; i < count; i++) {
+            uint8_t code;
+            if (!take(code)) return DeserializationError::IncompleteInput;
+
+            JsonVariant child;
+            uint64_t n;
+            if (code < 0x80 || code == 0xCC) {
+                // Schema key (unknown keys from a newer Hub keep their number)
+                n = code;
+                if (code == 0xCC && !readBigEndian(n, 1)) return DeserializationError::IncompleteInput;
+                const char* name = keyName((uint32_t)n);
+                child = name ? obj[name].to<JsonVariant>()
+                             : obj[std::to_string(n)].to<JsonVariant>();
+            } else if ((code & 0xE0) == 0xA0 || code == 0xD9) {
+                n = code & 0x1F;
+                if (code == 0xD9 && !readBigEndian(n, 1)) return DeserializationError::IncompleteInput;
+                std::string key;
+                if (!readRaw(n, key)) return DeserializationError::IncompleteInput;
+                child = obj[key].to<JsonVariant>();
+            } else {
+                return DeserializationError::InvalidInput;
+            }
+
+            DeserializationError err = readValue(child, depth + 1);
+            if (err) return err;
+        }
+        return DeserializationError::Ok;
+    }
+};
+
+} // namespace
+
+const char* keyName(uint32_t key) {
+    return (key > 0 && key < KEY_COUNT_END) ? KEY_NAMES[key] : nullptr;
+}
+
+uint8_t keyOf(const char* name) {
+    if (!name) return 0;
+    for (uint8_t key = 1; key < KEY_COUNT_END; key++) {
+        if (strcmp(KEY_NAMES[key], name) == 0) return key;
+    }
+    return 0;
+}
+
+bool isMsgPackContentType(const String& contentType) {
+    return strncmp(contentType.c_str(), CONTENT_TYPE_MSGPACK, strlen(CONTENT_TYPE_MSGPACK)) == 0;
+}
+
+void encodeMsgPack(JsonVariantConst value, std::vector<uint8_t>& out) {
+    out.clear();
+    encodeValue(value, out, 0);
+}
+
+DeserializationError decodeMsgPack(const uint8_t* data, size_t length, JsonDocument& doc) {
+    doc.clear();
+    if (length == 0) return DeserializationError::EmptyInput;
+
+    Reader reader(data, length);
+    DeserializationError err = reader.readValue(doc.to<JsonVariant>(), 0);
+    if (err) return err;
+    if (!reader.atEnd()) return DeserializationError::InvalidInput;
+    if (doc.overflowed()) return DeserializationError::NoMemory;
+    return DeserializationError::Ok;
+}
+
+} // namespace wire
@@ -0,0 +1,176 @@
+/**
+ * @file test_batch_sizer.cpp
+ * @brief Tests for the AIMD sync batch size
+ *
+ * Every batch is one /api/readings/batch request, modelled as a fixed
+ * request overhead (TLS, Hub round trip) plus a transfer time per reading.
+ *
+ * pio test -e native_test -f test_batch_sizer
+ */
+
+#include <unity.h>
+
+#include "config.h"
+#include "batch_sizer.h"
+
+// ============================================================
+// HELPERS
+// ============================================================
+
+static const uint32_t HEAP_PLENTY = 4u * 1024 * 1024;
+static const int RSSI_GOOD = -50;
+static const int SLOTS = 2;
+
+/**
+ * Request time of a batch on a link
+ */
+static uint32_t requestMs(int size, uint32_t overheadMs, float perReadingMs) {
+    return overheadMs + (uint32_t)(size * perReadingMs);
+}
+
+/**
+ * Run clean batches on a link
+ * @return size of the last batch
+ */
+static int runLink(BatchSizer& sizer, int batches, uint32_t overheadMs, float perReadingMs) {
+    int size = 0;
+    for (int i = 0; i < batches; i++) {
+        size = sizer.nextSize(HEAP_PLENTY, RSSI_GOOD, SLOTS, false);
+        sizer.onBatchResult(size, size, requestMs(size, overheadMs, perReadingMs), 0);
+    }
+    return size;
+}
+
+// ============================================================
+// GROWTH
+// ============================================================
+
+void test_healthy_tls_link_grows_to_max(void) {
+    // 1.5 s TLS request overhead, 5 ms per reading: a batch of 500 takes 4 s
+    BatchSizer sizer;
+    sizer.reset(50);
+
+    int size = runLink(sizer, 100, 1500, 5.0f);
+
+    TEST_ASSERT_EQUAL_INT(config::SYNC_BATCH_MAX, size);
+    TEST_ASSERT_EQUAL_INT(config::SYNC_BATCH_MAX, sizer.getWindow());
+}
+
+void test_request_over_target_halves(void) {
+    // 100 ms per reading: the request passes SYNC_BATCH_TARGET_MS at ~150 readings
+    BatchSizer sizer;
+    sizer.reset(50);
+
+    int largest = 0;
+    for (int i = 0; i < 100; i++) {
+        int size = sizer.nextSize(HEAP_PLENTY, RSSI_GOOD, SLOTS, false);
+        if (size > largest) largest = size;
+        sizer.onBatchResult(size, size, requestMs(size, 500, 100.0f), 0);
+    }
+
+    // Grew, but never past one step over the target
+    TEST_ASSERT_TRUE(largest > 50);
+    TEST_ASSERT_TRUE(requestMs(largest - config::SYNC_BATCH_ADDITIVE_STEP, 500, 100.0f) <= config::SYNC_BATCH_TARGET_MS);
+}
+
+// ============================================================
+// DECREASE
+// ============================================================
+
+void test_link_slowdown_halves(void) {
+    BatchSizer sizer;
+    sizer.reset(100);
+    runLink(sizer, 10, 1000, 2.0f);
+    int before = sizer.getWindow();
+
+    // Same size, link four times slower per reading
+    int size = sizer.nextSize(HEAP_PLENTY, RSSI_GOOD, SLOTS, false);
+    sizer.onBatchResult(size, size, requestMs(size, 4000, 8.0f), 0);
+
+    TEST_ASSERT_EQUAL_INT(size / 2, sizer.getWindow());
+    TEST_ASSERT_TRUE(sizer.getWindow() < before);
+}
+
+void test_smaller_batch_overhead_is_not_slowdown(void) {
+    // After a halving, the smaller batch pays the same overhead over fewer
+    // readings; that alone must not halve again
+    BatchSizer sizer;
+    sizer.reset(400);
+    runLink(sizer, 3, 3000, 1.0f);
+
+    // Two failed batches: a quarter of the size, four times the overhead per reading
+    for (int i = 0; i < 2; i++) {
+        int size = sizer.nextSize(HEAP_PLENTY, RSSI_GOOD, SLOTS, false);
+        sizer.onBatchResult(size, 0, 0, 500);
+    }
+    int reduced = sizer.getWindow();
+
+    int size = sizer.nextSize(HEAP_PLENTY, RSSI_GOOD, SLOTS, false);
+    TEST_ASSERT_EQUAL_INT(reduced, size);
+    sizer.onBatchResult(size, size, requestMs(size, 3000, 1.0f), 0);
+
+    TEST_ASSERT_EQUAL_INT(reduced + config::SYNC_BATCH_ADDITIVE_STEP, sizer.getWindow());
+}
+
+void test_413_sets_ceiling(void) {
+    BatchSizer sizer;
+    sizer.reset(400);
+
+    int size = sizer.nextSize(HEAP_PLENTY, RSSI_GOOD, SLOTS, false);
+    sizer.onBatchResult(size, 0, 300, 413);
+
+    // Clean batches afterwards never go back above half the rejected body
+    runLink(sizer, 50, 200, 1.0f);
+    size = sizer.nextSize(HEAP_PLENTY, RSSI_GOOD, SLOTS, false);
+    TEST_ASSERT_EQUAL_INT(200, size);
+}
+
+// ============================================================
+// BOUNDS
+// ============================================================
+
+void test_heap_and_rssi_bound_the_size(void) {
+    BatchSizer sizer;
+    sizer.reset(config::SYNC_BATCH_MAX);
+
+    // Weak link
+    TEST_ASSERT_EQUAL_INT(config::SYNC_WEAK_LINK_MAX_BATCH,
+                          sizer.nextSize(HEAP_PLENTY, config::SYNC_WEAK_RSSI_DBM - 5, SLOTS, false));
+
+    // Heap: every slot holds its readings and the encoded body
+    uint32_t heap = 100000;
+    int expected = (int)(heap / 100 * config::SYNC_BATCH_HEAP_PERCENT / (config::SYNC_READING_HEAP_BYTES * SLOTS));
+    TEST_ASSERT_EQUAL_INT(expected, sizer.nextSize(heap, RSSI_GOOD, SLOTS, false));
+
+    // Never below the minimum
+    TEST_ASSERT_EQUAL_INT(config::SYNC_BATCH_MIN, sizer.nextSize(1000, RSSI_GOOD, SLOTS, false));
+}
+
+// ============================================================
+// TEST RUNNER
+// ============================================================
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#ifdef UNIT_TEST
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Growth
+    RUN_TEST(test_healthy_tls_link_grows_to_max);
+    RUN_TEST(test_request_over_target_halves);
+
+    // Decrease
+    RUN_TEST(test_link_slowdown_halves);
+    RUN_TEST(test_smaller_batch_overhead_is_not_slowdown);
+    RUN_TEST(test_413_sets_ceiling);
+
+    // Bounds
+    RUN_TEST(test_heap_and_rssi_bound_the_size);
+
+    return UNITY_END();
+}
+
+#endif // UNIT_TEST
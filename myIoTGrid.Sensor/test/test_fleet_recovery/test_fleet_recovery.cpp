@@ -0,0 +1,253 @@
+/**
+ * @file test_fleet_recovery.cpp
+ * @brief Fleet recovery after a Hub outage (retry jitter + circuit breaker)
+ *
+ * 500 nodes boot within 2 s (site power returns) while the Hub needs 5 min
+ * longer. The fleet runs in virtual time with the firmware's
+ * DecorrelatedJitter, jitteredInterval() and CircuitBreaker, once with the
+ * fixed intervals and doubling sync retry of earlier firmware and once as
+ * the firmware does it now. Asserted: the Hub request peak in the first
+ * minute after its return, and that all offline readings get delivered.
+ *
+ * pio test -e native_test -f test_fleet_recovery
+ */
+
+#include <unity.h>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "config.h"
+#include "retry_policy.h"
+
+// ============================================================
+// FLEET MODEL
+// ============================================================
+
+static const int FLEET_NODES = 500;
+static const uint32_t FLEET_STEP_MS = 100;
+static const uint32_t FLEET_DURATION_MS = 1200000;     // 20 min
+static const uint32_t FLEET_BOOT_SPREAD_MS = 2000;     // Site power returns: all nodes boot together
+static const uint32_t FLEET_HUB_DOWN_MS = 300000;      // Hub needs 5 min longer than the nodes
+static const uint32_t FLEET_PERIOD_MS = 60000;         // Reading, heartbeat and config poll interval
+static const uint32_t FLEET_RETRY_BASE_MS = 60000;     // StorageConfig defaults
+static const uint32_t FLEET_RETRY_MAX_MS = 900000;
+
+// Pass criteria: after its return the Hub sees at most 2/5 of the fleet per
+// second (typically ~135/s; the fixed fleet sends heartbeat, config poll and
+// sync of every node within the same second, ~790/s), and the backlog is
+// gone within 10 minutes
+static const unsigned long MAX_RECOVERY_PEAK_PER_SECOND = FLEET_NODES * 2 / 5;
+static const unsigned long MAX_DRAIN_MS = 600000;
+
+/**
+ * One simulated node (timers as in main.cpp / SyncManager)
+ */
+struct FleetNode {
+    FleetNode(bool jittered, uint32_t seed)
+        : breaker(config::CIRCUIT_FAILURE_THRESHOLD, config::CIRCUIT_OPEN_BASE_MS,
+                  config::CIRCUIT_OPEN_MAX_MS, seed)
+        , syncJitter(FLEET_RETRY_BASE_MS, FLEET_RETRY_MAX_MS, seed ^ 0xA5A5A5A5)
+        , jittered(jittered) {}
+
+    CircuitBreaker breaker;
+    DecorrelatedJitter syncJitter;
+    bool jittered;
+
+    unsigned long nextReading = 0;
+    unsigned long nextHeartbeat = 0;
+    unsigned long nextConfig = 0;
+    unsigned long nextSync = 0;
+    int syncRetries = 0;
+    int pending = 0;
+    bool syncWaitsForHub = false;
+};
+
+struct FleetResult {
+    unsigned long outageRequests = 0;
+    unsigned long outagePeak = 0;
+    unsigned long recoveryPeak = 0;         // First minute after the Hub is back
+    unsigned long totalRequests = 0;
+    unsigned long rejectedLocally = 0;
+    unsigned long drainedAtMs = 0;          // All offline readings delivered (0 = never)
+};
+
+static FleetResult simulateFleet(bool jittered) {
+    std::mt19937 bootRng(42);
+    std::deque<FleetNode> nodes;
+    for (int i = 0; i < FLEET_NODES; i++) {
+        nodes.emplace_back(jittered, bootRng() | 1);
+        FleetNode& node = nodes.back();
+        unsigned long boot = bootRng() % FLEET_BOOT_SPREAD_MS;
+        node.nextReading = boot;
+        node.nextHeartbeat = boot + (jittered ? retry::jitteredInterval(FLEET_PERIOD_MS, config::PERIODIC_JITTER_PERCENT)
+                                              : FLEET_PERIOD_MS);
+        node.nextConfig = boot + (jittered ? retry::jitteredInterval(FLEET_PERIOD_MS, config::PERIODIC_JITTER_PERCENT)
+                                           : FLEET_PERIOD_MS);
+    }
+
+    std::vector<unsigned long> perSecond(FLEET_DURATION_MS / 1000, 0);
+    FleetResult result;
+
+    for (unsigned long now = 0; now < FLEET_DURATION_MS; now += FLEET_STEP_MS) {
+        bool hubUp = now >= FLEET_HUB_DOWN_MS;
+        unsigned long& bucket = perSecond[now / 1000];
+        unsigned long pendingTotal = 0;
+
+        for (FleetNode& node : nodes) {
+            // One Hub request; false if it failed or never left the node
+            auto request = [&]() {
+                if (node.jittered && !node.breaker.allowRequest(now)) {
+                    result.rejectedLocally++;
+                    return false;
+                }
+                bucket++;
+                if (node.jittered) node.breaker.onResult(!hubUp, 0, now);
+                return hubUp;
+            };
+
+            if (now >= node.nextReading) {
+                node.nextReading += FLEET_PERIOD_MS;
+                if (!request()) node.pending++;
+            }
+
+            if (now >= node.nextHeartbeat) {
+                request();
+                node.nextHeartbeat = now + (node.jittered
+                    ? retry::jitteredInterval(FLEET_PERIOD_MS, config::PERIODIC_JITTER_PERCENT) : FLEET_PERIOD_MS);
+            }
+
+            if (now >= node.nextConfig) {
+                request();
+                node.nextConfig = now + (node.jittered
+                    ? retry::jitteredInterval(FLEET_PERIOD_MS, config::PERIODIC_JITTER_PERCENT) : FLEET_PERIOD_MS);
+            }
+
+            // Hub reachable again (breaker closed by another request): sync soon, spread
+            if (node.syncWaitsForHub && node.breaker.getState() == CircuitState::CLOSED) {
+                node.syncWaitsForHub = false;
+                unsigned long soon = now + node.syncJitter.uniform(0, FLEET_RETRY_BASE_MS);
+                if (soon < node.nextSync) node.nextSync = soon;
+            }
+
+            // Offline sync: the stored readings fit one /api/readings/batch request
+            if (node.pending > 0 && now >= node.nextSync) {
+                if (request()) {
+                    node.pending = 0;
+                    node.syncRetries = 0;
+                    node.syncJitter.reset();
+                } else if (node.jittered) {
+                    uint32_t delay = node.syncJitter.next();
+                    uint32_t wait = node.breaker.getWaitMs(now);
+                    node.nextSync = now + (delay > wait ? delay : wait);
+                    node.syncWaitsForHub = true;
+                } else {
+                    unsigned long delay = FLEET_RETRY_BASE_MS * (1UL << node.syncRetries);
+                    if (delay > FLEET_RETRY_MAX_MS) delay = FLEET_RETRY_MAX_MS;
+                    node.syncRetries++;
+                    node.nextSync = now + delay;
+                }
+            }
+
+            pendingTotal += node.pending;
+        }
+
+        if (hubUp && pendingTotal == 0 && result.drainedAtMs == 0) {
+            result.drainedAtMs = now;
+        }
+    }
+
+    for (size_t second = 0; second < perSecond.size(); second++) {
+        unsigned long count = perSecond[second];
+        unsigned long ms = second * 1000;
+        result.totalRequests += count;
+        if (ms < FLEET_HUB_DOWN_MS) {
+            result.outageRequests += count;
+            if (count > result.outagePeak) result.outagePeak = count;
+        } else if (ms < FLEET_HUB_DOWN_MS + 60000) {
+            if (count > result.recoveryPeak) result.recoveryPeak = count;
+        }
+    }
+
+    return result;
+}
+
+static void printFleetResult(const char* name, const FleetResult& result) {
+    char drained[24];
+    if (result.drainedAtMs > 0) {
+        snprintf(drained, sizeof(drained), "%lu s", (result.drainedAtMs - FLEET_HUB_DOWN_MS) / 1000);
+    } else {
+        snprintf(drained, sizeof(drained), "no");
+    }
+
+    printf("[Fleet] %-9s outage %6lu req (peak %4lu/s) | recovery peak %4lu/s | "
+           "total %6lu | refused locally %6lu | drained after %s\n",
+           name, result.outageRequests, result.outagePeak, result.recoveryPeak,
+           result.totalRequests, result.rejectedLocally, drained);
+}
+
+static FleetResult fixedFleet;
+static FleetResult jitteredFleet;
+
+// ============================================================
+// RECOVERY
+// ============================================================
+
+void test_fixed_fleet_stampedes(void) {
+    // Reference: earlier firmware hits the Hub with the whole fleet at once
+    TEST_ASSERT_TRUE(fixedFleet.recoveryPeak > MAX_RECOVERY_PEAK_PER_SECOND);
+}
+
+void test_recovery_peak_is_bounded(void) {
+    TEST_ASSERT_TRUE_MESSAGE(jitteredFleet.recoveryPeak <= MAX_RECOVERY_PEAK_PER_SECOND,
+                             "Hub request peak after the outage above the limit");
+    TEST_ASSERT_TRUE(jitteredFleet.recoveryPeak * 4 <= fixedFleet.recoveryPeak);
+}
+
+void test_offline_readings_are_delivered(void) {
+    TEST_ASSERT_TRUE_MESSAGE(jitteredFleet.drainedAtMs > 0, "offline readings never delivered");
+    TEST_ASSERT_TRUE(jitteredFleet.drainedAtMs - FLEET_HUB_DOWN_MS <= MAX_DRAIN_MS);
+}
+
+// ============================================================
+// OUTAGE
+// ============================================================
+
+void test_breaker_spares_hub_during_outage(void) {
+    // Open breakers refuse locally instead of hammering the unreachable Hub
+    TEST_ASSERT_TRUE(jitteredFleet.rejectedLocally > 0);
+    TEST_ASSERT_TRUE(jitteredFleet.outageRequests < fixedFleet.outageRequests);
+}
+
+// ============================================================
+// TEST RUNNER
+// ============================================================
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#ifdef UNIT_TEST
+
+int main(int argc, char **argv) {
+    printf("[Fleet] %d nodes boot within %lu ms, Hub unreachable for the first %lu s\n",
+           FLEET_NODES, (unsigned long)FLEET_BOOT_SPREAD_MS, (unsigned long)(FLEET_HUB_DOWN_MS / 1000));
+    fixedFleet = simulateFleet(false);
+    jitteredFleet = simulateFleet(true);
+    printFleetResult("fixed", fixedFleet);
+    printFleetResult("jittered", jitteredFleet);
+
+    UNITY_BEGIN();
+
+    // Recovery
+    RUN_TEST(test_fixed_fleet_stampedes);
+    RUN_TEST(test_recovery_peak_is_bounded);
+    RUN_TEST(test_offline_readings_are_delivered);
+
+    // Outage
+    RUN_TEST(test_breaker_spares_hub_during_outage);
+
+    return UNITY_END();
+}
+
+#endif // UNIT_TEST
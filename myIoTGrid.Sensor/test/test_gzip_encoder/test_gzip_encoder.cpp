@@ -0,0 +1,237 @@
+/**
+ * @file test_gzip_encoder.cpp
+ * @brief Round-trip Tests for the firmware gzip Encoder
+ *
+ * GzipEncoder output is decoded with zlib (reference inflate), so the Hub's
+ * request decompression sees exactly these bytes.
+ *
+ * pio test -e native_test -f test_gzip_encoder
+ */
+
+#include <unity.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "config.h"
+#include "gzip_encoder.h"
+
+// ============================================================
+// HELPERS
+// ============================================================
+
+static const uint8_t WINDOW_BITS = config::HTTP_COMPRESSION_WINDOW_BITS;
+static const size_t WINDOW_SIZE = (size_t)1 << WINDOW_BITS;
+
+/**
+ * Upload-like JSON with random values: repeated keys give long matches,
+ * the values give literals
+ */
+static std::vector<uint8_t> makeJson(size_t length) {
+    std::vector<uint8_t> data;
+    data.reserve(length + 128);
+    uint32_t seed = 0x12345678;
+    int endpoint = 1;
+    while (data.size() < length) {
+        seed = seed * 1103515245u + 12345u;
+        char row[128];
+        int n = snprintf(row, sizeof(row),
+                         "{\"sensorType\":\"temperature\",\"endpointId\":%d,\"value\":%u.%02u,\"unit\":\"C\"},",
+                         endpoint, (unsigned)(seed >> 24) % 40, (unsigned)(seed >> 8) % 100);
+        data.insert(data.end(), row, row + n);
+        endpoint = endpoint % 8 + 1;
+    }
+    data.resize(length);
+    return data;
+}
+
+/**
+ * Incompressible bytes (literals only)
+ */
+static std::vector<uint8_t> makeRandom(size_t length) {
+    std::vector<uint8_t> data(length);
+    uint32_t seed = 0xCAFEBABE;
+    for (size_t i = 0; i < length; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        data[i] = (uint8_t)(seed >> 24);
+    }
+    return data;
+}
+
+/**
+ * Inflate a gzip stream with zlib
+ * @return false if zlib rejects the stream (bad header, codes, CRC or length)
+ */
+static bool gunzip(const std::vector<uint8_t>& compressed, std::vector<uint8_t>& out) {
+    z_stream stream = {};
+    if (inflateInit2(&stream, 15 + 16) != Z_OK) {   // 15 + 16: gzip framing
+        return false;
+    }
+
+    out.clear();
+    uint8_t chunk[4096];
+    stream.next_in = const_cast<uint8_t*>(compressed.data());
+    stream.avail_in = (uInt)compressed.size();
+
+    int result;
+    do {
+        stream.next_out = chunk;
+        stream.avail_out = sizeof(chunk);
+        result = inflate(&stream, Z_NO_FLUSH);
+        if (result != Z_OK && result != Z_STREAM_END) {
+            inflateEnd(&stream);
+            return false;
+        }
+        out.insert(out.end(), chunk, chunk + (sizeof(chunk) - stream.avail_out));
+    } while (result != Z_STREAM_END);
+
+    // Trailing bytes after the gzip member are an encoder bug too
+    bool complete = stream.avail_in == 0;
+    inflateEnd(&stream);
+    return complete;
+}
+
+static void assertRoundTrip(const std::vector<uint8_t>& input) {
+    std::vector<uint8_t> compressed;
+    TEST_ASSERT_TRUE(GzipEncoder::compress(input.data(), input.size(), compressed, WINDOW_BITS));
+
+    std::vector<uint8_t> decoded;
+    TEST_ASSERT_TRUE_MESSAGE(gunzip(compressed, decoded), "zlib rejected the gzip stream");
+    TEST_ASSERT_EQUAL_UINT32(input.size(), decoded.size());
+    if (!input.empty()) {
+        TEST_ASSERT_EQUAL_MEMORY(input.data(), decoded.data(), input.size());
+    }
+}
+
+// ============================================================
+// ROUND TRIP
+// ============================================================
+
+void test_empty_input(void) {
+    assertRoundTrip(std::vector<uint8_t>());
+}
+
+void test_single_byte(void) {
+    assertRoundTrip(std::vector<uint8_t>(1, 'x'));
+}
+
+void test_window_minus_one(void) {
+    assertRoundTrip(makeJson(WINDOW_SIZE - 1));
+    assertRoundTrip(makeRandom(WINDOW_SIZE - 1));
+}
+
+void test_window_exact(void) {
+    assertRoundTrip(makeJson(WINDOW_SIZE));
+    assertRoundTrip(makeRandom(WINDOW_SIZE));
+}
+
+void test_window_plus_one(void) {
+    assertRoundTrip(makeJson(WINDOW_SIZE + 1));
+    assertRoundTrip(makeRandom(WINDOW_SIZE + 1));
+}
+
+void test_double_window_boundary(void) {
+    // Buffer holds 2 * window: first slide happens here
+    assertRoundTrip(makeJson(2 * WINDOW_SIZE - 1));
+    assertRoundTrip(makeJson(2 * WINDOW_SIZE));
+    assertRoundTrip(makeJson(2 * WINDOW_SIZE + 1));
+}
+
+void test_long_runs(void) {
+    // Maximum match length (258) and distance 1
+    assertRoundTrip(std::vector<uint8_t>(3 * WINDOW_SIZE + 7, 'a'));
+}
+
+void test_300kb_upload(void) {
+    std::vector<uint8_t> input = makeJson(300 * 1024);
+    assertRoundTrip(input);
+
+    std::vector<uint8_t> compressed;
+    TEST_ASSERT_TRUE(GzipEncoder::compress(input.data(), input.size(), compressed, WINDOW_BITS));
+    TEST_ASSERT_LESS_THAN_UINT32(input.size() / 2, compressed.size());
+}
+
+void test_300kb_random(void) {
+    assertRoundTrip(makeRandom(300 * 1024));
+}
+
+// ============================================================
+// STREAMING
+// ============================================================
+
+void test_streaming_odd_pieces(void) {
+    std::vector<uint8_t> input = makeJson(5 * WINDOW_SIZE + 13);
+
+    std::vector<uint8_t> compressed;
+    GzipEncoder encoder(WINDOW_BITS);
+    TEST_ASSERT_TRUE(encoder.begin([&compressed](const uint8_t* data, size_t length) {
+        compressed.insert(compressed.end(), data, data + length);
+        return true;
+    }));
+
+    size_t offset = 0;
+    size_t piece = 1;
+    while (offset < input.size()) {
+        size_t length = std::min(piece, input.size() - offset);
+        TEST_ASSERT_TRUE(encoder.write(input.data() + offset, length));
+        offset += length;
+        piece = piece * 3 + 1;      // 1, 4, 13, 40, ... crosses every boundary
+        if (piece > WINDOW_SIZE * 2) piece = 7;
+    }
+    TEST_ASSERT_TRUE(encoder.finish());
+
+    TEST_ASSERT_EQUAL_UINT32(input.size(), encoder.getInputBytes());
+    TEST_ASSERT_EQUAL_UINT32(compressed.size(), encoder.getOutputBytes());
+
+    std::vector<uint8_t> decoded;
+    TEST_ASSERT_TRUE(gunzip(compressed, decoded));
+    TEST_ASSERT_EQUAL_UINT32(input.size(), decoded.size());
+    TEST_ASSERT_EQUAL_MEMORY(input.data(), decoded.data(), input.size());
+}
+
+void test_window_bits_range(void) {
+    std::vector<uint8_t> input = makeJson(40 * 1024);
+    for (uint8_t bits = 9; bits <= 14; bits++) {
+        std::vector<uint8_t> compressed;
+        TEST_ASSERT_TRUE(GzipEncoder::compress(input.data(), input.size(), compressed, bits));
+
+        std::vector<uint8_t> decoded;
+        TEST_ASSERT_TRUE(gunzip(compressed, decoded));
+        TEST_ASSERT_EQUAL_UINT32(input.size(), decoded.size());
+        TEST_ASSERT_EQUAL_MEMORY(input.data(), decoded.data(), input.size());
+    }
+}
+
+// ============================================================
+// TEST RUNNER
+// ============================================================
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#ifdef UNIT_TEST
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Round trip
+    RUN_TEST(test_empty_input);
+    RUN_TEST(test_single_byte);
+    RUN_TEST(test_window_minus_one);
+    RUN_TEST(test_window_exact);
+    RUN_TEST(test_window_plus_one);
+    RUN_TEST(test_double_window_boundary);
+    RUN_TEST(test_long_runs);
+    RUN_TEST(test_300kb_upload);
+    RUN_TEST(test_300kb_random);
+
+    // Streaming
+    RUN_TEST(test_streaming_odd_pieces);
+    RUN_TEST(test_window_bits_range);
+
+    return UNITY_END();
+}
+
+#endif // UNIT_TEST
@@ -0,0 +1,260 @@
+/**
+ * @file test_json_arena_soak.cpp
+ * @brief Multi-day soak of the JSON arena with the request documents of a node
+ *
+ * Plays simulated days of request documents (6 readings and a heartbeat
+ * per minute, a configuration poll every 5 and a sync batch of 50 readings
+ * every 10 minutes) while long-lived heap users (log queue) churn in
+ * between - once with heap documents as reference and once in JsonArena.
+ * Asserted: the arena is empty after every cycle and never spills to the
+ * heap. Heap growth per day is printed for both runs.
+ *
+ * pio test -e native_test -f test_json_arena_soak
+ * ARENA_SOAK_DAYS=30 pio test -e native_test -f test_json_arena_soak
+ */
+
+#include <unity.h>
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+#include <vector>
+
+#include <ArduinoJson.h>
+#include "ArduinoJsonString.h"
+#include "config.h"
+#include "json_arena.h"
+#include "metrics.h"
+
+// ============================================================
+// WORKLOAD
+// ============================================================
+
+static const unsigned long SOAK_DAYS_DEFAULT = 7;
+static const unsigned long MINUTES_PER_DAY = 24 * 60;
+
+struct SoakResult {
+    unsigned long minutes = 0;
+    uint32_t maxLiveAfterCycle = 0;     // Arena blocks left after a cycle (must stay 0)
+    size_t maxUsedAfterCycle = 0;       // Arena bytes left after a cycle (must stay 0)
+    uint32_t fallbacks = 0;             // Heap fallbacks during the run
+    uint32_t rewinds = 0;               // Arena rewinds to empty during the run
+    size_t peak = 0;
+    long heapGrowth = 0;                // glibc arena growth over the run (bytes)
+};
+
+/**
+ * Deterministic PRNG for the log queue churn (xorshift32)
+ */
+static uint32_t soakRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static String buildConfigurationBody() {
+    JsonDocument doc;
+    doc["nodeId"] = "00000000-0000-0000-0000-000000000001";
+    doc["serialNumber"] = "ESP32-0070078492CC";
+    doc["defaultIntervalSeconds"] = 60;
+    doc["storageMode"] = 1;
+    JsonArray sensors = doc["sensors"].to<JsonArray>();
+    for (int i = 0; i < 4; i++) {
+        JsonObject sensor = sensors.add<JsonObject>();
+        sensor["endpointId"] = i + 1;
+        sensor["sensorCode"] = "bme280";
+        sensor["isActive"] = true;
+        sensor["intervalSeconds"] = 60;
+        sensor["i2CAddress"] = "0x76";
+        JsonArray caps = sensor["capabilities"].to<JsonArray>();
+        for (int c = 0; c < 2; c++) {
+            JsonObject cap = caps.add<JsonObject>();
+            cap["measurementType"] = c ? "humidity" : "temperature";
+            cap["displayName"] = c ? "Luftfeuchte" : "Temperatur";
+            cap["unit"] = c ? "%" : "°C";
+        }
+    }
+    String body;
+    serializeJson(doc, body);
+    return body;
+}
+
+/**
+ * One simulated minute of request documents in one JsonDocument
+ */
+static void soakMinute(JsonDocument& doc, unsigned long minute, const String& configBody, String& body) {
+    for (int i = 0; i < 6; i++) {
+        doc.clear();
+        doc["sensorType"] = "temperature";
+        doc["value"] = 21.5 + (minute % 100) * 0.01;
+        doc["unit"] = "°C";
+        doc["endpointId"] = 1;
+        doc["timestamp"] = 1733150400UL + minute * 60 + i * 10;
+        body = "";
+        serializeJson(doc, body);
+    }
+
+    doc.clear();
+    doc["firmwareVersion"] = "1.9.1";
+    doc["metrics"] = serialized(metrics::Registry::getInstance().getSnapshotJson());
+    doc["arena"] = serialized(JsonArena::getInstance().getStatsJson());
+    body = "";
+    serializeJson(doc, body);
+
+    if (minute % 5 == 0) {
+        doc.clear();
+        deserializeJson(doc, configBody);
+    }
+
+    if (minute % 10 == 0) {
+        doc.clear();
+        JsonArray readings = doc["readings"].to<JsonArray>();
+        for (int i = 0; i < 50; i++) {
+            JsonObject reading = readings.add<JsonObject>();
+            reading["sensorType"] = (i % 2) ? "humidity" : "temperature";
+            reading["value"] = 20.0 + i * 0.37;
+            reading["unit"] = (i % 2) ? "%" : "°C";
+            reading["timestamp"] = 1733150400UL + minute * 60 + i;
+        }
+        body = "";
+        serializeJson(doc, body);
+    }
+}
+
+static SoakResult runSoak(const char* name, bool useArena, unsigned long days) {
+    JsonArena& arena = JsonArena::getInstance();
+    const String configBody = buildConfigurationBody();
+    std::vector<String> logQueue(64);       // Long-lived heap users in between
+    uint32_t rng = 0x9E3779B9;
+    String body;
+
+    SoakResult result;
+    result.minutes = days * MINUTES_PER_DAY;
+    uint32_t fallbacksBefore = arena.getFallbacks();
+    uint32_t rewindsBefore = arena.getRewinds();
+    struct mallinfo2 start = mallinfo2();
+
+    for (unsigned long minute = 0; minute < result.minutes; minute++) {
+        if (useArena) {
+            JsonDocument doc(&arena);
+            soakMinute(doc, minute, configBody, body);
+        } else {
+            JsonDocument doc;
+            soakMinute(doc, minute, configBody, body);
+        }
+
+        // Every request document of the cycle is gone: nothing may stay behind
+        if (arena.getLiveBlocks() > result.maxLiveAfterCycle) result.maxLiveAfterCycle = arena.getLiveBlocks();
+        if (arena.getUsedBytes() > result.maxUsedAfterCycle) result.maxUsedAfterCycle = arena.getUsedBytes();
+
+        for (int i = 0; i < 4; i++) {
+            String& entry = logQueue[soakRandom(rng) % logQueue.size()];
+            entry = String();
+            size_t length = 40 + soakRandom(rng) % 160;
+            for (size_t c = 0; c < length; c++) entry += 'x';
+        }
+
+        if ((minute + 1) % MINUTES_PER_DAY == 0) {
+            struct mallinfo2 now = mallinfo2();
+            printf("[Arena] %-15s day %3lu  heap %7zu B (%+ld)  free in heap %6zu B\n",
+                   name, (minute + 1) / MINUTES_PER_DAY, now.arena,
+                   (long)now.arena - (long)start.arena, now.fordblks);
+        }
+    }
+
+    result.heapGrowth = (long)mallinfo2().arena - (long)start.arena;
+    result.fallbacks = arena.getFallbacks() - fallbacksBefore;
+    result.rewinds = arena.getRewinds() - rewindsBefore;
+    result.peak = arena.getPeakBytes();
+    return result;
+}
+
+static SoakResult heapSoak;
+static SoakResult arenaSoak;
+
+// ============================================================
+// SOAK
+// ============================================================
+
+void test_arena_empty_after_every_cycle(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, arenaSoak.maxLiveAfterCycle);
+    TEST_ASSERT_EQUAL_UINT32(0, arenaSoak.maxUsedAfterCycle);
+}
+
+void test_arena_never_falls_back_to_heap(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, arenaSoak.fallbacks);
+    TEST_ASSERT_TRUE(arenaSoak.peak <= config::JSON_ARENA_SIZE);
+}
+
+void test_arena_rewinds_every_cycle(void) {
+    // At least the outer document of every minute rewinds the arena to empty
+    TEST_ASSERT_TRUE(arenaSoak.rewinds >= arenaSoak.minutes);
+}
+
+void test_heap_run_leaves_arena_unused(void) {
+    // Reference run: only the metrics snapshot uses the arena
+    TEST_ASSERT_EQUAL_UINT32(0, heapSoak.maxLiveAfterCycle);
+    TEST_ASSERT_EQUAL_UINT32(0, heapSoak.fallbacks);
+}
+
+// ============================================================
+// FALLBACK
+// ============================================================
+
+void test_oversized_document_falls_back_and_releases(void) {
+    JsonArena& arena = JsonArena::getInstance();
+    uint32_t fallbacksBefore = arena.getFallbacks();
+
+    {
+        // Sync batch at SYNC_BATCH_MAX does not fit the arena
+        JsonDocument doc(&arena);
+        JsonArray readings = doc["readings"].to<JsonArray>();
+        for (int i = 0; i < config::SYNC_BATCH_MAX; i++) {
+            JsonObject reading = readings.add<JsonObject>();
+            reading["sensorType"] = "temperature";
+            reading["value"] = 20.0 + i * 0.01;
+            reading["timestamp"] = 1733150400UL + i;
+        }
+        TEST_ASSERT_FALSE(doc.overflowed());
+        TEST_ASSERT_TRUE(arena.getFallbacks() > fallbacksBefore);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, arena.getLiveBlocks());
+    TEST_ASSERT_EQUAL_size_t(0, arena.getUsedBytes());
+}
+
+// ============================================================
+// TEST RUNNER
+// ============================================================
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#ifdef UNIT_TEST
+
+int main(int argc, char **argv) {
+    const char* daysEnv = std::getenv(config::ENV_ARENA_SOAK_DAYS);
+    unsigned long days = (daysEnv && atoi(daysEnv) > 0) ? (unsigned long)atoi(daysEnv) : SOAK_DAYS_DEFAULT;
+
+    heapSoak = runSoak("heap documents", false, days);
+    arenaSoak = runSoak("arena documents", true, days);
+    printf("[Arena] %lu simulated days: heap run %+ld B, arena run %+ld B, arena peak %zu of %zu B, "
+           "%lu rewinds, %lu fallbacks\n",
+           days, heapSoak.heapGrowth, arenaSoak.heapGrowth, arenaSoak.peak, config::JSON_ARENA_SIZE,
+           (unsigned long)arenaSoak.rewinds, (unsigned long)arenaSoak.fallbacks);
+
+    UNITY_BEGIN();
+
+    // Soak
+    RUN_TEST(test_arena_empty_after_every_cycle);
+    RUN_TEST(test_arena_never_falls_back_to_heap);
+    RUN_TEST(test_arena_rewinds_every_cycle);
+    RUN_TEST(test_heap_run_leaves_arena_unused);
+
+    // Fallback
+    RUN_TEST(test_oversized_document_falls_back_and_releases);
+
+    return UNITY_END();
+}
+
+#endif // UNIT_TEST
@@ -0,0 +1,179 @@
+/**
+ * @file test_uart_decoders.cpp
+ * @brief Tests for the SR04M-2 frame decoder and the GPS NMEA ingestion
+ *
+ * Both decoders are fed byte buffers as the UART tasks (ESP32) and the
+ * trace replay of U records (native) do.
+ *
+ * pio test -e native_test -f test_uart_decoders
+ */
+
+#include <unity.h>
+#include <cstring>
+
+#include "config.h"
+#include "gps_ingestion.h"
+#include "sr04m2_decoder.h"
+
+// ============================================================
+// HELPERS
+// ============================================================
+
+/**
+ * Append one SR04M-2 frame (0xFF 0xFE high low checksum)
+ */
+static size_t addFrame(uint8_t* buffer, size_t offset, uint16_t distanceMm, bool corrupt = false) {
+    uint8_t high = distanceMm >> 8;
+    uint8_t low = distanceMm & 0xFF;
+    buffer[offset++] = 0xFF;
+    buffer[offset++] = 0xFE;
+    buffer[offset++] = high;
+    buffer[offset++] = low;
+    buffer[offset++] = (uint8_t)(high + low + (corrupt ? 1 : 0));
+    return offset;
+}
+
+static uint32_t encodeNmea(const char* sentences) {
+    return GpsIngestion::getInstance().encode((const uint8_t*)sentences, strlen(sentences));
+}
+
+// ============================================================
+// SR04M-2
+// ============================================================
+
+void test_sr04m2_valid_frame(void) {
+    uint8_t data[8];
+    size_t length = addFrame(data, 0, 1500);
+
+    TEST_ASSERT_EQUAL_UINT32(1, Sr04m2Decoder::getInstance().decode(data, length));
+
+    Sr04m2Snapshot snapshot = Sr04m2Decoder::getInstance().getSnapshot();
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.framesValid);
+    TEST_ASSERT_EQUAL_UINT16(1500, snapshot.distanceMm);
+    TEST_ASSERT_EQUAL_UINT32(5, snapshot.bytesReceived);
+    TEST_ASSERT_TRUE(snapshot.lastStatus == Sr04m2FrameStatus::OK);
+}
+
+void test_sr04m2_checksum_error(void) {
+    uint8_t data[8];
+    size_t length = addFrame(data, 0, 1500, true);
+
+    TEST_ASSERT_EQUAL_UINT32(1, Sr04m2Decoder::getInstance().decode(data, length));
+
+    Sr04m2Snapshot snapshot = Sr04m2Decoder::getInstance().getSnapshot();
+    TEST_ASSERT_EQUAL_UINT32(0, snapshot.framesValid);
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.checksumErrors);
+    TEST_ASSERT_TRUE(snapshot.lastStatus == Sr04m2FrameStatus::CHECKSUM_ERROR);
+}
+
+void test_sr04m2_out_of_range(void) {
+    uint8_t data[8];
+    size_t length = addFrame(data, 0, 100);
+
+    Sr04m2Decoder::getInstance().decode(data, length);
+
+    Sr04m2Snapshot snapshot = Sr04m2Decoder::getInstance().getSnapshot();
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.outOfRange);
+    TEST_ASSERT_EQUAL_UINT16(100, snapshot.lastRawMm);
+    TEST_ASSERT_EQUAL_UINT16(0, snapshot.distanceMm);
+}
+
+void test_sr04m2_resyncs_after_garbage(void) {
+    // Noise, then a repeated 0xFF before the header completes
+    uint8_t data[16] = {0x12, 0xFF};
+    size_t length = addFrame(data, 2, 2345);
+
+    TEST_ASSERT_EQUAL_UINT32(1, Sr04m2Decoder::getInstance().decode(data, length));
+
+    Sr04m2Snapshot snapshot = Sr04m2Decoder::getInstance().getSnapshot();
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.framesValid);
+    TEST_ASSERT_EQUAL_UINT32(2, snapshot.bytesDiscarded);
+    TEST_ASSERT_EQUAL_UINT16(2345, snapshot.distanceMm);
+}
+
+void test_sr04m2_frame_split_across_buffers(void) {
+    // U records and UART reads cut the stream anywhere
+    uint8_t data[8];
+    size_t length = addFrame(data, 0, 1800);
+    Sr04m2Decoder& decoder = Sr04m2Decoder::getInstance();
+
+    TEST_ASSERT_EQUAL_UINT32(0, decoder.decode(data, 3));
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.decode(data + 3, length - 3));
+    TEST_ASSERT_EQUAL_UINT16(1800, decoder.getSnapshot().distanceMm);
+}
+
+void test_sr04m2_median_rejects_spike(void) {
+    uint8_t data[32];
+    size_t length = 0;
+    length = addFrame(data, length, 1500);
+    length = addFrame(data, length, 1502);
+    length = addFrame(data, length, 6000);
+
+    TEST_ASSERT_EQUAL_UINT32(3, Sr04m2Decoder::getInstance().decode(data, length));
+
+    Sr04m2Snapshot snapshot = Sr04m2Decoder::getInstance().getSnapshot();
+    TEST_ASSERT_EQUAL_UINT16(6000, snapshot.lastRawMm);
+    TEST_ASSERT_EQUAL_UINT16(1502, snapshot.distanceMm);
+}
+
+// ============================================================
+// GPS
+// ============================================================
+
+void test_gps_sentences_give_fix(void) {
+    uint32_t sentences = encodeNmea(
+        "$GPGGA,123519.00,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*69\r\n"
+        "$GPRMC,123519.00,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*44\r\n");
+
+    TEST_ASSERT_EQUAL_UINT32(2, sentences);
+
+    GpsSnapshot snapshot = GpsIngestion::getInstance().getSnapshot();
+    TEST_ASSERT_TRUE(snapshot.locationValid);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, 48.1173, snapshot.latitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, 11.516667, snapshot.longitude);
+    TEST_ASSERT_EQUAL_UINT32(8, snapshot.satellites);
+    TEST_ASSERT_EQUAL_UINT8(3, snapshot.fixType);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 545.4, snapshot.altitudeM);
+}
+
+void test_gps_bad_checksum_is_counted(void) {
+    uint32_t failedBefore = GpsIngestion::getInstance().getSnapshot().failedChecksums;
+
+    uint32_t sentences = encodeNmea(
+        "$GPGGA,123520.00,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*00\r\n");
+
+    TEST_ASSERT_EQUAL_UINT32(0, sentences);
+    TEST_ASSERT_EQUAL_UINT32(failedBefore + 1, GpsIngestion::getInstance().getSnapshot().failedChecksums);
+}
+
+// ============================================================
+// TEST RUNNER
+// ============================================================
+
+void setUp(void) {
+    Sr04m2Decoder::getInstance().reset();
+}
+
+void tearDown(void) {}
+
+#ifdef UNIT_TEST
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // SR04M-2
+    RUN_TEST(test_sr04m2_valid_frame);
+    RUN_TEST(test_sr04m2_checksum_error);
+    RUN_TEST(test_sr04m2_out_of_range);
+    RUN_TEST(test_sr04m2_resyncs_after_garbage);
+    RUN_TEST(test_sr04m2_frame_split_across_buffers);
+    RUN_TEST(test_sr04m2_median_rejects_spike);
+
+    // GPS
+    RUN_TEST(test_gps_sentences_give_fix);
+    RUN_TEST(test_gps_bad_checksum_is_counted);
+
+    return UNITY_END();
+}
+
+#endif // UNIT_TEST
@@ -1,3 +1,4 @@
+using System.Text.Json;
 using myIoTGrid.Shared.Common.Enums;
 
 namespace myIoTGrid.Shared.Common.DTOs;
@@ -153,11 +154,32 @@ public record RegenerateApiKeyDto(
 /// <summary>
 /// DTO for node heartbeat request.
 /// Sent periodically by node to Hub via REST API.
+/// The diagnostic objects are passed through as sent by the firmware and
+/// stored as one snapshot on the node (Node.DiagnosticsJson).
 /// </summary>
+/// <param name="NodeId">Node identifier</param>
+/// <param name="FirmwareVersion">Running firmware version</param>
+/// <param name="BatteryLevel">Battery level in percent</param>
+/// <param name="Wifi">WiFi link statistics (RSSI, reconnects)</param>
+/// <param name="Pipeline">Sensor pipeline statistics (reads, deadline misses)</param>
+/// <param name="Time">Time synchronisation state</param>
+/// <param name="Sync">Offline sync state (pending readings, batch size)</param>
+/// <param name="Compression">HTTP compression statistics</param>
+/// <param name="Metrics">Firmware metrics registry snapshot (counters, gauges, histograms)</param>
+/// <param name="Loop">Main loop profiler statistics</param>
+/// <param name="WireFormat">Active wire format of the node ("json" or "msgpack")</param>
 public record NodeHeartbeatDto(
     string NodeId,
     string? FirmwareVersion = null,
-    int? BatteryLevel = null
+    int? BatteryLevel = null,
+    JsonElement? Wifi = null,
+    JsonElement? Pipeline = null,
+    JsonElement? Time = null,
+    JsonElement? Sync = null,
+    JsonElement? Compression = null,
+    JsonElement? Metrics = null,
+    JsonElement? Loop = null,
+    string? WireFormat = null
 );
 
 /// <summary>
@@ -173,6 +195,7 @@ public record NodeHeartbeatResponseDto(
 /// <summary>
 /// DTO for node sensor configuration response.
 /// Returns full sensor configuration for the node to start measuring.
+/// WireFormat: preferred body format of the node ("json" / "msgpack").
 /// </summary>
 public record NodeSensorConfigurationDto(
     Guid NodeId,
@@ -181,7 +204,8 @@ public record NodeSensorConfigurationDto(
     bool IsSimulation,
     int DefaultIntervalSeconds,
     List<SensorAssignmentConfigDto> Sensors,
-    DateTime ConfigurationTimestamp
+    DateTime ConfigurationTimestamp,
+    string? WireFormat = null
 );
 
 /// <summary>
@@ -206,17 +230,23 @@ public record SensorAssignmentConfigDto(
     int? EchoPin,
     double OffsetCorrection,
     double GainCorrection,
-    List<SensorCapabilityConfigDto> Capabilities
+    List<SensorCapabilityConfigDto> Capabilities,
+    int AggregationWindowSeconds = 0
 );
 
 /// <summary>
 /// Sensor capability configuration for the firmware.
-/// Tells the sensor which measurement types to capture and their units.
+/// Tells the sensor which measurement types to capture and their units,
+/// and when an unchanged value may be skipped (deadband, null = firmware default).
 /// </summary>
 public record SensorCapabilityConfigDto(
     string MeasurementType,
     string DisplayName,
-    string Unit
+    string Unit,
+    double? DeadbandAbsolute = null,
+    double? DeadbandPercent = null,
+    double? DeadbandSlopePerMinute = null,
+    int? MaxSilenceSeconds = null
 );
 
 // === GPS Status DTOs ===
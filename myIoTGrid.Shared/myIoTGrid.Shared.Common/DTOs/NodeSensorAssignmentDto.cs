@@ -27,7 +27,8 @@ public record NodeSensorAssignmentDto(
     bool IsActive,
     DateTime? LastSeenAt,
     DateTime AssignedAt,
-    EffectiveConfigDto EffectiveConfig
+    EffectiveConfigDto EffectiveConfig,
+    int? AggregationWindowSeconds = null
 );
 
 /// <summary>
@@ -46,7 +47,8 @@ public record CreateNodeSensorAssignmentDto(
     int? TriggerPinOverride = null,
     int? EchoPinOverride = null,
     int? BaudRateOverride = null,
-    int? IntervalSecondsOverride = null
+    int? IntervalSecondsOverride = null,
+    int? AggregationWindowSeconds = null
 );
 
 /// <summary>
@@ -64,7 +66,8 @@ public record UpdateNodeSensorAssignmentDto(
     int? EchoPinOverride = null,
     int? BaudRateOverride = null,
     int? IntervalSecondsOverride = null,
-    bool? IsActive = null
+    bool? IsActive = null,
+    int? AggregationWindowSeconds = null
 );
 
 /// <summary>
@@ -84,5 +87,6 @@ public record EffectiveConfigDto(
     int? EchoPin,
     int? BaudRate,
     double OffsetCorrection,
-    double GainCorrection
+    double GainCorrection,
+    int AggregationWindowSeconds = 0
 );
@@ -70,7 +70,14 @@ public record CreateBatchReadingsDto(
 public record ReadingValueDto(
     int EndpointId,
     string MeasurementType,
-    double RawValue
+    double RawValue,
+    /// <summary>
+    /// Optional capture time of this reading (Unix seconds).
+    /// Offline sync sends readings spanning hours in one batch; falls back to the batch Timestamp.
+    /// </summary>
+    long? Timestamp = null,
+    /// <summary>Optional unit sent by the node (otherwise taken from the sensor capability)</summary>
+    string? Unit = null
 );
 
 /// <summary>
@@ -82,7 +82,11 @@ public record SensorCapabilityDto(
     uint? MatterClusterId,
     string? MatterClusterName,
     int SortOrder,
-    bool IsActive
+    bool IsActive,
+    double? DeadbandAbsolute = null,
+    double? DeadbandPercent = null,
+    double? DeadbandSlopePerMinute = null,
+    int? MaxSilenceSeconds = null
 );
 
 /// <summary>
@@ -147,7 +151,11 @@ public record CreateSensorCapabilityDto(
     double Accuracy = 0.5,
     uint? MatterClusterId = null,
     string? MatterClusterName = null,
-    int SortOrder = 0
+    int SortOrder = 0,
+    double? DeadbandAbsolute = null,
+    double? DeadbandPercent = null,
+    double? DeadbandSlopePerMinute = null,
+    int? MaxSilenceSeconds = null
 );
 
 /// <summary>
@@ -217,7 +225,11 @@ public record UpdateSensorCapabilityDto(
     uint? MatterClusterId = null,
     string? MatterClusterName = null,
     int? SortOrder = null,
-    bool? IsActive = null
+    bool? IsActive = null,
+    double? DeadbandAbsolute = null,
+    double? DeadbandPercent = null,
+    double? DeadbandSlopePerMinute = null,
+    int? MaxSilenceSeconds = null
 );
 
 /// <summary>
@@ -92,6 +92,14 @@ public class Node : IEntity
     /// <summary>When hardware status was last reported</summary>
     public DateTime? HardwareStatusReportedAt { get; set; }
 
+    // === Heartbeat Diagnostics ===
+
+    /// <summary>Diagnostics of the last heartbeat as JSON (wifi, pipeline, time, sync, compression, metrics, loop)</summary>
+    public string? DiagnosticsJson { get; set; }
+
+    /// <summary>When heartbeat diagnostics were last reported</summary>
+    public DateTime? DiagnosticsReportedAt { get; set; }
+
     // === Navigation Properties ===
 
     /// <summary>Hub managing this node</summary>
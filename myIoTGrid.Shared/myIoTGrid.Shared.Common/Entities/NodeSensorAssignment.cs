@@ -60,6 +60,12 @@ public class NodeSensorAssignment : IEntity
     /// <summary>Override measurement interval (null = use Sensor default)</summary>
     public int? IntervalSecondsOverride { get; set; }
 
+    /// <summary>
+    /// Aggregation window in seconds: the firmware samples at the interval and
+    /// uploads one min/max/mean summary per window (null = every sample)
+    /// </summary>
+    public int? AggregationWindowSeconds { get; set; }
+
     // === Status ===
 
     /// <summary>Is this assignment active?</summary>
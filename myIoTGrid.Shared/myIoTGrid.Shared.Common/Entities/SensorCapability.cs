@@ -48,6 +48,20 @@ public class SensorCapability : IEntity
     /// <summary>Is this capability active?</summary>
     public bool IsActive { get; set; } = true;
 
+    // === Report-by-Exception (firmware deadband filter) ===
+
+    /// <summary>Send when the value changed by this much since the last sent value (null = firmware default for the type)</summary>
+    public double? DeadbandAbsolute { get; set; }
+
+    /// <summary>Send when the value changed by this percentage of the last sent value (null = off)</summary>
+    public double? DeadbandPercent { get; set; }
+
+    /// <summary>Send when the value changes faster than this per minute (null = off)</summary>
+    public double? DeadbandSlopePerMinute { get; set; }
+
+    /// <summary>Send at least once within this many seconds (null = firmware default, 900 s)</summary>
+    public int? MaxSilenceSeconds { get; set; }
+
     // === Navigation Properties ===
 
     /// <summary>Parent sensor</summary>